@@ -0,0 +1,40 @@
+/**
+ * @file AllocationCounter.hpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+#ifndef WALKING_ALLOCATION_COUNTER_HPP
+#define WALKING_ALLOCATION_COUNTER_HPP
+
+// std
+#include <cstddef>
+
+// benchmark
+#include <benchmark/benchmark.h>
+
+/**
+ * The benchmarks replace the allocation functions of the C library (malloc, calloc, realloc and
+ * the aligned ones) in order to count the memory allocations performed by the kernels, including
+ * the ones of operator new and of the dynamic Eigen objects. Without glibc only the global
+ * operator new is replaced, so the allocations of Eigen are not counted.
+ */
+namespace AllocationCounter
+{
+/**
+ * Get the number of allocations performed since the beginning of the process.
+ * @return the number of allocations.
+ */
+std::size_t count();
+
+/**
+ * Add the "allocs/op" counter to a benchmark.
+ * @param state state of the benchmark;
+ * @param initialCount number of allocations before the benchmark loop.
+ */
+void report(benchmark::State& state, std::size_t initialCount);
+} // namespace AllocationCounter
+
+#endif
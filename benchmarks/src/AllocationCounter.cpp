@@ -0,0 +1,115 @@
+/**
+ * @file AllocationCounter.cpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+// std
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <new>
+
+#include <AllocationCounter.hpp>
+
+namespace
+{
+std::atomic<std::size_t> allocations{0};
+
+void countAllocation()
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+}
+} // namespace
+
+#if defined(__GLIBC__)
+// The allocations are counted at the malloc level: operator new (in all its forms) ends in malloc
+// or in one of the aligned functions, and Eigen allocates the dynamic matrices with std::malloc
+// (aligned_malloc). The functions defined here replace the ones of glibc, which are still
+// reachable through their __libc_* aliases.
+extern "C"
+{
+    void* __libc_malloc(std::size_t size);
+    void* __libc_calloc(std::size_t number, std::size_t size);
+    void* __libc_realloc(void* pointer, std::size_t size);
+    void* __libc_memalign(std::size_t alignment, std::size_t size);
+    void __libc_free(void* pointer);
+
+    void* malloc(std::size_t size)
+    {
+        countAllocation();
+        return __libc_malloc(size);
+    }
+
+    void* calloc(std::size_t number, std::size_t size)
+    {
+        countAllocation();
+        return __libc_calloc(number, size);
+    }
+
+    void* realloc(void* pointer, std::size_t size)
+    {
+        countAllocation();
+        return __libc_realloc(pointer, size);
+    }
+
+    void* memalign(std::size_t alignment, std::size_t size)
+    {
+        countAllocation();
+        return __libc_memalign(alignment, size);
+    }
+
+    void* aligned_alloc(std::size_t alignment, std::size_t size)
+    {
+        countAllocation();
+        return __libc_memalign(alignment, size);
+    }
+
+    int posix_memalign(void** pointer, std::size_t alignment, std::size_t size)
+    {
+        // the alignment has to be a power of two multiple of sizeof(void*)
+        if (alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0)
+            return EINVAL;
+
+        countAllocation();
+        void* memory = __libc_memalign(alignment, size);
+        if (memory == nullptr)
+            return ENOMEM;
+        *pointer = memory;
+        return 0;
+    }
+
+    void free(void* pointer)
+    {
+        __libc_free(pointer);
+    }
+}
+#else
+// Without glibc only the allocations of operator new are counted, the ones of Eigen (std::malloc)
+// are not. The other forms of operator new and delete call these ones.
+void* operator new(std::size_t size)
+{
+    countAllocation();
+    if (void* pointer = std::malloc(size == 0 ? 1 : size))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+#endif
+
+std::size_t AllocationCounter::count()
+{
+    return allocations.load(std::memory_order_relaxed);
+}
+
+void AllocationCounter::report(benchmark::State& state, std::size_t initialCount)
+{
+    state.counters["allocs/op"] = benchmark::Counter(static_cast<double>(count() - initialCount),
+                                                     benchmark::Counter::kAvgIterations);
+}
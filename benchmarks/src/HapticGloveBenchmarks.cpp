@@ -0,0 +1,299 @@
+/**
+ * @file HapticGloveBenchmarks.cpp
+ * @authors Kourosh Darvish <kourosh.darvish@iit.it>
+ * @copyright 2021 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2021
+ */
+
+// std
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+// benchmark
+#include <benchmark/benchmark.h>
+
+// YARP
+#include <yarp/os/Property.h>
+#include <yarp/sig/Vector.h>
+
+// teleoperation
+#include <AllocationCounter.hpp>
+#include <ControlHelper.hpp>
+#include <FixedSizeKalmanFilter.hpp>
+#include <InputSession.hpp>
+#include <LinearRegression.hpp>
+#include <Retargeting.hpp>
+#include <RobotMotorsEstimation.hpp>
+#include <RobotSkin.hpp>
+#include <Utils.hpp>
+
+using namespace HapticGlove;
+
+namespace
+{
+// the inputs are cycled in order to avoid that the branch predictor learns a single input
+constexpr std::size_t numberOfSamples = 256;
+constexpr double samplingTime = 0.01;
+
+// the skin is fed by a replayed session, see BM_RobotSkinUpdateTactileFeedbacks
+constexpr std::size_t numberOfSkinCalibrationCycles = 200;
+constexpr std::size_t numberOfSkinCycles = 20000;
+const std::string skinSessionFile = "HapticGloveBenchmarks_skin_inputs.bin";
+
+/**
+ * Load the configuration of the right hand of iCubGenova09, it has 19 joints, 9 axes and 60
+ * fingertip taxels.
+ */
+bool loadRightHandConfiguration(yarp::os::Property& config)
+{
+    if (!config.fromConfigFile(std::string(WALKING_TELEOPERATION_BENCHMARKS_ROBOT_DIR)
+                               + "/rightFingersHapticRetargetingParams.ini"))
+        return false;
+
+    config.put("samplingTime", samplingTime);
+    return true;
+}
+
+void BM_RetargetHumanMotionToRobot(benchmark::State& state)
+{
+    yarp::os::Property config;
+    std::vector<std::string> robotJoints, robotAxes, humanJoints;
+    if (!loadRightHandConfiguration(config)
+        || !YarpHelper::getVectorFromSearchable(config, "joint_list", robotJoints)
+        || !YarpHelper::getVectorFromSearchable(config, "axis_list", robotAxes)
+        || !YarpHelper::getVectorFromSearchable(config, "human_joint_list", humanJoints))
+    {
+        state.SkipWithError("Unable to load the configuration.");
+        return;
+    }
+
+    Retargeting retargeting(robotJoints, robotAxes, humanJoints);
+    if (!retargeting.configure(config, "icub", true)
+        || !retargeting.setRobotJointLimits(std::vector<double>(robotJoints.size(), 0.0),
+                                            std::vector<double>(robotJoints.size(), 1.5)))
+    {
+        state.SkipWithError("Unable to configure the retargeting.");
+        return;
+    }
+
+    // the human closes and opens the hand, with a part of the motion outside the robot limits
+    std::vector<std::vector<double>> humanJointAngles(numberOfSamples);
+    for (std::size_t i = 0; i < numberOfSamples; i++)
+    {
+        for (std::size_t j = 0; j < humanJoints.size(); j++)
+            humanJointAngles[i].push_back(
+                0.8 + 0.9 * std::sin(2 * M_PI * i / numberOfSamples + 0.1 * j));
+    }
+    std::size_t sample = 0;
+
+    const std::size_t allocations = AllocationCounter::count();
+    for (auto _ : state)
+    {
+        retargeting.retargetHumanMotionToRobot(humanJointAngles[sample++ % numberOfSamples]);
+    }
+    AllocationCounter::report(state, allocations);
+}
+BENCHMARK(BM_RetargetHumanMotionToRobot);
+
+void BM_FixedSizeKalmanFilterEstimateNextState(benchmark::State& state)
+{
+    // model of the motor estimator: position, velocity and acceleration of an axis
+    typedef FixedSizeKalmanFilter<3, 1, 3> Filter;
+    Filter::StateMatrix F = Filter::StateMatrix::Zero();
+    F(0, 1) = 1.0;
+    F(1, 2) = 1.0;
+    Filter::OutputMatrix H = Filter::OutputMatrix::Zero();
+    H(0, 0) = 1.0;
+    const Filter::MeasurementMatrix R = 1e-7 * Filter::MeasurementMatrix::Identity();
+    const Filter::InputCovarianceMatrix Q = Eigen::Vector3d(10.0, 150.0, 100000.0).asDiagonal();
+
+    Filter filter(samplingTime, F, Filter::InputMatrix::Identity(), H, R, Q);
+    filter.initialize(Filter::StateVector::Zero(), Filter::StateMatrix::Identity());
+
+    std::vector<Filter::MeasurementVector> measurements(numberOfSamples);
+    for (std::size_t i = 0; i < numberOfSamples; i++)
+        measurements[i](0) = std::sin(2 * M_PI * i / numberOfSamples);
+    std::size_t sample = 0;
+
+    const std::size_t allocations = AllocationCounter::count();
+    EIGEN_MALLOC_NOT_ALLOWED
+    for (auto _ : state)
+    {
+        filter.estimateNextState(measurements[sample++ % numberOfSamples]);
+    }
+    EIGEN_MALLOC_ALLOWED
+    AllocationCounter::report(state, allocations);
+}
+BENCHMARK(BM_FixedSizeKalmanFilterEstimateNextState);
+
+void BM_EstimatorsEstimateNextState(benchmark::State& state)
+{
+    const std::size_t numberOfAxes = state.range(0);
+
+    yarp::os::Property config;
+    if (!loadRightHandConfiguration(config))
+    {
+        state.SkipWithError("Unable to load the configuration.");
+        return;
+    }
+
+    Estimators estimators(numberOfAxes);
+    if (!estimators.configure(config, "benchmark")
+        || !estimators.initialize(std::vector<double>(numberOfAxes, 0.0)))
+    {
+        state.SkipWithError("Unable to configure the estimators.");
+        return;
+    }
+
+    std::vector<std::vector<double>> measurements(numberOfSamples);
+    for (std::size_t i = 0; i < numberOfSamples; i++)
+    {
+        for (std::size_t j = 0; j < numberOfAxes; j++)
+            measurements[i].push_back(std::sin(2 * M_PI * i / numberOfSamples + j));
+    }
+    std::size_t sample = 0;
+
+    const std::size_t allocations = AllocationCounter::count();
+    EIGEN_MALLOC_NOT_ALLOWED
+    for (auto _ : state)
+    {
+        estimators.estimateNextState(measurements[sample++ % numberOfSamples]);
+    }
+    EIGEN_MALLOC_ALLOWED
+    AllocationCounter::report(state, allocations);
+}
+BENCHMARK(BM_EstimatorsEstimateNextState)->DenseRange(6, 20, 2);
+
+/**
+ * Record the raw data of the skin of the right hand in a session file. The fingers are in turn
+ * pressed and released.
+ * @param numberOfTactileSensors number of values of the skin port.
+ * @return true in case of success and false otherwise.
+ */
+bool recordSkinSession(std::size_t numberOfTactileSensors)
+{
+    yarp::os::Property config;
+    config.fromString("(INPUT_SESSION (mode record) (file " + skinSessionFile + "))");
+
+    InputSession session;
+    if (!session.configure(config, "HapticGloveBenchmarks"))
+        return false;
+    const InputSession::Stream stream = session.addStream("right_hand/skin/raw");
+
+    // 240 means no load and 0 maximum load
+    std::mt19937 generator(42);
+    std::normal_distribution<double> noise(0.0, 1.5);
+    constexpr std::size_t numberOfFingers = 5;
+    constexpr std::size_t taxelsPerFinger = 12;
+    yarp::sig::Vector rawData(numberOfTactileSensors, 240.0);
+
+    for (std::size_t cycle = 0; cycle < numberOfSkinCycles; cycle++)
+    {
+        session.beginCycle();
+        for (std::size_t i = 0; i < numberOfTactileSensors; i++)
+        {
+            const std::size_t finger = i / taxelsPerFinger;
+            const bool isPressed = cycle > numberOfSkinCalibrationCycles
+                                   && finger < numberOfFingers
+                                   && (cycle / 100 + finger) % 3 == 0;
+            const double load = isPressed ? 150.0 * std::sin(M_PI * (cycle % 100) / 100.0) : 0.0;
+            rawData[i] = 240.0 - load + noise(generator);
+        }
+        session.record(stream, rawData);
+    }
+
+    session.close();
+    return true;
+}
+
+void BM_RobotSkinUpdateTactileFeedbacks(benchmark::State& state)
+{
+    yarp::os::Property config;
+    if (!loadRightHandConfiguration(config))
+    {
+        state.SkipWithError("Unable to load the configuration.");
+        return;
+    }
+
+    if (!recordSkinSession(config.check("noTactileSensors", yarp::os::Value(192)).asInt64()))
+    {
+        state.SkipWithError("Unable to record the skin session.");
+        return;
+    }
+
+    // the replayed session replaces the skin device
+    yarp::os::Property sessionConfig;
+    sessionConfig.fromString("(INPUT_SESSION (mode replay) (file " + skinSessionFile
+                             + ") (pace fast))");
+    InputSession session;
+    RobotSkin skin;
+    if (!session.configure(sessionConfig, "HapticGloveBenchmarks")
+        || !skin.configure(config, "icub", true, session))
+    {
+        std::remove(skinSessionFile.c_str());
+        state.SkipWithError("Unable to configure the robot skin.");
+        return;
+    }
+
+    for (std::size_t cycle = 0; cycle < numberOfSkinCalibrationCycles; cycle++)
+    {
+        session.beginCycle();
+        skin.updateTactileFeedbacks();
+        skin.collectSkinDataForCalibration();
+    }
+    skin.computeCalibrationParamters();
+
+    // beginCycle() copies the raw data of the cycle, as the device readout would do
+    const std::size_t allocations = AllocationCounter::count();
+    for (auto _ : state)
+    {
+        session.beginCycle();
+        skin.updateTactileFeedbacks();
+    }
+    AllocationCounter::report(state, allocations);
+
+    std::remove(skinSessionFile.c_str());
+}
+// the replayed session is finite, so the number of iterations is fixed
+BENCHMARK(BM_RobotSkinUpdateTactileFeedbacks)
+    ->Iterations(numberOfSkinCycles - numberOfSkinCalibrationCycles);
+
+void BM_LinearRegressionLearnOneShotMatrix(benchmark::State& state)
+{
+    // coupling between the 9 axes (plus the bias) and the 19 joints of the hand
+    const std::size_t numberOfObservations = state.range(0);
+    constexpr std::size_t numberOfAxes = 9;
+    constexpr std::size_t numberOfJoints = 19;
+
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> distribution(0.0, 1.5);
+    CtrlHelper::Eigen_Mat coupling(numberOfAxes + 1, numberOfJoints);
+    for (Eigen::Index i = 0; i < coupling.size(); i++)
+        coupling.data()[i] = distribution(generator);
+
+    CtrlHelper::Eigen_Mat axesData(numberOfObservations, numberOfAxes + 1);
+    axesData.col(0).setOnes();
+    for (std::size_t i = 0; i < numberOfObservations; i++)
+    {
+        for (std::size_t j = 1; j <= numberOfAxes; j++)
+            axesData(i, j) = distribution(generator);
+    }
+    const CtrlHelper::Eigen_Mat jointsData = axesData * coupling;
+
+    LinearRegression regression;
+    CtrlHelper::Eigen_Mat theta;
+
+    const std::size_t allocations = AllocationCounter::count();
+    for (auto _ : state)
+    {
+        regression.LearnOneShotMatrix(axesData, jointsData, theta);
+        benchmark::DoNotOptimize(theta.data());
+    }
+    AllocationCounter::report(state, allocations);
+}
+BENCHMARK(BM_LinearRegressionLearnOneShotMatrix)->Arg(200)->Arg(1000)->Arg(5000);
+} // namespace
@@ -0,0 +1,176 @@
+/**
+ * @file OculusRetargetingBenchmarks.cpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+// std
+#include <cmath>
+#include <random>
+#include <vector>
+
+// benchmark
+#include <benchmark/benchmark.h>
+
+// YARP
+#include <yarp/os/Property.h>
+#include <yarp/sig/Matrix.h>
+#include <yarp/sig/Vector.h>
+
+// iDynTree
+#include <iDynTree/Core/EigenHelpers.h>
+#include <iDynTree/Core/Rotation.h>
+#include <iDynTree/Core/Transform.h>
+#include <iDynTree/yarp/YARPConversions.h>
+
+#include <AllocationCounter.hpp>
+#include <HandRetargeting.hpp>
+#include <HeadRetargeting.hpp>
+#include <OrientationSmoother.hpp>
+
+namespace
+{
+// the inputs are cycled in order to avoid that the branch predictor learns a single input
+constexpr std::size_t numberOfSamples = 256;
+
+/**
+ * Head orientations reachable by the neck.
+ */
+std::vector<iDynTree::Rotation> headOrientations()
+{
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> pitch(-0.6, 0.4);
+    std::uniform_real_distribution<double> roll(-0.3, 0.3);
+    std::uniform_real_distribution<double> yaw(-0.8, 0.8);
+
+    std::vector<iDynTree::Rotation> orientations;
+    for (std::size_t i = 0; i < numberOfSamples; i++)
+        orientations.push_back(
+            HeadRetargeting::forwardKinematics(pitch(generator), roll(generator), yaw(generator)));
+    return orientations;
+}
+
+/**
+ * Hand poses of a user moving the joypads in front of the headset.
+ */
+std::vector<yarp::sig::Matrix> handTransforms()
+{
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> position(-0.6, 0.6);
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+
+    std::vector<yarp::sig::Matrix> transforms;
+    for (std::size_t i = 0; i < numberOfSamples; i++)
+    {
+        const iDynTree::Transform transform(
+            iDynTree::Rotation::RPY(angle(generator), angle(generator), angle(generator)),
+            iDynTree::Position(position(generator), position(generator), position(generator)));
+
+        yarp::sig::Matrix matrix(4, 4);
+        iDynTree::toYarp(transform.asHomogeneousTransform(), matrix);
+        transforms.push_back(matrix);
+    }
+    return transforms;
+}
+
+void BM_HeadRetargetingInverseKinematics(benchmark::State& state)
+{
+    const std::vector<iDynTree::Rotation> orientations = headOrientations();
+    double neckPitch, neckRoll, neckYaw;
+    std::size_t sample = 0;
+
+    const std::size_t allocations = AllocationCounter::count();
+    for (auto _ : state)
+    {
+        HeadRetargeting::inverseKinematics(
+            orientations[sample++ % numberOfSamples], neckPitch, neckRoll, neckYaw);
+        benchmark::DoNotOptimize(neckPitch);
+        benchmark::DoNotOptimize(neckRoll);
+        benchmark::DoNotOptimize(neckYaw);
+    }
+    AllocationCounter::report(state, allocations);
+}
+BENCHMARK(BM_HeadRetargetingInverseKinematics);
+
+void BM_HeadRetargetingInverseKinematicsXZY(benchmark::State& state)
+{
+    const std::vector<iDynTree::Rotation> orientations = headOrientations();
+    double neckPitch, neckRoll, neckYaw;
+    std::size_t sample = 0;
+
+    const std::size_t allocations = AllocationCounter::count();
+    for (auto _ : state)
+    {
+        HeadRetargeting::inverseKinematicsXZY(
+            orientations[sample++ % numberOfSamples], neckPitch, neckRoll, neckYaw);
+        benchmark::DoNotOptimize(neckPitch);
+        benchmark::DoNotOptimize(neckRoll);
+        benchmark::DoNotOptimize(neckYaw);
+    }
+    AllocationCounter::report(state, allocations);
+}
+BENCHMARK(BM_HeadRetargetingInverseKinematicsXZY);
+
+void BM_HeadOrientationSmoother(benchmark::State& state)
+{
+    // same sampling and smoothing times of the iCub configuration files
+    OrientationSmoother smoother;
+    if (!smoother.configure(0.01, 1.0))
+    {
+        state.SkipWithError("Unable to configure the orientation smoother.");
+        return;
+    }
+
+    std::vector<Eigen::Matrix3d> orientations;
+    for (const auto& orientation : headOrientations())
+        orientations.push_back(iDynTree::toEigen(orientation));
+    Eigen::Matrix3d smoothedOrientation;
+    std::size_t sample = 0;
+
+    const std::size_t allocations = AllocationCounter::count();
+    for (auto _ : state)
+    {
+        smoother.smooth(orientations[sample++ % numberOfSamples], smoothedOrientation);
+        benchmark::DoNotOptimize(smoothedOrientation.data());
+    }
+    AllocationCounter::report(state, allocations);
+}
+BENCHMARK(BM_HeadOrientationSmoother);
+
+void BM_HandRetargetingEvaluateDesiredHandPose(benchmark::State& state)
+{
+    // same frames of the iCub configuration files, the argument selects the representation of
+    // the hand pose (0: roll pitch yaw, 1: quaternion)
+    yarp::os::Property config;
+    config.fromString("(humanHeight 1.8) (robotArmSpan 1.0) "
+                      "(handOculusFrame_R_handRobotFrame ((0.0 0.0 -1.0) (-1.0 0.0 0.0) "
+                      "(0.0 1.0 0.0))) "
+                      "(teleoperationRobotFrame_R_teleoperationFrame ((-1.0 0.0 0.0) "
+                      "(0.0 -1.0 0.0) (0.0 0.0 1.0)))");
+    config.put("handPoseRepresentation", state.range(0) == 0 ? "rpy" : "quaternion");
+
+    HandRetargeting retargeting;
+    if (!retargeting.configure(config))
+    {
+        state.SkipWithError("Unable to configure the hand retargeting.");
+        return;
+    }
+    retargeting.setPlayerOrientation(0.3);
+
+    const std::vector<yarp::sig::Matrix> transforms = handTransforms();
+    yarp::sig::Vector handPose(state.range(0) == 0 ? 6 : 7, 0.0);
+    std::size_t sample = 0;
+
+    const std::size_t allocations = AllocationCounter::count();
+    for (auto _ : state)
+    {
+        retargeting.setHandTransform(transforms[sample++ % numberOfSamples]);
+        retargeting.evaluateDesiredHandPose(handPose);
+        benchmark::DoNotOptimize(handPose.data());
+    }
+    AllocationCounter::report(state, allocations);
+}
+BENCHMARK(BM_HandRetargetingEvaluateDesiredHandPose)->Arg(0)->Arg(1);
+} // namespace
@@ -0,0 +1,124 @@
+/**
+ * @file UtilsBenchmarks.cpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+// std
+#define _USE_MATH_DEFINES
+#include <cmath>
+#include <random>
+#include <vector>
+
+// benchmark
+#include <benchmark/benchmark.h>
+
+// Eigen
+#include <Eigen/Dense>
+
+// YARP
+#include <yarp/os/BufferedPort.h>
+#include <yarp/sig/Vector.h>
+
+#include <AllocationCounter.hpp>
+#include <Utils.hpp>
+
+namespace
+{
+/**
+ * Angles spread over a few turns, as the yaw of the player of the virtualizer.
+ * @param size number of angles.
+ */
+Eigen::VectorXd randomAngles(std::size_t size)
+{
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> angle(-4.0 * M_PI, 4.0 * M_PI);
+    Eigen::VectorXd angles(size);
+    for (std::size_t i = 0; i < size; i++)
+        angles(i) = angle(generator);
+    return angles;
+}
+
+void BM_NormalizeAngleScalar(benchmark::State& state)
+{
+    const Eigen::VectorXd input = randomAngles(state.range(0));
+    Eigen::VectorXd angles(input.size());
+
+    const std::size_t allocations = AllocationCounter::count();
+    for (auto _ : state)
+    {
+        for (Eigen::Index i = 0; i < input.size(); i++)
+            angles(i) = Angles::normalizeAngle(input(i));
+        benchmark::DoNotOptimize(angles.data());
+    }
+    AllocationCounter::report(state, allocations);
+}
+BENCHMARK(BM_NormalizeAngleScalar)->Arg(23)->Arg(66);
+
+void BM_NormalizeAngles(benchmark::State& state)
+{
+    const Eigen::VectorXd input = randomAngles(state.range(0));
+    Eigen::VectorXd angles(input.size());
+
+    const std::size_t allocations = AllocationCounter::count();
+    for (auto _ : state)
+    {
+        angles = input;
+        Angles::normalizeAngles(angles);
+        benchmark::DoNotOptimize(angles.data());
+    }
+    AllocationCounter::report(state, allocations);
+}
+BENCHMARK(BM_NormalizeAngles)->Arg(23)->Arg(66);
+
+void BM_ShortestAngularDistances(benchmark::State& state)
+{
+    const Eigen::VectorXd from = randomAngles(state.range(0));
+    const Eigen::VectorXd to = from.reverse();
+    Eigen::VectorXd distances(from.size());
+
+    const std::size_t allocations = AllocationCounter::count();
+    for (auto _ : state)
+    {
+        Angles::shortestAngularDistances(from, to, distances);
+        benchmark::DoNotOptimize(distances.data());
+    }
+    AllocationCounter::report(state, allocations);
+}
+BENCHMARK(BM_ShortestAngularDistances)->Arg(23)->Arg(66);
+
+void BM_SendVariadicVector(benchmark::State& state)
+{
+    // a message similar to the ones of the modules: a pose, the joint values, a small std vector
+    // and a scalar
+    yarp::os::BufferedPort<yarp::sig::Vector> port;
+    if (!port.open("/benchmark/variadicVector:o"))
+    {
+        state.SkipWithError("Unable to open the port.");
+        return;
+    }
+
+    yarp::sig::Vector pose(7, 0.0);
+    Eigen::VectorXd joints = Eigen::VectorXd::Zero(state.range(0));
+    std::vector<double> values(4, 0.0);
+    double scalar = 0;
+
+    // the first messages set the size of the buffers of the port
+    for (int i = 0; i < 10; i++)
+        YarpHelper::sendVariadicVector(port, pose, joints, values, scalar);
+
+    const std::size_t allocations = AllocationCounter::count();
+    for (auto _ : state)
+    {
+        scalar += 1e-3;
+        pose[0] = std::sin(scalar);
+        YarpHelper::sendVariadicVector(port, pose, joints, values, scalar);
+    }
+    AllocationCounter::report(state, allocations);
+
+    port.close();
+}
+BENCHMARK(BM_SendVariadicVector)->Arg(23)->Arg(66);
+} // namespace
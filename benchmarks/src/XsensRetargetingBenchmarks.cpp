@@ -0,0 +1,100 @@
+/**
+ * @file XsensRetargetingBenchmarks.cpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+// std
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+// benchmark
+#include <benchmark/benchmark.h>
+
+// YARP
+#include <yarp/sig/Vector.h>
+
+#include <AllocationCounter.hpp>
+#include <XsensJointMapping.hpp>
+
+namespace
+{
+// number of joints of the human model used by the human state provider
+constexpr std::size_t numberOfHumanJoints = 66;
+constexpr std::size_t numberOfSamples = 256;
+
+/**
+ * Joint lists ordered differently, as the ones of the human state provider and of the
+ * controller.
+ * @param numberOfRobotJoints number of joints of the controller.
+ */
+void jointLists(std::size_t numberOfRobotJoints,
+                std::vector<std::string>& robotJoints,
+                std::vector<std::string>& humanJoints)
+{
+    humanJoints.clear();
+    for (std::size_t i = 0; i < numberOfHumanJoints; i++)
+        humanJoints.push_back("joint_" + std::to_string(i));
+
+    std::mt19937 generator(42);
+    robotJoints = humanJoints;
+    std::shuffle(robotJoints.begin(), robotJoints.end(), generator);
+    robotJoints.resize(numberOfRobotJoints);
+}
+
+void BM_XsensMapJointsHDE2Controller(benchmark::State& state)
+{
+    std::vector<std::string> robotJoints, humanJoints;
+    jointLists(state.range(0), robotJoints, humanJoints);
+    std::vector<unsigned> humanToRobotMap;
+
+    const std::size_t allocations = AllocationCounter::count();
+    for (auto _ : state)
+    {
+        XsensJointMapping::mapJointsHDE2Controller(robotJoints, humanJoints, humanToRobotMap);
+        benchmark::DoNotOptimize(humanToRobotMap.data());
+    }
+    AllocationCounter::report(state, allocations);
+}
+BENCHMARK(BM_XsensMapJointsHDE2Controller)->Arg(23)->Arg(32);
+
+void BM_XsensMapJointValues(benchmark::State& state)
+{
+    std::vector<std::string> robotJoints, humanJoints;
+    jointLists(state.range(0), robotJoints, humanJoints);
+    std::vector<unsigned> humanToRobotMap;
+    if (!XsensJointMapping::mapJointsHDE2Controller(robotJoints, humanJoints, humanToRobotMap))
+    {
+        state.SkipWithError("Unable to map the joints.");
+        return;
+    }
+
+    // smooth human motion, so no spike is detected
+    std::vector<std::vector<double>> humanJointsValues(numberOfSamples);
+    for (std::size_t i = 0; i < numberOfSamples; i++)
+    {
+        for (std::size_t j = 0; j < numberOfHumanJoints; j++)
+            humanJointsValues[i].push_back(0.5 * std::sin(2 * M_PI * i / numberOfSamples + j));
+    }
+    yarp::sig::Vector robotJointsValues(robotJoints.size(), 0.0);
+    std::size_t sample = 0;
+
+    const std::size_t allocations = AllocationCounter::count();
+    for (auto _ : state)
+    {
+        XsensJointMapping::mapJointValues(humanJointsValues[sample++ % numberOfSamples],
+                                          humanToRobotMap,
+                                          robotJoints,
+                                          1.0,
+                                          robotJointsValues);
+        benchmark::DoNotOptimize(robotJointsValues.data());
+    }
+    AllocationCounter::report(state, allocations);
+}
+BENCHMARK(BM_XsensMapJointValues)->Arg(23)->Arg(32);
+} // namespace
@@ -0,0 +1,30 @@
+/**
+ * @file main.cpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+// std
+#include <cstdlib>
+
+// benchmark
+#include <benchmark/benchmark.h>
+
+// YARP
+#include <yarp/os/Network.h>
+
+int main(int argc, char* argv[])
+{
+    // the benchmarks use synthetic inputs, so the name server is not needed
+    yarp::os::Network::setLocalMode(true);
+    yarp::os::Network yarp;
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return EXIT_FAILURE;
+
+    benchmark::RunSpecifiedBenchmarks();
+    return EXIT_SUCCESS;
+}
@@ -140,6 +140,12 @@ if(ENABLE_LOGGER)
   find_package(matlogger2 REQUIRED)
 endif(ENABLE_LOGGER)
 
+# Enable the per-stage latency histograms of the control loops
+option(ENABLE_INSTRUMENTATION "Enable the per-stage latency histograms" ON)
+if(ENABLE_INSTRUMENTATION)
+  add_definitions(-DENABLE_INSTRUMENTATION)
+endif(ENABLE_INSTRUMENTATION)
+
 
 find_package(PkgConfig QUIET)
 if (PkgConfig_FOUND)
@@ -162,9 +168,13 @@ checkandset_dependency(IWear)
 find_package(WearableActuators QUIET)
 checkandset_dependency(WearableActuators)
 
+find_package(benchmark QUIET)
+checkandset_dependency(benchmark)
+
 
 WALKING_TELEOPERATION_dependent_option(WALKING_TELEOPERATION_COMPILE_XsensModule "Compile Xsens Module?" ON WALKING_TELEOPERATION_HAS_HumanDynamicsEstimation OFF)
 WALKING_TELEOPERATION_dependent_option(WALKING_TELEOPERATION_COMPILE_VirtualizerModule "Compile Virtualizer Module?" ON WALKING_TELEOPERATION_HAS_CybSDK OFF)
 WALKING_TELEOPERATION_dependent_option(WALKING_TELEOPERATION_COMPILE_FaceExpressionsRetargetingModule "Compile Face Expressions Module?" ON WALKING_TELEOPERATION_USE_libfvad OFF)
 WALKING_TELEOPERATION_dependent_option(WALKING_TELEOPERATION_COMPILE_SRanipalModule "Compile SRanipal Module?" ON WALKING_TELEOPERATION_USE_SRanipalSDK OFF)
 WALKING_TELEOPERATION_dependent_option(WALKING_TELEOPERATION_COMPILE_HapticGloveModule "Compile Haptic Glove Module?" ON "WALKING_TELEOPERATION_USE_IWear;WALKING_TELEOPERATION_USE_WearableActuators" OFF)
+WALKING_TELEOPERATION_dependent_option(WALKING_TELEOPERATION_COMPILE_Benchmarks "Compile the benchmarks of the retargeting and estimation kernels?" OFF WALKING_TELEOPERATION_USE_benchmark OFF)
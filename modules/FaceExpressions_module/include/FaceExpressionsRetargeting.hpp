@@ -15,6 +15,7 @@
 #include <yarp/os/RFModule.h> /** We inherit from this. **/
 #include <yarp/os/RpcClient.h> /** Needed to control the face expressions. **/
 #include <mutex> /** For mutex and lock_guard. **/
+#include <LockFree.hpp> /** Needed to get the latest sound without waiting for the port. **/
 
 /**
  * @brief The FaceExpressionsRetargetingModule class allows to control the mouth of the robot face expressions if it detects a voice
@@ -25,6 +26,7 @@ class FaceExpressionsRetargetingModule : public yarp::os::RFModule
 
     Fvad * m_fvadObject {nullptr}; /** The voice activity detection object. **/
     yarp::os::BufferedPort<yarp::sig::Sound> m_audioPort; /** The input port for receiving the microphone input. **/
+    LockFree::PortMailbox<yarp::sig::Sound> m_audioMailbox; /** The latest sound received by the port thread. **/
     std::vector<int16_t> m_copiedSound; /** Internal sound buffer. **/
     int m_isTalking{0}; /** Status integer to understand if the operator is talking. **/
     size_t m_switchCounter{0}; /** Internal counter to switch between different mouth positions (to give the impressions it is talking). **/
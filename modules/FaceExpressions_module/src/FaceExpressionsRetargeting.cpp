@@ -33,6 +33,7 @@ bool FaceExpressionsRetargetingModule::configure(yarp::os::ResourceFinder &rf)
 
     std::string audioPortIn = rf.check("audio_input_port_name", yarp::os::Value("/in"), "The name of the input port for the audio.").asString();
     m_audioPort.open("/" + name + audioPortIn);
+    m_audioPort.useCallback(m_audioMailbox);
 
     std::string emotionsPortOut = rf.check("emotions_output_port_name", yarp::os::Value("/emotions:o"), "The name of the output port for the emotions.").asString();
 
@@ -91,9 +92,10 @@ bool FaceExpressionsRetargetingModule::updateModule()
 {
     std::lock_guard<std::mutex> lock(m_mutex);
 
-    if (m_audioPort.getPendingReads())
+    const yarp::sig::Sound* inputSound = m_audioMailbox.read();
+
+    if (inputSound != nullptr)
     {
-        yarp::sig::Sound* inputSound = m_audioPort.read(false);
 
         if (inputSound->getFrequency() < VAD_FREQUENCY)
         {
@@ -7,6 +7,7 @@
  */
 
 #include <FaceExpressionsRetargeting.hpp>
+#include <PeriodicExecutor.hpp>
 #include <yarp/os/Network.h>
 #include <yarp/os/LogStream.h>
 
@@ -29,5 +30,5 @@ int main(int argc, char* argv[])
 
     FaceExpressionsRetargetingModule speechmodule;
 
-    return speechmodule.runModule(rf);
+    return YarpHelper::runModule(speechmodule, rf);
 }
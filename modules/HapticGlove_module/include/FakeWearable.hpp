@@ -0,0 +1,141 @@
+/**
+ * @file FakeWearable.hpp
+ * @authors  Kourosh Darvish <kourosh.darvish@iit.it>
+ * @copyright 2021 Artificial and Mechanical Intelligence - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2021
+ */
+
+#ifndef FAKE_WEARABLE_HPP
+#define FAKE_WEARABLE_HPP
+
+// std
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// wearable
+#include <Wearable/IWear/IWear.h>
+
+// YARP
+#include <yarp/dev/DeviceDriver.h>
+
+// utils
+#include <FakeDevices.hpp>
+
+namespace HapticGlove
+{
+class FakeWearable;
+} // namespace HapticGlove
+
+/**
+ * FakeWearable is an in-process IWear device that replaces the iwear_remapper of the glove.
+ * The sensors are created when they are requested, so any virtual link or virtual joint
+ * kinematic sensor exists. The joint positions are sinusoids, the link orientations are given
+ * by three sinusoidal ZYX Euler angles and the link positions by three sinusoids (see
+ * FakeSignal). The velocities and the accelerations are zero.
+ *
+ * The following parameters are read when the device is opened:
+ * - wearable_name: name of the wearable (default HapticGlove);
+ * - wearable_joint_offset, wearable_joint_amplitude, ...: parameters of the joint positions in
+ *   radians (default offset 0.5 and amplitude 0.5);
+ * - wearable_rotation_offset, wearable_rotation_amplitude, ...: parameters of the Euler angles
+ *   of the links in radians (default offset 0.0 and amplitude 0.3);
+ * - wearable_position_offset, wearable_position_amplitude, ...: parameters of the positions of
+ *   the links in meters (default offset 0.0 and amplitude 0.05);
+ * - seed: seed of the random number generator (default 0).
+ */
+class HapticGlove::FakeWearable : public yarp::dev::DeviceDriver, public wearable::IWear
+{
+    /**
+     * Synthetic signals shared by the sensors.
+     */
+    struct Signals
+    {
+        double startTime{0.0}; /**< Time at which the device has been opened. */
+        FakeSignal joint; /**< Signal of the joint positions. */
+        FakeSignal rotation; /**< Signal of the link Euler angles. */
+        FakeSignal position; /**< Signal of the link positions. */
+        std::mutex mutex; /**< Mutex protecting the signals. */
+    };
+
+    class LinkSensor;
+    class JointSensor;
+
+    std::string m_name; /**< Name of the wearable. */
+    std::shared_ptr<Signals> m_signals; /**< Synthetic signals. */
+
+    mutable std::mutex m_mutex; /**< Mutex protecting the sensors. */
+    mutable std::unordered_map<std::string, std::shared_ptr<LinkSensor>>
+        m_linkSensors; /**< Virtual link kinematic sensors. */
+    mutable std::unordered_map<std::string, std::shared_ptr<JointSensor>>
+        m_jointSensors; /**< Virtual joint kinematic sensors. */
+
+public:
+    FakeWearable();
+    ~FakeWearable() override;
+
+    // DeviceDriver
+    bool open(yarp::os::Searchable& config) override;
+    bool close() override;
+
+    // IWear
+    wearable::WearableName getWearableName() const override;
+    wearable::WearStatus getStatus() const override;
+    wearable::TimeStamp getTimeStamp() const override;
+
+    std::shared_ptr<const wearable::sensor::ISensor>
+    getSensor(const wearable::sensor::SensorName name) const override;
+    std::vector<std::shared_ptr<const wearable::sensor::ISensor>>
+    getSensors(const wearable::sensor::SensorType type) const override;
+
+    std::shared_ptr<const wearable::actuator::IActuator>
+    getActuator(const wearable::actuator::ActuatorName name) const override;
+    std::vector<std::shared_ptr<const wearable::actuator::IActuator>>
+    getActuators(const wearable::actuator::ActuatorType type) const override;
+
+    std::shared_ptr<const wearable::sensor::IVirtualLinkKinSensor>
+    getVirtualLinkKinSensor(const wearable::sensor::SensorName name) const override;
+    std::shared_ptr<const wearable::sensor::IVirtualJointKinSensor>
+    getVirtualJointKinSensor(const wearable::sensor::SensorName name) const override;
+
+    // the glove does not have the other sensors and actuators
+    std::shared_ptr<const wearable::sensor::IAccelerometer>
+    getAccelerometer(const wearable::sensor::SensorName name) const override;
+    std::shared_ptr<const wearable::sensor::IEmgSensor>
+    getEmgSensor(const wearable::sensor::SensorName name) const override;
+    std::shared_ptr<const wearable::sensor::IForce3DSensor>
+    getForce3DSensor(const wearable::sensor::SensorName name) const override;
+    std::shared_ptr<const wearable::sensor::IForceTorque6DSensor>
+    getForceTorque6DSensor(const wearable::sensor::SensorName name) const override;
+    std::shared_ptr<const wearable::sensor::IFreeBodyAccelerationSensor>
+    getFreeBodyAccelerationSensor(const wearable::sensor::SensorName name) const override;
+    std::shared_ptr<const wearable::sensor::IGyroscope>
+    getGyroscope(const wearable::sensor::SensorName name) const override;
+    std::shared_ptr<const wearable::sensor::IMagnetometer>
+    getMagnetometer(const wearable::sensor::SensorName name) const override;
+    std::shared_ptr<const wearable::sensor::IOrientationSensor>
+    getOrientationSensor(const wearable::sensor::SensorName name) const override;
+    std::shared_ptr<const wearable::sensor::IPoseSensor>
+    getPoseSensor(const wearable::sensor::SensorName name) const override;
+    std::shared_ptr<const wearable::sensor::IPositionSensor>
+    getPositionSensor(const wearable::sensor::SensorName name) const override;
+    std::shared_ptr<const wearable::sensor::ISkinSensor>
+    getSkinSensor(const wearable::sensor::SensorName name) const override;
+    std::shared_ptr<const wearable::sensor::ITemperatureSensor>
+    getTemperatureSensor(const wearable::sensor::SensorName name) const override;
+    std::shared_ptr<const wearable::sensor::ITorque3DSensor>
+    getTorque3DSensor(const wearable::sensor::SensorName name) const override;
+    std::shared_ptr<const wearable::sensor::IVirtualSphericalJointKinSensor>
+    getVirtualSphericalJointKinSensor(const wearable::sensor::SensorName name) const override;
+    std::shared_ptr<const wearable::actuator::IHaptic>
+    getHapticActuator(const wearable::actuator::ActuatorName name) const override;
+    std::shared_ptr<const wearable::actuator::IMotor>
+    getMotorActuator(const wearable::actuator::ActuatorName name) const override;
+    std::shared_ptr<const wearable::actuator::IHeater>
+    getHeaterActuator(const wearable::actuator::ActuatorName name) const override;
+};
+
+#endif
@@ -0,0 +1,175 @@
+/**
+ * @file FixedSizeKalmanFilter.hpp
+ * @authors  Kourosh Darvish <kourosh.darvish@iit.it>
+ * @copyright 2020 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2020
+ */
+
+/*
+ * Implementation based on Book:
+ * Applied Optimal Control: Optimization, Estimation, and Control
+ * ByArthur E. Bryson, Yu-Chi Ho
+ * Chapter 12|42 pages: Optimal filtering and prediction
+ */
+
+#ifndef FIXED_SIZE_KALMAN_FILTER_HPP
+#define FIXED_SIZE_KALMAN_FILTER_HPP
+
+// std
+#include <cstddef>
+
+// Eigen
+#include <Eigen/Dense>
+
+namespace HapticGlove
+{
+template <int N, int P, int M> class FixedSizeKalmanFilter;
+} // namespace HapticGlove
+
+/**
+ * FixedSizeKalmanFilter is a Kalman filter implementation with the sizes known at compile time.
+ * All the matrices are fixed-size Eigen objects, so an estimation step does not allocate memory.
+ * The gain is computed in the innovation form, i.e.
+ * K = M H^T (H M H^T + R)^(-1) and P = M - K H M,
+ * which is equivalent to P = (M^(-1) + H^T R^(-1) H)^(-1) and K = P H^T R^(-1) but requires only
+ * the inversion of a P*P matrix (a division when P == 1).
+ * Since the model is time-invariant the covariances converge to the solution of the discrete
+ * Riccati equation. When a convergence tolerance is set, the gain is frozen as soon as the change
+ * of P is below the tolerance, and the following steps only update the state.
+ * @tparam N size of the state vector (x);
+ * @tparam P size of the measurement vector (z);
+ * @tparam M size of the w vector.
+ */
+template <int N, int P, int M> class HapticGlove::FixedSizeKalmanFilter
+{
+public:
+    typedef Eigen::Matrix<double, N, 1> StateVector;
+    typedef Eigen::Matrix<double, N, N> StateMatrix;
+    typedef Eigen::Matrix<double, P, 1> MeasurementVector;
+    typedef Eigen::Matrix<double, P, P> MeasurementMatrix;
+    typedef Eigen::Matrix<double, P, N> OutputMatrix;
+    typedef Eigen::Matrix<double, N, M> InputMatrix;
+    typedef Eigen::Matrix<double, M, M> InputCovarianceMatrix;
+    typedef Eigen::Matrix<double, N, P> GainMatrix;
+
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+private:
+    StateMatrix m_Phi; /// <summary>  LTI Discrete system dynamics Matrix x(i+1)= Phi X(i)+ Gamma
+                       /// w(i)
+    InputMatrix m_Gamma; /// <summary>  LTI Discrete system input Matrix
+    OutputMatrix m_H; /// <summary>  Measurement Matrix Z(t)= Hx(t)+ v(t)
+    MeasurementMatrix m_R; /// <summary>  E[ v(t) v(t)^T ]
+    StateMatrix m_Gamma_Q_GammaT; /// <summary>  Gamma Q Gamma^T
+
+    StateMatrix m_M; /// <summary>  E[ (x(t)- x_bar(t))(x(t)- x_bar(t))^T ]
+    StateMatrix m_P; /// <summary>  covariance of the estimated state
+    GainMatrix m_K; /// <summary>  Kalman gain
+
+    StateVector m_x_bar; /// <summary>  state estimation before using the measurements
+    StateVector m_x_hat; /// <summary>  E[x(t)]
+
+    double m_convergenceTolerance; /// <summary>  tolerance on ||P(i) - P(i-1)|| / ||P(i)||
+    bool m_isGainConverged; /// <summary>  the covariances converged and the gain is frozen
+
+public:
+    /**
+     * constructor.
+     * @param dt sampling time
+     * @param F LTI Continuous system dynamics Matrix Dx(t)= Fx(t)+ Gw(t)
+     * @param G LTI Continuous system input Matrix Dx(t)= Fx(t)+ Gw(t)
+     * @param H Measurement Matrix
+     * @param R E[ v(t) v(t)^T ],
+     * @param Q E[ (w(t) -w_bar(t)) (w(t) -w_bar(t))^T ]
+     */
+    FixedSizeKalmanFilter(const double dt,
+                          const StateMatrix& F,
+                          const InputMatrix& G,
+                          const OutputMatrix& H,
+                          const MeasurementMatrix& R,
+                          const InputCovarianceMatrix& Q);
+
+    /**
+     * intialize the Kalman filter
+     * @param  x0 initial state estimation before using the measurements
+     * @param  M0 initial covariance matrix related to < E[ (x(t)- x_bar(t))(x(t)- x_bar(t))^T ]
+     */
+    bool initialize(const StateVector& x0, const StateMatrix& M0);
+
+    /**
+     * update the gain and the covariances with the prior covariance, without updating the state.
+     * The covariances do not depend on the measurements, hence a filter can compute the gain of
+     * several filters with the same model (see Estimators).
+     * Nothing is done if the gain converged.
+     */
+    void updateGain();
+
+    /**
+     * set the tolerance used to detect the convergence of the covariances.
+     * @param tolerance tolerance on the relative change of P, i.e. ||P(i) - P(i-1)|| / ||P(i)||,
+     * if it is not positive the gain is never frozen
+     */
+    void setConvergenceTolerance(const double tolerance);
+
+    /**
+     * solve the discrete Riccati equation by iterating updateGain() until the covariances
+     * converge, starting from the current prior covariance.
+     * @param maxIterations maximum number of iterations
+     * @return true if the covariances converged and false otherwise
+     */
+    bool computeSteadyStateGain(const std::size_t maxIterations);
+
+    /**
+     * check if the covariances converged, i.e. the gain is frozen
+     */
+    bool isGainConverged() const;
+
+    /**
+     * set the measurement vector and perform an estimation step. The gain is updated until the
+     * covariances converge.
+     * @param z new measurement vector
+     */
+    bool estimateNextState(const MeasurementVector& z);
+
+    /**
+     * set the measurement vector and perform an estimation step assuming stochastic steady state
+     * system, i.e. the gain is not updated.
+     * @param z new measurement vector
+     */
+    bool estimateNextSteadyState(const MeasurementVector& z);
+
+    /**
+     * get the expected state
+     * @return the expected state
+     */
+    const StateVector& expectedState() const;
+
+    /**
+     * get the covariance of the estimated state
+     * @return the covariance
+     */
+    const StateMatrix& covariance() const;
+
+    /**
+     * get the kalman gain
+     * @return the gain
+     */
+    const GainMatrix& gain() const;
+
+    /**
+     * get the LTI discrete system dynamics matrix
+     * @return the matrix Phi
+     */
+    const StateMatrix& transitionMatrix() const;
+
+    /**
+     * get the measurement matrix
+     * @return the matrix H
+     */
+    const OutputMatrix& outputMatrix() const;
+};
+
+#include "FixedSizeKalmanFilter.tpp"
+
+#endif // FIXED_SIZE_KALMAN_FILTER_HPP
@@ -0,0 +1,179 @@
+/**
+ * @file FixedSizeKalmanFilter.tpp
+ * @authors  Kourosh Darvish <kourosh.darvish@iit.it>
+ * @copyright 2020 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2020
+ */
+
+namespace HapticGlove
+{
+namespace KalmanFilterDetail
+{
+/**
+ * Inverse of the innovation covariance. Eigen uses the closed-form inverse for the fixed-size
+ * matrices up to 4x4.
+ */
+template <int P> struct InnovationInverse
+{
+    static Eigen::Matrix<double, P, P> compute(const Eigen::Matrix<double, P, P>& S)
+    {
+        return S.inverse();
+    }
+};
+
+/**
+ * With a single measurement the inversion is a division.
+ */
+template <> struct InnovationInverse<1>
+{
+    static Eigen::Matrix<double, 1, 1> compute(const Eigen::Matrix<double, 1, 1>& S)
+    {
+        return Eigen::Matrix<double, 1, 1>(1.0 / S(0, 0));
+    }
+};
+} // namespace KalmanFilterDetail
+} // namespace HapticGlove
+
+template <int N, int P, int M>
+HapticGlove::FixedSizeKalmanFilter<N, P, M>::FixedSizeKalmanFilter(const double dt,
+                                                                  const StateMatrix& F,
+                                                                  const InputMatrix& G,
+                                                                  const OutputMatrix& H,
+                                                                  const MeasurementMatrix& R,
+                                                                  const InputCovarianceMatrix& Q)
+    : m_H(H)
+    , m_R(R)
+    , m_convergenceTolerance(0.0)
+    , m_isGainConverged(false)
+{
+    m_Phi = StateMatrix::Identity() + F * dt;
+    m_Gamma = G * dt;
+    m_Gamma_Q_GammaT.noalias() = m_Gamma * Q * m_Gamma.transpose();
+
+    m_M.setIdentity();
+    m_P.setZero();
+    m_K.setZero();
+    m_x_bar.setZero();
+    m_x_hat.setZero();
+}
+
+template <int N, int P, int M> void HapticGlove::FixedSizeKalmanFilter<N, P, M>::updateGain()
+{
+    if (m_isGainConverged)
+        return;
+
+    const StateMatrix previousP = m_P;
+
+    const GainMatrix M_Ht = m_M * m_H.transpose();
+    const MeasurementMatrix S = m_H * M_Ht + m_R;
+
+    m_K.noalias() = M_Ht * KalmanFilterDetail::InnovationInverse<P>::compute(S);
+    m_P = m_M;
+    m_P.noalias() -= m_K * M_Ht.transpose();
+    m_M = m_Gamma_Q_GammaT;
+    m_M.noalias() += m_Phi * m_P * m_Phi.transpose();
+
+    m_isGainConverged = m_convergenceTolerance > 0
+                        && (m_P - previousP).norm() <= m_convergenceTolerance * m_P.norm();
+}
+
+template <int N, int P, int M>
+void HapticGlove::FixedSizeKalmanFilter<N, P, M>::setConvergenceTolerance(const double tolerance)
+{
+    m_convergenceTolerance = tolerance;
+    if (m_convergenceTolerance <= 0)
+        m_isGainConverged = false;
+}
+
+template <int N, int P, int M>
+bool HapticGlove::FixedSizeKalmanFilter<N, P, M>::computeSteadyStateGain(
+    const std::size_t maxIterations)
+{
+    for (std::size_t i = 0; i < maxIterations && !m_isGainConverged; i++)
+        updateGain();
+
+    return m_isGainConverged;
+}
+
+template <int N, int P, int M>
+bool HapticGlove::FixedSizeKalmanFilter<N, P, M>::isGainConverged() const
+{
+    return m_isGainConverged;
+}
+
+template <int N, int P, int M>
+bool HapticGlove::FixedSizeKalmanFilter<N, P, M>::initialize(const StateVector& x0,
+                                                             const StateMatrix& M0)
+{
+    m_x_bar = x0;
+    m_M = M0;
+
+    m_isGainConverged = false;
+    updateGain();
+
+    return true;
+}
+
+template <int N, int P, int M>
+bool HapticGlove::FixedSizeKalmanFilter<N, P, M>::estimateNextState(const MeasurementVector& z)
+{
+    /*
+     * J= 1/2 [(x-x_bar) M^(-1)(x-x_bar) + (z-Hx) R^(-1)(z-Hx)]
+     */
+
+    updateGain();
+
+    // the mean of w is zero
+    m_x_hat = m_x_bar;
+    m_x_hat.noalias() += m_K * (z - m_H * m_x_bar);
+    m_x_bar.noalias() = m_Phi * m_x_hat;
+
+    return true;
+}
+
+template <int N, int P, int M>
+bool HapticGlove::FixedSizeKalmanFilter<N, P, M>::estimateNextSteadyState(
+    const MeasurementVector& z)
+{
+    m_x_hat = m_x_bar;
+    m_x_hat.noalias() += m_K * (z - m_H * m_x_bar);
+    m_x_bar.noalias() = m_Phi * m_x_hat;
+
+    return true;
+}
+
+template <int N, int P, int M>
+const typename HapticGlove::FixedSizeKalmanFilter<N, P, M>::StateVector&
+HapticGlove::FixedSizeKalmanFilter<N, P, M>::expectedState() const
+{
+    return m_x_hat;
+}
+
+template <int N, int P, int M>
+const typename HapticGlove::FixedSizeKalmanFilter<N, P, M>::StateMatrix&
+HapticGlove::FixedSizeKalmanFilter<N, P, M>::covariance() const
+{
+    return m_P;
+}
+
+template <int N, int P, int M>
+const typename HapticGlove::FixedSizeKalmanFilter<N, P, M>::GainMatrix&
+HapticGlove::FixedSizeKalmanFilter<N, P, M>::gain() const
+{
+    return m_K;
+}
+
+template <int N, int P, int M>
+const typename HapticGlove::FixedSizeKalmanFilter<N, P, M>::StateMatrix&
+HapticGlove::FixedSizeKalmanFilter<N, P, M>::transitionMatrix() const
+{
+    return m_Phi;
+}
+
+template <int N, int P, int M>
+const typename HapticGlove::FixedSizeKalmanFilter<N, P, M>::OutputMatrix&
+HapticGlove::FixedSizeKalmanFilter<N, P, M>::outputMatrix() const
+{
+    return m_H;
+}
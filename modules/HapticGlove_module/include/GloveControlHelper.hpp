@@ -76,10 +76,13 @@ public:
      * @param config configuration options
      * @param name name of the robot
      * @param rightHand if true the right hand is used
+     * @param inputSession session used to record or replay the glove readouts
      * @return true/false in case of success/failure
      */
-    bool
-    configure(const yarp::os::Searchable& config, const std::string& name, const bool& rightHand);
+    bool configure(const yarp::os::Searchable& config,
+                   const std::string& name,
+                   const bool& rightHand,
+                   InputSession& inputSession);
 
     /**
      * Get the measured fingertip poses of all the fingers
@@ -20,6 +20,9 @@
 #include <yarp/os/BufferedPort.h>
 #include <yarp/os/Searchable.h>
 
+// utils
+#include <InputSession.hpp>
+
 template <typename E> constexpr typename std::underlying_type<E>::type to_underlying(E e) noexcept
 {
     return static_cast<typename std::underlying_type<E>::type>(e);
@@ -113,6 +116,11 @@ private:
 
     wearable::SensorPtr<const wearable::actuator::IHaptic> m_palmVibrotactileActuator;
 
+    InputSession* m_inputSession{nullptr}; /**< Record or replay of the glove readouts. */
+    InputSession::Stream m_jointsStream; /**< Human hand joint angles. */
+    InputSession::Stream m_palmRotationStream; /**< Human hand palm quaternion. */
+    InputSession::Stream m_fingertipPosesStream; /**< Human hand fingertip poses. */
+
 public:
     /**
      * ConstructorbrotactileValues(const std::vector<int>& values);
@@ -138,10 +146,13 @@ public:
      * @param config configuration options
      * @param name name of the robot
      * @param rightHand if true the right hand is used
+     * @param inputSession session used to record or replay the glove readouts
      * @return true/false in case of success/failure
      */
-    bool
-    configure(const yarp::os::Searchable& config, const std::string& name, const bool& rightHand);
+    bool configure(const yarp::os::Searchable& config,
+                   const std::string& name,
+                   const bool& rightHand,
+                   InputSession& inputSession);
 
     /**
      * initialize the Wearable data vectors associated with the sensors
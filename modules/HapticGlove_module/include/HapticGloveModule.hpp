@@ -16,6 +16,7 @@
 #include <yarp/os/RFModule.h>
 
 // teleoperation
+#include <TaskPool.hpp>
 #include <Teleoperation.hpp>
 
 /**
@@ -47,9 +48,30 @@ private:
     bool m_useLeftHand;
     bool m_useRightHand; /**< use the specided hand if the flag is ON (default value is ON)*/
 
+    StageProfiler m_profiler; /**< profiler of the stages of the module. */
+    std::size_t m_updateModuleStage; /**< index of the profiler stage of the update module. */
+    std::size_t m_handsRunStage; /**< index of the profiler stage of the run of both hands. */
+
+    InputSession m_inputSession; /**< record or replay of the inputs of the module. */
+    InputSession::Stream m_timeStream; /**< time used by the state machine. */
+
     std::unique_ptr<HapticGlove::Teleoperation> m_leftHand;
     std::unique_ptr<HapticGlove::Teleoperation> m_rightHand;
 
+    TaskPool m_handsPool; /**< tasks running the teleoperation of the hands. */
+
+    /**
+     * Configure the tasks running the teleoperation of the hands. The following parameters are
+     * read from the configuration object:
+     * - enableParallelHands: if true each hand runs on its own worker thread (optional, default
+     *   false, i.e. the hands run in sequence in the module thread);
+     * - leftHandCpu, rightHandCpu: CPU the worker thread of the hand is pinned to (optional,
+     *   default -1, i.e. no affinity).
+     * @param config configuration object
+     * @return true in case of success and false otherwise.
+     */
+    bool configureHandsPool(const yarp::os::Searchable& config);
+
 public:
     /**
      * Constructor
@@ -15,11 +15,8 @@
 // teleoperation
 #include <Teleoperation.hpp>
 
-// matlogger
-#ifdef ENABLE_LOGGER
-#include <matlogger2/matlogger2.h>
-#include <matlogger2/utils/mat_appender.h>
-#endif
+// utils
+#include <SessionRecorder.hpp>
 
 /**
  * Logger Class useful for logging all the relevant information for the haptic glove teleoperation
@@ -53,10 +50,56 @@ class HapticGlove::Teleoperation::Logger
 
     Data m_data; /// <summary> the data structure
 
-#ifdef ENABLE_LOGGER
-    XBot::MatLogger2::Ptr m_logger; /**< the pointer to the logger */
-    XBot::MatAppender::Ptr m_appender;
-#endif
+    SessionRecorder m_recorder; /// <summary> the binary recorder of the session
+
+    /**
+     * Handles of the recorder channels, resolved when the logger is opened.
+     */
+    struct Channels
+    {
+        SessionRecorder::Channel time;
+
+        SessionRecorder::Channel robotAxisReferences;
+        SessionRecorder::Channel robotAxisFeedbacks;
+        SessionRecorder::Channel robotAxisVelocityFeedbacks;
+        SessionRecorder::Channel robotJointReferences;
+        SessionRecorder::Channel robotJointFeedbacks;
+        SessionRecorder::Channel robotAxisValueErrors;
+        SessionRecorder::Channel robotAxisVelocityErrors;
+        SessionRecorder::Channel robotMotorCurrentReferences;
+        SessionRecorder::Channel robotMotorCurrentFeedbacks;
+        SessionRecorder::Channel robotMotorPwmReferences;
+        SessionRecorder::Channel robotMotorPwmFeedbacks;
+        SessionRecorder::Channel robotMotorPidOutputs;
+
+        SessionRecorder::Channel robotAxisValueReferencesKf;
+        SessionRecorder::Channel robotAxisVelocityReferencesKf;
+        SessionRecorder::Channel robotAxisAccelerationReferencesKf;
+        SessionRecorder::Channel robotAxisCovReferencesKf;
+        SessionRecorder::Channel robotAxisValueFeedbacksKf;
+        SessionRecorder::Channel robotAxisVelocityFeedbacksKf;
+        SessionRecorder::Channel robotAxisAccelerationFeedbacksKf;
+        SessionRecorder::Channel robotAxisCovFeedbacksKf;
+        SessionRecorder::Channel robotJointsExpectedKf;
+        SessionRecorder::Channel robotJointsFeedbackKf;
+
+        SessionRecorder::Channel humanJointValues;
+        SessionRecorder::Channel humanFingertipPoses;
+        SessionRecorder::Channel humanForceFeedbacks;
+        SessionRecorder::Channel humanVibrotactileFeedbacks;
+        SessionRecorder::Channel humanPalmRotation;
+
+        SessionRecorder::Channel skinData;
+        SessionRecorder::Channel calibratedSkinData;
+        SessionRecorder::Channel calibratedSkinDataDerivative;
+        SessionRecorder::Channel fingercontactStrength;
+        SessionRecorder::Channel fingercontactStrengthDerivative;
+        SessionRecorder::Channel skinAbsoluteValueVibrotactileFeedback;
+        SessionRecorder::Channel skinDerivativeValueVibrotactileFeedback;
+        SessionRecorder::Channel skinTotalValueVibrotactileFeedback;
+        SessionRecorder::Channel skinIsInContact;
+    };
+    Channels m_channels; /// <summary> the handles of the recorder channels
 
     /**
      * update the data structure of the logger
@@ -83,6 +126,7 @@ public:
 
     /**
      * log the data
+     * @return false if the log file can no longer be written
      * */
     bool logData();
 
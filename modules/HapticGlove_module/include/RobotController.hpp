@@ -106,10 +106,14 @@ public:
      * Configure the object.
      * @param config reference to a resource finder object.
      * @param name name of the robot
+     * @param rightHand if true the right hand is used
+     * @param inputSession session used to record or replay the robot feedbacks
      * @return true in case of success and false otherwise.
      */
-    bool
-    configure(const yarp::os::Searchable& config, const std::string& name, const bool& rightHand);
+    bool configure(const yarp::os::Searchable& config,
+                   const std::string& name,
+                   const bool& rightHand,
+                   InputSession& inputSession);
 
     /**
      * Set the fingers axis reference value
@@ -248,37 +252,15 @@ public:
     bool estimateNextStates();
 
     /**
-     * get motor estimated states
+     * get motor estimated states, they are copied from the views of the estimators
      * @return true if the robot motor estimator is returned correctly
      */
     bool getEstimatedMotorsState(std::vector<double>& feedbackAxisValuesEstimationKF,
                                  std::vector<double>& feedbackAxisVelocitiesEstimationKF,
                                  std::vector<double>& feedbackAxisAccelrationEstimationKF,
-                                 Eigen::MatrixXd& feedbackAxisCovEstimationKF,
                                  std::vector<double>& referenceAxisValuesEstimationKF,
                                  std::vector<double>& referenceAxisVelocitiesEstimationKF,
-                                 std::vector<double>& referenceAxisAccelrationEstimationKF,
-                                 Eigen::MatrixXd& referenceAxisCovEstimationKF);
-
-    /**
-     * get joints estimated states
-     * @return true if the robot joints estimator is returned correctly
-     */
-    bool getEstimatedJointValuesKf(std::vector<double>& feedbackJointValuesEstimationKF,
-                                   std::vector<double>& feedbackJointVelocitiesEstimationKF,
-                                   std::vector<double>& feedbackJointAccelrationEstimationKF,
-                                   Eigen::MatrixXd& feedbackJointCovEstimationKF,
-                                   std::vector<double>& expectedJointValuesEstimationKF,
-                                   std::vector<double>& expectedJointVelocitiesEstimationKF,
-                                   std::vector<double>& expectedJointAccelrationEstimationKF,
-                                   Eigen::MatrixXd& expectedJointCovEstimationKF);
-
-    /**
-     * get joints estimated states
-     * @return true if the robot joints estimator is returned correctly
-     */
-    bool getEstimatedJointValuesKf(std::vector<double>& feedbackJointValuesEstimationKF,
-                                   std::vector<double>& expectedJointValuesEstimationKF);
+                                 std::vector<double>& referenceAxisAccelrationEstimationKF);
 
     /**
      * Move the robot part
@@ -297,6 +279,30 @@ public:
      * @return control helper interface
      */
     std::unique_ptr<RobotInterface>& controlHelper();
+
+    /**
+     * Expose the estimators of the axis feedbacks (const)
+     * @return the estimators
+     */
+    const Estimators& axisFeedbackEstimators() const;
+
+    /**
+     * Expose the estimators of the axis references (const)
+     * @return the estimators
+     */
+    const Estimators& axisReferenceEstimators() const;
+
+    /**
+     * Expose the estimators of the joint feedbacks (const)
+     * @return the estimators
+     */
+    const Estimators& jointFeedbackEstimators() const;
+
+    /**
+     * Expose the estimators of the expected joint values (const)
+     * @return the estimators
+     */
+    const Estimators& jointExpectedEstimators() const;
 };
 
 #endif // ROBOT_CONTROLLER_HPP
@@ -33,6 +33,9 @@
 #include <yarp/os/Bottle.h>
 #include <yarp/sig/Vector.h>
 
+// utils
+#include <InputSession.hpp>
+
 namespace HapticGlove
 {
 class RobotInterface;
@@ -169,6 +172,23 @@ class HapticGlove::RobotInterface
 
     size_t m_steadyStateCounterThreshold;
 
+    InputSession* m_inputSession{nullptr}; /**< Record or replay of the inputs. */
+    InputSession::Stream m_encodersStream; /**< Axis positions [deg]. */
+    InputSession::Stream m_encoderSpeedsStream; /**< Axis velocities [deg/sec]. */
+    InputSession::Stream m_analogSensorStream; /**< Analog sensor feedback [raw]. */
+    InputSession::Stream m_currentsStream; /**< Motor currents. */
+    InputSession::Stream m_pwmStream; /**< Motor PWM. */
+    InputSession::Stream m_pidOutputsStream; /**< Low level pid outputs. */
+    InputSession::Stream m_limitsStream; /**< Axis limits [deg]. */
+    InputSession::Stream m_velocityLimitsStream; /**< Axis velocity limits [deg/sec]. */
+
+    /**
+     * Check if the inputs are replayed, in this case the devices are not opened and the
+     * references are not sent to the robot.
+     * @return true if the inputs are replayed
+     */
+    bool isReplaying() const;
+
     /**
      * Switch to control mode
      * @param controlMode is the specific control mode
@@ -276,12 +296,14 @@ public:
      * @param rightHand if the right hand of the robot is used
      * @param isMandatory if true the robot interface will return an error if there is a
      * problem in the configuration phase
+     * @param inputSession session used to record or replay the robot feedbacks
      * @return true / false in case of success / failure
      */
     bool configure(const yarp::os::Searchable& config,
                    const std::string& name,
                    const bool& rightHand,
-                   const bool& isMandatory);
+                   const bool& isMandatory,
+                   InputSession& inputSession);
 
     /**
      * Open robot devices
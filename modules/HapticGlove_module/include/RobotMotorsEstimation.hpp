@@ -17,7 +17,7 @@
 
 // teleoperation
 #include <ControlHelper.hpp>
-#include <MotorEstimation.hpp>
+#include <FixedSizeKalmanFilter.hpp>
 
 namespace HapticGlove
 {
@@ -26,25 +26,54 @@ class Estimators;
 
 /**
  * Estimators is a class for estimating the states of all the actuated axes/joints.
+ * All the axes/joints have the same model and they are initialized together, so the covariances
+ * and the gain of their kalman filters are the same. They are computed once per step by a single
+ * filter. The states are stored as structure of arrays (a column per state
+ * containing all the axes/joints), so a step updates all the axes/joints with a few vectorized
+ * operations on contiguous memory.
+ * The model is time-invariant, so the covariances converge to a steady state. Once the change of
+ * the covariance is below kf_convergence_tolerance the gain is frozen and estimateNextState() only
+ * updates the states, as estimateNextSteadyState(). The noise covariances are read by configure()
+ * only, so the gain never has to be updated again. If kf_precompute_steady_state_gain is true, the
+ * steady-state gain is computed by configure() solving the discrete Riccati equation, so the gain
+ * is frozen from the first step.
  */
 class HapticGlove::Estimators
 {
+public:
+    /// <summary> kalman filter of the model (3 states, 1 measurement, 3 inputs)
+    typedef FixedSizeKalmanFilter<3, 1, 3> MotorKalmanFilter;
 
-    std::string m_logPrefix;
+    /// <summary> read-only view of a state of all the axes/joints
+    typedef Eigen::Map<const Eigen::VectorXd> ConstVectorView;
+
+private:
+    static constexpr int numberOfStates = 3; /// <summary> number of states
+
+    /// <summary> states of all the axes/joints, column i contains the state i
+    typedef Eigen::Matrix<double, Eigen::Dynamic, numberOfStates> StatesMatrix;
 
-    std::vector<Estimator> m_motorEstimatorVector; /// <summary> vector of motor/joint estimators
+    std::string m_logPrefix;
 
     size_t m_numOfMotors; /// <summary> number of motor/joint
 
-    size_t m_n; /// <summary> number of states
+    std::unique_ptr<MotorKalmanFilter> m_kf; /// <summary> filter computing the shared covariances
+                                             /// and gain
 
-    CtrlHelper::Eigen_Mat m_z; /// <summary> vector of motor/joint measurements
+    StatesMatrix m_x_bar; /// <summary> states estimation before using the measurements
 
-    bool m_isInitialized; /// <summary> estimators are initialized
+    StatesMatrix m_x_hat; /// <summary> expected states
 
-    Eigen::VectorXd m_x_hat; /// <summary> vector of motor/joint expected values
+    Eigen::VectorXd m_innovation; /// <summary> measurements minus expected measurements
+
+    bool m_isInitialized; /// <summary> estimators are initialized
 
-    Eigen::VectorXd m_P; /// <summary>  vectorized version of the motor/joint estimation covariances
+    /**
+     * correct the states with the measurements and predict the next states with the current gain
+     * @param z measurements
+     * @return true in case of success and false otherwise
+     */
+    bool updateStates(const std::vector<double>& z);
 
 public:
     /**
@@ -84,34 +113,33 @@ public:
     bool estimateNextSteadyState(const std::vector<double>& z);
 
     /**
-     * get the estimation results
-     * @param estimatedValue expected angle value
-     * @param estimatedVelocity expected velocity
-     * @param estimatedAcceleration expected acceleration
-     * @param P covariance of the estimated state
+     * check if the covariances converged and the gain is frozen
+     */
+    bool isGainConverged() const;
+
+    /**
+     * get the expected values of all the axes/joints without copying them
+     * @return the view of the expected values (valid until the next step)
+     */
+    ConstVectorView estimatedValues() const;
+
+    /**
+     * get the expected velocities of all the axes/joints without copying them
+     * @return the view of the expected velocities (valid until the next step)
      */
-    bool getInfo(Eigen::VectorXd& estimatedValue,
-                 Eigen::VectorXd& estimatedVelocity,
-                 Eigen::VectorXd& estimatedAcceleration,
-                 Eigen::MatrixXd& P);
+    ConstVectorView estimatedVelocities() const;
 
     /**
-     * get the estimation results
-     * @param estimatedValue expected angle value
-     * @param estimatedVelocity expected velocity
-     * @param estimatedAcceleration expected acceleration
-     * @param P covariance of the estimated state
+     * get the expected accelerations of all the axes/joints without copying them
+     * @return the view of the expected accelerations (valid until the next step)
      */
-    bool getInfo(std::vector<double>& estimatedValue,
-                 std::vector<double>& estimatedVelocity,
-                 std::vector<double>& estimatedAcceleration,
-                 Eigen::MatrixXd& P);
+    ConstVectorView estimatedAccelerations() const;
 
     /**
-     * get the estimation results of the expected axis/joint values
-     * @param estimatedValue expected axis/joint value (angle)
+     * get the covariance of the estimated state, it is the same for all the axes/joints
+     * @return the covariance
      */
-    bool getMotorValueInfo(std::vector<double>& estimatedValue);
+    const MotorKalmanFilter::StateMatrix& covariance() const;
 
     /**
      * check if the estimators are initialized
@@ -184,6 +184,9 @@ private:
     yarp::dev::IAnalogSensor* m_tactileSensorInterface{
         nullptr}; /**< skin ananlog sensor interface */
 
+    InputSession* m_inputSession{nullptr}; /**< Record or replay of the tactile sensors. */
+    InputSession::Stream m_rawTactileStream; /**< Fingertip raw tactile feedbacks. */
+
     std::vector<double>
         m_fbParams; /**< # absolute vibrotactile feedback nonlinear function parameters; reference
                      to
@@ -211,10 +214,14 @@ public:
      * Configure the object.
      * @param config reference to a resource finder object.
      * @param name name of the robot
+     * @param rightHand if true the right hand is used
+     * @param inputSession session used to record or replay the tactile sensors
      * @return true in case of success and false otherwise.
      */
-    bool
-    configure(const yarp::os::Searchable& config, const std::string& name, const bool& rightHand);
+    bool configure(const yarp::os::Searchable& config,
+                   const std::string& name,
+                   const bool& rightHand,
+                   InputSession& inputSession);
 
     void updateTactileFeedbacks();
 
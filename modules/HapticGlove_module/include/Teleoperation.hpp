@@ -25,6 +25,9 @@
 #include <RobotController.hpp>
 #include <RobotSkin.hpp>
 
+// utils
+#include <Instrumentation.hpp>
+
 // eigen
 #include <Eigen/Dense>
 
@@ -68,9 +71,6 @@ struct HapticGlove::Data
                                                        /// vector computed by KF
     std::vector<double> robotAxisAccelerationReferencesKf; /// <summary> robot axis acceleration
                                                            /// reference vector computed by KF
-    Eigen::MatrixXd
-        robotAxisCovReferencesKf; /// <summary> robot axis covariance reference vector
-                                  /// computed by KF, size: numRobotActuatedAxis x 9 (9: 3x3)
 
     std::vector<double>
         robotAxisValueFeedbacksKf; /// <summary> robot axis value feedback vector computed by KF
@@ -78,16 +78,6 @@ struct HapticGlove::Data
                                                       /// vector computed by KF
     std::vector<double> robotAxisAccelerationFeedbacksKf; /// <summary> robot axis acceleration
                                                           /// feedback vector computed by KF
-    Eigen::MatrixXd
-        robotAxisCovFeedbacksKf; /// <summary> robot axis covariance feedback vector computed by
-                                 /// KF, size: numRobotActuatedAxis x 9 (9: 3x3)
-
-    std::vector<double>
-        robotJointsExpectedKf; /// <summary> robot joint expected value computed by KF (expect
-                               /// value= axis feedback value * aixs-joint coupling value)
-
-    std::vector<double>
-        robotJointsFeedbackKf; /// <summary> robot joint feedback value computed by KF
 
     // human
     std::vector<double> humanJointValues; /// <summary> juman joint values
@@ -193,6 +183,21 @@ class HapticGlove::Teleoperation
     class Logger; /**< forward decleration of the logger class */
     std::unique_ptr<Logger> m_loggerLeftHand; /**< pointer to the logger object. */
 
+    StageProfiler* m_profiler{nullptr}; /**< pointer to the profiler of the module. */
+    std::size_t m_runStage; /**< index of the profiler stage of the whole run method. */
+    std::size_t m_retargetingStage; /**< index of the profiler stage of the motion retargeting. */
+    std::size_t m_feedbackReadStage; /**< index of the profiler stage of the feedback reading. */
+    std::size_t m_estimationStage; /**< index of the profiler stage of the KF estimation. */
+    std::size_t m_controlStage; /**< index of the profiler stage of the control computation. */
+    std::size_t m_hapticFeedbackStage; /**< index of the profiler stage of the haptic feedback
+                                          computation. */
+    std::size_t m_outputStage; /**< index of the profiler stage of the robot and glove commands. */
+    std::size_t m_feedbackFailuresCounter; /**< index of the profiler counter of the failed
+                                              feedback readings. */
+
+    InputSession* m_inputSession{nullptr}; /**< session used to record or replay the inputs. */
+    InputSession::Stream m_timeStream; /**< time used by the calibration of the robot model. */
+
     /**
      * Get all the feedback signal from the robot controller
      * @return true/false in case of success/failure
@@ -215,10 +220,15 @@ public:
      * @param config configuration options
      * @param name name of the robot
      * @param rightHand if true the right hand is used
+     * @param profiler profiler of the module, the stages of the run method are added to it
+     * @param inputSession session used to record or replay the inputs of the teleoperation
      * @return true/false in case of success/failure
      */
-    bool
-    configure(const yarp::os::Searchable& config, const std::string& name, const bool& rightHand);
+    bool configure(const yarp::os::Searchable& config,
+                   const std::string& name,
+                   const bool& rightHand,
+                   StageProfiler& profiler,
+                   InputSession& inputSession);
 
     /**
      * Close the teleoperation class.
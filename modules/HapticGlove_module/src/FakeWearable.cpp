@@ -0,0 +1,335 @@
+/**
+ * @file FakeWearable.cpp
+ * @authors  Kourosh Darvish <kourosh.darvish@iit.it>
+ * @copyright 2021 Artificial and Mechanical Intelligence - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2021
+ */
+
+// Eigen
+#include <Eigen/Geometry>
+
+// YARP
+#include <yarp/os/LogStream.h>
+#include <yarp/os/Time.h>
+
+#include <FakeWearable.hpp>
+
+using namespace HapticGlove;
+
+class FakeWearable::LinkSensor : public wearable::sensor::IVirtualLinkKinSensor
+{
+    std::shared_ptr<Signals> m_signals;
+    std::size_t m_channel;
+
+public:
+    LinkSensor(const wearable::sensor::SensorName& name,
+               const std::shared_ptr<Signals>& signals,
+               const std::size_t& channel)
+        : IVirtualLinkKinSensor(name, wearable::sensor::SensorStatus::Ok)
+        , m_signals(signals)
+        , m_channel(channel)
+    {
+    }
+
+    bool getLinkAcceleration(wearable::Vector3& linear, wearable::Vector3& angular) const override
+    {
+        linear = {0.0, 0.0, 0.0};
+        angular = {0.0, 0.0, 0.0};
+        return true;
+    }
+
+    bool getLinkPose(wearable::Vector3& position, wearable::Quaternion& orientation) const override
+    {
+        std::lock_guard<std::mutex> guard(m_signals->mutex);
+        const double time = yarp::os::Time::now() - m_signals->startTime;
+
+        const Eigen::Quaterniond quaternion
+            = Eigen::AngleAxisd(m_signals->rotation(time, m_channel), Eigen::Vector3d::UnitZ())
+              * Eigen::AngleAxisd(m_signals->rotation(time, m_channel + 1),
+                                  Eigen::Vector3d::UnitY())
+              * Eigen::AngleAxisd(m_signals->rotation(time, m_channel + 2),
+                                  Eigen::Vector3d::UnitX());
+
+        orientation = {quaternion.w(), quaternion.x(), quaternion.y(), quaternion.z()};
+        for (std::size_t i = 0; i < 3; i++)
+            position[i] = m_signals->position(time, m_channel + i);
+        return true;
+    }
+
+    bool getLinkVelocity(wearable::Vector3& linear, wearable::Vector3& angular) const override
+    {
+        linear = {0.0, 0.0, 0.0};
+        angular = {0.0, 0.0, 0.0};
+        return true;
+    }
+
+    // the following methods are not marked override since depending on the version of IWear they
+    // are either virtual or inline helpers of the interface
+    bool getLinkPosition(wearable::Vector3& position) const
+    {
+        wearable::Quaternion orientation;
+        return getLinkPose(position, orientation);
+    }
+
+    bool getLinkOrientation(wearable::Quaternion& orientation) const
+    {
+        wearable::Vector3 position;
+        return getLinkPose(position, orientation);
+    }
+};
+
+class FakeWearable::JointSensor : public wearable::sensor::IVirtualJointKinSensor
+{
+    std::shared_ptr<Signals> m_signals;
+    std::size_t m_channel;
+
+public:
+    JointSensor(const wearable::sensor::SensorName& name,
+                const std::shared_ptr<Signals>& signals,
+                const std::size_t& channel)
+        : IVirtualJointKinSensor(name, wearable::sensor::SensorStatus::Ok)
+        , m_signals(signals)
+        , m_channel(channel)
+    {
+    }
+
+    bool getJointPosition(double& position) const override
+    {
+        std::lock_guard<std::mutex> guard(m_signals->mutex);
+        position = m_signals->joint(yarp::os::Time::now() - m_signals->startTime, m_channel);
+        return true;
+    }
+
+    bool getJointVelocity(double& velocity) const override
+    {
+        velocity = 0.0;
+        return true;
+    }
+
+    bool getJointAcceleration(double& acceleration) const override
+    {
+        acceleration = 0.0;
+        return true;
+    }
+};
+
+FakeWearable::FakeWearable()
+    : m_signals(std::make_shared<Signals>())
+{
+}
+
+FakeWearable::~FakeWearable() = default;
+
+bool FakeWearable::open(yarp::os::Searchable& config)
+{
+    m_name = config.check("wearable_name", yarp::os::Value("HapticGlove")).asString();
+
+    std::lock_guard<std::mutex> guard(m_signals->mutex);
+    m_signals->joint.configure(config, "wearable_joint", 0.5, 0.5);
+    m_signals->rotation.configure(config, "wearable_rotation", 0.0, 0.3);
+    m_signals->position.configure(config, "wearable_position", 0.0, 0.05);
+    m_signals->startTime = yarp::os::Time::now();
+    return true;
+}
+
+bool FakeWearable::close()
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_linkSensors.clear();
+    m_jointSensors.clear();
+    return true;
+}
+
+wearable::WearableName FakeWearable::getWearableName() const
+{
+    return m_name;
+}
+
+wearable::WearStatus FakeWearable::getStatus() const
+{
+    return wearable::WearStatus::Ok;
+}
+
+wearable::TimeStamp FakeWearable::getTimeStamp() const
+{
+    return {};
+}
+
+std::shared_ptr<const wearable::sensor::ISensor>
+FakeWearable::getSensor(const wearable::sensor::SensorName name) const
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+
+    const auto linkSensor = m_linkSensors.find(name);
+    if (linkSensor != m_linkSensors.end())
+        return linkSensor->second;
+
+    const auto jointSensor = m_jointSensors.find(name);
+    if (jointSensor != m_jointSensors.end())
+        return jointSensor->second;
+
+    return nullptr;
+}
+
+std::vector<std::shared_ptr<const wearable::sensor::ISensor>>
+FakeWearable::getSensors(const wearable::sensor::SensorType type) const
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+
+    std::vector<std::shared_ptr<const wearable::sensor::ISensor>> sensors;
+    if (type == wearable::sensor::SensorType::VirtualLinkKinSensor)
+        for (const auto& sensor : m_linkSensors)
+            sensors.push_back(sensor.second);
+
+    if (type == wearable::sensor::SensorType::VirtualJointKinSensor)
+        for (const auto& sensor : m_jointSensors)
+            sensors.push_back(sensor.second);
+
+    return sensors;
+}
+
+std::shared_ptr<const wearable::actuator::IActuator>
+FakeWearable::getActuator(const wearable::actuator::ActuatorName name) const
+{
+    return nullptr;
+}
+
+std::vector<std::shared_ptr<const wearable::actuator::IActuator>>
+FakeWearable::getActuators(const wearable::actuator::ActuatorType type) const
+{
+    return {};
+}
+
+std::shared_ptr<const wearable::sensor::IVirtualLinkKinSensor>
+FakeWearable::getVirtualLinkKinSensor(const wearable::sensor::SensorName name) const
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+
+    // each link uses three channels of the signals
+    auto sensor = m_linkSensors.find(name);
+    if (sensor == m_linkSensors.end())
+    {
+        auto newSensor = std::make_shared<LinkSensor>(name, m_signals, 3 * m_linkSensors.size());
+        sensor = m_linkSensors.emplace(name, newSensor).first;
+    }
+
+    return sensor->second;
+}
+
+std::shared_ptr<const wearable::sensor::IVirtualJointKinSensor>
+FakeWearable::getVirtualJointKinSensor(const wearable::sensor::SensorName name) const
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+
+    auto sensor = m_jointSensors.find(name);
+    if (sensor == m_jointSensors.end())
+    {
+        auto newSensor = std::make_shared<JointSensor>(name, m_signals, m_jointSensors.size());
+        sensor = m_jointSensors.emplace(name, newSensor).first;
+    }
+
+    return sensor->second;
+}
+
+std::shared_ptr<const wearable::sensor::IAccelerometer>
+FakeWearable::getAccelerometer(const wearable::sensor::SensorName name) const
+{
+    return nullptr;
+}
+
+std::shared_ptr<const wearable::sensor::IEmgSensor>
+FakeWearable::getEmgSensor(const wearable::sensor::SensorName name) const
+{
+    return nullptr;
+}
+
+std::shared_ptr<const wearable::sensor::IForce3DSensor>
+FakeWearable::getForce3DSensor(const wearable::sensor::SensorName name) const
+{
+    return nullptr;
+}
+
+std::shared_ptr<const wearable::sensor::IForceTorque6DSensor>
+FakeWearable::getForceTorque6DSensor(const wearable::sensor::SensorName name) const
+{
+    return nullptr;
+}
+
+std::shared_ptr<const wearable::sensor::IFreeBodyAccelerationSensor>
+FakeWearable::getFreeBodyAccelerationSensor(const wearable::sensor::SensorName name) const
+{
+    return nullptr;
+}
+
+std::shared_ptr<const wearable::sensor::IGyroscope>
+FakeWearable::getGyroscope(const wearable::sensor::SensorName name) const
+{
+    return nullptr;
+}
+
+std::shared_ptr<const wearable::sensor::IMagnetometer>
+FakeWearable::getMagnetometer(const wearable::sensor::SensorName name) const
+{
+    return nullptr;
+}
+
+std::shared_ptr<const wearable::sensor::IOrientationSensor>
+FakeWearable::getOrientationSensor(const wearable::sensor::SensorName name) const
+{
+    return nullptr;
+}
+
+std::shared_ptr<const wearable::sensor::IPoseSensor>
+FakeWearable::getPoseSensor(const wearable::sensor::SensorName name) const
+{
+    return nullptr;
+}
+
+std::shared_ptr<const wearable::sensor::IPositionSensor>
+FakeWearable::getPositionSensor(const wearable::sensor::SensorName name) const
+{
+    return nullptr;
+}
+
+std::shared_ptr<const wearable::sensor::ISkinSensor>
+FakeWearable::getSkinSensor(const wearable::sensor::SensorName name) const
+{
+    return nullptr;
+}
+
+std::shared_ptr<const wearable::sensor::ITemperatureSensor>
+FakeWearable::getTemperatureSensor(const wearable::sensor::SensorName name) const
+{
+    return nullptr;
+}
+
+std::shared_ptr<const wearable::sensor::ITorque3DSensor>
+FakeWearable::getTorque3DSensor(const wearable::sensor::SensorName name) const
+{
+    return nullptr;
+}
+
+std::shared_ptr<const wearable::sensor::IVirtualSphericalJointKinSensor>
+FakeWearable::getVirtualSphericalJointKinSensor(const wearable::sensor::SensorName name) const
+{
+    return nullptr;
+}
+
+std::shared_ptr<const wearable::actuator::IHaptic>
+FakeWearable::getHapticActuator(const wearable::actuator::ActuatorName name) const
+{
+    return nullptr;
+}
+
+std::shared_ptr<const wearable::actuator::IMotor>
+FakeWearable::getMotorActuator(const wearable::actuator::ActuatorName name) const
+{
+    return nullptr;
+}
+
+std::shared_ptr<const wearable::actuator::IHeater>
+FakeWearable::getHeaterActuator(const wearable::actuator::ActuatorName name) const
+{
+    return nullptr;
+}
@@ -24,7 +24,8 @@ GloveControlHelper::GloveControlHelper()
 
 bool GloveControlHelper::configure(const yarp::os::Searchable& config,
                                    const std::string& name,
-                                   const bool& rightHand)
+                                   const bool& rightHand,
+                                   InputSession& inputSession)
 {
 
     // robot name: used to connect to the robot
@@ -87,7 +88,7 @@ bool GloveControlHelper::configure(const yarp::os::Searchable& config,
     // wearable device
     m_pImp = std::make_unique<GloveWearableImpl>(
         m_numFingers, m_numForceFeedback, m_numVibrotactileFeedback, m_numHandJoints);
-    if (!m_pImp->configure(config, name, m_isRightHand))
+    if (!m_pImp->configure(config, name, m_isRightHand, inputSession))
     {
         yError() << m_logPrefix << "unable to configure the haptic glove wearable device.";
         return false;
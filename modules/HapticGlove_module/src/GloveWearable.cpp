@@ -6,6 +6,7 @@
  * @date 2021
  */
 
+#include <FakeDevices.hpp>
 #include <GloveWearable.hpp>
 #include <Utils.hpp>
 #include <mutex>
@@ -30,11 +31,18 @@ GloveWearableImpl::~GloveWearableImpl() = default;
 
 bool GloveWearableImpl::configure(const yarp::os::Searchable& config,
                                   const std::string& name,
-                                  const bool& rightHand)
+                                  const bool& rightHand,
+                                  InputSession& inputSession)
 {
 
     m_logPrefix += rightHand ? "RightHand:: " : "LeftHand:: ";
 
+    const std::string streamPrefix = rightHand ? "right_hand/glove/" : "left_hand/glove/";
+    m_inputSession = &inputSession;
+    m_jointsStream = m_inputSession->addStream(streamPrefix + "joints");
+    m_palmRotationStream = m_inputSession->addStream(streamPrefix + "palm_rotation");
+    m_fingertipPosesStream = m_inputSession->addStream(streamPrefix + "fingertip_poses");
+
     m_wearablePrefix = "HapticGlove::";
 
     // set Glove Joints List Names From Module
@@ -91,6 +99,14 @@ bool GloveWearableImpl::configure(const yarp::os::Searchable& config,
         return false;
     }
 
+    // the replayed session does not use the glove, the haptic commands are written on a port that
+    // is not opened
+    if (m_inputSession->isReplaying())
+    {
+        yInfo() << m_logPrefix << "configuration is done (replaying the glove readouts).";
+        return true;
+    }
+
     yarp::os::Property options;
     options.put("device", "iwear_remapper");
     yarp::os::Value* wearableDataPort;
@@ -102,6 +118,9 @@ bool GloveWearableImpl::configure(const yarp::os::Searchable& config,
     options.put("wearableDataPorts", wearableDataPort);
     options.put("carrier", "fast_tcp");
 
+    // the fake glove does not receive the haptic commands
+    const bool isFakeGlove = FakeDevices::replaceDevice(options);
+
     if (!m_wearableDevice.open(options))
     {
         yError() << m_logPrefix << "failed to connect wearable remapper device";
@@ -152,7 +171,7 @@ bool GloveWearableImpl::configure(const yarp::os::Searchable& config,
         return false;
     }
 
-    if (!Network::connect(m_iWearActuatorPort.getName(), portNameIn, "fast_tcp"))
+    if (!isFakeGlove && !Network::connect(m_iWearActuatorPort.getName(), portNameIn, "fast_tcp"))
     {
         yError() << m_logPrefix << "output port: " << portNameOut << "input port: " << portNameIn
                  << " unable to connect the ports.";
@@ -245,18 +264,20 @@ bool GloveWearableImpl::getJointValues(std::vector<double>& values)
     if (values.size() != m_numHandJoints)
         values.resize(m_numHandJoints, 0.0);
 
-    size_t i = 0;
-    for (const auto& sensor : m_jointSensors)
-    {
-        if (sensor->getSensorStatus() != wearable::sensor::SensorStatus::Ok)
+    return m_inputSession->read(m_jointsStream, values.data(), values.size(), [&] {
+        size_t i = 0;
+        for (const auto& sensor : m_jointSensors)
         {
-            std::string sName = sensor->getSensorName();
-            yError() << m_logPrefix << "sensor status is not OK, sensor name: " << sName;
+            if (sensor->getSensorStatus() != wearable::sensor::SensorStatus::Ok)
+            {
+                std::string sName = sensor->getSensorName();
+                yError() << m_logPrefix << "sensor status is not OK, sensor name: " << sName;
+            }
+            sensor->getJointPosition(values[i]);
+            i++;
         }
-        sensor->getJointPosition(values[i]);
-        i++;
-    }
-    return true;
+        return true;
+    });
 }
 
 bool GloveWearableImpl::getPalmImuRotationValues(std::vector<double>& values)
@@ -264,17 +285,19 @@ bool GloveWearableImpl::getPalmImuRotationValues(std::vector<double>& values)
     if (values.size() != 4) // quaternion size
         values.resize(4, 0.0);
 
-    if (m_handPalmSensor->getSensorStatus() != wearable::sensor::SensorStatus::Ok)
-    {
-        std::string sName = m_handPalmSensor->getSensorName();
-        yError() << m_logPrefix << "sensor status is not OK, sensor name: " << sName;
-    }
+    return m_inputSession->read(m_palmRotationStream, values.data(), values.size(), [&] {
+        if (m_handPalmSensor->getSensorStatus() != wearable::sensor::SensorStatus::Ok)
+        {
+            std::string sName = m_handPalmSensor->getSensorName();
+            yError() << m_logPrefix << "sensor status is not OK, sensor name: " << sName;
+        }
 
-    wearable::Quaternion orientation;
-    m_handPalmSensor->getLinkOrientation(orientation);
-    for (size_t i = 0; i < 4; i++)
-        values[i] = orientation[i];
-    return true;
+        wearable::Quaternion orientation;
+        m_handPalmSensor->getLinkOrientation(orientation);
+        for (size_t i = 0; i < 4; i++)
+            values[i] = orientation[i];
+        return true;
+    });
 }
 
 bool GloveWearableImpl::getFingertipPoseValues(Eigen::MatrixXd& values)
@@ -282,54 +305,57 @@ bool GloveWearableImpl::getFingertipPoseValues(Eigen::MatrixXd& values)
     if (values.rows() != m_numFingers && values.cols() != 7)
         values.resize(m_numFingers, 7);
 
-    size_t i = 0;
-    for (const auto& sensor : m_fingertipLinkSensors)
-    {
-        if (sensor->getSensorStatus() != wearable::sensor::SensorStatus::Ok)
+    // the matrix is stored in column-major order
+    return m_inputSession->read(m_fingertipPosesStream, values.data(), values.size(), [&] {
+        size_t i = 0;
+        for (const auto& sensor : m_fingertipLinkSensors)
         {
-            std::string sName = sensor->getSensorName();
-            yError() << m_logPrefix << "sensor status is not OK, sensor name: " << sName;
-
-            wearable::sensor::SensorStatus status = sensor->getSensorStatus();
-            switch (status)
+            if (sensor->getSensorStatus() != wearable::sensor::SensorStatus::Ok)
             {
-            case wearable::sensor::SensorStatus::Ok:
-                yInfo() << "sensor status: ok";
-                break;
-            case wearable::sensor::SensorStatus::Error:
-                yInfo() << "sensor status: Error";
-                break;
-            case wearable::sensor::SensorStatus::Calibrating:
-                yInfo() << "sensor status: Calibrating";
-                break;
-            case wearable::sensor::SensorStatus::Overflow:
-                yInfo() << "sensor status: Overflow";
-                break;
-            case wearable::sensor::SensorStatus::Timeout:
-                yInfo() << "sensor status: Timeout";
-                break;
-            case wearable::sensor::SensorStatus::Unknown:
-                yInfo() << "sensor status: Unknown";
-                break;
-            case wearable::sensor::SensorStatus::WaitingForFirstRead:
-                yInfo() << "sensor status: WaitingForFirstRead";
-                break;
-            default:
-                yInfo() << "default case!";
-                break;
+                std::string sName = sensor->getSensorName();
+                yError() << m_logPrefix << "sensor status is not OK, sensor name: " << sName;
+
+                wearable::sensor::SensorStatus status = sensor->getSensorStatus();
+                switch (status)
+                {
+                case wearable::sensor::SensorStatus::Ok:
+                    yInfo() << "sensor status: ok";
+                    break;
+                case wearable::sensor::SensorStatus::Error:
+                    yInfo() << "sensor status: Error";
+                    break;
+                case wearable::sensor::SensorStatus::Calibrating:
+                    yInfo() << "sensor status: Calibrating";
+                    break;
+                case wearable::sensor::SensorStatus::Overflow:
+                    yInfo() << "sensor status: Overflow";
+                    break;
+                case wearable::sensor::SensorStatus::Timeout:
+                    yInfo() << "sensor status: Timeout";
+                    break;
+                case wearable::sensor::SensorStatus::Unknown:
+                    yInfo() << "sensor status: Unknown";
+                    break;
+                case wearable::sensor::SensorStatus::WaitingForFirstRead:
+                    yInfo() << "sensor status: WaitingForFirstRead";
+                    break;
+                default:
+                    yInfo() << "default case!";
+                    break;
+                }
             }
-        }
 
-        wearable::Quaternion orientation;
-        wearable::Vector3 position;
-        sensor->getLinkPose(position, orientation);
-        for (size_t j = 0; j < 3; j++)
-            values(i, j) = position[j];
-        for (size_t j = 0; j < 4; j++)
-            values(i, j + 3) = orientation[j];
-        i++;
-    }
-    return true;
+            wearable::Quaternion orientation;
+            wearable::Vector3 position;
+            sensor->getLinkPose(position, orientation);
+            for (size_t j = 0; j < 3; j++)
+                values(i, j) = position[j];
+            for (size_t j = 0; j < 4; j++)
+                values(i, j + 3) = orientation[j];
+            i++;
+        }
+        return true;
+    });
 }
 
 bool GloveWearableImpl::setFingertipForceFeedbackValues(const std::vector<int>& values)
@@ -427,7 +453,8 @@ bool GloveWearableImpl::close()
 {
     yInfo() << m_logPrefix << "closing the glove wearable implementation.";
     m_iWear = nullptr;
-    m_wearableDevice.close();
+    if (m_wearableDevice.isValid())
+        m_wearableDevice.close();
 
     m_iWearActuatorPort.close();
 
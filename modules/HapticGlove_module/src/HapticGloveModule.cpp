@@ -8,11 +8,14 @@
 
 // std
 #include <thread>
+#include <vector>
 
 // yarp
 #include <yarp/os/LogStream.h>
 
 // teleoperation
+#include <FakeDevices.hpp>
+#include <FakeWearable.hpp>
 #include <HapticGloveModule.hpp>
 #include <Utils.hpp>
 
@@ -44,6 +47,21 @@ bool HapticGloveModule::configure(yarp::os::ResourceFinder& rf)
     }
     setName(name.c_str());
 
+    if (!m_inputSession.configure(rf, getName()))
+    {
+        yError() << m_logPrefix << "unable to configure the input session.";
+        return false;
+    }
+    m_timeStream = m_inputSession.addStream("time");
+
+    if (!FakeDevices::configure(rf))
+    {
+        yError() << m_logPrefix << "unable to configure the fake devices.";
+        return false;
+    }
+    if (FakeDevices::isEnabled())
+        FakeDevices::addDevice<HapticGlove::FakeWearable>("iwear_remapper", "fake_wearable");
+
     yarp::os::Bottle& generalOptions = rf.findGroup("GENERAL");
     // get the period
     m_dT = generalOptions.check("samplingTime", yarp::os::Value(0.1)).asFloat64();
@@ -57,6 +75,9 @@ bool HapticGloveModule::configure(yarp::os::ResourceFinder& rf)
     yInfo() << m_logPrefix << "use the left hand: " << m_useLeftHand;
     yInfo() << m_logPrefix << "use the right hand: " << m_useRightHand;
 
+    m_updateModuleStage = m_profiler.addStage("update_module");
+    m_handsRunStage = m_profiler.addStage("hands_run");
+
     // initialize the left hand teleoperation
     if (m_useLeftHand)
     {
@@ -64,7 +85,7 @@ bool HapticGloveModule::configure(yarp::os::ResourceFinder& rf)
         leftFingersOptions.append(generalOptions);
 
         m_leftHand = std::make_unique<HapticGlove::Teleoperation>();
-        if (!m_leftHand->configure(leftFingersOptions, m_robot, false))
+        if (!m_leftHand->configure(leftFingersOptions, m_robot, false, m_profiler, m_inputSession))
         {
             yError() << m_logPrefix
                      << "unable to initialize the left hand bilateral teleoperation.";
@@ -79,20 +100,27 @@ bool HapticGloveModule::configure(yarp::os::ResourceFinder& rf)
         rightFingersOptions.append(generalOptions);
 
         m_rightHand = std::make_unique<HapticGlove::Teleoperation>();
-        if (!m_rightHand->configure(rightFingersOptions, m_robot, true))
+        if (!m_rightHand->configure(rightFingersOptions, m_robot, true, m_profiler, m_inputSession))
         {
             yError() << m_logPrefix
                      << "unable to initialize the right hand bilateral teleoperation.";
             return false;
         }
     }
+
+    if (!configureHandsPool(generalOptions))
+    {
+        yError() << m_logPrefix << "unable to configure the hands pool.";
+        return false;
+    }
+
     // wainting time after preparation and before running state machine
     m_waitingStartTime = 0;
     m_waitingDurationTime
         = generalOptions.check("waitingDurationTime", yarp::os::Value(5.0)).asFloat64();
 
     // update the end of the configuration time step
-    double timeConfigurationEnd = yarp::os::Time::now();
+    double timeConfigurationEnd = m_inputSession.time(m_timeStream);
 
     if (m_useLeftHand)
     {
@@ -104,20 +132,70 @@ bool HapticGloveModule::configure(yarp::os::ResourceFinder& rf)
         m_rightHand->setEndOfConfigurationTime(timeConfigurationEnd);
     }
 
+    // the port used to query the latency of the stages
+    std::string profilerPortName
+        = generalOptions.check("profilerPortName", yarp::os::Value("/profiler/rpc")).asString();
+    if (!m_profiler.open("/" + name + profilerPortName))
+    {
+        yError() << m_logPrefix << "unable to open the profiler port.";
+        return false;
+    }
+
     yInfo() << m_logPrefix << "configuration is done. ";
     m_state = HapticGloveFSM::Preparing;
 
     return true;
 }
 
+bool HapticGloveModule::configureHandsPool(const yarp::os::Searchable& config)
+{
+    // the hands share no data, the per-hand timing is given by the left_hand/run and
+    // right_hand/run stages of the profiler
+    std::vector<int> cpus;
+    if (m_useLeftHand)
+    {
+        m_handsPool.addTask([this] {
+            if (!m_leftHand->run())
+            {
+                yError() << m_logPrefix << "cannot run the left hand.";
+                return false;
+            }
+            return true;
+        });
+        cpus.push_back(config.check("leftHandCpu", yarp::os::Value(-1)).asInt32());
+    }
+
+    if (m_useRightHand)
+    {
+        m_handsPool.addTask([this] {
+            if (!m_rightHand->run())
+            {
+                yError() << m_logPrefix << "cannot run the right hand.";
+                return false;
+            }
+            return true;
+        });
+        cpus.push_back(config.check("rightHandCpu", yarp::os::Value(-1)).asInt32());
+    }
+
+    // the hands run in sequence by default
+    const bool enableParallelHands
+        = config.check("enableParallelHands", yarp::os::Value(false)).asBool();
+    yInfo() << m_logPrefix << "parallel hands: " << enableParallelHands;
+
+    return enableParallelHands ? m_handsPool.startDedicated(cpus) : m_handsPool.start(0);
+}
+
 double HapticGloveModule::getPeriod()
 {
-    return m_dT;
+    return m_inputSession.period(m_dT);
 }
 
 bool HapticGloveModule::close()
 {
     yInfo() << m_logPrefix << "trying to close.";
+    m_handsPool.close();
+
     if (m_useLeftHand)
     {
         if (!m_leftHand->close())
@@ -134,30 +212,27 @@ bool HapticGloveModule::close()
         }
     }
 
+    m_profiler.close();
+    m_inputSession.close();
+
     return true;
 }
 
 bool HapticGloveModule::updateModule()
 {
-    double t1 = yarp::os::Time::now();
+    if (!m_inputSession.beginCycle())
+        return false;
+
+    INSTRUMENTATION_SCOPE(m_profiler, m_updateModuleStage);
 
     if (m_state == HapticGloveFSM::Running)
     {
-        if (m_useLeftHand)
+        // left and right hands (in parallel if enabled)
+        INSTRUMENTATION_SCOPE(m_profiler, m_handsRunStage);
+        if (!m_handsPool.run())
         {
-            if (!m_leftHand->run())
-            {
-                yError() << m_logPrefix << "cannot run the left hand.";
-                return false;
-            }
-        }
-        if (m_useRightHand)
-        {
-            if (!m_rightHand->run())
-            {
-                yError() << m_logPrefix << "cannot run the left hand.";
-                return false;
-            }
+            yError() << m_logPrefix << "cannot run the hands.";
+            return false;
         }
 
     } else if (m_state == HapticGloveFSM::Configuring)
@@ -193,11 +268,11 @@ bool HapticGloveModule::updateModule()
         if (isPrepared)
         {
             m_state = HapticGloveFSM::Waiting;
-            m_waitingStartTime = yarp::os::Time::now();
+            m_waitingStartTime = m_inputSession.time(m_timeStream);
         }
     } else if (m_state == HapticGloveFSM::Waiting)
     {
-        double timeNow = yarp::os::Time::now();
+        double timeNow = m_inputSession.time(m_timeStream);
 
         if (timeNow - m_waitingStartTime > m_waitingDurationTime)
         {
@@ -221,8 +296,6 @@ bool HapticGloveModule::updateModule()
             }
         }
     }
-    double t2 = yarp::os::Time::now();
-    yInfo() << m_logPrefix << "total computation time: " << t2 - t1;
 
     return true;
 }
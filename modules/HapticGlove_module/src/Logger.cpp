@@ -63,18 +63,6 @@ Teleoperation::Logger::Logger(const Teleoperation& module, const bool isRightHan
 
     m_data.robotMotorPidOutputs.resize(m_numRobotActuatedAxes, 0.0);
 
-    m_data.robotAxisValueReferencesKf.resize(m_numRobotActuatedAxes, 0.0);
-    m_data.robotAxisVelocityReferencesKf.resize(m_numRobotActuatedAxes, 0.0);
-    m_data.robotAxisAccelerationReferencesKf.resize(m_numRobotActuatedAxes, 0.0);
-    m_data.robotAxisCovReferencesKf = Eigen::MatrixXd::Zero(m_numRobotActuatedAxes, 9);
-
-    m_data.robotAxisValueFeedbacksKf.resize(m_numRobotActuatedAxes, 0.0);
-    m_data.robotAxisVelocityFeedbacksKf.resize(m_numRobotActuatedAxes, 0.0);
-    m_data.robotAxisAccelerationFeedbacksKf.resize(m_numRobotActuatedAxes, 0.0);
-    m_data.robotAxisCovFeedbacksKf = Eigen::MatrixXd::Zero(m_numRobotActuatedAxes, 9);
-
-    m_data.robotJointsExpectedKf.resize(m_numRobotActuatedJoints, 0.0);
-    m_data.robotJointsFeedbackKf.resize(m_numRobotActuatedJoints, 0.0);
     // human
     m_data.humanJointValues.resize(m_numHumanHandJoints, 0.0);
     m_data.humanFingertipPoses = Eigen::MatrixXd::Zero(m_numHumanHandFingers, 7);
@@ -105,127 +93,137 @@ Teleoperation::Logger::~Logger() = default;
 
 bool Teleoperation::Logger::openLogger()
 {
-
-#ifdef ENABLE_LOGGER
     std::string currentTime = YarpHelper::getTimeDateMatExtension();
-    m_logFileName = "HapticGloveModule_" + m_handName + "Hand_" + currentTime + "_log.mat";
+    m_logFileName = "HapticGloveModule_" + m_handName + "Hand_" + currentTime + "_log.bin";
 
     yInfo() << "log file name: " << currentTime << m_logFileName;
 
-    m_logger = XBot::MatLogger2::MakeLogger(m_logFileName);
-    m_appender = XBot::MatAppender::MakeInstance();
-    m_appender->add_logger(m_logger);
-    m_appender->start_flush_thread();
-
     // create the data structures to save
     // time
-    m_logger->create("time", 1);
+    m_channels.time = m_recorder.addChannel("time", 1);
 
     // axis
-    m_logger->create(m_robotPrefix + "AxisReferences", m_numRobotActuatedAxes);
-    m_logger->create(m_robotPrefix + "AxisFeedbacks", m_numRobotActuatedAxes);
-    m_logger->create(m_robotPrefix + "AxisVelocityFeedbacks", m_numRobotActuatedAxes);
+    m_channels.robotAxisReferences
+        = m_recorder.addChannel(m_robotPrefix + "AxisReferences", m_numRobotActuatedAxes);
+    m_channels.robotAxisFeedbacks
+        = m_recorder.addChannel(m_robotPrefix + "AxisFeedbacks", m_numRobotActuatedAxes);
+    m_channels.robotAxisVelocityFeedbacks
+        = m_recorder.addChannel(m_robotPrefix + "AxisVelocityFeedbacks", m_numRobotActuatedAxes);
 
     // robot hand joints
-    m_logger->create(m_robotPrefix + "JointReferences", m_numRobotActuatedJoints);
-    m_logger->create(m_robotPrefix + "JointFeedbacks", m_numRobotActuatedJoints);
+    m_channels.robotJointReferences
+        = m_recorder.addChannel(m_robotPrefix + "JointReferences", m_numRobotActuatedJoints);
+    m_channels.robotJointFeedbacks
+        = m_recorder.addChannel(m_robotPrefix + "JointFeedbacks", m_numRobotActuatedJoints);
 
     // robot axis errors
-    m_logger->create(m_robotPrefix + "AxisValueErrors", m_numRobotActuatedAxes);
-    m_logger->create(m_robotPrefix + "AxisVelocityErrors", m_numRobotActuatedAxes);
+    m_channels.robotAxisValueErrors
+        = m_recorder.addChannel(m_robotPrefix + "AxisValueErrors", m_numRobotActuatedAxes);
+    m_channels.robotAxisVelocityErrors
+        = m_recorder.addChannel(m_robotPrefix + "AxisVelocityErrors", m_numRobotActuatedAxes);
 
     // to check if it is real robot or simulation
     if (m_teleoperation.m_robot == "icub")
     {
         // current
-        m_logger->create(m_robotPrefix + "MotorCurrentReferences", m_numRobotActuatedAxes);
-        m_logger->create(m_robotPrefix + "MotorCurrentFeedbacks", m_numRobotActuatedAxes);
+        m_channels.robotMotorCurrentReferences = m_recorder.addChannel(
+            m_robotPrefix + "MotorCurrentReferences", m_numRobotActuatedAxes);
+        m_channels.robotMotorCurrentFeedbacks = m_recorder.addChannel(
+            m_robotPrefix + "MotorCurrentFeedbacks", m_numRobotActuatedAxes);
 
         // pwm
-        m_logger->create(m_robotPrefix + "MotorPwmReferences", m_numRobotActuatedAxes);
-        m_logger->create(m_robotPrefix + "MotorPwmFeedbacks", m_numRobotActuatedAxes);
+        m_channels.robotMotorPwmReferences
+            = m_recorder.addChannel(m_robotPrefix + "MotorPwmReferences", m_numRobotActuatedAxes);
+        m_channels.robotMotorPwmFeedbacks
+            = m_recorder.addChannel(m_robotPrefix + "MotorPwmFeedbacks", m_numRobotActuatedAxes);
     }
 
     // pid
-    m_logger->create(m_robotPrefix + "MotorPidOutputs", m_numRobotActuatedAxes);
+    m_channels.robotMotorPidOutputs
+        = m_recorder.addChannel(m_robotPrefix + "MotorPidOutputs", m_numRobotActuatedAxes);
 
     // axis reference KF
-    m_logger->create(m_robotPrefix + "AxisValueReferencesKf", m_numRobotActuatedAxes);
-    m_logger->create(m_robotPrefix + "AxisVelocityReferencesKf", m_numRobotActuatedAxes);
-    m_logger->create(m_robotPrefix + "AxisAccelerationReferencesKf", m_numRobotActuatedAxes);
-    m_logger->create(m_robotPrefix + "AxisCovReferencesKf",
-                     m_numRobotActuatedAxes,
-                     9); // states: value, velocity, acceleration --> cov matrix size: 3X3=9
+    m_channels.robotAxisValueReferencesKf
+        = m_recorder.addChannel(m_robotPrefix + "AxisValueReferencesKf", m_numRobotActuatedAxes);
+    m_channels.robotAxisVelocityReferencesKf = m_recorder.addChannel(
+        m_robotPrefix + "AxisVelocityReferencesKf", m_numRobotActuatedAxes);
+    m_channels.robotAxisAccelerationReferencesKf = m_recorder.addChannel(
+        m_robotPrefix + "AxisAccelerationReferencesKf", m_numRobotActuatedAxes);
+    // states: value, velocity, acceleration. The covariance is the same for all the axes
+    m_channels.robotAxisCovReferencesKf
+        = m_recorder.addChannel(m_robotPrefix + "AxisCovReferencesKf", 3, 3);
 
     // axis feedback KF
-    m_logger->create(m_robotPrefix + "AxisValueFeedbacksKf", m_numRobotActuatedAxes);
-    m_logger->create(m_robotPrefix + "AxisVelocityFeedbacksKf", m_numRobotActuatedAxes);
-    m_logger->create(m_robotPrefix + "AxisAccelerationFeedbacksKf", m_numRobotActuatedAxes);
-    m_logger->create(m_robotPrefix + "AxisCovFeedbacksKf",
-                     m_numRobotActuatedAxes,
-                     9); // states: value, velocity, acceleration --> cov matrix size: 3X3=9
+    m_channels.robotAxisValueFeedbacksKf
+        = m_recorder.addChannel(m_robotPrefix + "AxisValueFeedbacksKf", m_numRobotActuatedAxes);
+    m_channels.robotAxisVelocityFeedbacksKf = m_recorder.addChannel(
+        m_robotPrefix + "AxisVelocityFeedbacksKf", m_numRobotActuatedAxes);
+    m_channels.robotAxisAccelerationFeedbacksKf = m_recorder.addChannel(
+        m_robotPrefix + "AxisAccelerationFeedbacksKf", m_numRobotActuatedAxes);
+    m_channels.robotAxisCovFeedbacksKf
+        = m_recorder.addChannel(m_robotPrefix + "AxisCovFeedbacksKf", 3, 3);
 
     // joints KF
-    m_logger->create(m_robotPrefix + "JointsExpectedKf", m_numRobotActuatedJoints);
-    m_logger->create(m_robotPrefix + "JointsFeedbackKf", m_numRobotActuatedJoints);
+    m_channels.robotJointsExpectedKf
+        = m_recorder.addChannel(m_robotPrefix + "JointsExpectedKf", m_numRobotActuatedJoints);
+    m_channels.robotJointsFeedbackKf
+        = m_recorder.addChannel(m_robotPrefix + "JointsFeedbackKf", m_numRobotActuatedJoints);
 
     // Human data
-    m_logger->create(m_humanPrefix + "JointValues", m_numHumanHandJoints);
-    m_logger->create(m_humanPrefix + "FingertipPoses", m_numHumanHandFingers, 7);
-    m_logger->create(m_humanPrefix + "ForceFeedbacks", m_numHumanForceFeedback);
-    m_logger->create(m_humanPrefix + "VibrotactileFeedbacks", m_numHumanVibrotactileFeedback);
-    m_logger->create(m_humanPrefix + "PalmRotation", 4);
-
-    // add the robot and human fingers, axes, joints.
-    std::vector<std::string> robotActuatedAxisNames;
-    std::vector<std::string> robotActuatedJointNames;
-    std::vector<std::string> humanJointNames;
-    std::vector<std::string> humanFingerNames;
-
-    m_teleoperation.m_robotController->controlHelper()->getActuatedAxisNames(
-        robotActuatedAxisNames);
-    m_teleoperation.m_robotController->controlHelper()->getActuatedJointNames(
-        robotActuatedJointNames);
-    m_teleoperation.m_humanGlove->getHumanHandJointsNames(humanJointNames);
-    m_teleoperation.m_humanGlove->getHumanHandFingerNames(humanFingerNames);
-
-    m_logger->create(m_robotPrefix + "ActuatedAxisNames", m_numRobotActuatedAxes);
-    m_logger->create(m_robotPrefix + "ActuatedJointNames", m_numRobotActuatedJoints);
-    m_logger->create(m_humanPrefix + "JointNames", m_numHumanHandJoints);
-    m_logger->create(m_humanPrefix + "FingerNames", m_numHumanHandFingers);
+    m_channels.humanJointValues
+        = m_recorder.addChannel(m_humanPrefix + "JointValues", m_numHumanHandJoints);
+    m_channels.humanFingertipPoses
+        = m_recorder.addChannel(m_humanPrefix + "FingertipPoses", m_numHumanHandFingers, 7);
+    m_channels.humanForceFeedbacks
+        = m_recorder.addChannel(m_humanPrefix + "ForceFeedbacks", m_numHumanForceFeedback);
+    m_channels.humanVibrotactileFeedbacks = m_recorder.addChannel(
+        m_humanPrefix + "VibrotactileFeedbacks", m_numHumanVibrotactileFeedback);
+    m_channels.humanPalmRotation = m_recorder.addChannel(m_humanPrefix + "PalmRotation", 4);
 
     // skin data
     if (m_useSkin)
     {
-        m_logger->create(m_robotPrefix + "SkinData", m_numberRobotTactileFeedbacks);
-        m_logger->create(m_robotPrefix + "CalibratedSkinData", m_numberRobotTactileFeedbacks);
-        m_logger->create(m_robotPrefix + "CalibratedSkinDataDerivative",
-                         m_numberRobotTactileFeedbacks);
-        m_logger->create(m_robotPrefix + "FingercontactStrength", m_numHumanVibrotactileFeedback);
-        m_logger->create(m_robotPrefix + "FingercontactStrengthDerivative",
-                         m_numHumanVibrotactileFeedback);
-        m_logger->create(m_robotPrefix + "SkinAbsoluteValueVibrotactileFeedback",
-                         m_numHumanVibrotactileFeedback);
-        m_logger->create(m_robotPrefix + "SkinDerivativeValueVibrotactileFeedback",
-                         m_numHumanVibrotactileFeedback);
-        m_logger->create(m_robotPrefix + "SkinTotalValueVibrotactileFeedback",
-                         m_numHumanVibrotactileFeedback);
-        m_logger->create(m_robotPrefix + "SkinIsInContact", m_numHumanVibrotactileFeedback);
+        m_channels.skinData
+            = m_recorder.addChannel(m_robotPrefix + "SkinData", m_numberRobotTactileFeedbacks);
+        m_channels.calibratedSkinData = m_recorder.addChannel(
+            m_robotPrefix + "CalibratedSkinData", m_numberRobotTactileFeedbacks);
+        m_channels.calibratedSkinDataDerivative = m_recorder.addChannel(
+            m_robotPrefix + "CalibratedSkinDataDerivative", m_numberRobotTactileFeedbacks);
+        m_channels.fingercontactStrength = m_recorder.addChannel(
+            m_robotPrefix + "FingercontactStrength", m_numHumanVibrotactileFeedback);
+        m_channels.fingercontactStrengthDerivative = m_recorder.addChannel(
+            m_robotPrefix + "FingercontactStrengthDerivative", m_numHumanVibrotactileFeedback);
+        m_channels.skinAbsoluteValueVibrotactileFeedback = m_recorder.addChannel(
+            m_robotPrefix + "SkinAbsoluteValueVibrotactileFeedback",
+            m_numHumanVibrotactileFeedback);
+        m_channels.skinDerivativeValueVibrotactileFeedback = m_recorder.addChannel(
+            m_robotPrefix + "SkinDerivativeValueVibrotactileFeedback",
+            m_numHumanVibrotactileFeedback);
+        m_channels.skinTotalValueVibrotactileFeedback = m_recorder.addChannel(
+            m_robotPrefix + "SkinTotalValueVibrotactileFeedback", m_numHumanVibrotactileFeedback);
+        m_channels.skinIsInContact = m_recorder.addChannel(m_robotPrefix + "SkinIsInContact",
+                                                           m_numHumanVibrotactileFeedback);
+    }
+
+    // the file is preallocated for 10 minutes of data, then it is enlarged if needed
+    const std::size_t capacity = static_cast<std::size_t>(600.0 / m_teleoperation.m_dT);
+    if (!m_recorder.open(m_logFileName, capacity))
+    {
+        yError() << m_logPrefix << "unable to open the log file " << m_logFileName;
+        return false;
     }
 
-    //    m_logger->add(m_robotPrefix + "ActuatedAxisNames", robotActuatedAxisNames);
-    //    m_logger->add(m_robotPrefix + "ActuatedJointNames", robotActuatedJointNames);
-    //    m_logger->add(m_humanPrefix + "JointNames", humanJointNames);
-    //    m_logger->add(m_humanPrefix + "FingerNames", humanFingerNames);
+    // the file is written by a background thread, the queue holds one second of data
+    const std::size_t queueCapacity = static_cast<std::size_t>(1.0 / m_teleoperation.m_dT) + 1;
+    if (!m_recorder.startWriter(queueCapacity))
+    {
+        yError() << m_logPrefix << "unable to start the writer of the log file " << m_logFileName;
+        return false;
+    }
 
     // print
     yInfo() << m_logPrefix << "logging is active.";
 
-#else
-    yInfo() << m_logPrefix << " logging option is not active in CMakeLists.";
-
-#endif
-
     return true;
 }
 
@@ -264,18 +262,6 @@ bool Teleoperation::Logger::updateData()
 
     m_teleoperation.m_robotController->getMotorPidOutputs(m_data.robotMotorPidOutputs);
 
-    m_teleoperation.m_robotController->getEstimatedMotorsState(
-        m_data.robotAxisValueFeedbacksKf,
-        m_data.robotAxisVelocityFeedbacksKf,
-        m_data.robotAxisAccelerationFeedbacksKf,
-        m_data.robotAxisCovFeedbacksKf,
-        m_data.robotAxisValueReferencesKf,
-        m_data.robotAxisVelocityReferencesKf,
-        m_data.robotAxisAccelerationReferencesKf,
-        m_data.robotAxisCovReferencesKf);
-
-    m_teleoperation.m_robotController->getEstimatedJointValuesKf(m_data.robotJointsExpectedKf,
-                                                                 m_data.robotJointsFeedbackKf);
     // human
     m_teleoperation.m_humanGlove->getHandJointAngles(m_data.humanJointValues);
 
@@ -322,107 +308,123 @@ bool Teleoperation::Logger::updateData()
 }
 bool Teleoperation::Logger::logData()
 {
-#ifdef ENABLE_LOGGER
-
     if (!this->updateData())
     {
         yWarning() << m_logPrefix << "cannot update the data.";
     }
 
     // time
-    m_logger->add("time", m_data.time);
+    m_recorder.set(m_channels.time, m_data.time);
 
     // axis
-    m_logger->add(m_robotPrefix + "AxisReferences", m_data.robotAxisReferences);
-    m_logger->add(m_robotPrefix + "AxisFeedbacks", m_data.robotAxisFeedbacks);
-    m_logger->add(m_robotPrefix + "AxisVelocityFeedbacks", m_data.robotAxisVelocityFeedbacks);
+    m_recorder.set(m_channels.robotAxisReferences, m_data.robotAxisReferences);
+    m_recorder.set(m_channels.robotAxisFeedbacks, m_data.robotAxisFeedbacks);
+    m_recorder.set(m_channels.robotAxisVelocityFeedbacks, m_data.robotAxisVelocityFeedbacks);
 
     // robot hand joints
-    m_logger->add(m_robotPrefix + "JointReferences", m_data.robotJointReferences);
-    m_logger->add(m_robotPrefix + "JointFeedbacks", m_data.robotJointFeedbacks);
+    m_recorder.set(m_channels.robotJointReferences, m_data.robotJointReferences);
+    m_recorder.set(m_channels.robotJointFeedbacks, m_data.robotJointFeedbacks);
 
     // robot axis errors
-    m_logger->add(m_robotPrefix + "AxisValueErrors", m_data.robotAxisValueErrors);
-    m_logger->add(m_robotPrefix + "AxisVelocityErrors", m_data.robotAxisVelocityErrors);
+    m_recorder.set(m_channels.robotAxisValueErrors, m_data.robotAxisValueErrors);
+    m_recorder.set(m_channels.robotAxisVelocityErrors, m_data.robotAxisVelocityErrors);
 
     // to check if it is real robot or simulation
     if (m_teleoperation.m_robot == "icub")
     {
         // current
-        m_logger->add(m_robotPrefix + "MotorCurrentReferences", m_data.robotMotorCurrentReferences);
-        m_logger->add(m_robotPrefix + "MotorCurrentFeedbacks", m_data.robotMotorCurrentFeedbacks);
+        m_recorder.set(m_channels.robotMotorCurrentReferences, m_data.robotMotorCurrentReferences);
+        m_recorder.set(m_channels.robotMotorCurrentFeedbacks, m_data.robotMotorCurrentFeedbacks);
 
         // pwm
-        m_logger->add(m_robotPrefix + "MotorPwmReferences", m_data.robotMotorPwmReferences);
-        m_logger->add(m_robotPrefix + "MotorPwmFeedbacks", m_data.robotMotorPwmFeedbacks);
+        m_recorder.set(m_channels.robotMotorPwmReferences, m_data.robotMotorPwmReferences);
+        m_recorder.set(m_channels.robotMotorPwmFeedbacks, m_data.robotMotorPwmFeedbacks);
     }
 
     // pid
-    m_logger->add(m_robotPrefix + "MotorPidOutputs", m_data.robotMotorPidOutputs);
+    m_recorder.set(m_channels.robotMotorPidOutputs, m_data.robotMotorPidOutputs);
+
+    // the KF estimations are copied in the record directly from the views of the estimators
+    const RobotController& robotController = *m_teleoperation.m_robotController;
 
     // axis reference KF
-    m_logger->add(m_robotPrefix + "AxisValueReferencesKf", m_data.robotAxisValueReferencesKf);
-    m_logger->add(m_robotPrefix + "AxisVelocityReferencesKf", m_data.robotAxisVelocityReferencesKf);
-    m_logger->add(m_robotPrefix + "AxisAccelerationReferencesKf",
-                  m_data.robotAxisAccelerationReferencesKf);
-    m_logger->add(m_robotPrefix + "AxisCovReferencesKf", m_data.robotAxisCovReferencesKf);
+    const Estimators& axisReferenceEstimators = robotController.axisReferenceEstimators();
+    if (axisReferenceEstimators.isInitialized())
+    {
+        m_recorder.set(m_channels.robotAxisValueReferencesKf,
+                       axisReferenceEstimators.estimatedValues());
+        m_recorder.set(m_channels.robotAxisVelocityReferencesKf,
+                       axisReferenceEstimators.estimatedVelocities());
+        m_recorder.set(m_channels.robotAxisAccelerationReferencesKf,
+                       axisReferenceEstimators.estimatedAccelerations());
+        m_recorder.set(m_channels.robotAxisCovReferencesKf, axisReferenceEstimators.covariance());
+    }
 
     // axis feedback KF
-    m_logger->add(m_robotPrefix + "AxisValueFeedbacksKf", m_data.robotAxisValueFeedbacksKf);
-    m_logger->add(m_robotPrefix + "AxisVelocityFeedbacksKf", m_data.robotAxisVelocityFeedbacksKf);
-    m_logger->add(m_robotPrefix + "AxisAccelerationFeedbacksKf",
-                  m_data.robotAxisAccelerationFeedbacksKf);
-    m_logger->add(m_robotPrefix + "AxisCovFeedbacksKf", m_data.robotAxisCovFeedbacksKf);
+    const Estimators& axisFeedbackEstimators = robotController.axisFeedbackEstimators();
+    if (axisFeedbackEstimators.isInitialized())
+    {
+        m_recorder.set(m_channels.robotAxisValueFeedbacksKf,
+                       axisFeedbackEstimators.estimatedValues());
+        m_recorder.set(m_channels.robotAxisVelocityFeedbacksKf,
+                       axisFeedbackEstimators.estimatedVelocities());
+        m_recorder.set(m_channels.robotAxisAccelerationFeedbacksKf,
+                       axisFeedbackEstimators.estimatedAccelerations());
+        m_recorder.set(m_channels.robotAxisCovFeedbacksKf, axisFeedbackEstimators.covariance());
+    }
 
     // joints KF
-    m_logger->add(m_robotPrefix + "JointsExpectedKf", m_data.robotJointsExpectedKf);
-    m_logger->add(m_robotPrefix + "JointsFeedbackKf", m_data.robotJointsFeedbackKf);
+    if (robotController.jointExpectedEstimators().isInitialized())
+    {
+        m_recorder.set(m_channels.robotJointsExpectedKf,
+                       robotController.jointExpectedEstimators().estimatedValues());
+    }
+    if (robotController.jointFeedbackEstimators().isInitialized())
+    {
+        m_recorder.set(m_channels.robotJointsFeedbackKf,
+                       robotController.jointFeedbackEstimators().estimatedValues());
+    }
 
     // Human data
-    m_logger->add(m_humanPrefix + "JointValues", m_data.humanJointValues);
-    m_logger->add(m_humanPrefix + "FingertipPoses", m_data.humanFingertipPoses);
-    m_logger->add(m_humanPrefix + "ForceFeedbacks", m_data.humanForceFeedbacks);
-    m_logger->add(m_humanPrefix + "VibrotactileFeedbacks", m_data.humanVibrotactileFeedbacks);
-    m_logger->add(m_humanPrefix + "PalmRotation", m_data.humanPalmRotation);
+    m_recorder.set(m_channels.humanJointValues, m_data.humanJointValues);
+    m_recorder.set(m_channels.humanFingertipPoses, m_data.humanFingertipPoses);
+    m_recorder.set(m_channels.humanForceFeedbacks, m_data.humanForceFeedbacks);
+    m_recorder.set(m_channels.humanVibrotactileFeedbacks, m_data.humanVibrotactileFeedbacks);
+    m_recorder.set(m_channels.humanPalmRotation, m_data.humanPalmRotation);
 
     // skin
     if (m_useSkin)
     {
-        m_logger->add(m_robotPrefix + "SkinData", m_data.fingertipsSkinData);
-        m_logger->add(m_robotPrefix + "CalibratedSkinData",
-                      m_data.fingertipsCalibratedTactileFeedback);
-        m_logger->add(m_robotPrefix + "CalibratedSkinDataDerivative",
-                      m_data.fingertipsCalibratedDerivativeTactileFeedback);
-        m_logger->add(m_robotPrefix + "FingercontactStrength",
-                      m_data.fingercontactStrengthFeedback);
-        m_logger->add(m_robotPrefix + "FingercontactStrengthDerivative",
-                      m_data.fingercontactStrengthDerivativeFeedback);
-        m_logger->add(m_robotPrefix + "SkinAbsoluteValueVibrotactileFeedback",
-                      m_data.robotFingerSkinAbsoluteValueVibrotactileFeedbacks);
-        m_logger->add(m_robotPrefix + "SkinDerivativeValueVibrotactileFeedback",
-                      m_data.robotFingerSkinDerivativeValueVibrotactileFeedbacks);
-        m_logger->add(m_robotPrefix + "SkinTotalValueVibrotactileFeedback",
-                      m_data.robotFingerSkinTotalValueVibrotactileFeedbacks);
-
-        std::vector<int> areFingersSkinInContact(m_data.areFingersSkinInContact.begin(),
-                                                 m_data.areFingersSkinInContact.end());
-        m_logger->add(m_robotPrefix + "SkinIsInContact", areFingersSkinInContact);
+        m_recorder.set(m_channels.skinData, m_data.fingertipsSkinData);
+        m_recorder.set(m_channels.calibratedSkinData, m_data.fingertipsCalibratedTactileFeedback);
+        m_recorder.set(m_channels.calibratedSkinDataDerivative,
+                       m_data.fingertipsCalibratedDerivativeTactileFeedback);
+        m_recorder.set(m_channels.fingercontactStrength, m_data.fingercontactStrengthFeedback);
+        m_recorder.set(m_channels.fingercontactStrengthDerivative,
+                       m_data.fingercontactStrengthDerivativeFeedback);
+        m_recorder.set(m_channels.skinAbsoluteValueVibrotactileFeedback,
+                       m_data.robotFingerSkinAbsoluteValueVibrotactileFeedbacks);
+        m_recorder.set(m_channels.skinDerivativeValueVibrotactileFeedback,
+                       m_data.robotFingerSkinDerivativeValueVibrotactileFeedbacks);
+        m_recorder.set(m_channels.skinTotalValueVibrotactileFeedback,
+                       m_data.robotFingerSkinTotalValueVibrotactileFeedbacks);
+        m_recorder.set(m_channels.skinIsInContact, m_data.areFingersSkinInContact);
     }
 
-#endif
-
-    return true;
+    // the whole record is handed to the writer thread at once. The records dropped because the
+    // queue is full are reported by closeLogger()
+    return m_recorder.commit() || !m_recorder.isWriterFailed();
 }
 
 bool Teleoperation::Logger::closeLogger()
 {
-
-#ifdef ENABLE_LOGGER
-    m_logger->flush_available_data();
-    //    m_logger->~MatLogger2();
-    m_logger = nullptr;
-#endif
+    m_recorder.close();
     yInfo() << m_logPrefix << "logger is closing.";
+    if (m_recorder.droppedRecords() > 0)
+    {
+        yWarning() << m_logPrefix << m_recorder.droppedRecords()
+                   << "records have been dropped because the writer was too slow.";
+    }
     yInfo() << m_logPrefix << "log file is saved in: " << m_logFileName;
     return true;
 }
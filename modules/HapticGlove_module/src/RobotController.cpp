@@ -17,7 +17,8 @@ using namespace HapticGlove;
 
 bool RobotController::configure(const yarp::os::Searchable& config,
                                 const std::string& name,
-                                const bool& rightHand)
+                                const bool& rightHand,
+                                InputSession& inputSession)
 {
     m_rightHand = rightHand;
 
@@ -27,7 +28,7 @@ bool RobotController::configure(const yarp::os::Searchable& config,
     bool isMandatory = config.check("isMandatory", yarp::os::Value(0)).asBool();
 
     m_robotInterface = std::make_unique<RobotInterface>();
-    if (!m_robotInterface->configure(config, name, m_rightHand, isMandatory))
+    if (!m_robotInterface->configure(config, name, m_rightHand, isMandatory, inputSession))
     {
         yError() << m_logPrefix << "unable to intialized and configure the control.";
         return false;
@@ -490,14 +491,15 @@ bool RobotController::initializeEstimators()
     getJointValueFeedbacks(m_data->jointValueFeedbacksStd);
     getJointExpectedValues(m_data->jointValuesExpectedStd);
 
+    // each estimator is initialized with the measurements it estimates
     if (!m_axisReferenceEstimators->isInitialized())
-        m_axisReferenceEstimators->initialize(m_data->jointValuesExpectedStd);
+        m_axisReferenceEstimators->initialize(m_data->axisValueReferencesStd);
 
     if (!m_axisFeedbackEstimators->isInitialized())
         m_axisFeedbackEstimators->initialize(m_data->axisValueFeedbacksStd);
 
     if (!m_jointExpectedEstimators->isInitialized())
-        m_jointExpectedEstimators->initialize(m_data->axisValueReferencesStd);
+        m_jointExpectedEstimators->initialize(m_data->jointValuesExpectedStd);
 
     if (!m_jointFeedbackEstimators->isInitialized())
         m_jointFeedbackEstimators->initialize(m_data->jointValueFeedbacksStd);
@@ -547,82 +549,35 @@ bool RobotController::getEstimatedMotorsState(
     std::vector<double>& feedbackAxisValuesEstimationKF,
     std::vector<double>& feedbackAxisVelocitiesEstimationKF,
     std::vector<double>& feedbackAxisAccelrationEstimationKF,
-    Eigen::MatrixXd& feedbackAxisCovEstimationKF,
     std::vector<double>& referenceAxisValuesEstimationKF,
     std::vector<double>& referenceAxisVelocitiesEstimationKF,
-    std::vector<double>& referenceAxisAccelrationEstimationKF,
-    Eigen::MatrixXd& referenceAxisCovEstimationKF)
+    std::vector<double>& referenceAxisAccelrationEstimationKF)
 {
+    // the vectors are only resized if the number of axes changes
+    const auto copy = [](const Estimators::ConstVectorView& view, std::vector<double>& vector) {
+        vector.assign(view.data(), view.data() + view.size());
+    };
 
     if (m_axisFeedbackEstimators->isInitialized())
     {
-        m_axisFeedbackEstimators->getInfo(feedbackAxisValuesEstimationKF,
-                                          feedbackAxisVelocitiesEstimationKF,
-                                          feedbackAxisAccelrationEstimationKF,
-                                          feedbackAxisCovEstimationKF);
+        copy(m_axisFeedbackEstimators->estimatedValues(), feedbackAxisValuesEstimationKF);
+        copy(m_axisFeedbackEstimators->estimatedVelocities(), feedbackAxisVelocitiesEstimationKF);
+        copy(m_axisFeedbackEstimators->estimatedAccelerations(),
+             feedbackAxisAccelrationEstimationKF);
     }
 
     if (m_axisReferenceEstimators->isInitialized())
     {
-        m_axisReferenceEstimators->getInfo(referenceAxisValuesEstimationKF,
-                                           referenceAxisVelocitiesEstimationKF,
-                                           referenceAxisAccelrationEstimationKF,
-                                           referenceAxisCovEstimationKF);
+        copy(m_axisReferenceEstimators->estimatedValues(), referenceAxisValuesEstimationKF);
+        copy(m_axisReferenceEstimators->estimatedVelocities(),
+             referenceAxisVelocitiesEstimationKF);
+        copy(m_axisReferenceEstimators->estimatedAccelerations(),
+             referenceAxisAccelrationEstimationKF);
     }
 
     return true;
 }
 
-bool RobotController::getEstimatedJointValuesKf(
-    std::vector<double>& feedbackJointValuesEstimationKF,
-    std::vector<double>& feedbackJointVelocitiesEstimationKF,
-    std::vector<double>& feedbackJointAccelrationEstimationKF,
-    Eigen::MatrixXd& feedbackJointCovEstimationKF,
-    std::vector<double>& expectedJointValuesEstimationKF,
-    std::vector<double>& expectedJointVelocitiesEstimationKF,
-    std::vector<double>& expectedJointAccelrationEstimationKF,
-    Eigen::MatrixXd& expectedJointCovEstimationKF)
-{
-
-    if (m_jointFeedbackEstimators->isInitialized())
-    {
-        m_jointFeedbackEstimators->getInfo(feedbackJointValuesEstimationKF,
-                                           feedbackJointVelocitiesEstimationKF,
-                                           feedbackJointAccelrationEstimationKF,
-                                           feedbackJointCovEstimationKF);
-    }
-
-    if (m_jointExpectedEstimators->isInitialized())
-    {
-        m_jointExpectedEstimators->getInfo(expectedJointValuesEstimationKF,
-                                           expectedJointVelocitiesEstimationKF,
-                                           expectedJointAccelrationEstimationKF,
-                                           expectedJointCovEstimationKF);
-    }
-    return true;
-}
-
-bool RobotController::getEstimatedJointValuesKf(
-    std::vector<double>& feedbackJointValuesEstimationKF,
-    std::vector<double>& expectedJointValuesEstimationKF)
-{
-
-    std::vector<double> feedbackJointVelocitiesEstimationKF, feedbackJointAccelrationEstimationKF;
-    std::vector<double> expectedJointVelocitiesEstimationKF, expectedJointAccelrationEstimationKF;
-    Eigen::MatrixXd feedbackJointCovEstimationKF, expectedJointCovEstimationKF;
-
-    if (m_jointFeedbackEstimators->isInitialized())
-    {
-        m_jointFeedbackEstimators->getMotorValueInfo(feedbackJointValuesEstimationKF);
-    }
-
-    if (m_jointExpectedEstimators->isInitialized())
-    {
-        m_jointExpectedEstimators->getMotorValueInfo(expectedJointValuesEstimationKF);
-    }
-    return true;
-}
-
 bool RobotController::getCustomSetIndices(const std::vector<std::string>& allListName,
                                           const std::vector<std::string>& customListNames,
                                           const std::vector<double>& allListVector,
@@ -688,3 +643,23 @@ std::unique_ptr<HapticGlove::RobotInterface>& RobotController::controlHelper()
 {
     return m_robotInterface;
 }
+
+const Estimators& RobotController::axisFeedbackEstimators() const
+{
+    return *m_axisFeedbackEstimators;
+}
+
+const Estimators& RobotController::axisReferenceEstimators() const
+{
+    return *m_axisReferenceEstimators;
+}
+
+const Estimators& RobotController::jointFeedbackEstimators() const
+{
+    return *m_jointFeedbackEstimators;
+}
+
+const Estimators& RobotController::jointExpectedEstimators() const
+{
+    return *m_jointExpectedEstimators;
+}
@@ -14,16 +14,61 @@
 #include <iDynTree/Core/Utils.h>
 
 // teleoperation
+#include <ConfigSchema.hpp>
 #include <ControlHelper.hpp>
+#include <FakeDevices.hpp>
 #include <RobotInterface.hpp>
 #include <Utils.hpp>
 
 using namespace HapticGlove;
 
+namespace
+{
+/// <summary>
+/// Parameters of the robot interface of a hand.
+/// </summary>
+struct RobotInterfaceParameters
+{
+    std::string robot;
+    std::vector<std::string> axisList;
+    std::vector<std::string> allAxisList;
+    std::vector<std::string> jointList;
+    std::vector<std::string> robotFingerList;
+    std::vector<std::string> analogList;
+    yarp::sig::Vector analogJointsMinBoundary;
+    yarp::sig::Vector analogJointsMaxBoundary;
+    yarp::sig::Vector analogSensorsRawMinBoundary;
+    yarp::sig::Vector analogSensorsRawMaxBoundary;
+    bool useVelocity;
+    double robotInitializationTime;
+    unsigned int steadyStateCounterThreshold;
+    double steadyStateThreshold;
+
+    template <typename Visitor> void visit(Visitor& v)
+    {
+        v("robot", robot, std::string("icubSim"));
+        v("axis_list", axisList);
+        v("all_axis_list", allAxisList);
+        v("joint_list", jointList);
+        v("robot_finger_list", robotFingerList);
+        v("analog_list", analogList);
+        v("analog_joints_min_boundary", analogJointsMinBoundary);
+        v("analog_joints_max_boundary", analogJointsMaxBoundary);
+        v("analog_sensors_raw_min_boundary", analogSensorsRawMinBoundary);
+        v("analog_sensors_raw_max_boundary", analogSensorsRawMaxBoundary);
+        v("useVelocity", useVelocity, false);
+        v("robotInitializationTime", robotInitializationTime, 5.0);
+        v("steadyStateCounterThreshold", steadyStateCounterThreshold, 5u);
+        v("steadyStateThreshold", steadyStateThreshold, 0.05);
+    }
+};
+} // namespace
+
 bool RobotInterface::configure(const yarp::os::Searchable& config,
                                const std::string& name,
                                const bool& rightHand,
-                               const bool& isMandatory)
+                               const bool& isMandatory,
+                               InputSession& inputSession)
 {
     m_rightHand = rightHand;
     m_logPrefix = "RobotInterface::";
@@ -31,49 +76,46 @@ bool RobotInterface::configure(const yarp::os::Searchable& config,
 
     m_isMandatory = isMandatory;
 
-    // robot name: used to connect to the robot
-    std::string robot;
-    robot = config.check("robot", yarp::os::Value("icubSim")).asString();
+    // the feedbacks of the robot are the inputs of the teleoperation
+    const std::string streamPrefix = m_rightHand ? "right_hand/robot/" : "left_hand/robot/";
+    m_inputSession = &inputSession;
+    m_encodersStream = m_inputSession->addStream(streamPrefix + "encoders");
+    m_encoderSpeedsStream = m_inputSession->addStream(streamPrefix + "encoder_speeds");
+    m_analogSensorStream = m_inputSession->addStream(streamPrefix + "analog_sensor");
+    m_currentsStream = m_inputSession->addStream(streamPrefix + "currents");
+    m_pwmStream = m_inputSession->addStream(streamPrefix + "pwm");
+    m_pidOutputsStream = m_inputSession->addStream(streamPrefix + "pid_outputs");
+    m_limitsStream = m_inputSession->addStream(streamPrefix + "limits");
+    m_velocityLimitsStream = m_inputSession->addStream(streamPrefix + "velocity_limits");
 
-    if (!YarpHelper::getVectorFromSearchable(config, "axis_list", m_actuatedAxisNames))
+    RobotInterfaceParameters parameters;
+    if (!YarpHelper::parseParameters(config, parameters, m_logPrefix))
     {
-        yError() << m_logPrefix << "unable to get  axis_list from the config file.";
+        yError() << m_logPrefix << "unable to parse the robot interface parameters.";
         return false;
     }
+
+    // robot name: used to connect to the robot
+    const std::string& robot = parameters.robot;
+
+    m_actuatedAxisNames = parameters.axisList;
     m_noActuatedAxis = m_actuatedAxisNames.size();
 
-    if (!YarpHelper::getVectorFromSearchable(config, "all_axis_list", m_allAxisNames))
-    {
-        yError() << m_logPrefix << "unable to get  all_axis_list from the config file..";
-        return false;
-    }
+    m_allAxisNames = parameters.allAxisList;
 
     // // 5*3 analog sensors + 1 encoder thumb oppose + 1 encoder hand_finger
-    if (!YarpHelper::getVectorFromSearchable(config, "joint_list", m_allJointNames))
-    {
-        yError() << m_logPrefix << "unable to get joint_list from the config file.";
-        return false;
-    }
+    m_allJointNames = parameters.jointList;
 
     m_noAllAxis = m_allAxisNames.size();
 
     m_noAllJoints = m_allJointNames.size();
 
-    if (!YarpHelper::getVectorFromSearchable(config, "robot_finger_list", m_robotFingerNames))
-    {
-        yError() << m_logPrefix << "unable to get  robot_finger_list from the config file..";
-        return false;
-    }
+    m_robotFingerNames = parameters.robotFingerList;
 
     m_noFingers = m_robotFingerNames.size();
 
     // add the list of axis and associated analog sensors
-    std::vector<std::string> analogList;
-    if (!YarpHelper::getVectorFromSearchable(config, "analog_list", analogList))
-    {
-        yError() << m_logPrefix << "unable to get analog_list from config file.";
-        return false;
-    }
+    const std::vector<std::string>& analogList = parameters.analogList;
 
     m_noAnalogSensor = analogList.size();
 
@@ -157,41 +199,12 @@ bool RobotInterface::configure(const yarp::os::Searchable& config,
         return false;
     }
 
-    m_analogJointsMinBoundaryDegree.resize(m_noAnalogSensor, 0.0);
-    m_analogJointsMaxBoundaryDegree.resize(m_noAnalogSensor, 0.0);
-    m_analogSensorsRawMinBoundary.resize(m_noAnalogSensor, 0.0);
-    m_analogSensorsRawMaxBoundary.resize(m_noAnalogSensor, 0.0);
-
-    // get the joints limits boundaries
-    if (!YarpHelper::getYarpVectorFromSearchable(
-            config, "analog_joints_min_boundary", m_analogJointsMinBoundaryDegree))
-    {
-        yError() << m_logPrefix << "unable to get the minimum boundary of the joints limits.";
-        return false;
-    }
-
-    if (!YarpHelper::getYarpVectorFromSearchable(
-            config, "analog_joints_max_boundary", m_analogJointsMaxBoundaryDegree))
-    {
-        yError() << m_logPrefix << "unable to get the maximum boundary of the joints limits.";
-        return false;
-    }
-
-    // get the sensors limits boundaries
-    if (!YarpHelper::getYarpVectorFromSearchable(
-            config, "analog_sensors_raw_min_boundary", m_analogSensorsRawMinBoundary))
-    {
-        yError() << m_logPrefix << "unable to get the minimum boundary of the joints limits.";
-        return false;
-    }
+    // get the joints and the sensors limits boundaries
+    m_analogJointsMinBoundaryDegree = parameters.analogJointsMinBoundary;
+    m_analogJointsMaxBoundaryDegree = parameters.analogJointsMaxBoundary;
+    m_analogSensorsRawMinBoundary = parameters.analogSensorsRawMinBoundary;
+    m_analogSensorsRawMaxBoundary = parameters.analogSensorsRawMaxBoundary;
 
-    // get the sensors limits boundaries
-    if (!YarpHelper::getYarpVectorFromSearchable(
-            config, "analog_sensors_raw_max_boundary", m_analogSensorsRawMaxBoundary))
-    {
-        yError() << m_logPrefix << "unable to get the maximum boundary of the joints limits.";
-        return false;
-    }
     bool tmp = (m_analogJointsMinBoundaryDegree.size() == m_noAnalogSensor)
                && (m_analogJointsMaxBoundaryDegree.size() == m_noAnalogSensor)
                && (m_analogSensorsRawMinBoundary.size() == m_noAnalogSensor)
@@ -213,7 +226,7 @@ bool RobotInterface::configure(const yarp::os::Searchable& config,
               / double(m_analogSensorsRawMaxBoundary(i) - m_analogSensorsRawMinBoundary(i));
     }
 
-    bool useVelocity = config.check("useVelocity", yarp::os::Value(false)).asBool();
+    const bool useVelocity = parameters.useVelocity;
 
     m_controlMode = useVelocity ? VOCAB_CM_VELOCITY : VOCAB_CM_POSITION_DIRECT;
     m_pidControlMode
@@ -315,7 +328,12 @@ bool RobotInterface::configure(const yarp::os::Searchable& config,
     bool okPosition = false;
     for (int i = 0; i < 10 && !okPosition; i++)
     {
-        okPosition = m_encodersInterface->getEncoders(m_encoderPositionFeedbackInDegrees.data());
+        okPosition = m_inputSession->read(m_encodersStream,
+                                          m_encoderPositionFeedbackInDegrees,
+                                          [this] {
+                                              return m_encodersInterface->getEncoders(
+                                                  m_encoderPositionFeedbackInDegrees.data());
+                                          });
 
         if (!okPosition)
             yarp::os::Time::delay(0.1);
@@ -327,12 +345,10 @@ bool RobotInterface::configure(const yarp::os::Searchable& config,
     }
 
     // initialize the robot joint/axis configurations
-    double intializationTime
-        = config.check("robotInitializationTime", yarp::os::Value(5.0)).asFloat64();
+    double intializationTime = parameters.robotInitializationTime;
 
-    m_steadyStateCounterThreshold
-        = config.check("steadyStateCounterThreshold", yarp::os::Value(5)).asInt64();
-    m_steadyStateThreshold = config.check("steadyStateThreshold", yarp::os::Value(0.05)).asFloat64();
+    m_steadyStateCounterThreshold = parameters.steadyStateCounterThreshold;
+    m_steadyStateThreshold = parameters.steadyStateThreshold;
     m_steadyStateCounter = 0;
     yInfo() << m_logPrefix << "initialization time [sec]:" << intializationTime
             << ", steady state counter threshold [steps]:" << m_steadyStateCounterThreshold
@@ -372,6 +388,10 @@ bool RobotInterface::openRobotDevices(const yarp::os::Searchable& config,
                                       const std::string& name,
                                       const std::string& robot)
 {
+    // the replayed session does not use the robot
+    if (isReplaying())
+        return true;
+
     // get the info from the config file
     // get all controlled icub parts from the resource finder
     std::vector<std::string> iCubParts;
@@ -403,6 +423,7 @@ bool RobotInterface::openRobotDevices(const yarp::os::Searchable& config,
     // for communicating with the robot
 
     // open the device
+    FakeDevices::replaceDevice(optionsRobotDevice);
     if (!m_robotDevice.open(optionsRobotDevice) && m_isMandatory)
     {
         yError() << m_logPrefix << "could not open remotecontrolboardremapper object.";
@@ -491,6 +512,10 @@ bool RobotInterface::openAnalogDevices(const yarp::os::Searchable& config,
                                        const std::string& name,
                                        const std::string& robot)
 {
+    // the replayed session does not use the robot
+    if (isReplaying())
+        return true;
+
     // get all icub senosry parts from the resource finder
     std::string iCubSensorPart;
 
@@ -507,6 +532,7 @@ bool RobotInterface::openAnalogDevices(const yarp::os::Searchable& config,
     optionsAnalogDevice.put("local", "/" + name + "/" + iCubSensorPart + "/analog:i");
     optionsAnalogDevice.put("remote", "/" + robot + "/" + iCubSensorPart + "/analog:o");
 
+    FakeDevices::replaceDevice(optionsAnalogDevice);
     if (!m_analogDevice.open(optionsAnalogDevice))
     {
         yError() << m_logPrefix << "could not open analogSensorClient object.";
@@ -521,8 +547,16 @@ bool RobotInterface::openAnalogDevices(const yarp::os::Searchable& config,
     return true;
 }
 
+bool RobotInterface::isReplaying() const
+{
+    return m_inputSession->isReplaying();
+}
+
 bool RobotInterface::switchToControlMode(const int& controlMode)
 {
+    if (isReplaying())
+        return true;
+
     // check if the control interface is ready
     if (!m_controlModeInterface)
     {
@@ -568,6 +602,10 @@ bool RobotInterface::initializeAxisValues(const double& initializationTime)
         return false;
     }
 
+    // the replayed robot is not moved to the home values
+    if (isReplaying())
+        return true;
+
     if (!switchToControlMode(VOCAB_CM_POSITION))
     {
         yError() << m_logPrefix << "Unable to switch in position control.";
@@ -614,7 +652,7 @@ bool RobotInterface::initializeAxisValues(const double& initializationTime)
 
 bool RobotInterface::setDirectPositionReferences(const yarp::sig::Vector& desiredPosition)
 {
-    if (m_positionDirectInterface == nullptr)
+    if (m_positionDirectInterface == nullptr && !isReplaying())
     {
         yError() << m_logPrefix << "PositionDirect I/F not ready.";
         return false;
@@ -634,6 +672,10 @@ bool RobotInterface::setDirectPositionReferences(const yarp::sig::Vector& desire
     for (int i = 0; i < m_noActuatedAxis; i++)
         m_referenceValues(i) = iDynTree::rad2deg(desiredPosition(i));
 
+    // the references are not sent to the replayed robot
+    if (isReplaying())
+        return true;
+
     // set desired position
     if (!m_positionDirectInterface->setPositions(m_referenceValues.data()) && m_isMandatory)
     {
@@ -646,7 +688,7 @@ bool RobotInterface::setDirectPositionReferences(const yarp::sig::Vector& desire
 
 bool RobotInterface::setPositionReferences(const yarp::sig::Vector& desiredPosition)
 {
-    if (m_positionInterface == nullptr)
+    if (m_positionInterface == nullptr && !isReplaying())
     {
         yError() << m_logPrefix << "Position I/F not ready.";
         return false;
@@ -666,6 +708,10 @@ bool RobotInterface::setPositionReferences(const yarp::sig::Vector& desiredPosit
     for (int i = 0; i < m_noActuatedAxis; i++)
         m_referenceValues(i) = iDynTree::rad2deg(desiredPosition(i));
 
+    // the references are not sent to the replayed robot
+    if (isReplaying())
+        return true;
+
     // set desired position
     if (!m_positionInterface->positionMove(m_referenceValues.data()) && m_isMandatory)
     {
@@ -678,7 +724,7 @@ bool RobotInterface::setPositionReferences(const yarp::sig::Vector& desiredPosit
 
 bool RobotInterface::setVelocityReferences(const yarp::sig::Vector& desiredVelocity)
 {
-    if (m_velocityInterface == nullptr)
+    if (m_velocityInterface == nullptr && !isReplaying())
     {
         yError() << m_logPrefix << "Velocity I/F not ready.";
         return false;
@@ -698,6 +744,10 @@ bool RobotInterface::setVelocityReferences(const yarp::sig::Vector& desiredVeloc
     for (int i = 0; i < m_noActuatedAxis; i++)
         m_referenceValues(i) = iDynTree::rad2deg(desiredVelocity(i));
 
+    // the references are not sent to the replayed robot
+    if (isReplaying())
+        return true;
+
     // since the velocity interface use a minimum jerk trajectory a very high
     // acceleration is set in order to use it as velocity "direct" interface
     yarp::sig::Vector dummy(m_noActuatedAxis, std::numeric_limits<double>::max());
@@ -717,7 +767,7 @@ bool RobotInterface::setVelocityReferences(const yarp::sig::Vector& desiredVeloc
 
 bool RobotInterface::setCurrentReferences(const yarp::sig::Vector& desiredCurrent)
 {
-    if (m_currentInterface == nullptr)
+    if (m_currentInterface == nullptr && !isReplaying())
     {
         yError() << m_logPrefix << "Current I/F not ready.";
         return false;
@@ -735,6 +785,10 @@ bool RobotInterface::setCurrentReferences(const yarp::sig::Vector& desiredCurren
     m_motorCurrentReferences = desiredCurrent;
     m_referenceValues = desiredCurrent;
 
+    // the references are not sent to the replayed robot
+    if (isReplaying())
+        return true;
+
     // set desired current
     if (!m_currentInterface->setRefCurrents(m_referenceValues.data()) && m_isMandatory)
     {
@@ -746,7 +800,7 @@ bool RobotInterface::setCurrentReferences(const yarp::sig::Vector& desiredCurren
 
 bool RobotInterface::setPwmReferences(const yarp::sig::Vector& desiredPwm)
 {
-    if (m_pwmInterface == nullptr)
+    if (m_pwmInterface == nullptr && !isReplaying())
     {
         yError() << m_logPrefix << "PWM I/F not ready.";
         return false;
@@ -764,6 +818,10 @@ bool RobotInterface::setPwmReferences(const yarp::sig::Vector& desiredPwm)
     m_motorPwmReferences = desiredPwm;
     m_referenceValues = desiredPwm;
 
+    // the references are not sent to the replayed robot
+    if (isReplaying())
+        return true;
+
     // set desired PWM
     if (!m_pwmInterface->setRefDutyCycles(m_referenceValues.data()) && m_isMandatory)
     {
@@ -785,7 +843,12 @@ bool RobotInterface::getFeedback()
 {
     double time0 = yarp::os::Time::now();
 
-    if (!m_encodersInterface->getEncoders(m_encoderPositionFeedbackInDegrees.data())
+    if (!m_inputSession->read(m_encodersStream,
+                              m_encoderPositionFeedbackInDegrees,
+                              [this] {
+                                  return m_encodersInterface->getEncoders(
+                                      m_encoderPositionFeedbackInDegrees.data());
+                              })
         && m_isMandatory)
     {
         yError() << m_logPrefix << "Unable to get axes position.";
@@ -796,7 +859,12 @@ bool RobotInterface::getFeedback()
         m_encoderPositionFeedbackInRadians(j)
             = iDynTree::deg2rad(m_encoderPositionFeedbackInDegrees(j));
 
-    if (!m_encodersInterface->getEncoderSpeeds(m_encoderVelocityFeedbackInDegrees.data())
+    if (!m_inputSession->read(m_encoderSpeedsStream,
+                              m_encoderVelocityFeedbackInDegrees,
+                              [this] {
+                                  return m_encodersInterface->getEncoderSpeeds(
+                                      m_encoderVelocityFeedbackInDegrees.data());
+                              })
         && m_isMandatory)
     {
         yError() << m_logPrefix << "Unable to get axes velocity feedback.";
@@ -807,8 +875,10 @@ bool RobotInterface::getFeedback()
         m_encoderVelocityFeedbackInRadians(j)
             = iDynTree::deg2rad(m_encoderVelocityFeedbackInDegrees(j));
 
-    if (!(m_analogSensorInterface->read(m_analogSensorFeedbackRaw)
-          == yarp::dev::IAnalogSensor::AS_OK))
+    if (!m_inputSession->read(m_analogSensorStream, m_analogSensorFeedbackRaw, [this] {
+            return m_analogSensorInterface->read(m_analogSensorFeedbackRaw)
+                   == yarp::dev::IAnalogSensor::AS_OK;
+        }))
     {
         yError() << m_logPrefix << "Unable to get analog sensor data.";
         return false;
@@ -826,19 +896,35 @@ bool RobotInterface::getFeedback()
         return false;
     }
 
-    if (!m_currentInterface->getCurrents(m_motorCurrentFeedbacks.data()) && m_isMandatory)
+    if (!m_inputSession->read(m_currentsStream,
+                              m_motorCurrentFeedbacks,
+                              [this] {
+                                  return m_currentInterface->getCurrents(
+                                      m_motorCurrentFeedbacks.data());
+                              })
+        && m_isMandatory)
     {
         yError() << m_logPrefix << "Unable to get motor current feedbacks.";
         return false;
     }
 
-    if (!m_pwmInterface->getDutyCycles(m_motorPwmFeedbacks.data()) && m_isMandatory)
+    if (!m_inputSession->read(
+            m_pwmStream,
+            m_motorPwmFeedbacks,
+            [this] { return m_pwmInterface->getDutyCycles(m_motorPwmFeedbacks.data()); })
+        && m_isMandatory)
     {
         yError() << m_logPrefix << "Unable to get motor PWM feedbacks.";
         return false;
     }
 
-    if (!m_pidInterface->getPidOutputs(m_pidControlMode, m_pidOutput.data()) && m_isMandatory)
+    if (!m_inputSession->read(m_pidOutputsStream,
+                              m_pidOutput,
+                              [this] {
+                                  return m_pidInterface->getPidOutputs(m_pidControlMode,
+                                                                       m_pidOutput.data());
+                              })
+        && m_isMandatory)
     {
         yError() << m_logPrefix << "Unable to get pid outputs.";
         return false;
@@ -1010,6 +1096,9 @@ void RobotInterface::motorPidOutputs(std::vector<double>& motorPidOutputs)
 bool RobotInterface::close()
 {
     yInfo() << m_logPrefix << "closing.";
+    if (isReplaying())
+        return true;
+
     bool ok = true;
     if (!switchToControlMode(VOCAB_CM_POSITION))
     {
@@ -1112,11 +1201,14 @@ bool RobotInterface::getActuatedAxisLimits(yarp::sig::Matrix& limits)
     // resize matrix
     limits.resize(m_noActuatedAxis, 2);
 
-    double maxLimitInDegree, minLimitInDegree;
+    // minimum and maximum limits in degrees
+    yarp::sig::Vector limitsInDegree(2);
     for (int i = 0; i < m_noActuatedAxis; i++)
     {
         // get position limits
-        if (!m_limitsInterface->getLimits(i, &minLimitInDegree, &maxLimitInDegree))
+        if (!m_inputSession->read(m_limitsStream, limitsInDegree, [&] {
+                return m_limitsInterface->getLimits(i, &limitsInDegree(0), &limitsInDegree(1));
+            }))
         {
             if (m_isMandatory)
             {
@@ -1133,8 +1225,8 @@ bool RobotInterface::getActuatedAxisLimits(yarp::sig::Matrix& limits)
             }
         } else
         {
-            limits(i, 0) = iDynTree::deg2rad(minLimitInDegree);
-            limits(i, 1) = iDynTree::deg2rad(maxLimitInDegree);
+            limits(i, 0) = iDynTree::deg2rad(limitsInDegree(0));
+            limits(i, 1) = iDynTree::deg2rad(limitsInDegree(1));
         }
     }
     for (const auto& axisRangeMap : m_axisCustomMotionRange)
@@ -1267,19 +1359,22 @@ bool RobotInterface::getVelocityLimits(yarp::sig::Matrix& limits)
     // resize matrix
     limits.resize(m_noActuatedAxis, 2);
 
-    double maxLimitInDegree, minLimitInDegree;
+    // minimum and maximum velocity limits in degrees per second
+    yarp::sig::Vector limitsInDegree(2);
     for (int i = 0; i < m_noActuatedAxis; i++)
     {
         // get position limits
-        if (!m_limitsInterface->getVelLimits(i, &minLimitInDegree, &maxLimitInDegree))
+        if (!m_inputSession->read(m_velocityLimitsStream, limitsInDegree, [&] {
+                return m_limitsInterface->getVelLimits(i, &limitsInDegree(0), &limitsInDegree(1));
+            }))
         {
             yError() << m_logPrefix << "Unable get " << m_actuatedAxisNames[i] << " joint limits.";
             return false;
 
         } else
         {
-            limits(i, 0) = iDynTree::deg2rad(minLimitInDegree);
-            limits(i, 1) = iDynTree::deg2rad(maxLimitInDegree);
+            limits(i, 0) = iDynTree::deg2rad(limitsInDegree(0));
+            limits(i, 1) = iDynTree::deg2rad(limitsInDegree(1));
         }
     }
 
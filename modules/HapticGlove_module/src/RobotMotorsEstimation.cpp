@@ -13,6 +13,14 @@
 
 using namespace HapticGlove;
 
+constexpr int Estimators::numberOfStates;
+
+namespace
+{
+// maximum number of iterations of the discrete Riccati equation solved at configuration time
+constexpr std::size_t maxRiccatiIterations = 100000;
+} // namespace
+
 Estimators::Estimators(const int noMotors)
 {
     m_numOfMotors = noMotors;
@@ -40,6 +48,15 @@ bool Estimators::configure(const yarp::os::Searchable& config, const std::string
 
     no_measurement_kf = config.check("no_measurement_kf", yarp::os::Value(1)).asInt32();
 
+    // the model of the axes/joints is hard-coded
+    if (no_states_kf != numberOfStates || no_measurement_kf != 1)
+    {
+        yError() << m_logPrefix << "the model of the estimators has" << numberOfStates
+                 << "states and 1 measurement (no_states_kf:" << no_states_kf
+                 << ", no_measurement_kf:" << no_measurement_kf << ").";
+        return false;
+    }
+
     yarp::sig::Vector Q_vector(no_states_kf, 0.0), R_vector(no_measurement_kf, 0.0);
     if (!YarpHelper::getYarpVectorFromSearchable(config, "r_matrix_kf", R_vector))
     {
@@ -53,162 +70,150 @@ bool Estimators::configure(const yarp::os::Searchable& config, const std::string
         return false;
     }
 
-    Eigen::MatrixXd Q = Eigen::MatrixXd::Identity(no_states_kf, no_states_kf);
-    Eigen::MatrixXd R = Eigen::MatrixXd::Identity(no_measurement_kf, no_measurement_kf);
-    for (int i = 0; i < no_states_kf; i++)
+    MotorKalmanFilter::InputCovarianceMatrix Q = MotorKalmanFilter::InputCovarianceMatrix::Zero();
+    MotorKalmanFilter::MeasurementMatrix R;
+    for (int i = 0; i < numberOfStates; i++)
     {
         Q(i, i) = Q_vector(i);
     }
-    for (int i = 0; i < no_measurement_kf; i++)
-    {
-        R(i, i) = R_vector(i);
-    }
+    R(0, 0) = R_vector(0);
 
-    for (int i = 0; i < m_numOfMotors; i++)
+    // relative change of the covariance below which the gain is frozen (0 never freezes it)
+    const double convergenceTolerance
+        = config.check("kf_convergence_tolerance", yarp::os::Value(1e-9)).asFloat64();
+    const bool precomputeSteadyStateGain
+        = config.check("kf_precompute_steady_state_gain", yarp::os::Value(false)).asBool();
+    if (precomputeSteadyStateGain && convergenceTolerance <= 0)
     {
-        Estimator motorEstimator(dt, R, Q);
-        m_motorEstimatorVector.push_back(motorEstimator);
+        yError() << m_logPrefix
+                 << "kf_convergence_tolerance has to be positive to precompute the gain.";
+        return false;
     }
 
-    m_z = Eigen::MatrixXd::Zero(no_measurement_kf, 1);
+    /* Hard-coded continuous model of an axis:
+     * x_dot(t)= F * x(t) + G * w(t)
+     * x= [s, s_dot, s_ddot ]^T
+     * z= s
+     */
+    MotorKalmanFilter::StateMatrix F = MotorKalmanFilter::StateMatrix::Zero();
+    F(0, 1) = 1.0;
+    F(1, 2) = 1.0;
+    MotorKalmanFilter::OutputMatrix H = MotorKalmanFilter::OutputMatrix::Zero();
+    H(0, 0) = 1.0;
+
+    m_kf = std::make_unique<MotorKalmanFilter>(
+        dt, F, MotorKalmanFilter::InputMatrix::Identity(), H, R, Q);
+    m_kf->setConvergenceTolerance(convergenceTolerance);
+
+    // the covariances do not depend on the measurements, so they are initialized here
+    m_kf->initialize(MotorKalmanFilter::StateVector::Zero(),
+                     MotorKalmanFilter::StateMatrix::Identity());
+    if (precomputeSteadyStateGain && !m_kf->computeSteadyStateGain(maxRiccatiIterations))
+    {
+        yError() << m_logPrefix << "the discrete Riccati equation did not converge in"
+                 << maxRiccatiIterations << "iterations.";
+        return false;
+    }
 
-    m_x_hat = Eigen::MatrixXd::Zero(no_measurement_kf, 1);
-    m_P.resize(no_states_kf * no_states_kf);
+    m_x_bar = StatesMatrix::Zero(m_numOfMotors, numberOfStates);
+    m_x_hat = StatesMatrix::Zero(m_numOfMotors, numberOfStates);
+    m_innovation = Eigen::VectorXd::Zero(m_numOfMotors);
 
     return true;
 }
 
 bool Estimators::initialize(const std::vector<double>& z0)
 {
-    for (size_t i = 0; i < m_numOfMotors; i++)
+    if (z0.size() < m_numOfMotors)
     {
-        m_z(0, 0) = z0[i];
-        m_motorEstimatorVector[i].initialize(m_z);
-    }
-    m_isInitialized = true;
-    return true;
-}
-
-bool Estimators::estimateNextState(const std::vector<double>& z)
-{
-    for (size_t i = 0; i < m_numOfMotors; i++)
-    {
-        m_z(0, 0) = z[i];
-        m_motorEstimatorVector[i].estimateNextState(m_z);
+        yError() << m_logPrefix << "the size of the initial measurements is" << z0.size()
+                 << "while the number of motors is" << m_numOfMotors;
+        return false;
     }
 
-    return true;
-}
-
-bool Estimators::estimateNextSteadyState(const std::vector<double>& z)
-{
+    m_x_bar.setZero();
+    m_x_bar.col(0) = Eigen::Map<const Eigen::VectorXd>(z0.data(), m_numOfMotors);
+    m_x_hat = m_x_bar;
 
-    for (size_t i = 0; i < m_numOfMotors; i++)
-    {
-        m_z(0, 0) = z[i];
-        m_motorEstimatorVector[i].estimateNextSteadyState(m_z);
-    }
+    m_isInitialized = true;
     return true;
 }
 
-bool Estimators::getInfo(Eigen::VectorXd& estimatedValues,
-                         Eigen::VectorXd& estimatedVelocities,
-                         Eigen::VectorXd& estimatedAccelerations,
-                         Eigen::MatrixXd& P)
+bool Estimators::updateStates(const std::vector<double>& z)
 {
-    if (estimatedValues.size() != m_numOfMotors)
+    if (z.size() < m_numOfMotors)
     {
-        estimatedValues.resize(m_numOfMotors, 0.0);
+        yError() << m_logPrefix << "the size of the measurements is" << z.size()
+                 << "while the number of motors is" << m_numOfMotors;
+        return false;
     }
 
-    if (estimatedVelocities.size() != m_numOfMotors)
-    {
-        estimatedValues.resize(m_numOfMotors, 0.0);
-    }
+    const MotorKalmanFilter::GainMatrix& K = m_kf->gain();
+    const MotorKalmanFilter::OutputMatrix& H = m_kf->outputMatrix();
+    const MotorKalmanFilter::StateMatrix& Phi = m_kf->transitionMatrix();
 
-    if (estimatedAccelerations.size() != m_numOfMotors)
-    {
-        estimatedValues.resize(m_numOfMotors, 0.0);
-    }
+    // every line updates a state of all the axes/joints
+    m_innovation = Eigen::Map<const Eigen::VectorXd>(z.data(), m_numOfMotors);
+    for (int j = 0; j < numberOfStates; j++)
+        m_innovation -= H(0, j) * m_x_bar.col(j);
 
-    if (P.rows() != m_numOfMotors && P.cols() == m_n * m_n)
-    {
-        P.resize(m_numOfMotors, m_n * m_n);
-    }
+    for (int i = 0; i < numberOfStates; i++)
+        m_x_hat.col(i) = m_x_bar.col(i) + K(i, 0) * m_innovation;
 
-    size_t i = 0;
-    for (auto& estimator : m_motorEstimatorVector)
+    // the mean of w is zero
+    for (int i = 0; i < numberOfStates; i++)
     {
-        estimator.getInfo(m_x_hat, m_P);
-
-        estimatedValues[i] = m_x_hat[0];
-        estimatedVelocities[i] = m_x_hat[1];
-        estimatedAccelerations[i] = m_x_hat[2];
-
-        P.row(i) = m_P;
-        i++;
+        m_x_bar.col(i) = Phi(i, 0) * m_x_hat.col(0);
+        for (int j = 1; j < numberOfStates; j++)
+            m_x_bar.col(i) += Phi(i, j) * m_x_hat.col(j);
     }
 
     return true;
 }
 
-bool Estimators::getInfo(std::vector<double>& estimatedValues,
-                         std::vector<double>& estimatedVelocities,
-                         std::vector<double>& estimatedAccelerations,
-                         Eigen::MatrixXd& P)
+bool Estimators::estimateNextState(const std::vector<double>& z)
 {
-    if (estimatedValues.size() != m_numOfMotors)
+    // the covariances and the gain are the same for all the axes/joints, once they converged
+    // the step is the same of estimateNextSteadyState()
+    if (!m_kf->isGainConverged())
     {
-        estimatedValues.resize(m_numOfMotors, 0.0);
-    }
+        m_kf->updateGain();
 
-    if (estimatedVelocities.size() != m_numOfMotors)
-    {
-        estimatedValues.resize(m_numOfMotors, 0.0);
+        if (m_kf->isGainConverged())
+            yInfo() << m_logPrefix << "the covariances converged, the gain is frozen.";
     }
 
-    if (estimatedAccelerations.size() != m_numOfMotors)
-    {
-        estimatedValues.resize(m_numOfMotors, 0.0);
-    }
-
-    if (P.rows() != m_numOfMotors && P.cols() == m_n * m_n)
-    {
-        P.resize(m_numOfMotors, m_n * m_n);
-    }
-
-    size_t i = 0;
-    for (auto& estimator : m_motorEstimatorVector)
-    {
-        estimator.getInfo(m_x_hat, m_P);
+    return updateStates(z);
+}
 
-        estimatedValues[i] = m_x_hat[0];
-        estimatedVelocities[i] = m_x_hat[1];
-        estimatedAccelerations[i] = m_x_hat[2];
+bool Estimators::estimateNextSteadyState(const std::vector<double>& z)
+{
+    return updateStates(z);
+}
 
-        P.row(i) = m_P;
-        i++;
-    }
+bool Estimators::isGainConverged() const
+{
+    return m_kf->isGainConverged();
+}
 
-    return true;
+Estimators::ConstVectorView Estimators::estimatedValues() const
+{
+    return ConstVectorView(m_x_hat.col(0).data(), m_numOfMotors);
 }
 
-bool Estimators::getMotorValueInfo(std::vector<double>& estimatedValue)
+Estimators::ConstVectorView Estimators::estimatedVelocities() const
 {
-    if (estimatedValue.size() != m_numOfMotors)
-    {
-        estimatedValue.resize(m_numOfMotors, 0.0);
-    }
+    return ConstVectorView(m_x_hat.col(1).data(), m_numOfMotors);
+}
 
-    size_t i = 0;
-    for (auto& estimator : m_motorEstimatorVector)
-    {
-        estimator.getExpetedStateInfo(m_x_hat);
-        estimatedValue[i] = m_x_hat[0];
-        i++;
-    }
+Estimators::ConstVectorView Estimators::estimatedAccelerations() const
+{
+    return ConstVectorView(m_x_hat.col(2).data(), m_numOfMotors);
+}
 
-    return true;
+const Estimators::MotorKalmanFilter::StateMatrix& Estimators::covariance() const
+{
+    return m_kf->covariance();
 }
 
 bool Estimators::isInitialized() const
@@ -11,6 +11,7 @@
 
 // teleoperation
 #include <ControlHelper.hpp>
+#include <FakeDevices.hpp>
 #include <RobotSkin.hpp>
 #include <Utils.hpp>
 
@@ -23,12 +24,17 @@ RobotSkin::RobotSkin(){};
 
 bool RobotSkin::configure(const yarp::os::Searchable& config,
                           const std::string& name,
-                          const bool& rightHand)
+                          const bool& rightHand,
+                          InputSession& inputSession)
 {
     m_rightHand = rightHand;
     m_logPrefix = "RobotSkin::";
     m_logPrefix += m_rightHand ? "RightHand:: " : "LeftHand:: ";
 
+    m_inputSession = &inputSession;
+    m_rawTactileStream
+        = m_inputSession->addStream(m_rightHand ? "right_hand/skin/raw" : "left_hand/skin/raw");
+
     m_samplingTime = config.check("samplingTime", yarp::os::Value(0.01)).asFloat64();
 
     std::vector<std::string> robotFingerNameList;
@@ -81,16 +87,22 @@ bool RobotSkin::configure(const yarp::os::Searchable& config,
     optionsTactileDevice.put("local", "/" + robot + "/skin" + "/" + iCubSensorPart + "/in");
     optionsTactileDevice.put("remote", "/" + robot + "/skin" + "/" + iCubSensorPart);
 
-    if (!m_tactileSensorDevice.open(optionsTactileDevice))
+    // the replayed session does not use the robot skin
+    if (!m_inputSession->isReplaying())
     {
-        yError() << m_logPrefix << "could not open analogSensorClient object for the robot skin.";
-        return false;
-    }
+        FakeDevices::replaceDevice(optionsTactileDevice);
+        if (!m_tactileSensorDevice.open(optionsTactileDevice))
+        {
+            yError() << m_logPrefix
+                     << "could not open analogSensorClient object for the robot skin.";
+            return false;
+        }
 
-    if (!m_tactileSensorDevice.view(m_tactileSensorInterface) || !m_tactileSensorInterface)
-    {
-        yError() << m_logPrefix << "cannot obtain IAnalogSensor interface for the robot skin";
-        return false;
+        if (!m_tactileSensorDevice.view(m_tactileSensorInterface) || !m_tactileSensorInterface)
+        {
+            yError() << m_logPrefix << "cannot obtain IAnalogSensor interface for the robot skin";
+            return false;
+        }
     }
 
     // get the paramters for the nonlinear mapping of the vibrotactile feedback
@@ -346,8 +358,10 @@ bool RobotSkin::getFingertipTactileFeedbacks(const size_t fingertipIndex,
 
 bool RobotSkin::getRawTactileFeedbackFromRobot()
 {
-    if (!(m_tactileSensorInterface->read(m_fingertipRawTactileFeedbacksYarpVector)
-          == yarp::dev::IAnalogSensor::AS_OK))
+    if (!m_inputSession->read(m_rawTactileStream, m_fingertipRawTactileFeedbacksYarpVector, [this] {
+            return m_tactileSensorInterface->read(m_fingertipRawTactileFeedbacksYarpVector)
+                   == yarp::dev::IAnalogSensor::AS_OK;
+        }))
     {
         yWarning() << m_logPrefix << "Unable to get tactile sensor data.";
     }
@@ -556,7 +570,7 @@ const size_t RobotSkin::getNumOfTactileFeedbacks()
 bool RobotSkin::close()
 {
     bool ok = true;
-    if (!m_tactileSensorDevice.close())
+    if (m_tactileSensorDevice.isValid() && !m_tactileSensorDevice.close())
     {
         yWarning() << m_logPrefix
                    << "Unable to close the tactile sensor analogsensorclient device.";
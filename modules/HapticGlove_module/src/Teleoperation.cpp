@@ -6,6 +6,7 @@
  * @date 2021
  */
 
+#include <ConfigSchema.hpp>
 #include <Logger.hpp>
 #include <Teleoperation.hpp>
 
@@ -20,6 +21,30 @@
 
 using namespace HapticGlove;
 
+namespace
+{
+/// <summary>
+/// Parameters of the teleoperation of a hand.
+/// </summary>
+struct TeleoperationParameters
+{
+    double samplingTime;
+    double calibrationTimePeriod;
+    bool moveRobot;
+    bool useSkin;
+    bool getHumanMotionRange;
+
+    template <typename Visitor> void visit(Visitor& v)
+    {
+        v("samplingTime", samplingTime, 0.1);
+        v("calibrationTimePeriod", calibrationTimePeriod, 10.0);
+        v("enableMoveRobot", moveRobot, true);
+        v("useSkin", useSkin, true);
+        v("getHumanMotionRange", getHumanMotionRange, false);
+    }
+};
+} // namespace
+
 Teleoperation::Teleoperation()
 {
     m_logPrefix = "Teleoperation::";
@@ -29,32 +54,55 @@ Teleoperation::~Teleoperation() = default;
 
 bool Teleoperation::configure(const yarp::os::Searchable& config,
                               const std::string& name,
-                              const bool& rightHand)
+                              const bool& rightHand,
+                              StageProfiler& profiler,
+                              InputSession& inputSession)
 {
     m_logPrefix += rightHand ? "RightHand:: " : "LeftHand:: ";
 
+    // profiler stages
+    const std::string stagePrefix = rightHand ? "right_hand/" : "left_hand/";
+    m_profiler = &profiler;
+    m_runStage = m_profiler->addStage(stagePrefix + "run");
+    m_retargetingStage = m_profiler->addStage(stagePrefix + "retargeting");
+    m_feedbackReadStage = m_profiler->addStage(stagePrefix + "feedback_read");
+    m_estimationStage = m_profiler->addStage(stagePrefix + "kf_estimation");
+    m_controlStage = m_profiler->addStage(stagePrefix + "control");
+    m_hapticFeedbackStage = m_profiler->addStage(stagePrefix + "haptic_feedback");
+    m_outputStage = m_profiler->addStage(stagePrefix + "output");
+    m_feedbackFailuresCounter = m_profiler->addCounter(stagePrefix + "feedback_failures");
+
+    m_inputSession = &inputSession;
+    m_timeStream = m_inputSession->addStream(stagePrefix + "time");
+
     m_robot = name;
 
+    TeleoperationParameters parameters;
+    if (!YarpHelper::parseParameters(config, parameters, m_logPrefix))
+    {
+        yError() << m_logPrefix << "unable to parse the teleoperation parameters.";
+        return false;
+    }
+
     // get the period
-    m_dT = config.check("samplingTime", yarp::os::Value(0.1)).asFloat64();
+    m_dT = parameters.samplingTime;
 
     // check the calibration time period
-    m_calibrationTimePeriod
-        = config.check("calibrationTimePeriod", yarp::os::Value(10.0)).asFloat64();
+    m_calibrationTimePeriod = parameters.calibrationTimePeriod;
     yInfo() << m_logPrefix << "calibration time period: " << m_calibrationTimePeriod;
 
-    m_moveRobot = config.check("enableMoveRobot", yarp::os::Value(1)).asBool();
+    m_moveRobot = parameters.moveRobot;
     yInfo() << m_logPrefix << "move the robot: " << m_moveRobot;
 
-    m_useSkin = config.check("useSkin", yarp::os::Value(1)).asBool();
+    m_useSkin = parameters.useSkin;
     yInfo() << m_logPrefix << "use the robot fingertip skin: " << m_useSkin;
 
     // check if perform calibration phase for geting the user motion range
-    m_getHumanMotionRange = config.check("getHumanMotionRange", yarp::os::Value(0)).asBool();
+    m_getHumanMotionRange = parameters.getHumanMotionRange;
 
     // initialize the robot controller object
     m_robotController = std::make_unique<RobotController>();
-    if (!m_robotController->configure(config, m_robot, rightHand))
+    if (!m_robotController->configure(config, m_robot, rightHand, inputSession))
     {
         yError() << m_logPrefix << "unable to initialize robot controller.";
         return false;
@@ -62,7 +110,7 @@ bool Teleoperation::configure(const yarp::os::Searchable& config,
 
     // intialize the human glove object
     m_humanGlove = std::make_unique<HapticGlove::GloveControlHelper>();
-    if (!m_humanGlove->configure(config, m_robot, rightHand))
+    if (!m_humanGlove->configure(config, m_robot, rightHand, inputSession))
     {
         yError() << m_logPrefix << "unable to initialize the glove control helper.";
         return false;
@@ -116,7 +164,7 @@ bool Teleoperation::configure(const yarp::os::Searchable& config,
     if (m_useSkin)
     {
         m_robotSkin = std::make_unique<HapticGlove::RobotSkin>();
-        if (!m_robotSkin->configure(config, m_robot, rightHand))
+        if (!m_robotSkin->configure(config, m_robot, rightHand, inputSession))
         {
             yError() << m_logPrefix << "unable to configure robot skin class.";
             return false;
@@ -150,12 +198,10 @@ bool Teleoperation::configure(const yarp::os::Searchable& config,
     m_data.robotAxisValueFeedbacksKf.resize(numRobotActuatedAxis, 0.0);
     m_data.robotAxisVelocityFeedbacksKf.resize(numRobotActuatedAxis, 0.0);
     m_data.robotAxisAccelerationFeedbacksKf.resize(numRobotActuatedAxis, 0.0);
-    m_data.robotAxisCovFeedbacksKf = Eigen::MatrixXd::Zero(numRobotActuatedAxis, 9);
 
     m_data.robotAxisValueReferencesKf.resize(numRobotActuatedAxis, 0.0);
     m_data.robotAxisVelocityReferencesKf.resize(numRobotActuatedAxis, 0.0);
     m_data.robotAxisAccelerationReferencesKf.resize(numRobotActuatedAxis, 0.0);
-    m_data.robotAxisCovReferencesKf = Eigen::MatrixXd::Zero(numRobotActuatedAxis, 9);
 
     // human
     m_data.humanJointValues.resize(numHumanHandJoints, 0.0);
@@ -199,14 +245,21 @@ bool Teleoperation::configure(const yarp::os::Searchable& config,
 bool Teleoperation::getFeedbacks()
 {
     // get feedback from the robot left hand values
-    if (!m_robotController->updateFeedback())
     {
-        yWarning() << m_logPrefix << "unable to update the feedback values of the robot.";
+        INSTRUMENTATION_SCOPE(*m_profiler, m_feedbackReadStage);
+        if (!m_robotController->updateFeedback())
+        {
+            INSTRUMENTATION_COUNT(*m_profiler, m_feedbackFailuresCounter);
+            yWarning() << m_logPrefix << "unable to update the feedback values of the robot.";
+        }
     }
 
-    if (!m_robotController->estimateNextStates())
     {
-        yWarning() << m_logPrefix << "unable to perform the estimation.";
+        INSTRUMENTATION_SCOPE(*m_profiler, m_estimationStage);
+        if (!m_robotController->estimateNextStates())
+        {
+            yWarning() << m_logPrefix << "unable to perform the estimation.";
+        }
     }
 
     m_robotController->getAxisValueReferences(m_data.robotAxisReferences);
@@ -221,11 +274,9 @@ bool Teleoperation::getFeedbacks()
     m_robotController->getEstimatedMotorsState(m_data.robotAxisValueFeedbacksKf,
                                                m_data.robotAxisVelocityFeedbacksKf,
                                                m_data.robotAxisAccelerationFeedbacksKf,
-                                               m_data.robotAxisCovFeedbacksKf,
                                                m_data.robotAxisValueReferencesKf,
                                                m_data.robotAxisVelocityReferencesKf,
-                                               m_data.robotAxisAccelerationReferencesKf,
-                                               m_data.robotAxisCovReferencesKf);
+                                               m_data.robotAxisAccelerationReferencesKf);
 
     // get tactile sensors data
     if (m_useSkin)
@@ -237,26 +288,31 @@ bool Teleoperation::getFeedbacks()
 
 bool Teleoperation::run()
 {
+    INSTRUMENTATION_SCOPE(*m_profiler, m_runStage);
 
     // retarget human motion to the robot
-    if (!m_humanGlove->getHandJointAngles(m_data.humanJointValues))
     {
-        yWarning() << m_logPrefix << "unable to get human latest joint angles.";
-    }
+        INSTRUMENTATION_SCOPE(*m_profiler, m_retargetingStage);
+        if (!m_humanGlove->getHandJointAngles(m_data.humanJointValues))
+        {
+            yWarning() << m_logPrefix << "unable to get human latest joint angles.";
+        }
 
-    if (!m_retargeting->retargetHumanMotionToRobot(m_data.humanJointValues))
-    {
-        yWarning() << m_logPrefix << "unable to retaget human motion to robot motions.";
-    }
+        if (!m_retargeting->retargetHumanMotionToRobot(m_data.humanJointValues))
+        {
+            yWarning() << m_logPrefix << "unable to retaget human motion to robot motions.";
+        }
 
-    if (!m_retargeting->getRobotJointReferences(m_data.robotJointReferences))
-    {
-        yWarning() << m_logPrefix << "unable to get the robot joint references from retargeting.";
-    }
+        if (!m_retargeting->getRobotJointReferences(m_data.robotJointReferences))
+        {
+            yWarning() << m_logPrefix
+                       << "unable to get the robot joint references from retargeting.";
+        }
 
-    if (!m_robotController->setJointReferences(m_data.robotJointReferences))
-    {
-        yWarning() << m_logPrefix << "unable to set the joint references to the robot.";
+        if (!m_robotController->setJointReferences(m_data.robotJointReferences))
+        {
+            yWarning() << m_logPrefix << "unable to set the joint references to the robot.";
+        }
     }
 
     // since we have estimators for the references, we put the getFeedback method at this point.
@@ -266,69 +322,78 @@ bool Teleoperation::run()
         yWarning() << m_logPrefix << "unable to get the feedback";
     }
 
-    if (!m_robotController->computeControlSignals())
     {
-        yWarning() << m_logPrefix << "unable to compute the control signals.";
+        INSTRUMENTATION_SCOPE(*m_profiler, m_controlStage);
+        if (!m_robotController->computeControlSignals())
+        {
+            yWarning() << m_logPrefix << "unable to compute the control signals.";
+        }
     }
 
     // compute the haptic feedback
-    if (!m_retargeting->retargetHapticFeedbackFromRobotToHumanUsingKinestheticData(
-            m_data.robotAxisValueReferencesKf,
-            m_data.robotAxisVelocityReferencesKf,
-            m_data.robotAxisValueFeedbacksKf,
-            m_data.robotAxisVelocityFeedbacksKf))
     {
-        yWarning() << m_logPrefix
-                   << "unable to retarget haptic feedback from the robot to the human.";
-    }
-
-    if (m_useSkin)
-    {
-        // since skins may stop working in the middle of an experiment, we check it continuously
-        m_robotSkin->doTactileSensorsWork(m_data.doRobotFingerSkinsWork);
-
-        // check if the fingers are in contact
-        m_robotSkin->areFingersInContact(m_data.areFingersSkinInContact);
-
-        // get the skin data
-        // to delete
-        m_robotSkin->getVibrotactileAbsoluteFeedback(
-            m_data.robotFingerSkinAbsoluteValueVibrotactileFeedbacks);
-
-        //        yInfo() << "tactile absolute: " <<
-        //        m_data.robotFingerSkinAbsoluteValueVibrotactileFeedbacks;
-
-        // to delete
-        m_robotSkin->getVibrotactileDerivativeFeedback(
-            m_data.robotFingerSkinDerivativeValueVibrotactileFeedbacks);
-        //        yInfo() << "tactile derivative: "
-        //                << m_data.robotFingerSkinDerivativeValueVibrotactileFeedbacks;
-
-        m_robotSkin->getVibrotactileTotalFeedback(
-            m_data.robotFingerSkinTotalValueVibrotactileFeedbacks);
-        //        yInfo() << "tactile total: " <<
-        //        m_data.robotFingerSkinTotalValueVibrotactileFeedbacks;
+        INSTRUMENTATION_SCOPE(*m_profiler, m_hapticFeedbackStage);
+        if (!m_retargeting->retargetHapticFeedbackFromRobotToHumanUsingKinestheticData(
+                m_data.robotAxisValueReferencesKf,
+                m_data.robotAxisVelocityReferencesKf,
+                m_data.robotAxisValueFeedbacksKf,
+                m_data.robotAxisVelocityFeedbacksKf))
+        {
+            yWarning() << m_logPrefix
+                       << "unable to retarget haptic feedback from the robot to the human.";
+        }
 
-        // compute haptic feedback with consideration of the skin
-        m_retargeting->retargetHapticFeedbackFromRobotToHumanUsingSkinData(
-            m_data.doRobotFingerSkinsWork,
-            m_data.areFingersSkinInContact,
-            m_data.robotFingerSkinTotalValueVibrotactileFeedbacks);
-    }
+        if (m_useSkin)
+        {
+            // since skins may stop working in the middle of an experiment, we check it
+            // continuously
+            m_robotSkin->doTactileSensorsWork(m_data.doRobotFingerSkinsWork);
+
+            // check if the fingers are in contact
+            m_robotSkin->areFingersInContact(m_data.areFingersSkinInContact);
+
+            // get the skin data
+            // to delete
+            m_robotSkin->getVibrotactileAbsoluteFeedback(
+                m_data.robotFingerSkinAbsoluteValueVibrotactileFeedbacks);
+
+            //        yInfo() << "tactile absolute: " <<
+            //        m_data.robotFingerSkinAbsoluteValueVibrotactileFeedbacks;
+
+            // to delete
+            m_robotSkin->getVibrotactileDerivativeFeedback(
+                m_data.robotFingerSkinDerivativeValueVibrotactileFeedbacks);
+            //        yInfo() << "tactile derivative: "
+            //                << m_data.robotFingerSkinDerivativeValueVibrotactileFeedbacks;
+
+            m_robotSkin->getVibrotactileTotalFeedback(
+                m_data.robotFingerSkinTotalValueVibrotactileFeedbacks);
+            //        yInfo() << "tactile total: " <<
+            //        m_data.robotFingerSkinTotalValueVibrotactileFeedbacks;
+
+            // compute haptic feedback with consideration of the skin
+            m_retargeting->retargetHapticFeedbackFromRobotToHumanUsingSkinData(
+                m_data.doRobotFingerSkinsWork,
+                m_data.areFingersSkinInContact,
+                m_data.robotFingerSkinTotalValueVibrotactileFeedbacks);
+        }
 
-    if (!m_retargeting->getForceFeedbackToHuman(m_data.humanForceFeedbacks))
-    {
-        yWarning() << m_logPrefix << "unable to get the force feedback from retargeting.";
-    }
+        if (!m_retargeting->getForceFeedbackToHuman(m_data.humanForceFeedbacks))
+        {
+            yWarning() << m_logPrefix << "unable to get the force feedback from retargeting.";
+        }
 
-    if (!m_retargeting->getVibrotactileFeedbackToHuman(m_data.humanVibrotactileFeedbacks))
-    {
-        yWarning() << m_logPrefix << "unable to get the vibrotactile feedback from retargeting.";
+        if (!m_retargeting->getVibrotactileFeedbackToHuman(m_data.humanVibrotactileFeedbacks))
+        {
+            yWarning() << m_logPrefix
+                       << "unable to get the vibrotactile feedback from retargeting.";
+        }
     }
 
     // set the values
     if (m_moveRobot)
     {
+        INSTRUMENTATION_SCOPE(*m_profiler, m_outputStage);
         m_robotController->move();
         m_humanGlove->setFingertipForceFeedbackReferences(m_data.humanForceFeedbacks);
         m_humanGlove->setFingertipVibrotactileFeedbackReferences(m_data.humanVibrotactileFeedbacks);
@@ -338,7 +403,9 @@ bool Teleoperation::run()
     {
         if (!m_loggerLeftHand->logData())
         {
-            yWarning() << m_logPrefix << "unable to log the data.";
+            yError() << m_logPrefix << "unable to log the data, the logger is stopped.";
+            m_loggerLeftHand->closeLogger();
+            m_enableLogger = false;
         }
     }
 
@@ -354,7 +421,7 @@ bool Teleoperation::prepare(bool& isPrepared)
         return false;
     }
 
-    double time = yarp::os::Time::now();
+    double time = m_inputSession->time(m_timeStream);
     int dTime = int((time - m_timeConfigurationEnd) / m_dT);
     int CouplingConstant = (int)(m_calibrationTimePeriod / m_dT);
 
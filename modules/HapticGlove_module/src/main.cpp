@@ -12,16 +12,12 @@
 #include <yarp/os/RFModule.h>
 
 #include <HapticGloveModule.hpp>
+#include <InputSession.hpp>
+#include <PeriodicExecutor.hpp>
 
 int main(int argc, char* argv[])
 {
-    // initialise yarp network
     yarp::os::Network yarp;
-    if (!yarp.checkNetwork())
-    {
-        yError() << "[main] Unable to find YARP network";
-        return EXIT_FAILURE;
-    }
 
     // prepare and configure the resource finder
     yarp::os::ResourceFinder& rf = yarp::os::ResourceFinder::getResourceFinderSingleton();
@@ -34,8 +30,19 @@ int main(int argc, char* argv[])
         return EXIT_FAILURE;
     }
 
+    // initialise yarp network. A replayed session does not use the devices, so the ports are
+    // connected in the process and the name server is not needed.
+    if (InputSession::isReplayRequested(rf))
+    {
+        yarp::os::Network::setLocalMode(true);
+    } else if (!yarp.checkNetwork())
+    {
+        yError() << "[main] Unable to find YARP network";
+        return EXIT_FAILURE;
+    }
+
     // create the module
     HapticGloveModule module;
 
-    return module.runModule(rf);
+    return YarpHelper::runModule(module, rf);
 }
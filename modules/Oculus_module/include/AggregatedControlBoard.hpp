@@ -0,0 +1,190 @@
+/**
+ * @file AggregatedControlBoard.hpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+#ifndef AGGREGATED_CONTROL_BOARD_HPP
+#define AGGREGATED_CONTROL_BOARD_HPP
+
+// std
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// YARP
+#include <yarp/dev/IControlLimits.h>
+#include <yarp/dev/IControlMode.h>
+#include <yarp/dev/IEncodersTimed.h>
+#include <yarp/dev/IPositionDirect.h>
+#include <yarp/dev/IVelocityControl.h>
+#include <yarp/dev/PolyDriver.h>
+#include <yarp/dev/PreciselyTimed.h>
+#include <yarp/os/Searchable.h>
+#include <yarp/os/Stamp.h>
+
+/**
+ * AggregatedControlBoard opens a single remotecontrolboardremapper containing the joints of
+ * several robot parts (e.g. the neck and the fingers). The encoders of all the joints are read
+ * with a single call and the references set by the parts are sent together, with a call for the
+ * joints controlled in position direct and a call for the joints controlled in velocity. The
+ * joints of the non mandatory parts (e.g. the fingers) are sent with separate calls, so that the
+ * errors of the robot driver on them are only reported and never stop the module.
+ * The RobotControlHelper objects attached to the board access their joints through the indices
+ * returned by getJointIndices(), so they never communicate with the robot.
+ * setReference() can be called by different threads at the same time if they set different
+ * joints. All the other functions have to be called by a single thread.
+ */
+class AggregatedControlBoard
+{
+    yarp::dev::PolyDriver m_robotDevice; /**< Remapper containing all the joints. */
+
+    std::vector<std::string> m_axesList; /**< Names of the joints. */
+    std::vector<std::string> m_remoteControlBoards; /**< Parts containing the joints. */
+    std::vector<int> m_controlModes; /**< Control mode of each joint. */
+    std::vector<char> m_isJointMandatory; /**< One element per joint. If 0 the errors of the robot
+                                             driver on the joint are neglected. */
+    std::vector<int> m_mandatoryJoints; /**< Joints of the mandatory parts. */
+    std::vector<int> m_optionalJoints; /**< Joints of the non mandatory parts. */
+    std::size_t m_optionalJointErrors{0}; /**< Number of errors neglected on the optional joints. */
+
+    yarp::dev::IPreciselyTimed* m_timedInterface{nullptr};
+    yarp::dev::IEncodersTimed* m_encodersInterface{nullptr}; /**< Encoders interface. */
+    yarp::dev::IPositionDirect* m_positionDirectInterface{nullptr}; /**< Direct position control
+                                                                       interface. */
+    yarp::dev::IVelocityControl* m_velocityInterface{nullptr}; /**< Velocity control interface. */
+    yarp::dev::IControlMode* m_controlModeInterface{nullptr}; /**< Control mode interface. */
+    yarp::dev::IControlLimits* m_limitsInterface{nullptr}; /**< Limits interface. */
+
+    std::vector<double> m_encoders; /**< Joint positions [deg]. */
+    std::vector<double> m_encoderTimeStamps; /**< Time stamps of the joint positions [s]. */
+    std::vector<double> m_references; /**< Joint references [deg or deg/s]. */
+    std::vector<char> m_isReferenceUpdated; /**< One element per joint (a std::vector<bool>
+                                               cannot be written by different threads). */
+
+    /**
+     * Joints whose references are sent with a single call.
+     */
+    struct ReferenceBatch
+    {
+        std::vector<int> joints; /**< Indices of the joints. */
+        std::vector<double> references; /**< References of the joints. */
+        int size{0}; /**< Number of joints sent in the current cycle. */
+    };
+
+    ReferenceBatch m_positionBatch; /**< Mandatory joints sent in position direct. */
+    ReferenceBatch m_velocityBatch; /**< Mandatory joints sent in velocity. */
+    ReferenceBatch m_optionalPositionBatch; /**< Optional joints sent in position direct. */
+    ReferenceBatch m_optionalVelocityBatch; /**< Optional joints sent in velocity. */
+
+    /**
+     * Switch all the joints to a control mode.
+     * @param controlModes control mode of each joint.
+     * @return false if the control mode of a mandatory joint cannot be set.
+     */
+    bool switchToControlModes(const std::vector<int>& controlModes);
+
+    /**
+     * Send the references of a batch.
+     * @param batch joints and references;
+     * @param controlMode control mode of the joints of the batch.
+     * @return true / false in case of success / failure
+     */
+    bool sendReferences(const ReferenceBatch& batch, int controlMode);
+
+    /**
+     * Report an error of the robot driver on the optional joints. Only the first error is
+     * printed, the number of errors is printed by close().
+     * @param message description of the error.
+     */
+    void reportOptionalJointError(const char* message);
+
+public:
+    /**
+     * Add the joints of a robot part. It has to be called before open(). The following
+     * parameters are read from the configuration object:
+     * - remote_control_boards: list of the control boards containing the joints;
+     * - joints_list: list of the joints;
+     * - useVelocity: if true the joints are controlled in velocity, otherwise in position
+     *   direct (optional, default false).
+     * @param config configuration of the part;
+     * @param isMandatory if true the errors of the robot driver on the joints of the part are not
+     * neglected.
+     * @return true / false in case of success / failure
+     */
+    bool addPart(const yarp::os::Searchable& config, bool isMandatory);
+
+    /**
+     * Open the remapper and switch the joints to their control mode.
+     * @param robot name of the robot;
+     * @param name name of the module.
+     * @return true / false in case of success / failure
+     */
+    bool open(const std::string& robot, const std::string& name);
+
+    /**
+     * Get the indices of some joints in the board.
+     * @param axesList names of the joints;
+     * @param indices indices of the joints.
+     * @return false if a joint is not part of the board.
+     */
+    bool getJointIndices(const std::vector<std::string>& axesList,
+                         std::vector<int>& indices) const;
+
+    /**
+     * Read the encoders of all the joints.
+     * @return false if the encoders of a mandatory joint cannot be read.
+     */
+    bool readEncoders();
+
+    /**
+     * Get the position of a joint read by the last readEncoders().
+     * @param index index of the joint.
+     * @return the position [deg].
+     */
+    double encoder(int index) const;
+
+    /**
+     * Get the time stamp of the position of a joint read by the last readEncoders().
+     * @param index index of the joint.
+     * @return the time stamp [s].
+     */
+    double encoderTimeStamp(int index) const;
+
+    /**
+     * Get the limits of a joint.
+     * @param index index of the joint;
+     * @param minLimitInDegree lower limit;
+     * @param maxLimitInDegree upper limit.
+     * @return true / false in case of success / failure
+     */
+    bool getLimits(int index, double& minLimitInDegree, double& maxLimitInDegree);
+
+    /**
+     * Set the reference of a joint. It is sent by the next writeReferences().
+     * @param index index of the joint;
+     * @param reference position [deg] or velocity [deg/s] reference.
+     */
+    void setReference(int index, double reference);
+
+    /**
+     * Send the references set since the previous call.
+     * @return false if the references of the mandatory joints cannot be sent.
+     */
+    bool writeReferences();
+
+    /**
+     * Get the time stamp of the last input of the robot.
+     * @return the time stamp.
+     */
+    yarp::os::Stamp lastInputStamp();
+
+    /**
+     * Switch the joints to position control and close the remapper.
+     */
+    void close();
+};
+
+#endif
@@ -51,7 +51,8 @@ public:
     bool setFingersVelocity(const double& fingersVelocity);
 
     /**
-     * Get the fingers velocities or values
+     * Get the fingers velocities or values. The vector is resized only if it has a different
+     * size.
      * @param fingerValue get the finger velocity or value
      */
     void getFingerValues(std::vector<double>& fingerValues);
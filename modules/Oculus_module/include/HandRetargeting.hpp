@@ -13,12 +13,16 @@
 // std
 #include <vector>
 
+// Eigen
+#include <Eigen/Dense>
+
 // YARP
 #include <yarp/sig/Matrix.h>
 #include <yarp/sig/Vector.h>
 
 // iDynTree
-#include <iDynTree/Core/Transform.h>
+#include <iDynTree/Core/Position.h>
+#include <iDynTree/Core/Rotation.h>
 
 /**
  * HandRetargeing manages the retargeting of the hand.
@@ -27,6 +31,16 @@
  */
 class HandRetargeting
 {
+public:
+    /**
+     * Representation of the desired hand pose sent to the walking controller.
+     */
+    enum class HandPoseRepresentation
+    {
+        RollPitchYaw, /**< Position and roll pitch yaw angles (6 elements). */
+        Quaternion /**< Position and unit quaternion (w x y z) (7 elements). */
+    };
+
 private:
     // In order to understand the transform defined the following frames has to be defined
     // oculusInertial frame: it is the inertial frame of the oculus and it is placed in the
@@ -39,30 +53,72 @@ private:
     // handRobot frame: frame attached to the robot hand.
     // teleopRobot frame: attached to the robot w.r.t the desired handRobot pose is
     //                    evaluated
+    // All the transforms are stored as a rotation matrix and a position vector.
 
-    /** Transform between the inertial oculus frame and the teleoperation frame (This transform
+    /** Player orientation (coming from the virtualizer) used to evaluate the teleoperation frame
+     */
+    double m_playerOrientation{0};
+
+    /** Position of the teleoperation frame expressed in the inertial oculus frame */
+    Eigen::Vector3d m_oculusInertial_p_teleopFrame{Eigen::Vector3d::Zero()};
+
+    /** Rotation between the inertial oculus frame and the teleoperation frame (This rotation
      * depends on the virtualizer angle) */
-    iDynTree::Transform m_oculusInertial_T_teleopFrame;
+    Eigen::Matrix3d m_oculusInertial_R_teleopFrame{Eigen::Matrix3d::Identity()};
 
     /** Transform between the inertial oculus frame and the hand frame */
-    iDynTree::Transform m_oculusInertial_T_handOculusFrame;
+    Eigen::Matrix3d m_oculusInertial_R_handOculusFrame{Eigen::Matrix3d::Identity()};
+    Eigen::Vector3d m_oculusInertial_p_handOculusFrame{Eigen::Vector3d::Zero()};
 
-    /** Mapping between the hand oculus frame and the hand robot frame */
-    iDynTree::Transform m_handOculusFrame_T_handRobotFrame;
+    /** Mapping between the hand oculus frame and the hand robot frame (the frames have the same
+     * origin) */
+    Eigen::Matrix3d m_handOculusFrame_R_handRobotFrame{Eigen::Matrix3d::Identity()};
 
     /** Mapping between the teleoperation frame and the robot teleoperation frame. (Notice that the
      * robot teleoperation frame is in this specific case the "imu_frame". You can use a different
-     * frame but it has to be cooerent with one chosen in th walking-controller) */
-    iDynTree::Transform m_teleopRobotFrame_T_teleopFrame;
+     * frame but it has to be cooerent with one chosen in th walking-controller). The frames have
+     * the same origin */
+    Eigen::Matrix3d m_teleopRobotFrame_R_teleopFrame{Eigen::Matrix3d::Identity()};
+
+    /** Transform between the teleoperation robot frame and the inertial oculus frame. It is
+     * evaluated only when the player orientation or position change */
+    Eigen::Matrix3d m_teleopRobotFrame_R_oculusInertial{Eigen::Matrix3d::Identity()};
+    Eigen::Vector3d m_teleopRobotFrame_p_oculusInertial{Eigen::Vector3d::Zero()};
+    bool m_isTeleopRobotFrameUpdated{false}; /**< True if the cached transform is up to date */
 
     /** Desired tranformation between the teleoperation robot frame and the hand robot frame */
-    iDynTree::Transform m_teleopRobotFrame_T_handRobotFrame;
+    Eigen::Matrix3d m_teleopRobotFrame_R_handRobotFrame{Eigen::Matrix3d::Identity()};
+    Eigen::Vector3d m_teleopRobotFrame_p_handRobotFrame{Eigen::Vector3d::Zero()};
 
     double m_scalingFactor; /**< Scaling factor */
 
+    /** Representation of the desired hand pose */
+    HandPoseRepresentation m_handPoseRepresentation{HandPoseRepresentation::RollPitchYaw};
+
+    /** Last quaternion sent (w x y z), used to keep the quaternions in the same hemisphere */
+    Eigen::Matrix<double, 4, 1, Eigen::DontAlign> m_previousQuaternion{1, 0, 0, 0};
+
+    iDynTree::Rotation m_rotationBuffer; /**< Buffer used to evaluate the roll pitch yaw angles */
+
+    /**
+     * Update the transform between the teleoperation robot frame and the inertial oculus frame.
+     */
+    void updateTeleopRobotFrame();
+
+    /**
+     * Write a pose in a vector (position and roll pitch yaw angles).
+     * @param position the position;
+     * @param rotation the rotation matrix;
+     * @param pose the pose (the vector is resized only if it has a different size).
+     */
+    template <typename T>
+    void writePose(const Eigen::Vector3d& position, const Eigen::Matrix3d& rotation, T& pose);
+
 public:
     /**
      * Configure the hand retargeting.
+     * The parameter handPoseRepresentation ("rpy" (default) or "quaternion") selects the
+     * representation of the desired hand pose.
      * @param config reference to a resource finder object.
      * @return true in case of success and false otherwise
      */
@@ -89,13 +145,15 @@ public:
     /**
      * Evaluate the desired hand pose tacking into account the relative transformation between the
      * user and the virtualizer (if it is used)
-     * @param handPose desired hand position. This can be directly sent to walking controller.
+     * @param handPose desired hand pose in the representation chosen in the configuration (the
+     * vector is resized only if it has a different size). This can be directly sent to walking
+     * controller.
      */
     void evaluateDesiredHandPose(yarp::sig::Vector& handPose);
 
     /**
-     * Get the hand information
-     * user and the virtualizer (if it is used)
+     * Get the hand information (position and roll pitch yaw angles). The vectors are resized
+     * only if they have a different size.
      * @param robotHandpose_robotTel robot hand pose wrt to robot teleoperation frame.
      * @param humanHandpose_oculusInertial human hand pose wrt to oculus inertial frame
      * @param humanHandpose_humanTel human hand pose wrt to human teleoperation frame
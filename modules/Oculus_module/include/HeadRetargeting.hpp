@@ -22,6 +22,8 @@
 // iDynTree
 #include <iDynTree/Core/Rotation.h>
 
+#include <OrientationPredictor.hpp>
+#include <OrientationSmoother.hpp>
 #include <RetargetingController.hpp>
 
 /**
@@ -33,10 +35,6 @@ private:
     struct Impl;
     std::unique_ptr<Impl> pImpl;
 
-    /** Minimum jerk trajectory smoother for the desired head joints */
-    std::unique_ptr<iCub::ctrl::minJerkTrajGen> m_headTrajectorySmoother{nullptr};
-    yarp::sig::Vector m_desiredNeckJointsBeforeSmoothing;
-
     // In order to understand the transform defined the following frames has to be defined
     // oculusInertial frame: it is the inertial frame of the oculus and it is placed in the
     //                       initial position of the ovrheadset. The z axis points upward while
@@ -50,6 +48,29 @@ private:
 
     double m_playerOrientation{0};
 
+    OrientationPredictor m_headPredictor; /**< Predictor of the headset orientation */
+    bool m_usePrediction{false}; /**< True if the headset orientation is predicted */
+    Eigen::Matrix3d m_headOrientationBuffer; /**< Buffer used by the predictor */
+
+    OrientationSmoother m_headSmoother; /**< Smoother of the desired head orientation */
+    Eigen::Matrix3d m_desiredHeadOrientationBuffer; /**< Buffer used by the smoother */
+
+    /**
+     * Predict the headset orientation (if the prediction is enabled) to compensate the delay
+     * between the operator and the robot.
+     */
+    void predictHeadOrientation();
+
+    /**
+     * Smooth the desired head orientation (in the teleoperation frame) before evaluating the
+     * inverse kinematics
+     */
+    void smoothHeadOrientation();
+
+public:
+    HeadRetargeting();
+    ~HeadRetargeting() override;
+
     /**
      * Evaluate the inverse kinematics of the head
      * Further details on the joints name can be found in
@@ -64,6 +85,13 @@ private:
                                   double& neckRoll,
                                   double& neckYaw);
 
+    /**
+     * Evaluate the inverse kinematics of the head using the XZY Euler angles (OpenXR headsets).
+     * @param chest_R_head is the rotation matrix of the head with respect the chest frame
+     * @param neckPitch neck pitch angle expressed in radiant
+     * @param neckRoll neck roll angle expressed in radiant
+     * @param neckYaw neck yaw angle expressed in radiant
+     */
     static void inverseKinematicsXZY(const iDynTree::Rotation& chest_R_head,
                                      double& neckPitch,
                                      double& neckRoll,
@@ -81,15 +109,6 @@ private:
     static iDynTree::Rotation
     forwardKinematics(const double& neckPitch, const double& neckRoll, const double& neckYaw);
 
-    /**
-     * Smooth the neck joints before sending them to the robot
-     */
-    void smoothNeckJointValues();
-
-public:
-    HeadRetargeting();
-    ~HeadRetargeting() override;
-
     /**
      * Configure the object.
      * @param config is the reference to a resource finder object.
@@ -137,6 +156,26 @@ public:
      */
     void getNeckJointValues(yarp::sig::Vector& neckValues);
 
+    /**
+     * Get the errors of the headset orientation prediction.
+     * @param predictionError angle between the last sample and its prediction in radians;
+     * @param baselineError angle between the last sample and the sample received one prediction
+     * horizon earlier in radians (i.e. the error without prediction).
+     */
+    void getPredictionErrors(double& predictionError, double& baselineError) const;
+
+    /**
+     * Get the predictor of the headset orientation.
+     * @return the predictor.
+     */
+    const OrientationPredictor& headPredictor() const;
+
+    /**
+     * Check if the headset orientation is predicted.
+     * @return true if the prediction is enabled.
+     */
+    bool isPredictionUsed() const;
+
     /**
      * Move the neck joints according to the desired joint values
      * @return true in case of success and false otherwise
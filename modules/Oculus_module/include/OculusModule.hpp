@@ -11,6 +11,7 @@
 #define OCULUS_MODULE_HPP
 
 // std
+#include <bitset>
 #include <ctime>
 #include <memory>
 #include <mutex>
@@ -26,16 +27,22 @@
 #include <yarp/os/RpcServer.h>
 #include <yarp/sig/Vector.h>
 
+#include <AggregatedControlBoard.hpp>
 #include <FingersRetargeting.hpp>
+#include <GoalChannel.hpp>
 #include <HandRetargeting.hpp>
 #include <HeadRetargeting.hpp>
+#include <InputSession.hpp>
+#include <Instrumentation.hpp>
+#include <JoypadSampler.hpp>
+#include <LockFree.hpp>
+#include <RateScheduler.hpp>
+#include <SessionRecorder.hpp>
+#include <TaskPool.hpp>
+#include <TransformSnapshot.hpp>
 
 #include <thrifts/TeleoperationCommands.h>
 
-#ifdef ENABLE_LOGGER
-#include <matlogger2/matlogger2.h>
-#include <matlogger2/utils/mat_appender.h>
-#endif
 
 /**
  * OculusModule is the main core of the Oculus application. It is goal is to evaluate retrieve the
@@ -100,9 +107,22 @@ private:
         m_leftHandFrameName; /**< Name of the left hand frame used in the transform server */
     std::string
         m_rightHandFrameName; /**< Name of the right hand frame used in the transform server */
+    TransformSnapshot m_transformSnapshot; /**< Transforms read from the transform server. */
+    bool m_isHeadFrameStreamed{false}; /**< True if the head frame is in the transform snapshot */
+    std::size_t m_headFrameIndex{TransformSnapshot::maxFrames}; /**< Index of the head frame in
+                                                                   the transform snapshot */
+    std::size_t m_leftHandFrameIndex{TransformSnapshot::maxFrames}; /**< Index of the left hand
+                                                                       frame in the snapshot */
+    std::size_t m_rightHandFrameIndex{TransformSnapshot::maxFrames}; /**< Index of the right hand
+                                                                        frame in the snapshot */
 
     yarp::dev::PolyDriver m_joypadDevice; /**< Joypad polydriver. */
     yarp::dev::IJoypadController* m_joypadControllerInterface{nullptr}; /**< joypad interface. */
+    JoypadSampler m_joypadSampler; /**< Thread reading the joypad (if enabled). */
+    bool m_useJoypadSampler{false}; /**< True if the joypad is read by the sampler thread. */
+    JoypadSampler::Snapshot m_joypadSnapshot; /**< Joypad values read in the current cycle. */
+    std::bitset<JoypadSampler::maxButtons> m_pressedJoypadButtons; /**< Buttons pressed since
+                                                                      the previous cycle. */
 
     std::unique_ptr<HeadRetargeting> m_head; /**< Pointer to the head retargeting object. */
     std::unique_ptr<FingersRetargeting> m_leftHandFingers; /**< Pointer to the left
@@ -114,6 +134,10 @@ private:
     std::unique_ptr<HandRetargeting> m_leftHand; /**< Pointer to the left hand
                                                     retargeting object. */
 
+    AggregatedControlBoard m_controlBoard; /**< Joints of the head and of the fingers. */
+    bool m_useAggregatedControlBoard{false}; /**< True if the head and the fingers share the
+                                                control board. */
+
     // ports
     yarp::os::BufferedPort<yarp::sig::Vector> m_leftHandPosePort; /**< Left hand port pose. */
     yarp::os::BufferedPort<yarp::sig::Vector> m_rightHandPosePort; /**< Right hand port pose. */
@@ -124,6 +148,10 @@ private:
     yarp::os::BufferedPort<yarp::os::Bottle> m_imagesOrientationPort;
     /** Port used to retrieve the robot base orientation. */
     yarp::os::BufferedPort<yarp::sig::Vector> m_robotOrientationPort;
+    /** Latest player orientation received by the port thread. */
+    LockFree::PortMailbox<yarp::sig::Vector> m_playerOrientationMailbox;
+    /** Latest robot base orientation received by the port thread. */
+    LockFree::PortMailbox<yarp::sig::Vector> m_robotOrientationMailbox;
     /** Port used to retrieve the headset oculus orientation. */
     yarp::os::BufferedPort<yarp::os::Bottle> m_oculusOrientationPort;
     /** Port used to retrieve the headset oculus position. */
@@ -131,6 +159,9 @@ private:
 
     yarp::os::RpcClient m_rpcWalkingClient; /**< Rpc client used for sending command to the walking
                                                controller */
+    GoalChannel::Publisher m_goalPublisher; /**< Publisher of the goal of the walking
+                                               controller */
+    bool m_useGoalStreaming; /**< True if the goal is streamed instead of sent through the RPC */
     yarp::os::RpcClient
         m_rpcVirtualizerClient; /**< Rpc client used for sending command to the virtualizer */
 
@@ -155,11 +186,88 @@ private:
 
     std::mutex m_mutex; /**< Mutex. */
 
-#ifdef ENABLE_LOGGER
-    XBot::MatLogger2::Ptr m_logger; /**< */
-    XBot::MatAppender::Ptr m_appender;
+    RateScheduler m_scheduler; /**< Decides which subsystems run in the current cycle. */
+    std::size_t m_headSubsystem; /**< Index of the head in the scheduler. */
+    std::size_t m_handsSubsystem; /**< Index of the hands in the scheduler. */
+    std::size_t m_fingersSubsystem; /**< Index of the fingers in the scheduler. */
+    std::size_t m_locomotionSubsystem; /**< Index of the locomotion in the scheduler. */
+
+    TaskPool m_limbsPool; /**< Tasks retargeting the head, the hands and the fingers. */
+    double m_leftFingersVelocity{0}; /**< Desired velocity of the left fingers. */
+    double m_rightFingersVelocity{0}; /**< Desired velocity of the right fingers. */
+    bool m_updateTeleopPosition{false}; /**< True if the hands have to update the teleoperation
+                                           frame position the next time they run. */
+
+    StageProfiler m_profiler; /**< Profiler of the stages of the update module. */
+    std::size_t m_updateModuleStage; /**< Index of the stage of the whole update module. */
+    std::size_t m_feedbackReadStage; /**< Index of the stage of the feedback reading. */
+    std::size_t m_transformsReadStage; /**< Index of the stage of the transforms reading. */
+    std::size_t m_headRetargetingStage; /**< Index of the stage of the head retargeting. */
+    std::size_t m_limbsRetargetingStage; /**< Index of the stage of the limbs retargeting. */
+    std::size_t m_leftHandRetargetingStage; /**< Index of the stage of the left hand. */
+    std::size_t m_rightHandRetargetingStage; /**< Index of the stage of the right hand. */
+    std::size_t m_locomotionCommandStage; /**< Index of the stage of the walking command. */
+    std::size_t m_fingersRetargetingStage; /**< Index of the stage of the fingers retargeting. */
+    std::size_t m_loggingStage; /**< Index of the stage of the data logging. */
+
+    InputSession m_inputSession; /**< Record or replay of the inputs of the module. */
+    InputSession::Stream m_headTransformStream; /**< Transform of the headset. */
+    InputSession::Stream m_leftHandTransformStream; /**< Transform of the left controller. */
+    InputSession::Stream m_rightHandTransformStream; /**< Transform of the right controller. */
+    InputSession::Stream m_oculusOrientationStream; /**< Headset orientation port. */
+    InputSession::Stream m_oculusPositionStream; /**< Headset position port. */
+    InputSession::Stream m_playerOrientationStream; /**< Player orientation port. */
+    InputSession::Stream m_robotOrientationStream; /**< Robot base orientation port. */
+    InputSession::Stream m_joypadAxisStream; /**< Joypad axes, in the order they are read. */
+    InputSession::Stream m_joypadButtonStream; /**< Joypad buttons, in the order they are read. */
+    InputSession::Stream m_commandStream; /**< Commands received through the RPC port. */
+    InputSession::Stream m_timeStream; /**< Time of the logged cycle. */
+    yarp::sig::Vector m_headsetPortValues; /**< Values read from the headset ports. */
+
+    SessionRecorder m_recorder; /**< Binary recorder of the session. */
     std::string m_logger_prefix{"oculus"};
-#endif
+
+    /**
+     * Handles of the recorder channels, resolved when the logger is opened.
+     */
+    struct LoggerChannels
+    {
+        SessionRecorder::Channel time;
+        SessionRecorder::Channel playerOrientation;
+        SessionRecorder::Channel robotYaw;
+        SessionRecorder::Channel neckJointValues;
+        SessionRecorder::Channel neckFeedbackAge;
+        SessionRecorder::Channel leftFingerValues;
+        SessionRecorder::Channel rightFingerValues;
+        SessionRecorder::Channel leftRobotHandposeRobotTeleoperation;
+        SessionRecorder::Channel leftHumanHandposeOculusInertial;
+        SessionRecorder::Channel leftHumanHandposeHumanTeleoperation;
+        SessionRecorder::Channel rightRobotHandposeRobotTeleoperation;
+        SessionRecorder::Channel rightHumanHandposeOculusInertial;
+        SessionRecorder::Channel rightHumanHandposeHumanTeleoperation;
+        SessionRecorder::Channel oculusHeadsetInertial;
+        SessionRecorder::Channel headPredictionError;
+        SessionRecorder::Channel locomotionJoypad;
+    };
+    LoggerChannels m_loggerChannels; /**< Handles of the recorder channels. */
+
+    /**
+     * Buffers of the logged values, allocated when the logger is opened.
+     */
+    struct LoggerBuffers
+    {
+        std::vector<double> leftFingerValues;
+        std::vector<double> rightFingerValues;
+        std::vector<double> leftRobotHandposeRobotTeleoperation;
+        std::vector<double> leftHumanHandposeOculusInertial;
+        std::vector<double> leftHumanHandposeHumanTeleoperation;
+        std::vector<double> rightRobotHandposeRobotTeleoperation;
+        std::vector<double> rightHumanHandposeOculusInertial;
+        std::vector<double> rightHumanHandposeHumanTeleoperation;
+        std::vector<double> headPredictionErrors{0, 0};
+        std::vector<double> locomotionJoypad{0, 0};
+    };
+    LoggerBuffers m_loggerBuffers; /**< Buffers of the logged values. */
     /**
      * Configure the Oculus.
      * @param config configuration object
@@ -167,6 +275,14 @@ private:
      */
     bool configureOculus(const yarp::os::Searchable& config);
 
+    /**
+     * Open a single control board containing the joints of the head and of the fingers. Its
+     * encoders are read once per cycle and the references of all the parts are sent together.
+     * @param rf resource finder containing the configuration of the parts
+     * @return true in case of success and false otherwise.
+     */
+    bool configureControlBoard(yarp::os::ResourceFinder& rf);
+
     /**
      * Configure the Tranformation Client.
      * @param config configuration object
@@ -209,12 +325,106 @@ private:
      */
     double evaluateDesiredFingersVelocity(unsigned int squeezeIndex, unsigned int releaseIndex);
 
+    /**
+     * Configure the scheduler of the subsystems (head, hands, fingers and locomotion). Each
+     * subsystem runs every <subsystem>RateDivisor cycles (optional, default 1), e.g.
+     * headRateDivisor, handsRateDivisor, fingersRateDivisor and locomotionRateDivisor.
+     * @param config configuration object
+     * @return true in case of success and false otherwise.
+     */
+    bool configureScheduler(const yarp::os::Searchable& config);
+
+    /**
+     * Configure the tasks retargeting the limbs. The following parameters are read from the
+     * configuration object:
+     * - enableParallelLimbs: if true the limbs are retargeted in parallel (optional, default
+     *   false);
+     * - limbsThreads: number of worker threads used in parallel (optional, default 3).
+     * @param config configuration object
+     * @return true in case of success and false otherwise.
+     */
+    bool configureLimbsPool(const yarp::os::Searchable& config);
+
+    /**
+     * Retarget the head (task of the limbs pool).
+     * @return true in case of success and false otherwise.
+     */
+    bool retargetHead();
+
+    /**
+     * Retarget a hand (task of the limbs pool).
+     * @param hand the hand retargeting object;
+     * @param handPosePort port used to send the desired hand pose;
+     * @param oculusRoot_T_handOculus transform of the oculus joypad.
+     * @return true in case of success and false otherwise.
+     */
+    bool retargetHand(HandRetargeting& hand,
+                      yarp::os::BufferedPort<yarp::sig::Vector>& handPosePort,
+                      const yarp::sig::Matrix& oculusRoot_T_handOculus);
+
+    /**
+     * Retarget the fingers (task of the limbs pool).
+     * @return true in case of success and false otherwise.
+     */
+    bool retargetFingers();
+
     /**
      * Get the transformation from the transform server
      * @return true in case of success and false otherwise.
      */
     bool getTransforms();
 
+    /**
+     * Read (or replay) the transformation between a frame and the root frame. The transformation
+     * is taken from the transform snapshot updated by getTransforms().
+     * @param frameIndex index of the frame in the transform snapshot;
+     * @param stream stream of the input session associated to the frame;
+     * @param transform root_T_frame homogeneous transformation.
+     * @return true in case of success and false otherwise.
+     */
+    bool readTransform(const std::size_t& frameIndex,
+                       const InputSession::Stream& stream,
+                       yarp::sig::Matrix& transform);
+
+    /**
+     * Read (or replay) the values streamed by the headset on a port.
+     * @param port the port;
+     * @param stream stream of the input session associated to the port;
+     * @param values values read from the port.
+     * @return true if new values are available and false otherwise.
+     */
+    bool readHeadsetPort(yarp::os::BufferedPort<yarp::os::Bottle>& port,
+                         const InputSession::Stream& stream,
+                         yarp::sig::Vector& values);
+
+    /**
+     * Get the values of the joypad sampled since the previous cycle. It has to be called once
+     * per cycle, before reading the axes and the buttons.
+     */
+    void readJoypadSampler();
+
+    /**
+     * Read (or replay) the value of a joypad axis.
+     * @param index index of the axis;
+     * @param value value of the axis (not changed if the axis cannot be read).
+     * @return true in case of success and false otherwise.
+     */
+    bool getJoypadAxis(unsigned int index, double& value);
+
+    /**
+     * Read (or replay) the value of a joypad button. If the joypad is read by the sampler thread,
+     * a button pressed and released since the previous cycle has value 1.
+     * @param index index of the button;
+     * @param value value of the button (not changed if the button cannot be read).
+     * @return true in case of success and false otherwise.
+     */
+    bool getJoypadButton(unsigned int index, float& value);
+
+    /**
+     * Apply the commands received through the RPC port in the replayed cycle.
+     */
+    void replayCommands();
+
     /**
      * Open the logger
      * @return true if it could open the logger
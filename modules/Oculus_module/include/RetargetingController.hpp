@@ -29,7 +29,28 @@ protected:
     std::unique_ptr<RobotControlHelper> m_controlHelper; /**< Controller helper */
     yarp::sig::Vector m_desiredJointValue; /** Desired joint value in radiant or radiant/s  */
 
+    InputSession* m_inputSession{nullptr}; /**< Session used to record or replay the feedback. */
+    std::string m_inputStreamPrefix; /**< Prefix of the streams in the session. */
+
+    AggregatedControlBoard* m_controlBoard{nullptr}; /**< Board shared with other parts. */
+
 public:
+    /**
+     * Set the session used to record or replay the feedback of the robot. It has to be called
+     * before configure().
+     * @param inputSession the session.
+     * @param streamPrefix prefix of the names of the streams in the session.
+     */
+    void setInputSession(InputSession& inputSession, const std::string& streamPrefix);
+
+    /**
+     * Set the board containing the joints of this part and of the other parts. The board has to
+     * be opened before calling configure() and its owner reads the encoders and sends the
+     * references.
+     * @param controlBoard the board.
+     */
+    void setControlBoard(AggregatedControlBoard& controlBoard);
+
     /**
      * Configure the object.
      * @param config is the reference to a resource finder object.
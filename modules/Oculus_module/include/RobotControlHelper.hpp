@@ -10,6 +10,7 @@
 #define ROBOT_CONTROL_HELPER_HPP
 
 // std
+#include <cstddef>
 #include <memory>
 
 // YARP
@@ -25,6 +26,9 @@
 #include <yarp/os/Bottle.h>
 #include <yarp/sig/Vector.h>
 
+#include <AggregatedControlBoard.hpp>
+#include <InputSession.hpp>
+
 /**
  * RobotControlHelper is an helper class for controlling the robot.
  */
@@ -49,12 +53,47 @@ class RobotControlHelper
     yarp::sig::Vector m_desiredJointValue; /**< Desired joint value [deg or deg/s]. */
     yarp::sig::Vector m_positionFeedbackInDegrees; /**< Joint position [deg]. */
     yarp::sig::Vector m_positionFeedbackInRadians; /**< Joint position [rad]. */
+    yarp::sig::Vector m_encoderTimeStamps; /**< Time stamp of each joint position [s]. */
+    double m_feedbackTime; /**< Time stamp of the newest joint position [s]. */
+    bool m_isFeedbackNew{false}; /**< True if the last read returned new joint positions. */
+    std::size_t m_numberOfReads{0}; /**< Number of feedback reads. */
+    std::size_t m_numberOfStaleReads{0}; /**< Number of reads without new joint positions. */
     yarp::os::Stamp m_timeStamp; /**< Time stamp. */
 
     bool m_isMandatory; /**< If false neglect the errors coming from the robot driver. */
 
     yarp::conf::vocab32_t m_controlMode; /**< Used control mode. */
 
+    InputSession* m_inputSession{nullptr}; /**< Session used to record or replay the feedback. */
+    InputSession::Stream m_encodersStream; /**< Stream of the encoders. */
+    InputSession::Stream m_limitsStream; /**< Stream of the joint limits. */
+    InputSession::Stream m_encoderTimeStampsStream; /**< Stream of the encoders time stamps. */
+
+    AggregatedControlBoard* m_controlBoard{nullptr}; /**< Board shared with other helpers. */
+    std::vector<int> m_boardIndices; /**< Indices of the joints in the shared board. */
+
+    /**
+     * Check if the feedback is replayed. In this case the robot device is not opened.
+     * @return true if the feedback is replayed.
+     */
+    bool isReplaying() const;
+
+    /**
+     * Read the encoders and their time stamps (or replay them) in m_positionFeedbackInDegrees
+     * and m_encoderTimeStamps.
+     * @return true / false in case of success / failure
+     */
+    bool readEncoders();
+
+    /**
+     * Read (or replay) the limits of a joint.
+     * @param joint index of the joint;
+     * @param minLimitInDegree lower limit;
+     * @param maxLimitInDegree upper limit.
+     * @return true / false in case of success / failure
+     */
+    bool readLimits(int joint, double& minLimitInDegree, double& maxLimitInDegree);
+
     /**
      * Switch to control mode
      * @param controlMode is the specific control mode
@@ -90,9 +129,19 @@ public:
      * @param name name of the robot
      * @param isMandatory if true the helper will return an error if there is a
      * problem in the configuration phase
+     * @param inputSession session used to record or replay the feedback (it can be nullptr)
+     * @param streamPrefix prefix of the names of the streams in the session
+     * @param controlBoard opened board containing the joints of the helper (it can be nullptr).
+     * If it is used the helper does not open its own device: the encoders are read and the
+     * references are sent by the owner of the board.
      * @return true / false in case of success / failure
      */
-    bool configure(const yarp::os::Searchable& config, const std::string& name, bool isMandatory);
+    bool configure(const yarp::os::Searchable& config,
+                   const std::string& name,
+                   bool isMandatory,
+                   InputSession* inputSession = nullptr,
+                   const std::string& streamPrefix = "",
+                   AggregatedControlBoard* controlBoard = nullptr);
 
     /**
      * Update the time stamp
@@ -113,11 +162,45 @@ public:
     bool isVelocityControlUsed();
 
     /**
-     * Get feedback from the robot
+     * Get feedback from the robot. The joint positions are converted in radians only if at
+     * least one of them is newer than the previous read, otherwise the read is counted as stale.
+     * The time stamp of the helper is updated with the time of the newest joint position.
      * @return true / false in case of success / failure
      */
     bool getFeedback();
 
+    /**
+     * Check if the last getFeedback() returned new joint positions.
+     * @return true if at least one joint position is newer than the previous read.
+     */
+    bool isFeedbackNew() const;
+
+    /**
+     * Get the age of the feedback, i.e. the time elapsed since the newest joint position was
+     * measured.
+     * @param now current time in seconds (same clock of the robot, i.e. yarp::os::Time::now()).
+     * @return the age in seconds.
+     */
+    double feedbackAge(const double& now) const;
+
+    /**
+     * Get the time stamps of the joint positions
+     * @return the time stamp of each joint position in seconds
+     */
+    const yarp::sig::Vector& encoderTimeStamps() const;
+
+    /**
+     * Get the number of feedback reads
+     * @return the number of calls to getFeedback()
+     */
+    std::size_t numberOfReads() const;
+
+    /**
+     * Get the number of feedback reads that did not return new joint positions
+     * @return the number of stale reads
+     */
+    std::size_t numberOfStaleReads() const;
+
     /**
      * Get the joint limits
      * @param limits matrix containing the joint limits in radian
@@ -0,0 +1,412 @@
+/**
+ * @file AggregatedControlBoard.cpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+// std
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
+// YARP
+#include <yarp/os/Bottle.h>
+#include <yarp/os/LogStream.h>
+#include <yarp/os/Property.h>
+#include <yarp/os/Time.h>
+
+#include <AggregatedControlBoard.hpp>
+#include <FakeDevices.hpp>
+#include <Utils.hpp>
+
+bool AggregatedControlBoard::addPart(const yarp::os::Searchable& config, bool isMandatory)
+{
+    if (m_robotDevice.isValid())
+    {
+        yError() << "[AggregatedControlBoard::addPart] The parts cannot be added after opening "
+                    "the board.";
+        return false;
+    }
+
+    std::vector<std::string> remoteControlBoards;
+    yarp::os::Value* remoteControlBoardsYarp;
+    if (!config.check("remote_control_boards", remoteControlBoardsYarp)
+        || !YarpHelper::yarpListToStringVector(remoteControlBoardsYarp, remoteControlBoards))
+    {
+        yError() << "[AggregatedControlBoard::addPart] Unable to find remote_control_boards into "
+                    "config file.";
+        return false;
+    }
+
+    std::vector<std::string> axesList;
+    yarp::os::Value* axesListYarp;
+    if (!config.check("joints_list", axesListYarp)
+        || !YarpHelper::yarpListToStringVector(axesListYarp, axesList))
+    {
+        yError() << "[AggregatedControlBoard::addPart] Unable to find joints_list into config "
+                    "file.";
+        return false;
+    }
+
+    const bool useVelocity = config.check("useVelocity", yarp::os::Value(false)).asBool();
+    const int controlMode = useVelocity ? VOCAB_CM_VELOCITY : VOCAB_CM_POSITION_DIRECT;
+
+    for (const auto& axis : axesList)
+    {
+        if (std::find(m_axesList.begin(), m_axesList.end(), axis) != m_axesList.end())
+        {
+            yError() << "[AggregatedControlBoard::addPart] The joint" << axis
+                     << "belongs to more than one part.";
+            return false;
+        }
+        m_axesList.push_back(axis);
+        m_controlModes.push_back(controlMode);
+        m_isJointMandatory.push_back(isMandatory ? 1 : 0);
+    }
+
+    for (const auto& remoteControlBoard : remoteControlBoards)
+    {
+        if (std::find(m_remoteControlBoards.begin(),
+                      m_remoteControlBoards.end(),
+                      remoteControlBoard)
+            == m_remoteControlBoards.end())
+            m_remoteControlBoards.push_back(remoteControlBoard);
+    }
+
+    return true;
+}
+
+bool AggregatedControlBoard::open(const std::string& robot, const std::string& name)
+{
+    if (m_axesList.empty())
+    {
+        yError() << "[AggregatedControlBoard::open] No part has been added.";
+        return false;
+    }
+
+    // open the remotecontrolboardremepper YARP device
+    yarp::os::Property options;
+    options.put("device", "remotecontrolboardremapper");
+    YarpHelper::addVectorOfStringToProperty(options, "axesNames", m_axesList);
+
+    yarp::os::Bottle remoteControlBoards;
+    yarp::os::Bottle& remoteControlBoardsList = remoteControlBoards.addList();
+    for (const auto& remoteControlBoard : m_remoteControlBoards)
+        remoteControlBoardsList.addString("/" + robot + "/" + remoteControlBoard);
+
+    options.put("remoteControlBoards", remoteControlBoards.get(0));
+    options.put("localPortPrefix", "/" + name + "/aggregatedControlBoard");
+    yarp::os::Property& remoteControlBoardsOpts = options.addGroup("REMOTE_CONTROLBOARD_OPTIONS");
+    remoteControlBoardsOpts.put("writeStrict", "on");
+
+    const std::size_t numberOfJoints = m_axesList.size();
+    m_encoders.assign(numberOfJoints, 0.0);
+    m_encoderTimeStamps.assign(numberOfJoints, 0.0);
+    m_references.assign(numberOfJoints, 0.0);
+    m_isReferenceUpdated.assign(numberOfJoints, 0);
+    m_mandatoryJoints.clear();
+    m_optionalJoints.clear();
+    for (std::size_t i = 0; i < numberOfJoints; i++)
+    {
+        if (m_isJointMandatory[i])
+            m_mandatoryJoints.push_back(i);
+        else
+            m_optionalJoints.push_back(i);
+    }
+    for (ReferenceBatch* batch :
+         {&m_positionBatch, &m_velocityBatch, &m_optionalPositionBatch, &m_optionalVelocityBatch})
+    {
+        batch->joints.resize(numberOfJoints);
+        batch->references.resize(numberOfJoints);
+        batch->size = 0;
+    }
+
+    FakeDevices::replaceDevice(options);
+    if (!m_robotDevice.open(options))
+    {
+        yError() << "[AggregatedControlBoard::open] Could not open remotecontrolboardremapper "
+                    "object.";
+        return false;
+    }
+
+    if (!m_robotDevice.view(m_encodersInterface) || !m_encodersInterface)
+    {
+        yError() << "[AggregatedControlBoard::open] Cannot obtain IEncoders interface";
+        return false;
+    }
+
+    if (!m_robotDevice.view(m_positionDirectInterface) || !m_positionDirectInterface)
+    {
+        yError() << "[AggregatedControlBoard::open] Cannot obtain IPositionDirect interface";
+        return false;
+    }
+
+    if (!m_robotDevice.view(m_velocityInterface) || !m_velocityInterface)
+    {
+        yError() << "[AggregatedControlBoard::open] Cannot obtain IVelocityInterface interface";
+        return false;
+    }
+
+    if (!m_robotDevice.view(m_limitsInterface) || !m_limitsInterface)
+    {
+        yError() << "[AggregatedControlBoard::open] Cannot obtain IControlLimits interface";
+        return false;
+    }
+
+    if (!m_robotDevice.view(m_controlModeInterface) || !m_controlModeInterface)
+    {
+        yError() << "[AggregatedControlBoard::open] Cannot obtain IControlMode interface";
+        return false;
+    }
+
+    if (!m_robotDevice.view(m_timedInterface) || !m_timedInterface)
+    {
+        yError() << "[AggregatedControlBoard::open] Cannot obtain iTimed interface";
+        return false;
+    }
+
+    // check if the robot is alive
+    bool okPosition = false;
+    for (int i = 0; i < 10 && !okPosition; i++)
+    {
+        okPosition = m_encodersInterface->getEncodersTimed(m_encoders.data(),
+                                                           m_encoderTimeStamps.data());
+
+        if (!okPosition)
+            yarp::os::Time::delay(0.1);
+    }
+    if (!okPosition)
+    {
+        yError() << "[AggregatedControlBoard::open] Unable to read encoders (position).";
+        return false;
+    }
+
+    if (!switchToControlModes(m_controlModes))
+    {
+        yError() << "[AggregatedControlBoard::open] Unable to switch the control mode";
+        return false;
+    }
+
+    // since the velocity interface use a minimum jerk trajectory a very high acceleration is set
+    // in order to use it as velocity "direct" interface. It is set once, not in every cycle
+    for (ReferenceBatch* batch : {&m_velocityBatch, &m_optionalVelocityBatch})
+    {
+        const bool isMandatory = batch == &m_velocityBatch;
+        batch->size = 0;
+        for (std::size_t i = 0; i < numberOfJoints; i++)
+        {
+            if (m_controlModes[i] == VOCAB_CM_VELOCITY
+                && (m_isJointMandatory[i] != 0) == isMandatory)
+            {
+                batch->joints[batch->size] = i;
+                batch->references[batch->size++] = std::numeric_limits<double>::max();
+            }
+        }
+
+        if (batch->size > 0
+            && !m_velocityInterface->setRefAccelerations(
+                batch->size, batch->joints.data(), batch->references.data()))
+        {
+            if (isMandatory)
+            {
+                yError() << "[AggregatedControlBoard::open] Error while setting the desired "
+                            "acceleration.";
+                return false;
+            }
+            reportOptionalJointError("Error while setting the desired acceleration.");
+        }
+    }
+
+    yInfo() << "[AggregatedControlBoard::open] The board contains" << numberOfJoints
+            << "joints of" << m_remoteControlBoards.size() << "control boards.";
+    return true;
+}
+
+bool AggregatedControlBoard::switchToControlModes(const std::vector<int>& controlModes)
+{
+    if (!m_controlModeInterface)
+    {
+        yError() << "[AggregatedControlBoard::switchToControlModes] ControlMode I/F not ready.";
+        return false;
+    }
+
+    // the mandatory and the optional joints are switched with different calls, so that an error
+    // on the optional ones does not hide the result of the mandatory ones
+    std::vector<int> modes;
+    for (const std::vector<int>* joints : {&m_mandatoryJoints, &m_optionalJoints})
+    {
+        if (joints->empty())
+            continue;
+
+        modes.clear();
+        for (const int joint : *joints)
+            modes.push_back(controlModes[joint]);
+
+        if (!m_controlModeInterface->setControlModes(joints->size(), joints->data(), modes.data()))
+        {
+            if (joints == &m_mandatoryJoints)
+            {
+                yError() << "[AggregatedControlBoard::switchToControlModes] Error while setting "
+                            "the controlMode.";
+                return false;
+            }
+            reportOptionalJointError("Error while setting the controlMode.");
+        }
+    }
+    return true;
+}
+
+bool AggregatedControlBoard::sendReferences(const ReferenceBatch& batch, int controlMode)
+{
+    if (batch.size == 0)
+        return true;
+
+    if (controlMode == VOCAB_CM_VELOCITY)
+        return m_velocityInterface->velocityMove(
+            batch.size, batch.joints.data(), batch.references.data());
+
+    return m_positionDirectInterface->setPositions(
+        batch.size, batch.joints.data(), batch.references.data());
+}
+
+void AggregatedControlBoard::reportOptionalJointError(const char* message)
+{
+    if (m_optionalJointErrors++ == 0)
+        yWarning() << "[AggregatedControlBoard] Neglected error on the optional joints:" << message;
+}
+
+bool AggregatedControlBoard::getJointIndices(const std::vector<std::string>& axesList,
+                                             std::vector<int>& indices) const
+{
+    indices.resize(axesList.size());
+    for (std::size_t i = 0; i < axesList.size(); i++)
+    {
+        const auto axis = std::find(m_axesList.begin(), m_axesList.end(), axesList[i]);
+        if (axis == m_axesList.end())
+        {
+            yError() << "[AggregatedControlBoard::getJointIndices] The joint" << axesList[i]
+                     << "is not part of the board.";
+            return false;
+        }
+        indices[i] = std::distance(m_axesList.begin(), axis);
+    }
+    return true;
+}
+
+bool AggregatedControlBoard::readEncoders()
+{
+    if (m_encodersInterface->getEncodersTimed(m_encoders.data(), m_encoderTimeStamps.data()))
+        return true;
+
+    if (m_optionalJoints.empty())
+    {
+        yError() << "[AggregatedControlBoard::readEncoders] Unable to get joint position";
+        return false;
+    }
+
+    // the board cannot read all the joints at once. The mandatory joints are read one by one, so
+    // that an error on the optional ones does not stop the module
+    for (const int joint : m_mandatoryJoints)
+    {
+        if (!m_encodersInterface->getEncoderTimed(
+                joint, &m_encoders[joint], &m_encoderTimeStamps[joint]))
+        {
+            yError() << "[AggregatedControlBoard::readEncoders] Unable to get joint position";
+            return false;
+        }
+    }
+    reportOptionalJointError("Unable to get joint position.");
+    return true;
+}
+
+double AggregatedControlBoard::encoder(int index) const
+{
+    return m_encoders[index];
+}
+
+double AggregatedControlBoard::encoderTimeStamp(int index) const
+{
+    return m_encoderTimeStamps[index];
+}
+
+bool AggregatedControlBoard::getLimits(int index,
+                                       double& minLimitInDegree,
+                                       double& maxLimitInDegree)
+{
+    return m_limitsInterface->getLimits(index, &minLimitInDegree, &maxLimitInDegree);
+}
+
+void AggregatedControlBoard::setReference(int index, double reference)
+{
+    m_references[index] = reference;
+    m_isReferenceUpdated[index] = 1;
+}
+
+bool AggregatedControlBoard::writeReferences()
+{
+    // the updated joints are grouped by control mode and by part type in the preallocated batches
+    m_positionBatch.size = 0;
+    m_velocityBatch.size = 0;
+    m_optionalPositionBatch.size = 0;
+    m_optionalVelocityBatch.size = 0;
+    for (std::size_t i = 0; i < m_references.size(); i++)
+    {
+        if (!m_isReferenceUpdated[i])
+            continue;
+        m_isReferenceUpdated[i] = 0;
+
+        ReferenceBatch& batch
+            = m_controlModes[i] == VOCAB_CM_VELOCITY
+                  ? (m_isJointMandatory[i] ? m_velocityBatch : m_optionalVelocityBatch)
+                  : (m_isJointMandatory[i] ? m_positionBatch : m_optionalPositionBatch);
+        batch.joints[batch.size] = i;
+        batch.references[batch.size++] = m_references[i];
+    }
+
+    if (!sendReferences(m_positionBatch, VOCAB_CM_POSITION_DIRECT))
+    {
+        yError() << "[AggregatedControlBoard::writeReferences] Error while setting the desired "
+                    "position.";
+        return false;
+    }
+
+    if (!sendReferences(m_velocityBatch, VOCAB_CM_VELOCITY))
+    {
+        yError() << "[AggregatedControlBoard::writeReferences] Error while setting the desired "
+                    "velocity.";
+        return false;
+    }
+
+    // the errors on the optional joints are only reported
+    if (!sendReferences(m_optionalPositionBatch, VOCAB_CM_POSITION_DIRECT))
+        reportOptionalJointError("Error while setting the desired position.");
+
+    if (!sendReferences(m_optionalVelocityBatch, VOCAB_CM_VELOCITY))
+        reportOptionalJointError("Error while setting the desired velocity.");
+
+    return true;
+}
+
+yarp::os::Stamp AggregatedControlBoard::lastInputStamp()
+{
+    return m_timedInterface->getLastInputStamp();
+}
+
+void AggregatedControlBoard::close()
+{
+    if (!m_robotDevice.isValid())
+        return;
+
+    std::vector<int> controlModes(m_axesList.size(), VOCAB_CM_POSITION);
+    if (!switchToControlModes(controlModes))
+        yError() << "[AggregatedControlBoard::close] Unable to switch in position control.";
+
+    if (m_optionalJointErrors > 0)
+        yWarning() << "[AggregatedControlBoard::close] Neglected errors on the optional joints:"
+                   << m_optionalJointErrors;
+
+    if (!m_robotDevice.close())
+        yError() << "[AggregatedControlBoard::close] Unable to close the device.";
+}
@@ -13,7 +13,8 @@
 bool FingersRetargeting::configure(const yarp::os::Searchable& config, const std::string& name)
 {
     m_controlHelper = std::make_unique<RobotControlHelper>();
-    if (!m_controlHelper->configure(config, name, false))
+    if (!m_controlHelper->configure(
+            config, name, false, m_inputSession, m_inputStreamPrefix, m_controlBoard))
     {
         yError() << "[FingersRetargeting::configure] Unable to configure the control helper";
         return false;
@@ -67,7 +68,9 @@ bool FingersRetargeting::setFingersVelocity(const double& fingersVelocity)
 
 void FingersRetargeting::getFingerValues(std::vector<double>& fingerValues)
 {
-    fingerValues.clear();
+    if (fingerValues.size() != m_desiredJointValue.size())
+        fingerValues.resize(m_desiredJointValue.size());
+
     for (size_t i = 0; i < m_desiredJointValue.size(); i++)
-        fingerValues.push_back(m_desiredJointValue[i]);
+        fingerValues[i] = m_desiredJointValue[i];
 }
@@ -41,6 +41,19 @@ bool HandRetargeting::configure(const yarp::os::Searchable& config)
         << "[HandRetargeting::configure] kinematic scaling factor (= robotArmSpan / humanHeight): "
         << m_scalingFactor;
 
+    std::string handPoseRepresentation
+        = config.check("handPoseRepresentation", yarp::os::Value("rpy")).asString();
+    if (handPoseRepresentation == "rpy")
+        m_handPoseRepresentation = HandPoseRepresentation::RollPitchYaw;
+    else if (handPoseRepresentation == "quaternion")
+        m_handPoseRepresentation = HandPoseRepresentation::Quaternion;
+    else
+    {
+        yError() << "[HandRetargeting::configure] The handPoseRepresentation"
+                 << handPoseRepresentation << "is not supported. Use rpy or quaternion.";
+        return false;
+    }
+
     // getting the mapping between the robot and the retargeting frames
     iDynTree::Rotation tempRotation;
     if (!iDynTree::parseRotationMatrix(config, "handOculusFrame_R_handRobotFrame", tempRotation))
@@ -50,8 +63,7 @@ bool HandRetargeting::configure(const yarp::os::Searchable& config)
         return false;
     }
 
-    m_handOculusFrame_T_handRobotFrame.setRotation(tempRotation);
-    m_handOculusFrame_T_handRobotFrame.setPosition(iDynTree::Position::Zero());
+    m_handOculusFrame_R_handRobotFrame = iDynTree::toEigen(tempRotation);
 
     if (!iDynTree::parseRotationMatrix(
             config, "teleoperationRobotFrame_R_teleoperationFrame", tempRotation))
@@ -61,50 +73,111 @@ bool HandRetargeting::configure(const yarp::os::Searchable& config)
         return false;
     }
 
-    m_teleopRobotFrame_T_teleopFrame.setRotation(tempRotation);
-    m_teleopRobotFrame_T_teleopFrame.setPosition(iDynTree::Position::Zero());
+    m_teleopRobotFrame_R_teleopFrame = iDynTree::toEigen(tempRotation);
 
-    m_oculusInertial_T_teleopFrame.setPosition(iDynTree::Position::Zero());
+    m_playerOrientation = 0;
+    m_oculusInertial_R_teleopFrame.setIdentity();
+    m_oculusInertial_p_teleopFrame.setZero();
+    m_isTeleopRobotFrameUpdated = false;
 
     return true;
 }
 
 void HandRetargeting::setPlayerOrientation(const double& playerOrientation)
 {
+    // the player orientation is set at every cycle but it changes only if the virtualizer is used
+    if (m_isTeleopRobotFrameUpdated && playerOrientation == m_playerOrientation)
+        return;
+
     // notice the minus sign is not an error. Indeed the virtualizer angle is positive clockwise
-    m_oculusInertial_T_teleopFrame.setRotation(iDynTree::Rotation::RotZ(-playerOrientation));
+    m_playerOrientation = playerOrientation;
+    m_oculusInertial_R_teleopFrame
+        = Eigen::AngleAxisd(-playerOrientation, Eigen::Vector3d::UnitZ()).toRotationMatrix();
+    m_isTeleopRobotFrameUpdated = false;
 }
 
 void HandRetargeting::setPlayerPosition(const iDynTree::Position& playerPosition)
 {
-    m_oculusInertial_T_teleopFrame.setPosition(playerPosition);
+    m_oculusInertial_p_teleopFrame = iDynTree::toEigen(playerPosition);
+    m_isTeleopRobotFrameUpdated = false;
 }
 
 void HandRetargeting::setHandTransform(const yarp::sig::Matrix& handTransformation)
 {
-    iDynTree::toiDynTree(handTransformation, m_oculusInertial_T_handOculusFrame);
+    // the yarp matrix is stored in row-major order
+    const Eigen::Map<const Eigen::Matrix<double, 4, 4, Eigen::RowMajor>> transform(
+        handTransformation.data());
+    m_oculusInertial_R_handOculusFrame = transform.topLeftCorner<3, 3>();
+    m_oculusInertial_p_handOculusFrame = transform.topRightCorner<3, 1>();
+}
+
+void HandRetargeting::updateTeleopRobotFrame()
+{
+    if (m_isTeleopRobotFrameUpdated)
+        return;
+
+    // teleopRobotFrame_T_teleopFrame * oculusInertial_T_teleopFrame^-1 (the first transform is a
+    // pure rotation)
+    m_teleopRobotFrame_R_oculusInertial
+        = m_teleopRobotFrame_R_teleopFrame * m_oculusInertial_R_teleopFrame.transpose();
+    m_teleopRobotFrame_p_oculusInertial
+        = -m_teleopRobotFrame_R_oculusInertial * m_oculusInertial_p_teleopFrame;
+    m_isTeleopRobotFrameUpdated = true;
+}
+
+template <typename T>
+void HandRetargeting::writePose(const Eigen::Vector3d& position,
+                                const Eigen::Matrix3d& rotation,
+                                T& pose)
+{
+    if (pose.size() != 6)
+        pose.resize(6);
+
+    iDynTree::toEigen(m_rotationBuffer) = rotation;
+    m_rotationBuffer.getRPY(pose[3], pose[4], pose[5]);
+
+    pose[0] = position(0);
+    pose[1] = position(1);
+    pose[2] = position(2);
 }
 
 void HandRetargeting::evaluateDesiredHandPose(yarp::sig::Vector& handPose)
 {
-    m_teleopRobotFrame_T_handRobotFrame
-        = m_teleopRobotFrame_T_teleopFrame * m_oculusInertial_T_teleopFrame.inverse()
-          * m_oculusInertial_T_handOculusFrame * m_handOculusFrame_T_handRobotFrame;
-
-    // probably we should avoid to use roll pitch and yaw. A possible solution
-    // is to use quaternion or directly SE(3).
-    iDynTree::Vector3 handOrientation, handPosition;
-    handOrientation = m_teleopRobotFrame_T_handRobotFrame.getRotation().asRPY();
-    handPosition = m_teleopRobotFrame_T_handRobotFrame.getPosition();
-    iDynTree::toEigen(handPosition) = m_scalingFactor * iDynTree::toEigen(handPosition);
-
-    handPose.clear();
-    handPose.push_back(handPosition(0));
-    handPose.push_back(handPosition(1));
-    handPose.push_back(handPosition(2));
-    handPose.push_back(handOrientation(0));
-    handPose.push_back(handOrientation(1));
-    handPose.push_back(handOrientation(2));
+    updateTeleopRobotFrame();
+
+    // teleopRobotFrame_T_oculusInertial * oculusInertial_T_handOculusFrame
+    // * handOculusFrame_T_handRobotFrame (the last transform is a pure rotation)
+    m_teleopRobotFrame_R_handRobotFrame.noalias() = m_teleopRobotFrame_R_oculusInertial
+                                                    * m_oculusInertial_R_handOculusFrame
+                                                    * m_handOculusFrame_R_handRobotFrame;
+    m_teleopRobotFrame_p_handRobotFrame.noalias()
+        = m_teleopRobotFrame_R_oculusInertial * m_oculusInertial_p_handOculusFrame;
+    m_teleopRobotFrame_p_handRobotFrame += m_teleopRobotFrame_p_oculusInertial;
+
+    const Eigen::Vector3d handPosition = m_scalingFactor * m_teleopRobotFrame_p_handRobotFrame;
+
+    if (m_handPoseRepresentation == HandPoseRepresentation::RollPitchYaw)
+    {
+        writePose(handPosition, m_teleopRobotFrame_R_handRobotFrame, handPose);
+        return;
+    }
+
+    // the quaternion avoids the singularities of the roll pitch yaw angles. q and -q represent
+    // the same rotation, the one closer to the previous quaternion is sent.
+    const Eigen::Quaterniond quaternion(m_teleopRobotFrame_R_handRobotFrame);
+    Eigen::Vector4d quaternionValues(
+        quaternion.w(), quaternion.x(), quaternion.y(), quaternion.z());
+    if (quaternionValues.dot(m_previousQuaternion) < 0)
+        quaternionValues = -quaternionValues;
+    m_previousQuaternion = quaternionValues;
+
+    if (handPose.size() != 7)
+        handPose.resize(7);
+
+    for (int i = 0; i < 3; i++)
+        handPose[i] = handPosition(i);
+    for (int i = 0; i < 4; i++)
+        handPose[3 + i] = quaternionValues(i);
 }
 
 void HandRetargeting::getHandInfo(std::vector<double>& robotHandposeWrtRobotTel,
@@ -112,45 +185,22 @@ void HandRetargeting::getHandInfo(std::vector<double>& robotHandposeWrtRobotTel,
                                   std::vector<double>& humanHandposeWrtHumanTel)
 {
     // robot hand pose wrt robot teleoperation frame
-    iDynTree::Vector3 handOrientation, handPosition;
-    handOrientation = m_teleopRobotFrame_T_handRobotFrame.getRotation().asRPY();
-    handPosition = m_teleopRobotFrame_T_handRobotFrame.getPosition();
-    iDynTree::toEigen(handPosition) = m_scalingFactor * iDynTree::toEigen(handPosition);
-
-    robotHandposeWrtRobotTel.clear();
-    robotHandposeWrtRobotTel.push_back(handPosition(0));
-    robotHandposeWrtRobotTel.push_back(handPosition(1));
-    robotHandposeWrtRobotTel.push_back(handPosition(2));
-    robotHandposeWrtRobotTel.push_back(handOrientation(0));
-    robotHandposeWrtRobotTel.push_back(handOrientation(1));
-    robotHandposeWrtRobotTel.push_back(handOrientation(2));
+    writePose(m_scalingFactor * m_teleopRobotFrame_p_handRobotFrame,
+              m_teleopRobotFrame_R_handRobotFrame,
+              robotHandposeWrtRobotTel);
 
     // human hand pose wrt oculus inertial frame
-    iDynTree::Vector3 handOrientationInertial, handPositionInertial;
-    handOrientationInertial = m_oculusInertial_T_handOculusFrame.getRotation().asRPY();
-    handPositionInertial = m_oculusInertial_T_handOculusFrame.getPosition();
-
-    humanHandposeWrtOculusInertial.clear();
-    humanHandposeWrtOculusInertial.push_back(handPositionInertial(0));
-    humanHandposeWrtOculusInertial.push_back(handPositionInertial(1));
-    humanHandposeWrtOculusInertial.push_back(handPositionInertial(2));
-    humanHandposeWrtOculusInertial.push_back(handOrientationInertial(0));
-    humanHandposeWrtOculusInertial.push_back(handOrientationInertial(1));
-    humanHandposeWrtOculusInertial.push_back(handOrientationInertial(2));
+    writePose(m_oculusInertial_p_handOculusFrame,
+              m_oculusInertial_R_handOculusFrame,
+              humanHandposeWrtOculusInertial);
 
     // human hand pose wrt human teleopration frame
-    iDynTree::Transform teleopFrame_T_handOculusFrame
-        = m_oculusInertial_T_teleopFrame.inverse() * m_oculusInertial_T_handOculusFrame;
-
-    iDynTree::Vector3 handOrientationTeleoperation, handPositionTeleoperation;
-    handOrientationTeleoperation = teleopFrame_T_handOculusFrame.getRotation().asRPY();
-    handPositionTeleoperation = teleopFrame_T_handOculusFrame.getPosition();
-
-    humanHandposeWrtHumanTel.clear();
-    humanHandposeWrtHumanTel.push_back(handPositionTeleoperation(0));
-    humanHandposeWrtHumanTel.push_back(handPositionTeleoperation(1));
-    humanHandposeWrtHumanTel.push_back(handPositionTeleoperation(2));
-    humanHandposeWrtHumanTel.push_back(handOrientationTeleoperation(0));
-    humanHandposeWrtHumanTel.push_back(handOrientationTeleoperation(1));
-    humanHandposeWrtHumanTel.push_back(handOrientationTeleoperation(2));
+    const Eigen::Matrix3d teleopFrame_R_handOculusFrame
+        = m_oculusInertial_R_teleopFrame.transpose() * m_oculusInertial_R_handOculusFrame;
+    const Eigen::Vector3d teleopFrame_p_handOculusFrame
+        = m_oculusInertial_R_teleopFrame.transpose()
+          * (m_oculusInertial_p_handOculusFrame - m_oculusInertial_p_teleopFrame);
+    writePose(teleopFrame_p_handOculusFrame,
+              teleopFrame_R_handOculusFrame,
+              humanHandposeWrtHumanTel);
 }
@@ -12,9 +12,38 @@
 #include <iDynTree/yarp/YARPConversions.h>
 #include <iDynTree/yarp/YARPEigenConversions.h>
 
+#include <ConfigSchema.hpp>
 #include <HeadRetargeting.hpp>
 #include <Utils.hpp>
 
+namespace
+{
+/**
+ * Parameters of the head retargeting.
+ */
+struct HeadRetargetingParameters
+{
+    double samplingTime;
+    double smoothingTime;
+    double preparationSmoothingTime;
+    yarp::sig::Vector preparationJointReferenceValues;
+    double predictionHorizon;
+    double predictionFilterGain;
+    double predictionMaxAngle;
+
+    template <typename Visitor> void visit(Visitor& v)
+    {
+        v("samplingTime", samplingTime);
+        v("smoothingTime", smoothingTime);
+        v("PreparationSmoothingTime", preparationSmoothingTime);
+        v("PreparationJointReferenceValues", preparationJointReferenceValues);
+        v("predictionHorizon", predictionHorizon, 0.0);
+        v("predictionFilterGain", predictionFilterGain, 0.5);
+        v("predictionMaxAngle", predictionMaxAngle, 0.35);
+    }
+};
+} // namespace
+
 struct HeadRetargeting::Impl
 {
     std::unique_ptr<iCub::ctrl::minJerkTrajGen> m_NeckJointsPreparationSmoother{nullptr};
@@ -118,51 +147,46 @@ bool HeadRetargeting::configure(const yarp::os::Searchable& config, const std::s
     }
 
     m_controlHelper = std::make_unique<RobotControlHelper>();
-    if (!m_controlHelper->configure(config, name, true))
+    if (!m_controlHelper->configure(
+            config, name, true, m_inputSession, m_inputStreamPrefix, m_controlBoard))
     {
         yError() << "[FingersRetargeting::configure] Unable to configure the finger helper";
         return false;
     }
 
-    // initialize minimum jerk trajectory for the head
-    double samplingTime;
-    if (!YarpHelper::getDoubleFromSearchable(config, "samplingTime", samplingTime))
-    {
-        yError() << "[HeadRetargeting::configure] Unable to find the head sampling time";
-        return false;
-    }
+    unsigned headDoFs = controlHelper()->getDoFs();
 
-    double smoothingTime;
-    if (!YarpHelper::getDoubleFromSearchable(config, "smoothingTime", smoothingTime))
+    HeadRetargetingParameters parameters;
+    parameters.preparationJointReferenceValues.resize(headDoFs);
+
+    if (!YarpHelper::parseParameters(config, parameters, "[HeadRetargeting::configure]"))
     {
-        yError() << "[HeadRetargeting::configure] Unable to find the head smoothing time";
+        yError() << "[HeadRetargeting::configure] Unable to parse the head retargeting "
+                    "parameters.";
         return false;
     }
 
-    double preparationSmoothingTime;
-    if (!YarpHelper::getDoubleFromSearchable(
-            config, "PreparationSmoothingTime", preparationSmoothingTime))
+    const double samplingTime = parameters.samplingTime;
+    const double smoothingTime = parameters.smoothingTime;
+    const double preparationSmoothingTime = parameters.preparationSmoothingTime;
+    const yarp::sig::Vector& preparationJointReferenceValues
+        = parameters.preparationJointReferenceValues;
+
+    // the neck kinematics assumes three joints (pitch, roll and yaw)
+    if (headDoFs != 3)
     {
-        yError() << "[HeadRetargeting::configure] Unable to find the head smoothing time";
+        yError() << "[HeadRetargeting::configure] The head retargeting requires three neck "
+                    "joints.";
         return false;
     }
-    unsigned headDoFs = controlHelper()->getDoFs();
 
-    yarp::sig::Vector preparationJointReferenceValues;
-    preparationJointReferenceValues.resize(headDoFs);
-
-    if (!YarpHelper::getYarpVectorFromSearchable(
-            config, "PreparationJointReferenceValues", preparationJointReferenceValues))
+    // the smoother starts from the identity, i.e. all the neck joints equal to zero
+    if (!m_headSmoother.configure(samplingTime, smoothingTime))
     {
-        yError() << "[HeadRetargeting::configure] Initialization failed while reading "
-                    "PreparationJointReferenceValues vector.";
+        yError() << "[HeadRetargeting::configure] Unable to configure the head smoother.";
         return false;
     }
-
-    m_headTrajectorySmoother
-        = std::make_unique<iCub::ctrl::minJerkTrajGen>(headDoFs, samplingTime, smoothingTime);
-    yarp::sig::Vector buff(headDoFs, 0.0);
-    m_headTrajectorySmoother->init(buff);
+    m_desiredJointValue.resize(headDoFs, 0.0);
 
     yarp::sig::Vector neckJointsFbk;
     getNeckJointValues(neckJointsFbk);
@@ -170,9 +194,20 @@ bool HeadRetargeting::configure(const yarp::os::Searchable& config, const std::s
         headDoFs, samplingTime, preparationSmoothingTime, neckJointsFbk);
     pImpl->m_preparationJointReferenceValues = preparationJointReferenceValues;
 
-    m_playerOrientation = 0;
+    // the headset orientation is extrapolated only if the horizon is positive
+    if (!m_headPredictor.configure(samplingTime,
+                                   parameters.predictionHorizon,
+                                   parameters.predictionFilterGain,
+                                   parameters.predictionMaxAngle))
+    {
+        yError() << "[HeadRetargeting::configure] Unable to configure the head predictor.";
+        return false;
+    }
+    m_usePrediction = parameters.predictionHorizon > 0;
+    yInfo() << "[HeadRetargeting::configure] head prediction horizon: "
+            << parameters.predictionHorizon;
 
-    m_desiredNeckJointsBeforeSmoothing.resize(3);
+    m_playerOrientation = 0;
 
     return true;
 }
@@ -189,20 +224,21 @@ void HeadRetargeting::setDesiredHeadOrientation(
     // get the rotation matrix
     iDynTree::toEigen(m_oculusInertial_R_headOculus)
         = iDynTree::toEigen(oculusInertial_T_headOculus).block(0, 0, 3, 3);
+    predictHeadOrientation();
 
     m_teleopFrame_R_headOculus
         = iDynTree::Rotation::RotZ(m_playerOrientation).inverse() * m_oculusInertial_R_headOculus;
 
+    smoothHeadOrientation();
+
     // notice here the following assumption is done:
     // desiredNeckJoint(0) = neckPitch
     // desiredNeckJoint(1) = neckRoll
     // desiredNeckJoint(2) = neckYaw
-    inverseKinematics(
-        m_teleopFrame_R_headOculus, m_desiredNeckJointsBeforeSmoothing(0),
-                                    m_desiredNeckJointsBeforeSmoothing(1),
-                                    m_desiredNeckJointsBeforeSmoothing(2));
-
-    smoothNeckJointValues();
+    inverseKinematics(m_teleopFrame_R_headOculus,
+                      m_desiredJointValue(0),
+                      m_desiredJointValue(1),
+                      m_desiredJointValue(2));
 }
 
 void HeadRetargeting::setDesiredHeadOrientationFromOpenXr(const yarp::sig::Matrix &openXrInertial_T_headOpenXr)
@@ -210,6 +246,7 @@ void HeadRetargeting::setDesiredHeadOrientationFromOpenXr(const yarp::sig::Matri
     // get the rotation matrix
     iDynTree::toEigen(m_oculusInertial_R_headOculus)
         = iDynTree::toEigen(openXrInertial_T_headOpenXr).block(0, 0, 3, 3);
+    predictHeadOrientation();
 
     m_teleopFrame_R_headOculus
         = iDynTree::Rotation::RotY(m_playerOrientation).inverse() //With OpenXr the Y is up
@@ -222,12 +259,37 @@ void HeadRetargeting::setDesiredHeadOrientationFromOpenXr(const yarp::sig::Matri
     // The kinematic chain from the chest to the neck is composed of the pitch, roll, and yaw angles, in this order. 
     // The neck pitch axis is aligned with the x axis of the reference frame used by openxr, the roll with the z axis,
     // and the yaw with the y axis. Hence, we need to find the Euler angles corresponding to R_x * R_z * R_y.
-    inverseKinematicsXZY(
-        m_teleopFrame_R_headOculus, m_desiredNeckJointsBeforeSmoothing(0),
-                                    m_desiredNeckJointsBeforeSmoothing(1),
-                                    m_desiredNeckJointsBeforeSmoothing(2));
+    smoothHeadOrientation();
+    inverseKinematicsXZY(m_teleopFrame_R_headOculus,
+                         m_desiredJointValue(0),
+                         m_desiredJointValue(1),
+                         m_desiredJointValue(2));
+}
 
-    smoothNeckJointValues();
+void HeadRetargeting::predictHeadOrientation()
+{
+    if (!m_usePrediction)
+        return;
+
+    m_headOrientationBuffer = iDynTree::toEigen(m_oculusInertial_R_headOculus);
+    m_headPredictor.predict(m_headOrientationBuffer, m_headOrientationBuffer);
+    iDynTree::toEigen(m_oculusInertial_R_headOculus) = m_headOrientationBuffer;
+}
+
+void HeadRetargeting::getPredictionErrors(double& predictionError, double& baselineError) const
+{
+    predictionError = m_headPredictor.predictionError();
+    baselineError = m_headPredictor.baselineError();
+}
+
+const OrientationPredictor& HeadRetargeting::headPredictor() const
+{
+    return m_headPredictor;
+}
+
+bool HeadRetargeting::isPredictionUsed() const
+{
+    return m_usePrediction;
 }
 
 bool HeadRetargeting::move()
@@ -235,17 +297,19 @@ bool HeadRetargeting::move()
     return RetargetingController::move();
 }
 
-void HeadRetargeting::smoothNeckJointValues()
+void HeadRetargeting::smoothHeadOrientation()
 {
-
-    // Notice: this can generate problems when the inverse kinematics return angles
-    // near the singularity. it would be nice to implement a smoother in SO(3).
-    m_headTrajectorySmoother->computeNextValues(m_desiredNeckJointsBeforeSmoothing);
-    m_desiredJointValue = m_headTrajectorySmoother->getPos();
+    // the orientation is smoothed before the inverse kinematics, so the smoothed trajectory does
+    // not depend on the singularities of the Euler angles
+    m_desiredHeadOrientationBuffer = iDynTree::toEigen(m_teleopFrame_R_headOculus);
+    m_headSmoother.smooth(m_desiredHeadOrientationBuffer, m_desiredHeadOrientationBuffer);
+    iDynTree::toEigen(m_teleopFrame_R_headOculus) = m_desiredHeadOrientationBuffer;
 }
 
 void HeadRetargeting::initializeNeckJointValues()
 {
+    // the orientation samples received before the preparation are not consecutive
+    m_headPredictor.reset();
     m_desiredJointValue.clear();
     pImpl->getNeckJointsRefSmoothedValues(m_desiredJointValue);
 }
@@ -18,6 +18,8 @@
 #include <iDynTree/yarp/YARPConversions.h>
 #include <iDynTree/yarp/YARPEigenConversions.h>
 
+#include <ConfigSchema.hpp>
+#include <FakeDevices.hpp>
 #include <OculusModule.hpp>
 #include <Utils.hpp>
 
@@ -46,6 +48,45 @@ yarp::sig::Matrix identitySE3()
     return m;
 }
 
+namespace
+{
+/**
+ * Parameters of the joypad used to move the robot.
+ */
+struct JoypadParameters
+{
+    double deadzone;
+    double fullscale;
+    double scaleX;
+    double scaleY;
+
+    template <typename Visitor> void visit(Visitor& v)
+    {
+        v("deadzone", deadzone);
+        v("fullscale", fullscale);
+        v("scale_X", scaleX);
+        v("scale_Y", scaleY);
+    }
+};
+
+// values of the commands received through the RPC port stored in the input session
+constexpr double prepareCommand = 0;
+constexpr double runCommand = 1;
+
+/**
+ * Set the sampling time of a retargeting group. The value precedes the general options appended
+ * to the group, hence it is the one found by the retargeting object.
+ * @param group the group;
+ * @param samplingTime sampling time of the subsystem in seconds.
+ */
+void setSamplingTime(yarp::os::Bottle& group, const double& samplingTime)
+{
+    yarp::os::Bottle& samplingTimeOption = group.addList();
+    samplingTimeOption.addString("samplingTime");
+    samplingTimeOption.addFloat64(samplingTime);
+}
+} // namespace
+
 struct OculusModule::Impl
 {
     std::unique_ptr<iCub::ctrl::minJerkTrajGen> m_NeckJointsPreparationSmoother{nullptr};
@@ -66,22 +107,28 @@ OculusModule::~OculusModule(){};
 
 bool OculusModule::configureTranformClient(const yarp::os::Searchable& config)
 {
-    yarp::os::Property options;
-    options.put("device", "transformClient");
-    options.put("remote", "/transformServer");
-    options.put("local", "/" + getName() + "/transformClient");
-
-    if (!m_transformClientDevice.open(options))
+    // the replayed transforms do not need the transform server
+    if (!m_inputSession.isReplaying())
     {
-        yError() << "[OculusModule::configureTranformClient] Unable to open transformClient device";
-        return false;
-    }
+        yarp::os::Property options;
+        options.put("device", "transformClient");
+        options.put("remote", "/transformServer");
+        options.put("local", "/" + getName() + "/transformClient");
 
-    // obtain the interface
-    if (!m_transformClientDevice.view(m_frameTransformInterface) || !m_frameTransformInterface)
-    {
-        yError() << "[OculusModule::configureTranformClient] Cannot obtain Transform client.";
-        return false;
+        FakeDevices::replaceDevice(options);
+        if (!m_transformClientDevice.open(options))
+        {
+            yError() << "[OculusModule::configureTranformClient] Unable to open transformClient "
+                        "device";
+            return false;
+        }
+
+        // obtain the interface
+        if (!m_transformClientDevice.view(m_frameTransformInterface) || !m_frameTransformInterface)
+        {
+            yError() << "[OculusModule::configureTranformClient] Cannot obtain Transform client.";
+            return false;
+        }
     }
 
     if (!YarpHelper::getStringFromSearchable(config, "root_frame_name", m_rootFrameName))
@@ -146,6 +193,35 @@ bool OculusModule::configureTranformClient(const yarp::os::Searchable& config)
         return false;
     }
 
+    // the frames are registered once, then all the transforms are read in a single pass
+    const double transformTimeout
+        = config.check("transform_timeout", yarp::os::Value(0.5)).asFloat64();
+    if (!m_transformSnapshot.configure(m_rootFrameName, transformTimeout))
+    {
+        yError() << "[OculusModule::configureTranformClient] Unable to configure the transform "
+                    "snapshot.";
+        return false;
+    }
+
+    m_isHeadFrameStreamed = !m_headFrameName.empty();
+    if (m_isHeadFrameStreamed && !m_transformSnapshot.addFrame(m_headFrameName, m_headFrameIndex))
+    {
+        yError() << "[OculusModule::configureTranformClient] Unable to add the head frame to the "
+                    "transform snapshot.";
+        return false;
+    }
+
+    if (!m_useXsens && !m_useIFeel)
+    {
+        if (!m_transformSnapshot.addFrame(m_leftHandFrameName, m_leftHandFrameIndex)
+            || !m_transformSnapshot.addFrame(m_rightHandFrameName, m_rightHandFrameIndex))
+        {
+            yError() << "[OculusModule::configureTranformClient] Unable to add the hand frames to "
+                        "the transform snapshot.";
+            return false;
+        }
+    }
+
     m_oculusRoot_T_lOculus = identitySE3();
     m_oculusRoot_T_rOculus = identitySE3();
     m_oculusRoot_T_headOculus = identitySE3();
@@ -168,26 +244,16 @@ bool OculusModule::configureJoypad(const yarp::os::Searchable& config)
 
     if (!m_useVirtualizer)
     {
-        if (!YarpHelper::getDoubleFromSearchable(config, "deadzone", m_deadzone))
-        {
-            yError() << "[OculusModule::configureJoypad] Unable to find parameter deadzone";
-            return false;
-        }
-        if (!YarpHelper::getDoubleFromSearchable(config, "fullscale", m_fullscale))
+        JoypadParameters parameters;
+        if (!YarpHelper::parseParameters(config, parameters, "[OculusModule::configureJoypad]"))
         {
-            yError() << "[OculusModule::configureJoypad] Unable to find parameter fullscale";
-            return false;
-        }
-        if (!YarpHelper::getDoubleFromSearchable(config, "scale_X", m_scaleX))
-        {
-            yError() << "[OculusModule::configureJoypad] Unable to find parameter scale_X";
-            return false;
-        }
-        if (!YarpHelper::getDoubleFromSearchable(config, "scale_Y", m_scaleY))
-        {
-            yError() << "[OculusModule::configureJoypad] Unable to find parameter scale_Y";
+            yError() << "[OculusModule::configureJoypad] Unable to parse the joypad parameters";
             return false;
         }
+        m_deadzone = parameters.deadzone;
+        m_fullscale = parameters.fullscale;
+        m_scaleX = parameters.scaleX;
+        m_scaleY = parameters.scaleY;
 
         // set the index of the axis according to the OVRheadset yarp device
         bool useLeftStick = config.check("use_left", yarp::os::Value("false")).asBool();
@@ -209,8 +275,14 @@ bool OculusModule::configureJoypad(const yarp::os::Searchable& config)
     options.put("device", "JoypadControlClient");
     options.put("remote", "/joypadDevice/Oculus");
     options.put("local", "/" + getName() + "/joypadControlClient");
+    FakeDevices::replaceDevice(options);
+
+    // the joypad can be read by a dedicated thread (joypadSamplingTime > 0), so the control loop
+    // does not query the joypad client and it does not miss the short presses of the buttons
+    const double joypadSamplingTime
+        = config.check("joypadSamplingTime", yarp::os::Value(0.0)).asFloat64();
 
-    if (!m_skipJoypad)
+    if (!m_skipJoypad && !m_inputSession.isReplaying())
     {
         if (m_joypadDevice.open(options))
         {
@@ -247,6 +319,18 @@ bool OculusModule::configureJoypad(const yarp::os::Searchable& config)
         }
     }
 
+    m_useJoypadSampler = joypadSamplingTime > 0 && m_joypadControllerInterface != nullptr;
+    if (m_useJoypadSampler)
+    {
+        if (!m_joypadSampler.start(m_joypadControllerInterface, joypadSamplingTime))
+        {
+            yError() << "[OculusModule::configureJoypad] Unable to start the joypad sampler.";
+            return false;
+        }
+        yInfo() << "[OculusModule::configureJoypad] The joypad is sampled every"
+                << joypadSamplingTime << "s.";
+    }
+
     return true;
 }
 
@@ -309,12 +393,6 @@ bool OculusModule::configure(yarp::os::ResourceFinder& rf)
 {
     std::lock_guard<std::mutex> guard(m_mutex);
 
-#ifdef ENABLE_LOGGER
-    yInfo() << "[OculusModule::configure] matlogger2 is eanbled!";
-#else
-    yInfo() << "[OculusModule::configure] matlogger2 is disabled!";
-#endif
-
     // check if the configuration file is empty
     if (rf.isNull())
     {
@@ -327,6 +405,13 @@ bool OculusModule::configure(yarp::os::ResourceFinder& rf)
     // get the period
     m_dT = generalOptions.check("samplingTime", yarp::os::Value(0.1)).asFloat64();
 
+    // the subsystems run at a divisor of the module rate
+    if (!configureScheduler(generalOptions))
+    {
+        yError() << "[OculusModule::configure] Unable to configure the scheduler";
+        return false;
+    }
+
     // check if move the robot
     m_moveRobot = generalOptions.check("enableMoveRobot", yarp::os::Value(1)).asBool();
     yInfo() << "[OculusModule::configure] move the robot: " << m_moveRobot;
@@ -349,6 +434,29 @@ bool OculusModule::configure(yarp::os::ResourceFinder& rf)
     }
     setName(name.c_str());
 
+    if (!m_inputSession.configure(rf, getName()))
+    {
+        yError() << "[OculusModule::configure] Unable to configure the input session";
+        return false;
+    }
+    m_headTransformStream = m_inputSession.addStream("transforms/head");
+    m_leftHandTransformStream = m_inputSession.addStream("transforms/left_hand");
+    m_rightHandTransformStream = m_inputSession.addStream("transforms/right_hand");
+    m_oculusOrientationStream = m_inputSession.addStream("oculus/orientation");
+    m_oculusPositionStream = m_inputSession.addStream("oculus/position");
+    m_playerOrientationStream = m_inputSession.addStream("player_orientation");
+    m_robotOrientationStream = m_inputSession.addStream("robot_orientation");
+    m_joypadAxisStream = m_inputSession.addStream("joypad/axes");
+    m_joypadButtonStream = m_inputSession.addStream("joypad/buttons");
+    m_commandStream = m_inputSession.addStream("commands");
+    m_timeStream = m_inputSession.addStream("time");
+
+    if (!FakeDevices::configure(rf))
+    {
+        yError() << "[OculusModule::configure] Unable to configure the fake devices";
+        return false;
+    }
+
     m_useXsens = generalOptions.check("useXsens", yarp::os::Value(false)).asBool();
     yInfo() << "Teleoperation uses Xsens: " << m_useXsens;
 
@@ -376,11 +484,28 @@ bool OculusModule::configure(yarp::os::ResourceFinder& rf)
         return false;
     }
 
+    // the head and the fingers can share a control board (the replayed feedback does not need
+    // the robot)
+    m_useAggregatedControlBoard
+        = generalOptions.check("useAggregatedControlBoard", yarp::os::Value(false)).asBool()
+          && !m_inputSession.isReplaying() && !(m_useXsens && m_useSenseGlove);
+    yInfo() << "[OculusModule::configure] aggregated control board: "
+            << m_useAggregatedControlBoard;
+    if (m_useAggregatedControlBoard && !configureControlBoard(rf))
+    {
+        yError() << "[OculusModule::configure] Unable to configure the aggregated control board";
+        return false;
+    }
+
     // configure head retargeting
     if (!m_useXsens)
     {
         m_head = std::make_unique<HeadRetargeting>();
+        m_head->setInputSession(m_inputSession, "neck/");
+        if (m_useAggregatedControlBoard)
+            m_head->setControlBoard(m_controlBoard);
         yarp::os::Bottle& headOptions = rf.findGroup("HEAD_RETARGETING");
+        setSamplingTime(headOptions, m_scheduler.samplingTime(m_headSubsystem));
         headOptions.append(generalOptions);
         if (!m_head->configure(headOptions, getName()))
         {
@@ -393,7 +518,11 @@ bool OculusModule::configure(yarp::os::ResourceFinder& rf)
     {
         // configure fingers retargeting
         m_leftHandFingers = std::make_unique<FingersRetargeting>();
+        m_leftHandFingers->setInputSession(m_inputSession, "left_fingers/");
+        if (m_useAggregatedControlBoard)
+            m_leftHandFingers->setControlBoard(m_controlBoard);
         yarp::os::Bottle& leftFingersOptions = rf.findGroup("LEFT_FINGERS_RETARGETING");
+        setSamplingTime(leftFingersOptions, m_scheduler.samplingTime(m_fingersSubsystem));
         leftFingersOptions.append(generalOptions);
         if (!m_leftHandFingers->configure(leftFingersOptions, getName()))
         {
@@ -403,7 +532,11 @@ bool OculusModule::configure(yarp::os::ResourceFinder& rf)
         }
 
         m_rightHandFingers = std::make_unique<FingersRetargeting>();
+        m_rightHandFingers->setInputSession(m_inputSession, "right_fingers/");
+        if (m_useAggregatedControlBoard)
+            m_rightHandFingers->setControlBoard(m_controlBoard);
         yarp::os::Bottle& rightFingersOptions = rf.findGroup("RIGHT_FINGERS_RETARGETING");
+        setSamplingTime(rightFingersOptions, m_scheduler.samplingTime(m_fingersSubsystem));
         rightFingersOptions.append(generalOptions);
         if (!m_rightHandFingers->configure(rightFingersOptions, getName()))
         {
@@ -466,6 +599,7 @@ bool OculusModule::configure(yarp::os::ResourceFinder& rf)
         yError() << "[OculusModule::configure] Unable to open the port " << portName;
         return false;
     }
+    m_robotOrientationPort.useCallback(m_robotOrientationMailbox);
 
     if (!YarpHelper::getStringFromSearchable(rf, "playerOrientationPort", portName))
     {
@@ -477,6 +611,7 @@ bool OculusModule::configure(yarp::os::ResourceFinder& rf)
         yError() << "[OculusModule::configure] Unable to open the port " << portName;
         return false;
     }
+    m_playerOrientationPort.useCallback(m_playerOrientationMailbox);
 
     if (!YarpHelper::getStringFromSearchable(rf, "rpcWalkingPort_name", portName))
     {
@@ -489,6 +624,27 @@ bool OculusModule::configure(yarp::os::ResourceFinder& rf)
         return false;
     }
 
+    // the goal is streamed to the walking controller, the RPC port is used only for the state
+    // transitions
+    m_useGoalStreaming = rf.check("goalWalkingPort_name");
+    if (m_useGoalStreaming)
+    {
+        if (!YarpHelper::getStringFromSearchable(rf, "goalWalkingPort_name", portName))
+        {
+            yError() << "[OculusModule::configure] Unable to get a string from a searchable";
+            return false;
+        }
+        if (!m_goalPublisher.open("/" + getName() + portName))
+        {
+            yError() << "[OculusModule::configure] Unable to open the port " << portName;
+            return false;
+        }
+    } else
+    {
+        yWarning() << "[OculusModule::configure] goalWalkingPort_name is not set. The joypad goal "
+                      "is sent through the walking RPC port.";
+    }
+
     if (!YarpHelper::getStringFromSearchable(rf, "rpcVirtualizerPort_name", portName))
     {
         yError() << "[OculusModule::configure] Unable to get a string from a searchable";
@@ -513,6 +669,31 @@ bool OculusModule::configure(yarp::os::ResourceFinder& rf)
         return false;
     }
 
+    // stages of the update module and port used to query their latency
+    m_updateModuleStage = m_profiler.addStage("update_module");
+    m_feedbackReadStage = m_profiler.addStage("feedback_read");
+    m_transformsReadStage = m_profiler.addStage("transforms_read");
+    m_limbsRetargetingStage = m_profiler.addStage("limbs_retargeting");
+    m_headRetargetingStage = m_profiler.addStage("head_retargeting");
+    m_leftHandRetargetingStage = m_profiler.addStage("left_hand_retargeting");
+    m_rightHandRetargetingStage = m_profiler.addStage("right_hand_retargeting");
+    m_locomotionCommandStage = m_profiler.addStage("locomotion_command");
+    m_fingersRetargetingStage = m_profiler.addStage("fingers_retargeting");
+    m_loggingStage = m_profiler.addStage("logging");
+    portName = generalOptions.check("profilerPortName", yarp::os::Value("/profiler/rpc"))
+                   .asString();
+    if (!m_profiler.open("/" + getName() + portName))
+    {
+        yError() << "[OculusModule::configure] Unable to open the profiler port " << portName;
+        return false;
+    }
+
+    if (!configureLimbsPool(generalOptions))
+    {
+        yError() << "[OculusModule::configure] Unable to configure the limbs pool";
+        return false;
+    }
+
     m_playerOrientation = 0;
     m_playerOrientationOld = 0;
     m_robotYaw = 0;
@@ -531,7 +712,8 @@ bool OculusModule::configure(yarp::os::ResourceFinder& rf)
     // Reset the cameras if necessary
     bool resetCameras = generalOptions.check("resetCameras", yarp::os::Value(false)).asBool();
     yInfo() << "[OculusModule::configure] Reset camera: " << resetCameras;
-    if (resetCameras)
+    // the replayed session and the fake devices do not use the cameras
+    if (resetCameras && !m_inputSession.isReplaying() && !FakeDevices::isEnabled())
     {
 
         std::string leftCameraPort, rightCameraPort;
@@ -571,20 +753,33 @@ bool OculusModule::configure(yarp::os::ResourceFinder& rf)
 
 double OculusModule::getPeriod()
 {
-    return m_dT;
+    return m_inputSession.period(m_dT);
 }
 
 bool OculusModule::close()
 {
     std::lock_guard<std::mutex> guard(m_mutex);
 
-#ifdef ENABLE_LOGGER
+    m_limbsPool.close();
+
+    if (m_head != nullptr && m_head->isPredictionUsed())
+    {
+        yInfo() << "[OculusModule::close] RMS of the head orientation error with prediction: "
+                << m_head->headPredictor().rmsPredictionError() << " rad, without prediction: "
+                << m_head->headPredictor().rmsBaselineError() << " rad.";
+    }
+
+    if (m_head != nullptr && m_head->controlHelper()->numberOfReads() > 0)
+    {
+        yInfo() << "[OculusModule::close] Neck feedback reads without new encoder values: "
+                << m_head->controlHelper()->numberOfStaleReads() << " / "
+                << m_head->controlHelper()->numberOfReads();
+    }
+
     if (m_enableLogger)
     {
-        m_logger->flush_available_data();
+        m_recorder.close();
     }
-#endif
-    // m_logger.reset();
 
     // close devices
     if (!m_useXsens)
@@ -598,18 +793,35 @@ bool OculusModule::close()
         m_leftHandFingers->controlHelper()->close();
     }
 
+    if (m_useAggregatedControlBoard)
+    {
+        m_controlBoard.close();
+    }
+
+    // the sampler uses the joypad interface, hence it is stopped before closing the device
+    if (m_useJoypadSampler)
+    {
+        m_joypadSampler.stop();
+        if (m_joypadSampler.droppedEvents() > 0)
+            yWarning() << "[OculusModule::close]" << m_joypadSampler.droppedEvents()
+                       << "joypad button events were dropped.";
+    }
     m_joypadDevice.close();
     m_transformClientDevice.close();
 
     m_rpcOculusServerPort.close();
     m_rpcVirtualizerClient.close();
     m_rpcWalkingClient.close();
+    m_goalPublisher.close();
     m_oculusPositionPort.close();
     m_oculusOrientationPort.close();
     m_imagesOrientationPort.close();
     m_playerOrientationPort.close();
+    m_robotOrientationPort.close();
     m_rightHandPosePort.close();
     m_leftHandPosePort.close();
+    m_profiler.close();
+    m_inputSession.close();
 
     return true;
 }
@@ -644,6 +856,7 @@ bool OculusModule::prepareTeleoperation()
         return false;
     }
 
+    m_inputSession.record(m_commandStream, prepareCommand);
     return this->preparingModule();
 }
 
@@ -660,6 +873,7 @@ bool OculusModule::runTeleoperation()
         return false;
     }
 
+    m_inputSession.record(m_commandStream, runCommand);
     return this->runningModule();
 }
 
@@ -683,20 +897,10 @@ bool OculusModule::runningModule()
 
     if (m_useOpenXr)
     {
-        if (!m_frameTransformInterface->frameExists(m_headFrameName))
-        {
-            yError() << "[OculusModule::runningModule] The frame named " << m_headFrameName
-                     << " does not exist.";
-            yError() << "[OculusModule::runningModule] I will not start the walking. Please "
-                        "try to start again.";
-            return true;
-        }
         yarp::sig::Matrix openXrHeadInitialTransform = identitySE3();
-        if (!m_frameTransformInterface->getTransform(
-                    m_headFrameName, m_rootFrameName, openXrHeadInitialTransform))
+        if (!m_isHeadFrameStreamed
+            || !readTransform(m_headFrameIndex, m_headTransformStream, openXrHeadInitialTransform))
         {
-            yError() << "[OculusModule::runningModule] Unable to evaluate the " << m_headFrameName
-                     << " to " << m_rootFrameName << "transformation";
             yError() << "[OculusModule::runningModule] I will not start the walking. Please "
                         "try to start again.";
             return true;
@@ -779,11 +983,8 @@ double OculusModule::evaluateDesiredFingersVelocity(unsigned int squeezeIndex,
                                                     unsigned int releaseIndex)
 {
     double releaseFingersVelocity = 0.0, squeezeFingersVelocity = 0.0;
-    if (m_joypadControllerInterface)
-    {
-        m_joypadControllerInterface->getAxis(squeezeIndex, squeezeFingersVelocity);
-        m_joypadControllerInterface->getAxis(releaseIndex, releaseFingersVelocity);
-    }
+    getJoypadAxis(squeezeIndex, squeezeFingersVelocity);
+    getJoypadAxis(releaseIndex, releaseFingersVelocity);
 
     if (squeezeFingersVelocity > releaseFingersVelocity)
         return squeezeFingersVelocity;
@@ -793,18 +994,311 @@ double OculusModule::evaluateDesiredFingersVelocity(unsigned int squeezeIndex,
         return 0;
 }
 
+bool OculusModule::retargetHead()
+{
+    INSTRUMENTATION_SCOPE(m_profiler, m_headRetargetingStage);
+    m_head->setPlayerOrientation(m_playerOrientation);
+    if (m_useOpenXr)
+    {
+        m_head->setDesiredHeadOrientationFromOpenXr(m_oculusRoot_T_headOculus);
+    } else
+    {
+        m_head->setDesiredHeadOrientation(m_oculusRoot_T_headOculus);
+    }
+
+    if (m_moveRobot)
+    {
+        if (!m_head->move())
+        {
+            yError() << "[OculusModule::retargetHead] unable to move the head";
+            return false;
+        }
+    }
+    return true;
+}
+
+bool OculusModule::retargetHand(HandRetargeting& hand,
+                                yarp::os::BufferedPort<yarp::sig::Vector>& handPosePort,
+                                const yarp::sig::Matrix& oculusRoot_T_handOculus)
+{
+    INSTRUMENTATION_SCOPE(m_profiler,
+                          &hand == m_leftHand.get() ? m_leftHandRetargetingStage
+                                                    : m_rightHandRetargetingStage);
+
+    // update the hand transformation values
+    yarp::sig::Vector& handPose = handPosePort.prepare();
+    hand.setPlayerOrientation(m_playerOrientation);
+    hand.setHandTransform(oculusRoot_T_handOculus);
+
+    if (m_updateTeleopPosition)
+    {
+        iDynTree::Position teleopPosition = {m_oculusHeadsetPoseInertial[0],
+                                             m_oculusHeadsetPoseInertial[1],
+                                             m_oculusHeadsetPoseInertial[2]};
+        hand.setPlayerPosition(teleopPosition);
+    }
+
+    // evaluate the robot hand pose
+    hand.evaluateDesiredHandPose(handPose);
+
+    // move the robot
+    if (m_moveRobot)
+        handPosePort.write();
+
+    return true;
+}
+
+bool OculusModule::retargetFingers()
+{
+    INSTRUMENTATION_SCOPE(m_profiler, m_fingersRetargetingStage);
+    // left fingers
+    if (!m_leftHandFingers->setFingersVelocity(m_leftFingersVelocity))
+    {
+        yError() << "[OculusModule::retargetFingers] Unable to set the left finger velocity.";
+        return false;
+    }
+    if (m_moveRobot)
+    {
+        if (!m_leftHandFingers->move())
+        {
+            yError() << "[OculusModule::retargetFingers] Unable to move the left finger";
+            return false;
+        }
+    }
+
+    // right fingers
+    if (!m_rightHandFingers->setFingersVelocity(m_rightFingersVelocity))
+    {
+        yError() << "[OculusModule::retargetFingers] Unable to set the right finger velocity.";
+        return false;
+    }
+    if (m_moveRobot)
+    {
+        if (!m_rightHandFingers->move())
+        {
+            yError() << "[OculusModule::retargetFingers] Unable to move the right finger";
+            return false;
+        }
+    }
+    return true;
+}
+
+bool OculusModule::configureScheduler(const yarp::os::Searchable& config)
+{
+    if (!m_scheduler.configure(m_dT))
+        return false;
+
+    return m_scheduler.addSubsystem(config, "head", m_headSubsystem)
+           && m_scheduler.addSubsystem(config, "hands", m_handsSubsystem)
+           && m_scheduler.addSubsystem(config, "fingers", m_fingersSubsystem)
+           && m_scheduler.addSubsystem(config, "locomotion", m_locomotionSubsystem);
+}
+
+bool OculusModule::configureControlBoard(yarp::os::ResourceFinder& rf)
+{
+    if (!m_useXsens && !m_controlBoard.addPart(rf.findGroup("HEAD_RETARGETING"), true))
+    {
+        yError() << "[OculusModule::configureControlBoard] Unable to add the head.";
+        return false;
+    }
+
+    if (!m_useSenseGlove
+        && (!m_controlBoard.addPart(rf.findGroup("LEFT_FINGERS_RETARGETING"), false)
+            || !m_controlBoard.addPart(rf.findGroup("RIGHT_FINGERS_RETARGETING"), false)))
+    {
+        yError() << "[OculusModule::configureControlBoard] Unable to add the fingers.";
+        return false;
+    }
+
+    const std::string robot
+        = rf.findGroup("GENERAL").check("robot", yarp::os::Value("icubSim")).asString();
+    return m_controlBoard.open(robot, getName());
+}
+
+bool OculusModule::configureLimbsPool(const yarp::os::Searchable& config)
+{
+    // a task does nothing in the cycles in which its subsystem is not scheduled
+    if (!m_useXsens)
+        m_limbsPool.addTask(
+            [this] { return !m_scheduler.isActive(m_headSubsystem) || retargetHead(); });
+
+    if (!m_useXsens && !m_useIFeel)
+    {
+        m_limbsPool.addTask([this] {
+            return !m_scheduler.isActive(m_handsSubsystem)
+                   || retargetHand(*m_leftHand, m_leftHandPosePort, m_oculusRoot_T_lOculus);
+        });
+        m_limbsPool.addTask([this] {
+            return !m_scheduler.isActive(m_handsSubsystem)
+                   || retargetHand(*m_rightHand, m_rightHandPosePort, m_oculusRoot_T_rOculus);
+        });
+    }
+
+    if (!m_useSenseGlove)
+        m_limbsPool.addTask(
+            [this] { return !m_scheduler.isActive(m_fingersSubsystem) || retargetFingers(); });
+
+    // the limbs are retargeted in sequence by default
+    const bool enableParallelLimbs
+        = config.check("enableParallelLimbs", yarp::os::Value(false)).asBool();
+    const int numberOfThreads
+        = enableParallelLimbs ? config.check("limbsThreads", yarp::os::Value(3)).asInt32() : 0;
+    if (numberOfThreads < 0)
+    {
+        yError() << "[OculusModule::configureLimbsPool] The number of threads cannot be negative.";
+        return false;
+    }
+    yInfo() << "[OculusModule::configureLimbsPool] parallel limbs: " << enableParallelLimbs;
+
+    return m_limbsPool.start(numberOfThreads);
+}
+
+bool OculusModule::readTransform(const std::size_t& frameIndex,
+                                 const InputSession::Stream& stream,
+                                 yarp::sig::Matrix& transform)
+{
+    // the 4x4 matrix is stored in row-major order
+    Eigen::Map<Eigen::Matrix<double, 16, 1>> transformValues(transform.data());
+
+    if (m_inputSession.isReplaying())
+    {
+        if (!m_inputSession.replay(stream, transformValues.data(), transformValues.size()))
+        {
+            yError() << "[OculusModule::readTransform] Unable to replay the "
+                     << m_transformSnapshot.frameName(frameIndex) << " to " << m_rootFrameName
+                     << "transformation";
+            return false;
+        }
+        return true;
+    }
+
+    if (!m_transformSnapshot.isValid(frameIndex))
+    {
+        yError() << "[OculusModule::readTransform] Unable to evaluate the "
+                 << m_transformSnapshot.frameName(frameIndex) << " to " << m_rootFrameName
+                 << "transformation";
+        return false;
+    }
+
+    transformValues = Eigen::Map<const Eigen::Matrix<double, 16, 1>>(
+        m_transformSnapshot.transform(frameIndex).data());
+
+    m_inputSession.record(stream, transformValues);
+    return true;
+}
+
+bool OculusModule::readHeadsetPort(yarp::os::BufferedPort<yarp::os::Bottle>& port,
+                                   const InputSession::Stream& stream,
+                                   yarp::sig::Vector& values)
+{
+    if (m_inputSession.isReplaying())
+        return m_inputSession.replay(stream, values);
+
+    yarp::os::Bottle* bottle = port.read(false);
+    if (bottle == nullptr)
+        return false;
+
+    if (values.size() != bottle->size())
+        values.resize(bottle->size());
+    for (size_t i = 0; i < bottle->size(); i++)
+        values(i) = bottle->get(i).asFloat64();
+
+    m_inputSession.record(stream, values);
+    return true;
+}
+
+void OculusModule::readJoypadSampler()
+{
+    if (!m_useJoypadSampler)
+        return;
+
+    // the buttons released before the end of the cycle are considered pressed in this cycle
+    m_joypadSampler.read(m_joypadSnapshot);
+    m_pressedJoypadButtons.reset();
+    JoypadSampler::ButtonEvent event;
+    while (m_joypadSampler.popEvent(event))
+    {
+        if (event.isPressed)
+            m_pressedJoypadButtons.set(event.button);
+    }
+}
+
+bool OculusModule::getJoypadAxis(unsigned int index, double& value)
+{
+    if (m_inputSession.isReplaying())
+        return m_inputSession.replay(m_joypadAxisStream, &value, 1);
+
+    if (m_useJoypadSampler)
+    {
+        if (index >= m_joypadSnapshot.numberOfAxes)
+            return false;
+        value = m_joypadSnapshot.axes[index];
+    } else if (m_joypadControllerInterface == nullptr
+               || !m_joypadControllerInterface->getAxis(index, value))
+        return false;
+
+    m_inputSession.record(m_joypadAxisStream, value);
+    return true;
+}
+
+bool OculusModule::getJoypadButton(unsigned int index, float& value)
+{
+    double buttonValue = value;
+    if (m_inputSession.isReplaying())
+    {
+        if (!m_inputSession.replay(m_joypadButtonStream, &buttonValue, 1))
+            return false;
+        value = static_cast<float>(buttonValue);
+        return true;
+    }
+
+    if (m_useJoypadSampler)
+    {
+        if (index >= m_joypadSnapshot.numberOfButtons)
+            return false;
+        value = m_joypadSnapshot.buttons[index];
+        if (m_pressedJoypadButtons.test(index) && value <= 0)
+            value = 1;
+    } else if (m_joypadControllerInterface == nullptr
+               || !m_joypadControllerInterface->getButton(index, value))
+        return false;
+
+    // the recorded value is the one used by the module, so the replay does not need the events
+    m_inputSession.record(m_joypadButtonStream, static_cast<double>(value));
+    return true;
+}
+
+void OculusModule::replayCommands()
+{
+    double command;
+    while (m_inputSession.replay(m_commandStream, &command, 1))
+    {
+        if (command == prepareCommand)
+            preparingModule();
+        else if (command == runCommand)
+            runningModule();
+    }
+}
+
 bool OculusModule::getTransforms()
 {
     if (!m_useXsens)
     {
-        // check if everything is ok
-        if (!m_frameTransformInterface->frameExists(m_rootFrameName))
+        // read all the transforms at once
+        if (!m_inputSession.isReplaying()
+            && !m_transformSnapshot.update(*m_frameTransformInterface, yarp::os::Time::now()))
         {
             yError() << "[OculusModule::getTransforms] No " << m_rootFrameName << " frame.";
             return false;
         }
 
-        if (!m_frameTransformInterface->frameExists(m_headFrameName))
+        // a replayed session contains the head transform only if it was streamed by the
+        // transform server
+        const bool headFrameExists
+            = m_inputSession.isReplaying()
+                  ? m_inputSession.hasSample(m_headTransformStream)
+                  : m_isHeadFrameStreamed && m_transformSnapshot.isValid(m_headFrameIndex);
+        if (!headFrameExists)
         {
 
             if (m_useOpenXr)
@@ -816,14 +1310,12 @@ bool OculusModule::getTransforms()
 
             // head
             // get head orientation
-            yarp::os::Bottle* desiredHeadOrientation = NULL;
-            iDynTree::Vector3 desiredHeadOrientationVector;
-            desiredHeadOrientation = m_oculusOrientationPort.read(false);
-            if (desiredHeadOrientation != NULL)
+            if (readHeadsetPort(
+                    m_oculusOrientationPort, m_oculusOrientationStream, m_headsetPortValues))
             {
-                for (int i = 0; i < desiredHeadOrientation->size(); i++)
-                    desiredHeadOrientationVector(i)
-                        = iDynTree::deg2rad(desiredHeadOrientation->get(i).asFloat64());
+                iDynTree::Vector3 desiredHeadOrientationVector;
+                for (int i = 0; i < m_headsetPortValues.size(); i++)
+                    desiredHeadOrientationVector(i) = iDynTree::deg2rad(m_headsetPortValues(i));
 
                 // Notice that the data coming from the port are written in the following order:
                 // [ pitch, -roll, yaw].
@@ -838,14 +1330,11 @@ bool OculusModule::getTransforms()
             }
 
             // get head position
-            yarp::os::Bottle* desiredHeadPosition = NULL;
-            desiredHeadPosition = m_oculusPositionPort.read(false);
-            if (desiredHeadPosition != NULL)
+            if (readHeadsetPort(m_oculusPositionPort, m_oculusPositionStream, m_headsetPortValues))
             {
-                for (unsigned i = 0; i < desiredHeadPosition->size(); i++)
+                for (unsigned i = 0; i < m_headsetPortValues.size(); i++)
                 {
-                    getPosition(m_oculusRoot_T_headOculus)(i)
-                        = desiredHeadPosition->get(i).asFloat64();
+                    getPosition(m_oculusRoot_T_headOculus)(i) = m_headsetPortValues(i);
                 }
 
                 // the data coming from oculus vr is with the following order:
@@ -858,11 +1347,9 @@ bool OculusModule::getTransforms()
 
         } else
         {
-            if (!m_frameTransformInterface->getTransform(
-                    m_headFrameName, m_rootFrameName, m_oculusRoot_T_headOculus))
+            if (!readTransform(m_headFrameIndex, m_headTransformStream, m_oculusRoot_T_headOculus))
             {
-                yError() << "[OculusModule::getTransforms] Unable to evaluate the "
-                         << m_headFrameName << " to " << m_rootFrameName << "transformation";
+                yError() << "[OculusModule::getTransforms] Unable to get the head transform.";
                 return false;
             }
 
@@ -890,33 +1377,16 @@ bool OculusModule::getTransforms()
 
     if (!m_useXsens && !m_useIFeel)
     {
-
-        if (!m_frameTransformInterface->frameExists(m_leftHandFrameName))
-        {
-
-            yError() << "[OculusModule::getTransforms] No " << m_leftHandFrameName << " frame.";
-            return false;
-        }
-
-        if (!m_frameTransformInterface->frameExists(m_rightHandFrameName))
-        {
-            yError() << "[OculusModule::getTransforms] No " << m_rightHandFrameName << " frame.";
-            return false;
-        }
-
-        if (!m_frameTransformInterface->getTransform(
-                m_leftHandFrameName, m_rootFrameName, m_oculusRoot_T_lOculus))
+        if (!readTransform(m_leftHandFrameIndex, m_leftHandTransformStream, m_oculusRoot_T_lOculus))
         {
-            yError() << "[OculusModule::getTransforms] Unable to evaluate the "
-                     << m_leftHandFrameName << " to " << m_rootFrameName << "transformation";
+            yError() << "[OculusModule::getTransforms] Unable to get the left hand transform.";
             return false;
         }
 
-        if (!m_frameTransformInterface->getTransform(
-                m_rightHandFrameName, m_rootFrameName, m_oculusRoot_T_rOculus))
+        if (!readTransform(
+                m_rightHandFrameIndex, m_rightHandTransformStream, m_oculusRoot_T_rOculus))
         {
-            yError() << "[OculusModule::getTransforms] Unable to evaluate the "
-                     << m_rightHandFrameName << " to " << m_rootFrameName << "transformation";
+            yError() << "[OculusModule::getTransforms] Unable to get the right hand transform.";
             return false;
         }
     }
@@ -925,6 +1395,13 @@ bool OculusModule::getTransforms()
 
 bool OculusModule::getFeedbacks()
 {
+    // a single read for all the parts of the shared board
+    if (m_useAggregatedControlBoard && !m_controlBoard.readEncoders())
+    {
+        yError() << "[OculusModule::getFeedbacks] Unable to get the joint encoders feedback: "
+                    "aggregated control board";
+        return false;
+    }
 
     if (!m_useXsens)
     {
@@ -934,7 +1411,6 @@ bool OculusModule::getFeedbacks()
                         "HeadRetargeting";
             return false;
         }
-        m_head->controlHelper()->updateTimeStamp();
     }
 
     return true;
@@ -944,167 +1420,141 @@ bool OculusModule::updateModule()
 {
     std::lock_guard<std::mutex> guard(m_mutex);
 
-    if (!getFeedbacks())
-    {
-        yError() << "[OculusModule::updateModule] Unable to get the feedback";
+    // the commands are received through the RPC port between two cycles
+    if (m_inputSession.isReplaying())
+        replayCommands();
+    if (!m_inputSession.beginCycle())
         return false;
+    m_scheduler.startCycle();
+
+    INSTRUMENTATION_SCOPE(m_profiler, m_updateModuleStage);
+
+    {
+        INSTRUMENTATION_SCOPE(m_profiler, m_feedbackReadStage);
+        if (!getFeedbacks())
+        {
+            yError() << "[OculusModule::updateModule] Unable to get the feedback";
+            return false;
+        }
+        readJoypadSampler();
     }
 
     if (m_state == OculusFSM::Running)
     {
 
         // get the transformation form the oculus
-        if (!getTransforms())
         {
-            yError() << "[OculusModule::updateModule] Unable to get the transform";
-            return false;
+            INSTRUMENTATION_SCOPE(m_profiler, m_transformsReadStage);
+            if (!getTransforms())
+            {
+                yError() << "[OculusModule::updateModule] Unable to get the transform";
+                return false;
+            }
         }
 
         if (m_useVirtualizer)
         {
             // in the future the transform server will be used
-            yarp::sig::Vector* playerOrientation = m_playerOrientationPort.read(false);
-            if (playerOrientation != nullptr)
-                m_playerOrientation = (*playerOrientation)(0);
-
-            // used for the image inside the oculus
-            yarp::sig::Vector* robotOrientation = m_robotOrientationPort.read(false);
-            if (robotOrientation != NULL)
-                m_robotYaw = Angles::normalizeAngle((*robotOrientation)(0));
-        }
-
-        if (!m_useXsens)
-        {
-            m_head->setPlayerOrientation(m_playerOrientation);
-            if (m_useOpenXr)
+            // the ports are read by their own threads, the mailboxes never block the loop
+            if (m_inputSession.isReplaying())
             {
-                m_head->setDesiredHeadOrientationFromOpenXr(m_oculusRoot_T_headOculus);
+                m_inputSession.replay(m_playerOrientationStream, &m_playerOrientation, 1);
+
+                double robotYaw;
+                if (m_inputSession.replay(m_robotOrientationStream, &robotYaw, 1))
+                    m_robotYaw = Angles::normalizeAngle(robotYaw);
             } else
             {
-                m_head->setDesiredHeadOrientation(m_oculusRoot_T_headOculus);
-            }
-            // m_head->setDesiredHeadOrientation(desiredHeadOrientationVector(0),
-            // desiredHeadOrientationVector(1), desiredHeadOrientationVector(2));
-            if (m_moveRobot)
-            {
-                if (!m_head->move())
+                const yarp::sig::Vector* playerOrientation = m_playerOrientationMailbox.read();
+                if (playerOrientation != nullptr)
                 {
-                    yError() << "[updateModule::updateModule] unable to move the head";
-                    return false;
+                    m_playerOrientation = (*playerOrientation)(0);
+                    m_inputSession.record(m_playerOrientationStream, m_playerOrientation);
                 }
-            }
-        }
-        if (!m_useXsens && !m_useIFeel)
-        {
-            // update left hand transformation values
-            yarp::sig::Vector& leftHandPose = m_leftHandPosePort.prepare();
-            m_leftHand->setPlayerOrientation(m_playerOrientation);
-            m_leftHand->setHandTransform(m_oculusRoot_T_lOculus);
 
-            // update right hand transformation values
-            yarp::sig::Vector& rightHandPose = m_rightHandPosePort.prepare();
-            m_rightHand->setPlayerOrientation(m_playerOrientation);
-            m_rightHand->setHandTransform(m_oculusRoot_T_rOculus);
-
-            if (m_useVirtualizer)
-            {
-                if (std::abs(m_playerOrientation - m_playerOrientationOld)
-                    > m_playerOrientationThreshold)
+                // used for the image inside the oculus
+                const yarp::sig::Vector* robotOrientation = m_robotOrientationMailbox.read();
+                if (robotOrientation != NULL)
                 {
-                    iDynTree::Position teleopPosition = {m_oculusHeadsetPoseInertial[0],
-                                                         m_oculusHeadsetPoseInertial[1],
-                                                         m_oculusHeadsetPoseInertial[2]};
-
-                    m_leftHand->setPlayerPosition(teleopPosition);
-                    m_rightHand->setPlayerPosition(teleopPosition);
-                    m_playerOrientationOld = m_playerOrientation;
+                    m_robotYaw = Angles::normalizeAngle((*robotOrientation)(0));
+                    m_inputSession.record(m_robotOrientationStream, (*robotOrientation)(0));
                 }
             }
-
-            // evaluate the robot hands' pose
-            m_leftHand->evaluateDesiredHandPose(leftHandPose);
-            m_rightHand->evaluateDesiredHandPose(rightHandPose);
-
-            // move the robot
-            if (m_moveRobot)
-            {
-                m_leftHandPosePort.write();
-                m_rightHandPosePort.write();
-            }
         }
 
         // use joypad
-        std::vector<double> locCmd;
-        if (!m_useVirtualizer)
+        bool isLocomotionUpdated = false;
+        if (!m_useVirtualizer && m_scheduler.isActive(m_locomotionSubsystem))
         {
+            INSTRUMENTATION_SCOPE(m_profiler, m_locomotionCommandStage);
             yarp::os::Bottle cmd, outcome;
             double x = 0.0, y = 0.0;
-            if (m_joypadControllerInterface)
-            {
-                m_joypadControllerInterface->getAxis(m_xJoypadIndex, x);
-                m_joypadControllerInterface->getAxis(m_yJoypadIndex, y);
-            }
+            getJoypadAxis(m_xJoypadIndex, x);
+            getJoypadAxis(m_yJoypadIndex, y);
 
             x = -m_scaleX * deadzone(x);
             y = m_scaleY * deadzone(y);
             std::swap(x, y);
 
-            cmd.addString("setGoal");
-            cmd.addFloat64(x);
-            cmd.addFloat64(y);
             if (m_moveRobot)
             {
-                m_rpcWalkingClient.write(cmd, outcome);
+                if (m_useGoalStreaming)
+                    m_goalPublisher.publish(x, y);
+                else
+                {
+                    cmd.addString("setGoal");
+                    cmd.addFloat64(x);
+                    cmd.addFloat64(y);
+                    m_rpcWalkingClient.write(cmd, outcome);
+                }
             }
-            locCmd.push_back(x);
-            locCmd.push_back(y);
+            m_loggerBuffers.locomotionJoypad[0] = x;
+            m_loggerBuffers.locomotionJoypad[1] = y;
+            isLocomotionUpdated = true;
         }
 
-        if (!m_useSenseGlove)
+        // the inputs of the limbs are read before dispatching the limbs, so the input session is
+        // accessed by this thread only
+        if (!m_useSenseGlove && m_scheduler.isActive(m_fingersSubsystem))
         {
-            // left fingers
-            double leftFingersVelocity
+            m_leftFingersVelocity
                 = evaluateDesiredFingersVelocity(m_squeezeLeftIndex, m_releaseLeftIndex);
-            if (!m_leftHandFingers->setFingersVelocity(leftFingersVelocity))
+            m_rightFingersVelocity
+                = evaluateDesiredFingersVelocity(m_squeezeRightIndex, m_releaseRightIndex);
+        }
+
+        if (m_useVirtualizer
+            && std::abs(m_playerOrientation - m_playerOrientationOld)
+                   > m_playerOrientationThreshold)
+        {
+            m_updateTeleopPosition = true;
+            m_playerOrientationOld = m_playerOrientation;
+        }
+
+        // head, hands and fingers (in parallel if enabled)
+        {
+            INSTRUMENTATION_SCOPE(m_profiler, m_limbsRetargetingStage);
+            if (!m_limbsPool.run())
             {
-                yError() << "[OculusModule::updateModule] Unable to set the left finger velocity.";
+                yError() << "[OculusModule::updateModule] Unable to retarget the limbs.";
                 return false;
             }
-            if (m_moveRobot)
-            {
-                if (!m_leftHandFingers->move())
-                {
-                    yError() << "[OculusModule::updateModule] Unable to move the left finger";
-                    return false;
-                }
-            }
 
-            // right fingers
-            double rightFingersVelocity
-                = evaluateDesiredFingersVelocity(m_squeezeRightIndex, m_releaseRightIndex);
-            if (!m_rightHandFingers->setFingersVelocity(rightFingersVelocity))
+            // the references of the head and of the fingers are sent together
+            if (m_useAggregatedControlBoard && m_moveRobot && !m_controlBoard.writeReferences())
             {
-                yError() << "[OculusModule::updateModule] Unable to set the right finger velocity.";
+                yError() << "[OculusModule::updateModule] Unable to move the head and the fingers.";
                 return false;
             }
-            if (m_moveRobot)
-            {
-                if (!m_rightHandFingers->move())
-                {
-                    yError() << "[OculusModule::updateModule] Unable to move the right finger";
-                    return false;
-                }
-            }
         }
+        if (m_scheduler.isActive(m_handsSubsystem))
+            m_updateTeleopPosition = false;
 
         // check if it is time to prepare or start walking
         float buttonMapping = -1.0;
 
-        if (m_joypadControllerInterface)
-        {
-            // prepare robot (A button)
-            m_joypadControllerInterface->getButton(m_stopWalkingIndex, buttonMapping);
-        }
+        // prepare robot (A button)
+        getJoypadButton(m_stopWalkingIndex, buttonMapping);
 
         yarp::os::Bottle cmd, outcome;
 
@@ -1120,87 +1570,89 @@ bool OculusModule::updateModule()
             return false;
         }
 
-#ifdef ENABLE_LOGGER
         if (m_enableLogger)
         {
-            m_logger->add(m_logger_prefix + "_time", yarp::os::Time::now());
-            m_logger->add(m_logger_prefix + "_playerOrientation", m_playerOrientation);
+            INSTRUMENTATION_SCOPE(m_profiler, m_loggingStage);
+            // in replay mode the time of the replayed cycle is used, so that the age of the
+            // replayed feedback is the recorded one
+            const double now = m_inputSession.time(m_timeStream);
+            m_recorder.set(m_loggerChannels.time, now);
+            m_recorder.set(m_loggerChannels.playerOrientation, m_playerOrientation);
             if (m_moveRobot)
             {
-                m_logger->add(m_logger_prefix + "_robotYaw", m_robotYaw);
+                m_recorder.set(m_loggerChannels.robotYaw, m_robotYaw);
             } else
             {
-                m_logger->add(m_logger_prefix + "_robotYaw", 0.0);
+                m_recorder.set(m_loggerChannels.robotYaw, 0.0);
             }
 
-            std::vector<double> neckAngles;
-            yarp::sig::Vector neckValuesSig;
-            m_head->getNeckJointValues(neckValuesSig);
-            for (unsigned i = 0; i < neckValuesSig.size(); i++)
+            // the feedback of the neck was read at the beginning of the cycle
+            if (m_head != nullptr)
             {
-                neckAngles.push_back(neckValuesSig(i));
+                m_recorder.set(m_loggerChannels.neckJointValues,
+                               m_head->controlHelper()->jointEncoders());
+                m_recorder.set(m_loggerChannels.neckFeedbackAge,
+                               m_head->controlHelper()->feedbackAge(now));
             }
-            m_logger->add(m_logger_prefix + "_neckJointValues", neckAngles);
 
-            std::vector<double> lFingers, rFingers;
-            m_leftHandFingers->getFingerValues(lFingers);
-            m_rightHandFingers->getFingerValues(rFingers);
-            if (lFingers.size() > 0)
+            m_leftHandFingers->getFingerValues(m_loggerBuffers.leftFingerValues);
+            m_rightHandFingers->getFingerValues(m_loggerBuffers.rightFingerValues);
+            m_recorder.set(m_loggerChannels.leftFingerValues, m_loggerBuffers.leftFingerValues);
+            m_recorder.set(m_loggerChannels.rightFingerValues, m_loggerBuffers.rightFingerValues);
+
+            m_leftHand->getHandInfo(m_loggerBuffers.leftRobotHandposeRobotTeleoperation,
+                                    m_loggerBuffers.leftHumanHandposeOculusInertial,
+                                    m_loggerBuffers.leftHumanHandposeHumanTeleoperation);
+            m_recorder.set(m_loggerChannels.leftRobotHandposeRobotTeleoperation,
+                           m_loggerBuffers.leftRobotHandposeRobotTeleoperation);
+            m_recorder.set(m_loggerChannels.leftHumanHandposeOculusInertial,
+                           m_loggerBuffers.leftHumanHandposeOculusInertial);
+            m_recorder.set(m_loggerChannels.leftHumanHandposeHumanTeleoperation,
+                           m_loggerBuffers.leftHumanHandposeHumanTeleoperation);
+
+            m_rightHand->getHandInfo(m_loggerBuffers.rightRobotHandposeRobotTeleoperation,
+                                     m_loggerBuffers.rightHumanHandposeOculusInertial,
+                                     m_loggerBuffers.rightHumanHandposeHumanTeleoperation);
+            m_recorder.set(m_loggerChannels.rightRobotHandposeRobotTeleoperation,
+                           m_loggerBuffers.rightRobotHandposeRobotTeleoperation);
+            m_recorder.set(m_loggerChannels.rightHumanHandposeOculusInertial,
+                           m_loggerBuffers.rightHumanHandposeOculusInertial);
+            m_recorder.set(m_loggerChannels.rightHumanHandposeHumanTeleoperation,
+                           m_loggerBuffers.rightHumanHandposeHumanTeleoperation);
+
+            m_recorder.set(m_loggerChannels.oculusHeadsetInertial,
+                           m_oculusHeadsetPoseInertial); // pose sizein 3D space
+
+            if (m_head != nullptr)
             {
-                m_logger->add(m_logger_prefix + "_leftFingerValues", lFingers);
+                m_head->getPredictionErrors(m_loggerBuffers.headPredictionErrors[0],
+                                            m_loggerBuffers.headPredictionErrors[1]);
+                m_recorder.set(m_loggerChannels.headPredictionError,
+                               m_loggerBuffers.headPredictionErrors);
             }
-            if (rFingers.size() > 0)
+
+            // the channel keeps its value in the cycles without locomotion
+            if (isLocomotionUpdated)
             {
-                m_logger->add(m_logger_prefix + "_rightFingerValues", rFingers);
+                m_recorder.set(m_loggerChannels.locomotionJoypad, m_loggerBuffers.locomotionJoypad);
             }
 
-            std::vector<double> left_robotHandpose_robotTel, left_humanHandpose_oculusInertial,
-                left_humanHandpose_humanTel;
-            m_leftHand->getHandInfo(left_robotHandpose_robotTel,
-                                    left_humanHandpose_oculusInertial,
-                                    left_humanHandpose_humanTel);
-
-            m_logger->add(m_logger_prefix + "_left_robotHandpose_robotTeleoperation",
-                          left_robotHandpose_robotTel);
-            m_logger->add(m_logger_prefix + "_left_humanHandpose_oculusInertial",
-                          left_humanHandpose_oculusInertial);
-            m_logger->add(m_logger_prefix + "_left_humanHandpose_humanTeleoperation",
-                          left_humanHandpose_humanTel);
-
-            std::vector<double> right_robotHandpose_robotTel, right_humanHandpose_oculusInertial,
-                right_humanHandpose_humanTel;
-            m_rightHand->getHandInfo(right_robotHandpose_robotTel,
-                                     right_humanHandpose_oculusInertial,
-                                     right_humanHandpose_humanTel);
-
-            m_logger->add(m_logger_prefix + "_right_robotHandpose_robotTeleoperation",
-                          right_robotHandpose_robotTel);
-            m_logger->add(m_logger_prefix + "_right_humanHandpose_oculusInertial",
-                          right_humanHandpose_oculusInertial);
-            m_logger->add(m_logger_prefix + "_right_humanHandpose_humanTeleoperation",
-                          right_humanHandpose_humanTel);
-
-            m_logger->add(m_logger_prefix + "_oculusHeadset_Inertial",
-                          m_oculusHeadsetPoseInertial); // pose sizein 3D space
-
-            if (!m_useVirtualizer)
+            // the whole record is handed to the writer thread at once
+            if (!m_recorder.commit() && m_recorder.isWriterFailed())
             {
-                m_logger->add(m_logger_prefix + "_loc_joypad_x_y", locCmd);
+                yError() << "[OculusModule::updateModule] Unable to write the log file, the "
+                            "logger is stopped.";
+                m_recorder.close();
+                m_enableLogger = false;
             }
-
-            m_logger->flush_available_data();
         }
-#endif
     } else if (m_state == OculusFSM::Configured)
     {
         // check if it is time to prepare or start walking
         float buttonMapping = -1.0;
 
-        if (m_joypadControllerInterface)
-        {
-            // prepare robot (A button)
-            m_joypadControllerInterface->getButton(m_prepareWalkingIndex, buttonMapping);
-        }
+        // prepare robot (A button)
+        getJoypadButton(m_prepareWalkingIndex, buttonMapping);
         if (buttonMapping > 0)
         {
             this->preparingModule();
@@ -1210,10 +1662,11 @@ bool OculusModule::updateModule()
     {
         if (!m_useXsens)
         {
-            if (m_moveRobot)
+            if (m_moveRobot && m_scheduler.isActive(m_headSubsystem))
             {
                 m_head->initializeNeckJointValues();
-                if (!m_head->move())
+                if (!m_head->move()
+                    || (m_useAggregatedControlBoard && !m_controlBoard.writeReferences()))
                 {
                     yError() << "[updateModule::updateModule] unable to move the head";
                     return false;
@@ -1222,11 +1675,8 @@ bool OculusModule::updateModule()
         }
 
         float buttonMapping = -1.0;
-        if (m_joypadControllerInterface)
-        {
-            // start walking (X button)
-            m_joypadControllerInterface->getButton(m_startWalkingIndex, buttonMapping);
-        }
+        // start walking (X button)
+        getJoypadButton(m_startWalkingIndex, buttonMapping);
         if (buttonMapping > 0)
         {
             this->runningModule();
@@ -1255,49 +1705,76 @@ double OculusModule::deadzone(const double& input)
 
 bool OculusModule::openLogger()
 {
-#ifdef ENABLE_LOGGER
     std::string currentTime = YarpHelper::getTimeDateMatExtension();
-    std::string fileName = "OculusModule" + currentTime + "log.mat";
-
-    m_logger = XBot::MatLogger2::MakeLogger(fileName);
-    m_appender = XBot::MatAppender::MakeInstance();
-    m_appender->add_logger(m_logger);
-    m_appender->start_flush_thread();
-
-    m_logger->create(m_logger_prefix + "_time", 1);
-    m_logger->create(m_logger_prefix + "_playerOrientation", 1);
-
-    m_logger->create(m_logger_prefix + "_robotYaw", 1);
-
-    m_logger->create(m_logger_prefix + "_neckJointValues", m_head->controlHelper()->getDoFs());
-    m_logger->create(m_logger_prefix + "_leftFingerValues",
-                     m_leftHandFingers->controlHelper()->getDoFs());
-    m_logger->create(m_logger_prefix + "_rightFingerValues",
-                     m_rightHandFingers->controlHelper()->getDoFs());
-
-    m_logger->create(m_logger_prefix + "_left_robotHandpose_robotTeleoperation",
-                     6); // pose sizein 3D space
-    m_logger->create(m_logger_prefix + "_left_humanHandpose_oculusInertial",
-                     6); // pose sizein 3D space
-    m_logger->create(m_logger_prefix + "_left_humanHandpose_humanTeleoperation",
-                     6); // pose sizein 3D space
-
-    m_logger->create(m_logger_prefix + "_right_robotHandpose_robotTeleoperation",
-                     6); // pose sizein 3D space
-    m_logger->create(m_logger_prefix + "_right_humanHandpose_oculusInertial",
-                     6); // pose sizein 3D space
-    m_logger->create(m_logger_prefix + "_right_humanHandpose_humanTeleoperation",
-                     6); // pose sizein 3D space
-    m_logger->create(m_logger_prefix + "_oculusHeadset_Inertial",
-                     6); // pose sizein 3D space
-
-    m_logger->create(m_logger_prefix + "_loc_joypad_x_y",
-                     2); // [x,y] component for robot locomotion
-    yInfo() << "[OculusModule::openLogger] Logging is active.";
-#else
-    yInfo() << "[OculusModule::openLogger] option is not active in CMakeLists.";
+    std::string fileName = "OculusModule" + currentTime + "log.bin";
+
+    m_loggerChannels.time = m_recorder.addChannel(m_logger_prefix + "_time", 1);
+    m_loggerChannels.playerOrientation
+        = m_recorder.addChannel(m_logger_prefix + "_playerOrientation", 1);
+
+    m_loggerChannels.robotYaw = m_recorder.addChannel(m_logger_prefix + "_robotYaw", 1);
+
+    m_loggerChannels.neckJointValues = m_recorder.addChannel(
+        m_logger_prefix + "_neckJointValues", m_head->controlHelper()->getDoFs());
+    // time elapsed since the neck joint values were measured
+    m_loggerChannels.neckFeedbackAge
+        = m_recorder.addChannel(m_logger_prefix + "_neckFeedbackAge", 1);
+    m_loggerChannels.leftFingerValues = m_recorder.addChannel(
+        m_logger_prefix + "_leftFingerValues", m_leftHandFingers->controlHelper()->getDoFs());
+    m_loggerChannels.rightFingerValues = m_recorder.addChannel(
+        m_logger_prefix + "_rightFingerValues", m_rightHandFingers->controlHelper()->getDoFs());
+
+    // pose size in 3D space
+    m_loggerChannels.leftRobotHandposeRobotTeleoperation
+        = m_recorder.addChannel(m_logger_prefix + "_left_robotHandpose_robotTeleoperation", 6);
+    m_loggerChannels.leftHumanHandposeOculusInertial
+        = m_recorder.addChannel(m_logger_prefix + "_left_humanHandpose_oculusInertial", 6);
+    m_loggerChannels.leftHumanHandposeHumanTeleoperation
+        = m_recorder.addChannel(m_logger_prefix + "_left_humanHandpose_humanTeleoperation", 6);
+
+    m_loggerChannels.rightRobotHandposeRobotTeleoperation
+        = m_recorder.addChannel(m_logger_prefix + "_right_robotHandpose_robotTeleoperation", 6);
+    m_loggerChannels.rightHumanHandposeOculusInertial
+        = m_recorder.addChannel(m_logger_prefix + "_right_humanHandpose_oculusInertial", 6);
+    m_loggerChannels.rightHumanHandposeHumanTeleoperation
+        = m_recorder.addChannel(m_logger_prefix + "_right_humanHandpose_humanTeleoperation", 6);
+    m_loggerChannels.oculusHeadsetInertial
+        = m_recorder.addChannel(m_logger_prefix + "_oculusHeadset_Inertial", 6);
+
+    // [prediction error, error without prediction] of the headset orientation
+    m_loggerChannels.headPredictionError
+        = m_recorder.addChannel(m_logger_prefix + "_headPredictionError", 2);
+
+    // [x,y] component for robot locomotion
+    m_loggerChannels.locomotionJoypad
+        = m_recorder.addChannel(m_logger_prefix + "_loc_joypad_x_y", 2);
+
+    // the buffers are allocated here, so the logging does not allocate memory in the loop
+    const std::size_t handPoseSize = 6;
+    m_loggerBuffers.leftFingerValues.resize(m_leftHandFingers->controlHelper()->getDoFs());
+    m_loggerBuffers.rightFingerValues.resize(m_rightHandFingers->controlHelper()->getDoFs());
+    m_loggerBuffers.leftRobotHandposeRobotTeleoperation.resize(handPoseSize);
+    m_loggerBuffers.leftHumanHandposeOculusInertial.resize(handPoseSize);
+    m_loggerBuffers.leftHumanHandposeHumanTeleoperation.resize(handPoseSize);
+    m_loggerBuffers.rightRobotHandposeRobotTeleoperation.resize(handPoseSize);
+    m_loggerBuffers.rightHumanHandposeOculusInertial.resize(handPoseSize);
+    m_loggerBuffers.rightHumanHandposeHumanTeleoperation.resize(handPoseSize);
+
+    // the file is preallocated for 10 minutes of data, then it is enlarged if needed
+    if (!m_recorder.open(fileName, static_cast<std::size_t>(600.0 / m_dT)))
+    {
+        yError() << "[OculusModule::openLogger] Unable to open the log file " << fileName;
+        return false;
+    }
 
-#endif
+    // the file is written by a background thread, the queue holds one second of data
+    if (!m_recorder.startWriter(static_cast<std::size_t>(1.0 / m_dT) + 1))
+    {
+        yError() << "[OculusModule::openLogger] Unable to start the writer of the log file.";
+        return false;
+    }
+
+    yInfo() << "[OculusModule::openLogger] Logging is active.";
     return true;
 }
 
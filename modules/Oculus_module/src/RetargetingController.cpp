@@ -8,6 +8,18 @@
 
 #include <RetargetingController.hpp>
 
+void RetargetingController::setInputSession(InputSession& inputSession,
+                                            const std::string& streamPrefix)
+{
+    m_inputSession = &inputSession;
+    m_inputStreamPrefix = streamPrefix;
+}
+
+void RetargetingController::setControlBoard(AggregatedControlBoard& controlBoard)
+{
+    m_controlBoard = &controlBoard;
+}
+
 bool RetargetingController::move()
 {
     return m_controlHelper->setJointReference(m_desiredJointValue);
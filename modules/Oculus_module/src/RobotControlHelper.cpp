@@ -6,20 +6,35 @@
  * @date 2018
  */
 
+#include <algorithm>
+#include <array>
 #include <limits>
 
 // iDynTree
 #include <iDynTree/Core/Utils.h>
+#include <iDynTree/yarp/YARPEigenConversions.h>
 
+#include <FakeDevices.hpp>
 #include <RobotControlHelper.hpp>
 #include <Utils.hpp>
 
 bool RobotControlHelper::configure(const yarp::os::Searchable& config,
                                    const std::string& name,
-                                   bool isMandatory)
+                                   bool isMandatory,
+                                   InputSession* inputSession,
+                                   const std::string& streamPrefix,
+                                   AggregatedControlBoard* controlBoard)
 {
     m_isMandatory = isMandatory;
 
+    m_inputSession = inputSession;
+    if (m_inputSession != nullptr)
+    {
+        m_encodersStream = m_inputSession->addStream(streamPrefix + "encoders");
+        m_limitsStream = m_inputSession->addStream(streamPrefix + "limits");
+        m_encoderTimeStampsStream = m_inputSession->addStream(streamPrefix + "encoders_time");
+    }
+
     // robot name: used to connect to the robot
     std::string robot;
     robot = config.check("robot", yarp::os::Value("icubSim")).asString();
@@ -76,7 +91,46 @@ bool RobotControlHelper::configure(const yarp::os::Searchable& config,
     bool useVelocity = config.check("useVelocity", yarp::os::Value(false)).asBool();
     m_controlMode = useVelocity ? VOCAB_CM_VELOCITY : VOCAB_CM_POSITION_DIRECT;
 
+    m_desiredJointValue.resize(m_actuatedDOFs);
+    m_positionFeedbackInDegrees.resize(m_actuatedDOFs);
+    m_positionFeedbackInRadians.resize(m_actuatedDOFs);
+    m_encoderTimeStamps.resize(m_actuatedDOFs, 0.0);
+    m_feedbackTime = -1;
+    m_numberOfReads = 0;
+    m_numberOfStaleReads = 0;
+
+    // the replayed feedback does not need the robot
+    if (isReplaying())
+    {
+        if (!readEncoders())
+        {
+            yError() << "[RobotControlHelper::configure] Unable to replay the encoders (position).";
+            return false;
+        }
+        return true;
+    }
+
+    // the joints are read and controlled through the shared board
+    m_controlBoard = controlBoard;
+    if (m_controlBoard != nullptr)
+    {
+        if (!m_controlBoard->getJointIndices(m_axesList, m_boardIndices))
+        {
+            yError() << "[RobotControlHelper::configure] The joints are not part of the control "
+                        "board.";
+            return false;
+        }
+
+        if (!readEncoders())
+        {
+            yError() << "[RobotControlHelper::configure] Unable to read encoders (position).";
+            return false;
+        }
+        return true;
+    }
+
     // open the device
+    FakeDevices::replaceDevice(options);
     if (!m_robotDevice.open(options) && m_isMandatory)
     {
         yError() << "[RobotControlHelper::configure] Could not open remotecontrolboardremapper "
@@ -126,15 +180,11 @@ bool RobotControlHelper::configure(const yarp::os::Searchable& config,
         return false;
     }
 
-    m_desiredJointValue.resize(m_actuatedDOFs);
-    m_positionFeedbackInDegrees.resize(m_actuatedDOFs);
-    m_positionFeedbackInRadians.resize(m_actuatedDOFs);
-
     // check if the robot is alive
     bool okPosition = false;
     for (int i = 0; i < 10 && !okPosition; i++)
     {
-        okPosition = m_encodersInterface->getEncoders(m_positionFeedbackInDegrees.data());
+        okPosition = readEncoders();
 
         if (!okPosition)
             yarp::os::Time::delay(0.1);
@@ -272,9 +322,79 @@ bool RobotControlHelper::setVelocityReferences(const yarp::sig::Vector& desiredV
     return true;
 }
 
+bool RobotControlHelper::isReplaying() const
+{
+    return m_inputSession != nullptr && m_inputSession->isReplaying();
+}
+
+bool RobotControlHelper::readEncoders()
+{
+    if (isReplaying())
+    {
+        if (!m_inputSession->replay(
+                m_encodersStream, m_positionFeedbackInDegrees.data(), m_actuatedDOFs))
+            return false;
+
+        // the sessions recorded without the time stamps are replayed as if every read were new
+        if (!m_inputSession->replay(
+                m_encoderTimeStampsStream, m_encoderTimeStamps.data(), m_actuatedDOFs))
+            m_encoderTimeStamps = m_feedbackTime + 1;
+        return true;
+    }
+
+    // the encoders of the shared board are read once per cycle by its owner
+    if (m_controlBoard != nullptr)
+    {
+        for (int i = 0; i < m_actuatedDOFs; i++)
+        {
+            m_positionFeedbackInDegrees(i) = m_controlBoard->encoder(m_boardIndices[i]);
+            m_encoderTimeStamps(i) = m_controlBoard->encoderTimeStamp(m_boardIndices[i]);
+        }
+    } else if (!m_encodersInterface->getEncodersTimed(m_positionFeedbackInDegrees.data(),
+                                                      m_encoderTimeStamps.data()))
+        return false;
+
+    if (m_inputSession != nullptr)
+    {
+        m_inputSession->record(m_encodersStream, m_positionFeedbackInDegrees);
+        m_inputSession->record(m_encoderTimeStampsStream, m_encoderTimeStamps);
+    }
+    return true;
+}
+
+bool RobotControlHelper::readLimits(int joint, double& minLimitInDegree, double& maxLimitInDegree)
+{
+    std::array<double, 2> limits;
+    if (isReplaying())
+    {
+        if (!m_inputSession->replay(m_limitsStream, limits.data(), limits.size()))
+            return false;
+        minLimitInDegree = limits[0];
+        maxLimitInDegree = limits[1];
+        return true;
+    }
+
+    const bool ok = m_controlBoard != nullptr
+                        ? m_controlBoard->getLimits(
+                            m_boardIndices[joint], minLimitInDegree, maxLimitInDegree)
+                        : m_limitsInterface->getLimits(joint, &minLimitInDegree, &maxLimitInDegree);
+    if (!ok)
+        return false;
+
+    if (m_inputSession != nullptr)
+    {
+        limits[0] = minLimitInDegree;
+        limits[1] = maxLimitInDegree;
+        m_inputSession->record(m_limitsStream, limits);
+    }
+    return true;
+}
+
 void RobotControlHelper::updateTimeStamp()
 {
-    if (m_timedInterface)
+    if (m_controlBoard != nullptr)
+        m_timeStamp = m_controlBoard->lastInputStamp();
+    else if (m_timedInterface)
         m_timeStamp = m_timedInterface->getLastInputStamp();
     else
         m_timeStamp.update();
@@ -282,18 +402,58 @@ void RobotControlHelper::updateTimeStamp()
 
 bool RobotControlHelper::getFeedback()
 {
-    if (!m_encodersInterface->getEncoders(m_positionFeedbackInDegrees.data()) && m_isMandatory)
+    if (!readEncoders() && m_isMandatory)
     {
         yError() << "[RobotControlHelper::getFeedbacks] Unable to get joint position";
         return false;
     }
+    m_numberOfReads++;
 
+    // the positions are processed only if at least one of them is new
+    double feedbackTime = m_feedbackTime;
     for (unsigned j = 0; j < m_actuatedDOFs; ++j)
-        m_positionFeedbackInRadians(j) = iDynTree::deg2rad(m_positionFeedbackInDegrees(j));
+        feedbackTime = std::max(feedbackTime, m_encoderTimeStamps(j));
+
+    m_isFeedbackNew = feedbackTime > m_feedbackTime;
+    if (!m_isFeedbackNew)
+    {
+        m_numberOfStaleReads++;
+        return true;
+    }
+
+    m_feedbackTime = feedbackTime;
+    m_timeStamp.update(m_feedbackTime);
+    iDynTree::toEigen(m_positionFeedbackInRadians)
+        = iDynTree::deg2rad(1.0) * iDynTree::toEigen(m_positionFeedbackInDegrees);
 
     return true;
 }
 
+bool RobotControlHelper::isFeedbackNew() const
+{
+    return m_isFeedbackNew;
+}
+
+double RobotControlHelper::feedbackAge(const double& now) const
+{
+    return now - m_feedbackTime;
+}
+
+const yarp::sig::Vector& RobotControlHelper::encoderTimeStamps() const
+{
+    return m_encoderTimeStamps;
+}
+
+std::size_t RobotControlHelper::numberOfReads() const
+{
+    return m_numberOfReads;
+}
+
+std::size_t RobotControlHelper::numberOfStaleReads() const
+{
+    return m_numberOfStaleReads;
+}
+
 const yarp::os::Stamp& RobotControlHelper::timeStamp() const
 {
     return m_timeStamp;
@@ -311,6 +471,10 @@ const yarp::sig::Vector& RobotControlHelper::jointEncoders() const
 
 void RobotControlHelper::close()
 {
+    // the shared board is closed by its owner
+    if (isReplaying() || m_controlBoard != nullptr)
+        return;
+
     if (!switchToControlMode(VOCAB_CM_POSITION))
         yError() << "[RobotControlHelper::close] Unable to switch in position control.";
 
@@ -338,7 +502,7 @@ bool RobotControlHelper::getLimits(yarp::sig::Matrix& limits)
     for (int i = 0; i < m_actuatedDOFs; i++)
     {
         // get position limits
-        if (!m_limitsInterface->getLimits(i, &minLimitInDegree, &maxLimitInDegree))
+        if (!readLimits(i, minLimitInDegree, maxLimitInDegree))
         {
             if (m_isMandatory)
             {
@@ -364,6 +528,25 @@ bool RobotControlHelper::getLimits(yarp::sig::Matrix& limits)
 
 bool RobotControlHelper::setJointReference(const yarp::sig::Vector& desiredValue)
 {
+    // the references computed from a replayed session are not sent
+    if (isReplaying())
+        return true;
+
+    // the references of the shared board are sent by its owner
+    if (m_controlBoard != nullptr)
+    {
+        if (desiredValue.size() != m_actuatedDOFs)
+        {
+            yError() << "[RobotControlHelper::setJointReference] Dimension mismatch between "
+                        "desired value vector and the number of controlled joints.";
+            return false;
+        }
+
+        for (int i = 0; i < m_actuatedDOFs; i++)
+            m_controlBoard->setReference(m_boardIndices[i], iDynTree::rad2deg(desiredValue(i)));
+        return true;
+    }
+
     switch (m_controlMode)
     {
     case VOCAB_CM_POSITION_DIRECT:
@@ -11,6 +11,7 @@
 #endif
 
 #include <GazeRetargeting.hpp>
+#include <Utils.hpp>
 #include <yarp/os/LogStream.h>
 #include <yarp/dev/IAxisInfo.h>
 #include <yarp/dev/IControlLimits.h>
@@ -694,13 +695,7 @@ void GazeRetargeting::VRInterface::close()
 
 void GazeRetargeting::VRInterface::EyeControl::sendAngles()
 {
-    yarp::sig::Vector& output = imageControlPort.prepare();
-
-    output.resize(2);
-    output(0) = azimuth;
-    output(1) = elevation;
-
-    imageControlPort.write();
+    YarpHelper::sendVariadicVector(imageControlPort, azimuth, elevation);
 }
 
 iDynTree::Transform GazeRetargeting::VRInterface::EyeControl::currentImageTransform()
@@ -7,6 +7,7 @@
  */
 
 #include <SRanipalModule.hpp>
+#include <PeriodicExecutor.hpp>
 #include <yarp/os/Network.h>
 #include <yarp/os/LogStream.h>
 
@@ -27,5 +28,5 @@ int main(int argc, char* argv[])
 
     SRanipalModule sranipalModule;
 
-    return sranipalModule.runModule(rf);
+    return YarpHelper::runModule(sranipalModule, rf);
 }
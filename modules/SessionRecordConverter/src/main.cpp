@@ -0,0 +1,175 @@
+/**
+ * @file main.cpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+// std
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+
+// YARP
+#include <yarp/os/LogStream.h>
+#include <yarp/os/ResourceFinder.h>
+
+// matlogger
+#ifdef ENABLE_LOGGER
+#include <Eigen/Dense>
+#include <matlogger2/matlogger2.h>
+#endif
+
+#include <SessionRecorder.hpp>
+
+namespace
+{
+/**
+ * Write a session record in a CSV file. Each value of a channel is a column named
+ * channel, channel_i or channel_i_j (scalar, vector, matrix).
+ */
+bool convertToCsv(const SessionRecordReader& reader, const std::string& fileName)
+{
+    std::ofstream file(fileName);
+    if (!file.is_open())
+    {
+        yError() << "[convertToCsv] Unable to open the file" << fileName;
+        return false;
+    }
+
+    const auto& channels = reader.channels();
+    bool isFirstColumn = true;
+    for (const auto& channel : channels)
+    {
+        for (std::size_t col = 0; col < channel.cols; col++)
+        {
+            for (std::size_t row = 0; row < channel.rows; row++)
+            {
+                file << (isFirstColumn ? "" : ",") << channel.name;
+                if (channel.cols > 1)
+                    file << "_" << row << "_" << col;
+                else if (channel.rows > 1)
+                    file << "_" << row;
+                isFirstColumn = false;
+            }
+        }
+    }
+    file << "\n";
+
+    file << std::setprecision(std::numeric_limits<double>::max_digits10);
+    for (std::size_t record = 0; record < reader.numberOfRecords(); record++)
+    {
+        isFirstColumn = true;
+        for (std::size_t i = 0; i < channels.size(); i++)
+        {
+            const double* values = reader.data(record, i);
+            for (std::size_t j = 0; j < channels[i].size(); j++)
+            {
+                file << (isFirstColumn ? "" : ",") << values[j];
+                isFirstColumn = false;
+            }
+        }
+        file << "\n";
+    }
+
+    return static_cast<bool>(file);
+}
+
+#ifdef ENABLE_LOGGER
+/**
+ * Write a session record in a .mat file. Each channel is a variable with the same shape of the
+ * one used by matlogger2 in the modules.
+ */
+bool convertToMat(const SessionRecordReader& reader, const std::string& fileName)
+{
+    // in circular buffer mode the whole session is kept in memory and written when the logger is
+    // destroyed
+    auto logger = XBot::MatLogger2::MakeLogger(fileName);
+    logger->set_buffer_mode(XBot::VariableBuffer::Mode::circular_buffer);
+
+    const auto& channels = reader.channels();
+    const int bufferSize = std::max(static_cast<int>(reader.numberOfRecords()), 1);
+    for (const auto& channel : channels)
+        logger->create(channel.name, channel.rows, channel.cols, bufferSize);
+
+    for (std::size_t record = 0; record < reader.numberOfRecords(); record++)
+    {
+        for (std::size_t i = 0; i < channels.size(); i++)
+        {
+            logger->add(channels[i].name,
+                        Eigen::Map<const Eigen::MatrixXd>(
+                            reader.data(record, i), channels[i].rows, channels[i].cols));
+        }
+    }
+
+    logger.reset();
+    return true;
+}
+#endif
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    yarp::os::ResourceFinder rf;
+    rf.configure(argc, argv);
+
+    if (!rf.check("file") || rf.check("help"))
+    {
+        yInfo() << "Usage: SessionRecordConverter --file <record.bin> [--format csv|mat] "
+                   "[--output <file>]";
+        return rf.check("help") ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    const std::string inputFileName = rf.find("file").asString();
+#ifdef ENABLE_LOGGER
+    const std::string defaultFormat = "mat";
+#else
+    const std::string defaultFormat = "csv";
+#endif
+    const std::string format = rf.check("format", yarp::os::Value(defaultFormat)).asString();
+
+    std::string outputFileName = inputFileName;
+    const std::size_t extension = outputFileName.rfind(".bin");
+    if (extension != std::string::npos)
+        outputFileName.erase(extension);
+    outputFileName
+        = rf.check("output", yarp::os::Value(outputFileName + "." + format)).asString();
+
+    SessionRecordReader reader;
+    if (!reader.open(inputFileName))
+    {
+        yError() << "[main] Unable to read the session record" << inputFileName;
+        return EXIT_FAILURE;
+    }
+
+    bool ok = false;
+    if (format == "csv")
+    {
+        ok = convertToCsv(reader, outputFileName);
+    } else if (format == "mat")
+    {
+#ifdef ENABLE_LOGGER
+        ok = convertToMat(reader, outputFileName);
+#else
+        yError() << "[main] The .mat format requires matlogger2. Enable ENABLE_LOGGER in CMake "
+                    "or use --format csv.";
+        return EXIT_FAILURE;
+#endif
+    } else
+    {
+        yError() << "[main] Unknown format" << format << ". Available formats: csv, mat.";
+        return EXIT_FAILURE;
+    }
+
+    if (!ok)
+    {
+        yError() << "[main] Unable to convert the session record" << inputFileName;
+        return EXIT_FAILURE;
+    }
+
+    yInfo() << "[main]" << reader.numberOfRecords() << "records saved in" << outputFileName;
+    return EXIT_SUCCESS;
+}
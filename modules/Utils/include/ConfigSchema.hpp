@@ -0,0 +1,110 @@
+/**
+ * @file ConfigSchema.hpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+#ifndef WALKING_CONFIG_SCHEMA_HPP
+#define WALKING_CONFIG_SCHEMA_HPP
+
+// std
+#include <string>
+#include <vector>
+
+// YARP
+#include <yarp/os/Searchable.h>
+#include <yarp/sig/Vector.h>
+
+/**
+ * Helper for YARP library.
+ */
+namespace YarpHelper
+{
+/**
+ * A parameter schema is a struct that describes the parameters of a configuration group. It has
+ * to implement the method
+ * @code
+ * template <typename Visitor> void visit(Visitor& v)
+ * {
+ *     v("requiredKey", m_requiredValue);
+ *     v("optionalKey", m_optionalValue, defaultValue);
+ * }
+ * @endcode
+ * The same description is used to parse and validate the parameters.
+ */
+
+/**
+ * Visitor that reads the parameters from a searchable object. All the parameters are parsed in a
+ * single pass and every error is stored instead of stopping at the first one.
+ */
+class ParameterParser
+{
+    const yarp::os::Searchable& m_config; /**< Configuration object. */
+    std::vector<std::string> m_errors; /**< List of the errors found while parsing. */
+
+    /**
+     * Get a value from the searchable object.
+     * @param key the name to check for;
+     * @return the pointer to the value, nullptr if the key is missing.
+     */
+    yarp::os::Value* find(const char* key);
+
+    /**
+     * Store an error associated to a key.
+     * @param key the name of the parameter;
+     * @param message the description of the error.
+     */
+    void addError(const char* key, const std::string& message);
+
+public:
+    /**
+     * Constructor.
+     * @param config is the searchable object.
+     */
+    ParameterParser(const yarp::os::Searchable& config);
+
+    void operator()(const char* key, std::string& value);
+    void operator()(const char* key, double& value);
+    void operator()(const char* key, int& value);
+    void operator()(const char* key, unsigned int& value);
+    void operator()(const char* key, bool& value);
+    void operator()(const char* key, std::vector<double>& value);
+    void operator()(const char* key, std::vector<int>& value);
+    void operator()(const char* key, std::vector<std::string>& value);
+    void operator()(const char* key, yarp::sig::Vector& value);
+
+    /**
+     * Parse an optional parameter.
+     * @param key the name to check for;
+     * @param value the parameter;
+     * @param defaultValue value used if the key is not in the searchable object.
+     */
+    template <typename T> void operator()(const char* key, T& value, const T& defaultValue);
+
+    /**
+     * Get the errors found while parsing.
+     * @return the list of errors.
+     */
+    const std::vector<std::string>& errors() const;
+};
+
+/**
+ * Parse all the parameters described by a schema from a searchable object. All the errors are
+ * reported at once.
+ * @param config is the searchable object;
+ * @param parameters is the struct describing the parameters;
+ * @param prefix the prefix to print.
+ * @return true/false in case of success/failure
+ */
+template <typename Schema>
+bool parseParameters(const yarp::os::Searchable& config,
+                     Schema& parameters,
+                     const std::string& prefix = "");
+
+} // namespace YarpHelper
+
+#include "ConfigSchema.tpp"
+
+#endif
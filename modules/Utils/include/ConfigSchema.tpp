@@ -0,0 +1,41 @@
+/**
+ * @file ConfigSchema.tpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+// YARP
+#include <yarp/os/LogStream.h>
+
+template <typename T>
+void YarpHelper::ParameterParser::operator()(const char* key, T& value, const T& defaultValue)
+{
+    if (!m_config.check(key))
+    {
+        value = defaultValue;
+        return;
+    }
+
+    (*this)(key, value);
+}
+
+template <typename Schema>
+bool YarpHelper::parseParameters(const yarp::os::Searchable& config,
+                                 Schema& parameters,
+                                 const std::string& prefix /*= ""*/)
+{
+    ParameterParser parser(config);
+    parameters.visit(parser);
+
+    if (parser.errors().empty())
+        return true;
+
+    yError() << prefix << "Found" << parser.errors().size()
+             << "error(s) while parsing the configuration:";
+    for (const auto& error : parser.errors())
+        yError() << prefix << " -" << error;
+
+    return false;
+}
@@ -0,0 +1,55 @@
+/**
+ * @file FakeAnalogSensor.hpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+#ifndef WALKING_FAKE_ANALOG_SENSOR_HPP
+#define WALKING_FAKE_ANALOG_SENSOR_HPP
+
+// std
+#include <mutex>
+
+// YARP
+#include <yarp/dev/DeviceDriver.h>
+#include <yarp/dev/IAnalogSensor.h>
+#include <yarp/sig/Vector.h>
+
+#include <FakeDevices.hpp>
+
+/**
+ * FakeAnalogSensor is an in-process analog sensor whose channels are sinusoids (see FakeSignal).
+ *
+ * The following parameters are read when the device is opened:
+ * - channels: number of channels (optional, by default it is the size of the vector passed to
+ *   read(), so the device adapts to the sensor expected by the module);
+ * - analog_offset, analog_amplitude, analog_frequency, analog_phase_shift, analog_noise:
+ *   parameters of the signal (default offset 127.5 and amplitude 100.0, i.e. the raw range of
+ *   the iCub hand and skin sensors);
+ * - seed: seed of the random number generator (default 0).
+ */
+class FakeAnalogSensor : public yarp::dev::DeviceDriver, public yarp::dev::IAnalogSensor
+{
+    int m_channels{0}; /**< Number of channels (0 if it follows the read vector). */
+    double m_startTime{0.0}; /**< Time at which the device has been opened. */
+    FakeSignal m_signal; /**< Signal of the channels. */
+    std::mutex m_mutex; /**< Mutex protecting the signal. */
+
+public:
+    // DeviceDriver
+    bool open(yarp::os::Searchable& config) override;
+    bool close() override;
+
+    // IAnalogSensor
+    int read(yarp::sig::Vector& out) override;
+    int getState(int ch) override;
+    int getChannels() override;
+    int calibrateSensor() override;
+    int calibrateSensor(const yarp::sig::Vector& value) override;
+    int calibrateChannel(int ch) override;
+    int calibrateChannel(int ch, double value) override;
+};
+
+#endif
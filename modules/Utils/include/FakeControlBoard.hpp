@@ -0,0 +1,278 @@
+/**
+ * @file FakeControlBoard.hpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+#ifndef WALKING_FAKE_CONTROL_BOARD_HPP
+#define WALKING_FAKE_CONTROL_BOARD_HPP
+
+// std
+#include <mutex>
+#include <string>
+#include <vector>
+
+// YARP
+#include <yarp/dev/ControlBoardInterfaces.h>
+#include <yarp/dev/DeviceDriver.h>
+#include <yarp/dev/IAxisInfo.h>
+#include <yarp/dev/IPreciselyTimed.h>
+#include <yarp/os/Stamp.h>
+
+#include <FakeDevices.hpp>
+
+/**
+ * FakeControlBoard is an in-process control board. The joints follow the references with a
+ * first order dynamics:
+ * - position and position direct modes: the joints converge to the reference with the time
+ *   constant time_constant (the position mode is also limited by the reference speed);
+ * - velocity mode: the joints move with the reference velocity;
+ * - current and PWM modes: the joint velocity is proportional to the reference
+ *   (current_to_velocity and pwm_to_velocity gains).
+ * The measured currents, duty cycles and PID outputs are proportional to the position error.
+ * The state is updated when the interfaces are called, so it does not need a thread.
+ *
+ * The following parameters are read when the device is opened:
+ * - axesNames: names of the axes (required);
+ * - joint_limits: lower and upper limits of the joints in degrees (default (-90.0 90.0));
+ * - velocity_limit: velocity limit of the joints in degrees per second (default 100.0);
+ * - time_constant: time constant of the joints in seconds (default 0.05);
+ * - encoder_noise: standard deviation of the encoders noise in degrees (default 0.0);
+ * - current_to_velocity, pwm_to_velocity: gains of the current and PWM modes (default 10.0);
+ * - error_to_current, error_to_pwm: gains of the measured current and duty cycle (default 1.0);
+ * - seed: seed of the random number generator (default 0).
+ */
+class FakeControlBoard : public yarp::dev::DeviceDriver,
+                         public yarp::dev::IEncodersTimed,
+                         public yarp::dev::IPositionControl,
+                         public yarp::dev::IPositionDirect,
+                         public yarp::dev::IVelocityControl,
+                         public yarp::dev::IControlMode,
+                         public yarp::dev::IControlLimits,
+                         public yarp::dev::ICurrentControl,
+                         public yarp::dev::IPWMControl,
+                         public yarp::dev::IPidControl,
+                         public yarp::dev::IAxisInfo,
+                         public yarp::dev::IPreciselyTimed
+{
+    /**
+     * State of a joint. The angles are expressed in degrees.
+     */
+    struct Joint
+    {
+        std::string name; /**< Name of the axis. */
+        int controlMode{VOCAB_CM_POSITION}; /**< Control mode. */
+        double position{0.0}; /**< Position. */
+        double velocity{0.0}; /**< Velocity. */
+        double acceleration{0.0}; /**< Acceleration. */
+        double positionReference{0.0}; /**< Reference of the position direct mode. */
+        double targetPosition{0.0}; /**< Target of the position mode. */
+        double referenceSpeed{10.0}; /**< Reference speed of the position mode. */
+        double referenceAcceleration{0.0}; /**< Reference acceleration. */
+        double velocityReference{0.0}; /**< Reference of the velocity mode. */
+        double currentReference{0.0}; /**< Reference of the current mode. */
+        double dutyCycleReference{0.0}; /**< Reference of the PWM mode. */
+        double minLimit{-90.0}; /**< Lower limit. */
+        double maxLimit{90.0}; /**< Upper limit. */
+        double velocityLimit{100.0}; /**< Velocity limit. */
+        yarp::dev::Pid pid; /**< Gains returned by the PID interface. */
+    };
+
+    std::vector<Joint> m_joints; /**< Joints of the control board. */
+
+    double m_timeConstant; /**< Time constant of the joints. */
+    double m_encoderNoise; /**< Standard deviation of the encoders noise. */
+    double m_currentToVelocity; /**< Gain between the current and the joint velocity. */
+    double m_pwmToVelocity; /**< Gain between the duty cycle and the joint velocity. */
+    double m_errorToCurrent; /**< Gain between the position error and the current. */
+    double m_errorToPwm; /**< Gain between the position error and the duty cycle. */
+
+    double m_lastUpdateTime{0.0}; /**< Time of the last update of the joints. */
+    yarp::os::Stamp m_stamp; /**< Time stamp of the last update. */
+    FakeSignal m_noise; /**< Generator of the encoders noise. */
+    std::mutex m_mutex; /**< Mutex protecting the joints. */
+
+    /**
+     * Integrate the joints up to the current time (the mutex has to be locked).
+     */
+    void update();
+
+    /**
+     * Position error of a joint with respect to the reference of its control mode.
+     * @param joint the joint.
+     * @return the position error.
+     */
+    double positionError(const Joint& joint) const;
+
+    /**
+     * Check if an index refers to a joint.
+     * @param j the index.
+     * @return true if the index is valid.
+     */
+    bool isValid(int j) const;
+
+    /**
+     * Apply a function to each joint.
+     * @param function function returning false in case of failure.
+     * @return true in case of success and false otherwise.
+     */
+    template <typename F> bool forEachJoint(F&& function);
+
+    /**
+     * Apply a function to a group of joints.
+     * @param n number of joints;
+     * @param joints indices of the joints;
+     * @param function function returning false in case of failure.
+     * @return true in case of success and false otherwise.
+     */
+    template <typename F> bool forJoints(int n, const int* joints, F&& function);
+
+public:
+    // DeviceDriver
+    bool open(yarp::os::Searchable& config) override;
+    bool close() override;
+
+    // IEncodersTimed
+    bool getAxes(int* ax) override;
+    bool resetEncoder(int j) override;
+    bool resetEncoders() override;
+    bool setEncoder(int j, double val) override;
+    bool setEncoders(const double* vals) override;
+    bool getEncoder(int j, double* v) override;
+    bool getEncoders(double* encs) override;
+    bool getEncoderSpeed(int j, double* sp) override;
+    bool getEncoderSpeeds(double* spds) override;
+    bool getEncoderAcceleration(int j, double* spds) override;
+    bool getEncoderAccelerations(double* accs) override;
+    bool getEncodersTimed(double* encs, double* time) override;
+    bool getEncoderTimed(int j, double* encs, double* time) override;
+
+    // IPositionControl
+    bool positionMove(int j, double ref) override;
+    bool positionMove(const double* refs) override;
+    bool positionMove(const int n_joint, const int* joints, const double* refs) override;
+    bool relativeMove(int j, double delta) override;
+    bool relativeMove(const double* deltas) override;
+    bool relativeMove(const int n_joint, const int* joints, const double* deltas) override;
+    bool checkMotionDone(int j, bool* flag) override;
+    bool checkMotionDone(bool* flag) override;
+    bool checkMotionDone(const int n_joint, const int* joints, bool* flag) override;
+    bool setRefSpeed(int j, double sp) override;
+    bool setRefSpeeds(const double* spds) override;
+    bool setRefSpeeds(const int n_joint, const int* joints, const double* spds) override;
+    bool getRefSpeed(int j, double* ref) override;
+    bool getRefSpeeds(double* spds) override;
+    bool getRefSpeeds(const int n_joint, const int* joints, double* spds) override;
+    bool getTargetPosition(const int joint, double* ref) override;
+    bool getTargetPositions(double* refs) override;
+    bool getTargetPositions(const int n_joint, const int* joints, double* refs) override;
+
+    // IPositionControl and IVelocityControl
+    bool setRefAcceleration(int j, double acc) override;
+    bool setRefAccelerations(const double* accs) override;
+    bool setRefAccelerations(const int n_joint, const int* joints, const double* accs) override;
+    bool getRefAcceleration(int j, double* acc) override;
+    bool getRefAccelerations(double* accs) override;
+    bool getRefAccelerations(const int n_joint, const int* joints, double* accs) override;
+    bool stop(int j) override;
+    bool stop() override;
+    bool stop(const int n_joint, const int* joints) override;
+
+    // IPositionDirect
+    bool setPosition(int j, double ref) override;
+    bool setPositions(const int n_joint, const int* joints, const double* refs) override;
+    bool setPositions(const double* refs) override;
+    bool getRefPosition(const int joint, double* ref) override;
+    bool getRefPositions(double* refs) override;
+    bool getRefPositions(const int n_joint, const int* joints, double* refs) override;
+
+    // IVelocityControl
+    bool velocityMove(int j, double sp) override;
+    bool velocityMove(const double* sp) override;
+    bool velocityMove(const int n_joint, const int* joints, const double* spds) override;
+    bool getRefVelocity(const int joint, double* vel) override;
+    bool getRefVelocities(double* vels) override;
+    bool getRefVelocities(const int n_joint, const int* joints, double* vels) override;
+
+    // IControlMode
+    bool getControlMode(int j, int* mode) override;
+    bool getControlModes(int* modes) override;
+    bool getControlModes(const int n_joint, const int* joints, int* modes) override;
+    bool setControlMode(const int j, const int mode) override;
+    bool setControlModes(const int n_joint, const int* joints, int* modes) override;
+    bool setControlModes(int* modes) override;
+
+    // IControlLimits
+    bool setLimits(int axis, double min, double max) override;
+    bool getLimits(int axis, double* min, double* max) override;
+    bool setVelLimits(int axis, double min, double max) override;
+    bool getVelLimits(int axis, double* min, double* max) override;
+
+    // ICurrentControl and IPWMControl
+    bool getNumberOfMotors(int* ax) override;
+
+    // ICurrentControl
+    bool getCurrent(int m, double* curr) override;
+    bool getCurrents(double* currs) override;
+    bool getCurrentRange(int m, double* min, double* max) override;
+    bool getCurrentRanges(double* min, double* max) override;
+    bool setRefCurrents(const double* currs) override;
+    bool setRefCurrent(int m, double curr) override;
+    bool setRefCurrents(const int n_motor, const int* motors, const double* currs) override;
+    bool getRefCurrents(double* currs) override;
+    bool getRefCurrent(int m, double* curr) override;
+
+    // IPWMControl
+    bool setRefDutyCycle(int m, double ref) override;
+    bool setRefDutyCycles(const double* refs) override;
+    bool getRefDutyCycle(int m, double* ref) override;
+    bool getRefDutyCycles(double* refs) override;
+    bool getDutyCycle(int m, double* val) override;
+    bool getDutyCycles(double* vals) override;
+
+    // IPidControl
+    bool setPid(const yarp::dev::PidControlTypeEnum& pidtype,
+                int j,
+                const yarp::dev::Pid& pid) override;
+    bool setPids(const yarp::dev::PidControlTypeEnum& pidtype, const yarp::dev::Pid* pids) override;
+    bool setPidReference(const yarp::dev::PidControlTypeEnum& pidtype, int j, double ref) override;
+    bool setPidReferences(const yarp::dev::PidControlTypeEnum& pidtype,
+                          const double* refs) override;
+    bool setPidErrorLimit(const yarp::dev::PidControlTypeEnum& pidtype,
+                          int j,
+                          double limit) override;
+    bool setPidErrorLimits(const yarp::dev::PidControlTypeEnum& pidtype,
+                           const double* limits) override;
+    bool getPidError(const yarp::dev::PidControlTypeEnum& pidtype, int j, double* err) override;
+    bool getPidErrors(const yarp::dev::PidControlTypeEnum& pidtype, double* errs) override;
+    bool getPidOutput(const yarp::dev::PidControlTypeEnum& pidtype, int j, double* out) override;
+    bool getPidOutputs(const yarp::dev::PidControlTypeEnum& pidtype, double* outs) override;
+    bool getPid(const yarp::dev::PidControlTypeEnum& pidtype, int j, yarp::dev::Pid* pid) override;
+    bool getPids(const yarp::dev::PidControlTypeEnum& pidtype, yarp::dev::Pid* pids) override;
+    bool getPidReference(const yarp::dev::PidControlTypeEnum& pidtype,
+                         int j,
+                         double* ref) override;
+    bool getPidReferences(const yarp::dev::PidControlTypeEnum& pidtype, double* refs) override;
+    bool getPidErrorLimit(const yarp::dev::PidControlTypeEnum& pidtype,
+                          int j,
+                          double* limit) override;
+    bool getPidErrorLimits(const yarp::dev::PidControlTypeEnum& pidtype, double* limits) override;
+    bool resetPid(const yarp::dev::PidControlTypeEnum& pidtype, int j) override;
+    bool disablePid(const yarp::dev::PidControlTypeEnum& pidtype, int j) override;
+    bool enablePid(const yarp::dev::PidControlTypeEnum& pidtype, int j) override;
+    bool setPidOffset(const yarp::dev::PidControlTypeEnum& pidtype, int j, double v) override;
+    bool isPidEnabled(const yarp::dev::PidControlTypeEnum& pidtype,
+                      int j,
+                      bool* enabled) override;
+
+    // IAxisInfo
+    bool getAxisName(int axis, std::string& name) override;
+    bool getJointType(int axis, yarp::dev::JointTypeEnum& type) override;
+
+    // IPreciselyTimed
+    yarp::os::Stamp getLastInputStamp() override;
+};
+
+#endif
@@ -0,0 +1,127 @@
+/**
+ * @file FakeDevices.hpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+#ifndef WALKING_FAKE_DEVICES_HPP
+#define WALKING_FAKE_DEVICES_HPP
+
+// std
+#include <cstddef>
+#include <random>
+#include <string>
+
+// YARP
+#include <yarp/dev/Drivers.h>
+#include <yarp/os/Property.h>
+#include <yarp/os/Searchable.h>
+
+/**
+ * FakeSignal generates a synthetic signal for each channel of a fake device:
+ * value = offset + amplitude * sin(2 pi frequency time + phase_shift channel) + noise
+ * where noise is a zero mean gaussian noise.
+ */
+class FakeSignal
+{
+    double m_offset{0.0}; /**< Offset of the signal. */
+    double m_amplitude{1.0}; /**< Amplitude of the sinusoid. */
+    double m_frequency{0.5}; /**< Frequency of the sinusoid in Hz. */
+    double m_phaseShift{0.5}; /**< Phase between two consecutive channels in rad. */
+    double m_noise{0.0}; /**< Standard deviation of the noise. */
+
+    std::mt19937 m_generator; /**< Random number generator. */
+    std::normal_distribution<double> m_noiseDistribution{0.0, 1.0}; /**< Noise distribution. */
+
+public:
+    /**
+     * Configure the signal.
+     * The following parameters are read from the configuration object (all optional):
+     * <prefix>_offset, <prefix>_amplitude, <prefix>_frequency, <prefix>_phase_shift,
+     * <prefix>_noise and seed (seed of the random number generator, default 0).
+     * @param config configuration object;
+     * @param prefix prefix of the parameters;
+     * @param offset default offset;
+     * @param amplitude default amplitude.
+     */
+    void configure(const yarp::os::Searchable& config,
+                   const std::string& prefix,
+                   const double& offset,
+                   const double& amplitude);
+
+    /**
+     * Evaluate the signal.
+     * @param time time in seconds;
+     * @param channel index of the channel.
+     * @return the value of the signal.
+     */
+    double operator()(const double& time, const std::size_t& channel);
+
+    /**
+     * Get a sample of the noise.
+     * @param standardDeviation standard deviation of the noise.
+     * @return the sample.
+     */
+    double noise(const double& standardDeviation);
+};
+
+/**
+ * The fake devices are in-process implementations of the devices used by the modules
+ * (control boards, analog sensors, ...). They do not need the robot, the simulator or the
+ * hardware, so the modules can run without them, e.g. to measure the cost of the loops.
+ * The fake devices are registered in the YARP device factory and they replace the real devices
+ * when the modules open them.
+ *
+ * The fake devices are configured by the FAKE_DEVICES group of the module configuration:
+ * - enable: true to use the fake devices (optional, default false);
+ * - the other parameters of the group are passed to the fake devices when they are opened
+ *   (the parameters set by the module are not overwritten), see FakeControlBoard,
+ *   FakeAnalogSensor, FakeFrameTransform and FakeJoypad.
+ */
+namespace FakeDevices
+{
+/**
+ * Configure the fake devices. If they are enabled the fake devices of the utility library are
+ * registered in the YARP device factory.
+ * @param config configuration object (the group FAKE_DEVICES is used).
+ * @return true in case of success and false otherwise.
+ */
+bool configure(const yarp::os::Searchable& config);
+
+/**
+ * Check if the fake devices are enabled.
+ * @return true if the fake devices are enabled.
+ */
+bool isEnabled();
+
+/**
+ * Register a fake device in the YARP device factory. The device is registered only once.
+ * @param device name of the device replaced by the fake device;
+ * @param fakeDevice name of the fake device.
+ */
+template <typename T> void addDevice(const std::string& device, const std::string& fakeDevice);
+
+/**
+ * Replace the device of the options with the corresponding fake device. It does nothing if the
+ * fake devices are disabled or if the device does not have a fake counterpart.
+ * @param options options used to open the device.
+ * @return true if the device has been replaced.
+ */
+bool replaceDevice(yarp::os::Property& options);
+
+/**
+ * Register a device creator in the YARP device factory (use addDevice()).
+ * @param device name of the device replaced by the fake device;
+ * @param fakeDevice name of the fake device;
+ * @param creator device creator, it is deleted if the device is already registered.
+ */
+void addDeviceCreator(const std::string& device,
+                      const std::string& fakeDevice,
+                      yarp::dev::DriverCreator* creator);
+} // namespace FakeDevices
+
+#include "FakeDevices.tpp"
+
+#endif
@@ -0,0 +1,15 @@
+/**
+ * @file FakeDevices.tpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+template <typename T>
+void FakeDevices::addDevice(const std::string& device, const std::string& fakeDevice)
+{
+    addDeviceCreator(device,
+                     fakeDevice,
+                     new yarp::dev::DriverCreatorOf<T>(fakeDevice.c_str(), "", fakeDevice.c_str()));
+}
@@ -0,0 +1,87 @@
+/**
+ * @file FakeFrameTransform.hpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+#ifndef WALKING_FAKE_FRAME_TRANSFORM_HPP
+#define WALKING_FAKE_FRAME_TRANSFORM_HPP
+
+// std
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// YARP
+#include <yarp/dev/DeviceDriver.h>
+#include <yarp/dev/IFrameTransform.h>
+#include <yarp/sig/Matrix.h>
+
+#include <FakeDevices.hpp>
+
+/**
+ * FakeFrameTransform is an in-process transform client. Every frame exists: the transform of a
+ * frame is a synthetic motion, the rotation is given by three sinusoidal ZYX Euler angles and the
+ * position by three sinusoids (see FakeSignal). The transforms set by the module replace the
+ * synthetic ones.
+ *
+ * The following parameters are read when the device is opened:
+ * - transform_rotation_offset, transform_rotation_amplitude, ...: parameters of the Euler
+ *   angles in radians (default offset 0.0 and amplitude 0.2);
+ * - transform_position_offset, transform_position_amplitude, ...: parameters of the position
+ *   in meters (default offset 0.0 and amplitude 0.1);
+ * - seed: seed of the random number generator (default 0).
+ */
+class FakeFrameTransform : public yarp::dev::DeviceDriver, public yarp::dev::IFrameTransform
+{
+    double m_startTime{0.0}; /**< Time at which the device has been opened. */
+    FakeSignal m_rotation; /**< Signal of the Euler angles. */
+    FakeSignal m_position; /**< Signal of the position. */
+    std::unordered_map<std::string, std::size_t> m_frames; /**< Index of the synthetic frames. */
+    std::unordered_map<std::string, yarp::sig::Matrix> m_transforms; /**< Transforms set. */
+    std::mutex m_mutex; /**< Mutex protecting the frames. */
+
+public:
+    // DeviceDriver
+    bool open(yarp::os::Searchable& config) override;
+    bool close() override;
+
+    // IFrameTransform
+    bool allFramesAsString(std::string& all_frames) override;
+    bool canTransform(const std::string& target_frame, const std::string& source_frame) override;
+    bool clear() override;
+    bool frameExists(const std::string& frame_id) override;
+    bool getAllFrameIds(std::vector<std::string>& ids) override;
+    bool getParent(const std::string& frame_id, std::string& parent_frame_id) override;
+    bool getTransform(const std::string& target_frame_id,
+                      const std::string& source_frame_id,
+                      yarp::sig::Matrix& transform) override;
+    bool setTransform(const std::string& target_frame_id,
+                      const std::string& source_frame_id,
+                      const yarp::sig::Matrix& transform) override;
+    bool setTransformStatic(const std::string& target_frame_id,
+                            const std::string& source_frame_id,
+                            const yarp::sig::Matrix& transform) override;
+    bool deleteTransform(const std::string& target_frame_id,
+                         const std::string& source_frame_id) override;
+    bool transformPoint(const std::string& target_frame_id,
+                        const std::string& source_frame_id,
+                        const yarp::sig::Vector& input_point,
+                        yarp::sig::Vector& transformed_point) override;
+    bool transformPose(const std::string& target_frame_id,
+                       const std::string& source_frame_id,
+                       const yarp::sig::Vector& input_pose,
+                       yarp::sig::Vector& transformed_pose) override;
+    bool transformQuaternion(const std::string& target_frame_id,
+                             const std::string& source_frame_id,
+                             const yarp::math::Quaternion& input_quaternion,
+                             yarp::math::Quaternion& transformed_quaternion) override;
+    bool waitForTransform(const std::string& target_frame_id,
+                          const std::string& source_frame_id,
+                          const double& timeout) override;
+};
+
+#endif
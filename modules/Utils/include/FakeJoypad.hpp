@@ -0,0 +1,66 @@
+/**
+ * @file FakeJoypad.hpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+#ifndef WALKING_FAKE_JOYPAD_HPP
+#define WALKING_FAKE_JOYPAD_HPP
+
+// std
+#include <mutex>
+
+// YARP
+#include <yarp/dev/DeviceDriver.h>
+#include <yarp/dev/IJoypadController.h>
+#include <yarp/sig/Vector.h>
+
+#include <FakeDevices.hpp>
+
+/**
+ * FakeJoypad is an in-process joypad whose axes and buttons are sinusoids (see FakeSignal).
+ * By default the axes and the buttons are zero, i.e. the operator does not touch the joypad.
+ *
+ * The following parameters are read when the device is opened:
+ * - joypad_axes, joypad_buttons: number of axes and buttons (default 8);
+ * - joypad_axis_offset, joypad_axis_amplitude, ...: parameters of the axes (default offset
+ *   and amplitude 0.0);
+ * - joypad_button_offset, joypad_button_amplitude, ...: parameters of the buttons, the value is
+ *   saturated between 0 and 1 (default offset and amplitude 0.0);
+ * - seed: seed of the random number generator (default 0).
+ */
+class FakeJoypad : public yarp::dev::DeviceDriver, public yarp::dev::IJoypadController
+{
+    unsigned int m_axes{0}; /**< Number of axes. */
+    unsigned int m_buttons{0}; /**< Number of buttons. */
+    double m_startTime{0.0}; /**< Time at which the device has been opened. */
+    FakeSignal m_axis; /**< Signal of the axes. */
+    FakeSignal m_button; /**< Signal of the buttons. */
+    std::mutex m_mutex; /**< Mutex protecting the signals. */
+
+public:
+    // DeviceDriver
+    bool open(yarp::os::Searchable& config) override;
+    bool close() override;
+
+    // IJoypadController
+    bool getAxisCount(unsigned int& axis_count) override;
+    bool getButtonCount(unsigned int& button_count) override;
+    bool getTrackballCount(unsigned int& Trackball_count) override;
+    bool getHatCount(unsigned int& Hat_count) override;
+    bool getTouchSurfaceCount(unsigned int& touch_count) override;
+    bool getStickCount(unsigned int& stick_count) override;
+    bool getStickDoF(unsigned int stick_id, unsigned int& DoF) override;
+    bool getButton(unsigned int button_id, float& value) override;
+    bool getTrackball(unsigned int trackball_id, yarp::sig::Vector& value) override;
+    bool getHat(unsigned int hat_id, unsigned char& value) override;
+    bool getAxis(unsigned int axis_id, double& value) override;
+    bool getStick(unsigned int stick_id,
+                  yarp::sig::Vector& value,
+                  JoypadCtrl_coordinateMode coordinate_mode) override;
+    bool getTouch(unsigned int touch_id, yarp::sig::Vector& value) override;
+};
+
+#endif
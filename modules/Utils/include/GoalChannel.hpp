@@ -0,0 +1,103 @@
+/**
+ * @file GoalChannel.hpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+#ifndef WALKING_GOAL_CHANNEL_HPP
+#define WALKING_GOAL_CHANNEL_HPP
+
+// std
+#include <cstddef>
+#include <string>
+
+// YARP
+#include <yarp/os/BufferedPort.h>
+#include <yarp/os/Stamp.h>
+#include <yarp/sig/Vector.h>
+
+/**
+ * Streaming channel used to send the locomotion goal (x, y) to the walking controller.
+ * The channel is one-way and latest-wins:
+ * - the publisher never waits for the reader. If the previous goal has not been sent yet, it
+ *   is replaced by the new one;
+ * - the reader never waits for the publisher. It drops all the goals but the most recent one and
+ *   it considers the goal expired (i.e. zero) if no goal is received for longer than a timeout.
+ *   Hence the robot stops if the publisher stops streaming.
+ * Each goal is sent with an envelope containing a sequence number and the time of the publisher.
+ * The state transitions of the walking controller (prepare, start and stop) are still sent
+ * through the RPC port.
+ */
+namespace GoalChannel
+{
+/** Number of elements of a goal. */
+constexpr std::size_t goalSize = 2;
+
+/**
+ * Publisher of the goal.
+ */
+class Publisher
+{
+    yarp::os::BufferedPort<yarp::sig::Vector> m_port; /**< Goal port. */
+    yarp::os::Stamp m_stamp; /**< Envelope of the goal. */
+
+public:
+    /**
+     * Open the port.
+     * @param portName name of the port.
+     * @return true in case of success and false otherwise.
+     */
+    bool open(const std::string& portName);
+
+    /**
+     * Publish a goal. The function does not block.
+     * @param x goal along the x axis;
+     * @param y goal along the y axis.
+     */
+    void publish(const double& x, const double& y);
+
+    /**
+     * Close the port.
+     */
+    void close();
+};
+
+/**
+ * Reader of the goal (matching the contract of the publisher).
+ */
+class Reader
+{
+    yarp::os::BufferedPort<yarp::sig::Vector> m_port; /**< Goal port. */
+    double m_timeout{0.5}; /**< Time after which the goal expires in seconds. */
+    double m_receivedTime{-1}; /**< Time in which the last goal was received. */
+    double m_x{0}; /**< Last goal along the x axis. */
+    double m_y{0}; /**< Last goal along the y axis. */
+
+public:
+    /**
+     * Open the port.
+     * @param portName name of the port;
+     * @param timeout time after which the goal expires in seconds.
+     * @return true in case of success and false otherwise.
+     */
+    bool open(const std::string& portName, const double& timeout);
+
+    /**
+     * Read the most recent goal. The function does not block.
+     * @param now current time in seconds;
+     * @param x goal along the x axis (zero if the goal expired);
+     * @param y goal along the y axis (zero if the goal expired).
+     * @return false if the goal expired and true otherwise.
+     */
+    bool read(const double& now, double& x, double& y);
+
+    /**
+     * Close the port.
+     */
+    void close();
+};
+} // namespace GoalChannel
+
+#endif
@@ -0,0 +1,110 @@
+/**
+ * @file Histogram.hpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+#ifndef WALKING_HISTOGRAM_HPP
+#define WALKING_HISTOGRAM_HPP
+
+// std
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// YARP
+#include <yarp/os/Bottle.h>
+
+/**
+ * Histogram of durations expressed in nanoseconds. The buckets are log-linear (HDR-style): every
+ * power of two is split in 32 sub-buckets, so the relative error of the stored values is lower
+ * than 3%. The storage is preallocated and recording a value does not allocate memory.
+ * The histogram is meant to be written by a single thread. It can be read by another thread
+ * at the same time.
+ */
+class LatencyHistogram
+{
+public:
+    static constexpr unsigned int subBucketBits = 5; /**< log2 of the number of sub-buckets. */
+    static constexpr unsigned int maxExponent = 36; /**< Values up to 2^41 ns (~36 min). */
+    static constexpr std::size_t numberOfBuckets = (maxExponent + 2) << subBucketBits;
+
+private:
+    std::array<std::atomic<std::uint64_t>, numberOfBuckets> m_buckets; /**< Counts. */
+    std::atomic<std::uint64_t> m_count; /**< Number of recorded values. */
+    std::atomic<std::uint64_t> m_max; /**< Maximum recorded value. */
+    std::atomic<std::uint64_t> m_sum; /**< Sum of the recorded values. */
+
+    /**
+     * Get the index of the bucket associated to a value.
+     * @param value the value in nanoseconds.
+     * @return the index of the bucket.
+     */
+    static std::size_t bucketIndex(std::uint64_t value);
+
+    /**
+     * Get the smallest value stored in a bucket.
+     * @param index the index of the bucket.
+     * @return the value in nanoseconds.
+     */
+    static std::uint64_t bucketValue(std::size_t index);
+
+public:
+    LatencyHistogram();
+
+    /**
+     * Record a value.
+     * @param value the value in nanoseconds.
+     */
+    void record(std::uint64_t value);
+
+    /**
+     * Reset the histogram.
+     */
+    void reset();
+
+    /**
+     * Get the number of recorded values.
+     * @return the number of values.
+     */
+    std::uint64_t count() const;
+
+    /**
+     * Get the maximum recorded value.
+     * @return the maximum value in nanoseconds.
+     */
+    std::uint64_t max() const;
+
+    /**
+     * Get the mean of the recorded values.
+     * @return the mean value in nanoseconds.
+     */
+    double mean() const;
+
+    /**
+     * Get a percentile of the recorded values.
+     * @param percentile the percentile (between 0 and 100).
+     * @return the value in nanoseconds.
+     */
+    std::uint64_t percentile(double percentile) const;
+};
+
+namespace YarpHelper
+{
+/**
+ * Add to a bottle the list (name (count c mean m p50 a p99 b p99.9 c max d)) describing a
+ * histogram. The values are expressed in microseconds.
+ * @param bottle the bottle;
+ * @param name name of the histogram;
+ * @param histogram the histogram.
+ */
+void addHistogramToBottle(yarp::os::Bottle& bottle,
+                          const std::string& name,
+                          const LatencyHistogram& histogram);
+} // namespace YarpHelper
+
+#endif
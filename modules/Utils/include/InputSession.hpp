@@ -0,0 +1,307 @@
+/**
+ * @file InputSession.hpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+#ifndef WALKING_INPUT_SESSION_HPP
+#define WALKING_INPUT_SESSION_HPP
+
+// std
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// YARP
+#include <yarp/os/Searchable.h>
+
+#include <Utils.hpp>
+
+/**
+ * InputSession records the inputs of a module (device readouts and port messages) and replays
+ * them without the devices. Each input is a named stream of timestamped samples (vectors of
+ * doubles or lists of strings). The samples are grouped in cycles: beginCycle() is called at the
+ * beginning of each iteration of the module loop, while the samples read during the
+ * configuration belong to a cycle preceding the first one.
+ * In replay mode the module reads the samples of a stream in the same order they were recorded
+ * in the same cycle, so the module sees exactly the same inputs of the recorded session. The
+ * cycles are replayed as fast as possible or with the same timing of the recording.
+ * Within a cycle different streams can be read by different threads (e.g. the two hands of a
+ * module running in parallel): the recorded samples are written under a mutex and each replayed
+ * stream has its own position. The streams have to be added and the cycles begun by one thread.
+ *
+ * The session is configured by the INPUT_SESSION group of the module configuration:
+ * - mode: "none" (default), "record" or "replay";
+ * - file: name of the file (by default <name>_inputs_<date>.bin when recording);
+ * - pace: "realtime" (default) or "fast", used only in replay mode.
+ */
+class InputSession
+{
+public:
+    typedef std::size_t Stream; /**< Handle of a stream. */
+
+    /**
+     * Mode of the session.
+     */
+    enum class Mode
+    {
+        Disabled,
+        Record,
+        Replay
+    };
+
+private:
+    /**
+     * Sample stored in the replayed file.
+     */
+    struct Sample
+    {
+        std::size_t cycle; /**< Cycle of the sample. */
+        double timestamp; /**< Time at which the sample was recorded. */
+        std::size_t offset; /**< Position of the values (or of the labels). */
+        std::size_t size; /**< Number of values (0 for labels). */
+        bool isLabels; /**< True if the sample is a list of strings. */
+    };
+
+    /**
+     * Samples of a replayed stream.
+     */
+    struct ReplayStream
+    {
+        std::vector<Sample> samples; /**< Samples in the order they were recorded. */
+        std::size_t next{0}; /**< Next sample to be replayed. */
+    };
+
+    Mode m_mode{Mode::Disabled}; /**< Mode of the session. */
+    std::string m_fileName; /**< Name of the file. */
+    std::unordered_map<std::string, Stream> m_streamIndices; /**< Handle of each stream. */
+    std::size_t m_cycle{0}; /**< Current cycle (0 during the configuration). */
+
+    // record
+    std::FILE* m_file{nullptr}; /**< Recorded file. */
+    std::vector<double> m_buffer; /**< Buffer used to serialize a sample. */
+    std::mutex m_fileMutex; /**< Mutex protecting the recorded file and the buffer. */
+
+    // replay
+    bool m_realTimePace{true}; /**< If true the cycles are replayed with the recorded timing. */
+    std::vector<ReplayStream> m_streams; /**< Replayed streams. */
+    std::vector<double> m_values; /**< Values of all the replayed samples. */
+    std::vector<std::vector<std::string>> m_labels; /**< Labels of all the replayed samples. */
+    std::vector<double> m_cycleTimestamps; /**< Time at which each cycle began. */
+    double m_replayStartTime{0}; /**< Time at which the first cycle was replayed. */
+
+    /**
+     * Write an entry in the recorded file. The mutex of the file has to be locked.
+     * @param type type of the entry;
+     * @param stream stream of the entry;
+     * @param payload data following the header of the entry;
+     * @param size size of the payload in bytes.
+     * @return true in case of success and false otherwise.
+     */
+    bool writeEntry(std::uint32_t type, Stream stream, const void* payload, std::size_t size);
+
+    /**
+     * Lock the mutex of the file and write an entry in the recorded file.
+     * @param type type of the entry;
+     * @param stream stream of the entry;
+     * @param payload data following the header of the entry;
+     * @param size size of the payload in bytes.
+     * @return true in case of success and false otherwise.
+     */
+    bool write(std::uint32_t type, Stream stream, const void* payload, std::size_t size);
+
+    /**
+     * Write a sample in the recorded file. The mutex of the file has to be locked.
+     * @param stream handle of the stream;
+     * @param values values of the sample;
+     * @param size number of values.
+     */
+    void writeValues(const Stream& stream, const double* values, std::size_t size);
+
+    /**
+     * Write a sample in the recorded file.
+     * @param stream handle of the stream;
+     * @param values values of the sample;
+     * @param size number of values.
+     */
+    void recordValues(const Stream& stream, const double* values, std::size_t size);
+
+    /**
+     * Load the file to be replayed.
+     * @return true in case of success and false otherwise.
+     */
+    bool load();
+
+    /**
+     * Get the next sample of a stream in the current cycle.
+     * @param stream handle of the stream.
+     * @return pointer to the sample or nullptr if the stream has no more samples in the cycle.
+     */
+    const Sample* nextSample(const Stream& stream);
+
+public:
+    ~InputSession();
+
+    /**
+     * Configure the session.
+     * @param config configuration of the module (the INPUT_SESSION group is used);
+     * @param name name of the module, used for the default file name.
+     * @return true in case of success and false otherwise.
+     */
+    bool configure(const yarp::os::Searchable& config, const std::string& name);
+
+    /**
+     * Check if the configuration requires to replay a session. It can be used before
+     * configuring the YARP network, since a replayed session does not need the name server.
+     * @param config configuration of the module.
+     * @return true if the INPUT_SESSION group selects the replay mode.
+     */
+    static bool isReplayRequested(const yarp::os::Searchable& config);
+
+    /**
+     * Get the mode of the session.
+     * @return the mode.
+     */
+    Mode mode() const;
+
+    /**
+     * Check if the inputs are recorded.
+     * @return true in record mode.
+     */
+    bool isRecording() const;
+
+    /**
+     * Check if the inputs are replayed. In this case the devices must not be opened.
+     * @return true in replay mode.
+     */
+    bool isReplaying() const;
+
+    /**
+     * Get the period of the module loop. In replay mode the loop is paced by beginCycle().
+     * @param period nominal period of the module.
+     * @return the period to be used by the module.
+     */
+    double period(double period) const;
+
+    /**
+     * Add a stream. If a stream with the same name exists its handle is returned.
+     * @param name name of the stream.
+     * @return the handle of the stream.
+     */
+    Stream addStream(const std::string& name);
+
+    /**
+     * Begin a new cycle. In replay mode the samples of the previous cycle that have not been
+     * read are skipped and, if the realtime pace is used, the function waits until the time of
+     * the recorded cycle.
+     * @return false if the replayed session ended and true otherwise.
+     */
+    bool beginCycle();
+
+    /**
+     * Record a sample (only in record mode).
+     * @param stream handle of the stream;
+     * @param vector vector (std, yarp, iDynTree or Eigen) containing the sample.
+     */
+    template <typename T> void record(const Stream& stream, const T& vector);
+
+    /**
+     * Record a scalar sample (only in record mode).
+     * @param stream handle of the stream;
+     * @param value the sample.
+     */
+    void record(const Stream& stream, double value);
+
+    /**
+     * Record a list of strings (only in record mode).
+     * @param stream handle of the stream;
+     * @param labels the list of strings.
+     */
+    void recordLabels(const Stream& stream, const std::vector<std::string>& labels);
+
+    /**
+     * Get the next sample of a stream in the current cycle.
+     * @param stream handle of the stream;
+     * @param size number of values of the sample.
+     * @return pointer to the values or nullptr if the stream has no more samples in the cycle.
+     */
+    const double* replay(const Stream& stream, std::size_t& size);
+
+    /**
+     * Check if a stream has a sample to be replayed in the current cycle.
+     * @param stream handle of the stream.
+     * @return true if the next call to replay() or replayLabels() returns a sample.
+     */
+    bool hasSample(const Stream& stream) const;
+
+    /**
+     * Copy the next sample of a stream in a buffer with a known size.
+     * @param stream handle of the stream;
+     * @param values buffer;
+     * @param size size of the buffer.
+     * @return true if a sample of the same size was found and false otherwise.
+     */
+    bool replay(const Stream& stream, double* values, std::size_t size);
+
+    /**
+     * Copy the next sample of a stream in a resizable vector (std::vector or yarp::sig::Vector).
+     * @param stream handle of the stream;
+     * @param vector the vector.
+     * @return true if a sample was found and false otherwise.
+     */
+    template <typename T> bool replay(const Stream& stream, T& vector);
+
+    /**
+     * Read a sample with a function (e.g. a device readout) and record it or, in replay mode,
+     * replay it without calling the function.
+     * @param stream handle of the stream;
+     * @param vector resizable vector (std::vector or yarp::sig::Vector) filled by the function;
+     * @param read function reading the sample, it returns true in case of success.
+     * @return true if the sample was read (or replayed) and false otherwise.
+     */
+    template <typename T, typename F> bool read(const Stream& stream, T& vector, F&& read);
+
+    /**
+     * Read a sample with a function and record it or, in replay mode, replay it without calling
+     * the function.
+     * @param stream handle of the stream;
+     * @param values buffer filled by the function;
+     * @param size size of the buffer;
+     * @param read function reading the sample, it returns true in case of success.
+     * @return true if the sample was read (or replayed) and false otherwise.
+     */
+    template <typename F>
+    bool read(const Stream& stream, double* values, std::size_t size, F&& read);
+
+    /**
+     * Get the current time. The time is an input of the module (e.g. when it drives a state
+     * machine), so it is recorded or replayed.
+     * @param stream handle of the stream.
+     * @return the current (or replayed) time. In replay mode the time of the replayed cycle is
+     * returned if the stream has no sample.
+     */
+    double time(const Stream& stream);
+
+    /**
+     * Get the next list of strings of a stream in the current cycle.
+     * @param stream handle of the stream;
+     * @param labels the list of strings.
+     * @return true if a list was found and false otherwise.
+     */
+    bool replayLabels(const Stream& stream, std::vector<std::string>& labels);
+
+    /**
+     * Close the session.
+     */
+    void close();
+};
+
+#include "InputSession.tpp"
+
+#endif
@@ -0,0 +1,62 @@
+/**
+ * @file InputSession.tpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+// std
+#include <algorithm>
+
+template <typename T> void InputSession::record(const Stream& stream, const T& vector)
+{
+    if (m_mode != Mode::Record)
+        return;
+
+    // the buffer keeps its capacity, so it allocates memory only when a larger sample is recorded
+    std::lock_guard<std::mutex> guard(m_fileMutex);
+    m_buffer.resize(YarpHelper::VectorTraits<T>::size(vector));
+    YarpHelper::VectorTraits<T>::copy(vector, m_buffer.data());
+    writeValues(stream, m_buffer.data(), m_buffer.size());
+}
+
+template <typename T> bool InputSession::replay(const Stream& stream, T& vector)
+{
+    std::size_t size;
+    const double* values = replay(stream, size);
+    if (values == nullptr)
+        return false;
+
+    if (static_cast<std::size_t>(vector.size()) != size)
+        vector.resize(size);
+    std::copy_n(values, size, vector.data());
+    return true;
+}
+
+template <typename T, typename F>
+bool InputSession::read(const Stream& stream, T& vector, F&& read)
+{
+    if (m_mode == Mode::Replay)
+        return replay(stream, vector);
+
+    if (!read())
+        return false;
+
+    record(stream, vector);
+    return true;
+}
+
+template <typename F>
+bool InputSession::read(const Stream& stream, double* values, std::size_t size, F&& read)
+{
+    if (m_mode == Mode::Replay)
+        return replay(stream, values, size);
+
+    if (!read())
+        return false;
+
+    if (m_mode == Mode::Record)
+        recordValues(stream, values, size);
+    return true;
+}
@@ -0,0 +1,188 @@
+/**
+ * @file Instrumentation.hpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+#ifndef WALKING_INSTRUMENTATION_HPP
+#define WALKING_INSTRUMENTATION_HPP
+
+// std
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// YARP
+#include <yarp/os/Bottle.h>
+#include <yarp/os/PortReader.h>
+#include <yarp/os/RpcServer.h>
+
+#include <Histogram.hpp>
+
+/**
+ * StageProfiler collects the duration of the named stages of a control loop in preallocated
+ * histograms, and a set of named counters. The stages and the counters have to be added before
+ * opening the RPC port, then they can be updated from the control loop without allocating memory.
+ * Every stage and every counter is meant to be updated by a single thread.
+ * The statistics can be queried through the RPC port with the commands "stats" and "reset". The
+ * reset is only requested by the RPC thread: each stage and each counter is cleared by the thread
+ * that updates it, before its next update.
+ * If the project is compiled without ENABLE_INSTRUMENTATION the INSTRUMENTATION_* macros are
+ * empty and the port is not opened.
+ */
+class StageProfiler : public yarp::os::PortReader
+{
+    /**
+     * A named histogram.
+     */
+    struct Stage
+    {
+        std::string name; /**< Name of the stage. */
+        LatencyHistogram histogram; /**< Durations of the stage. */
+        std::uint64_t handledResetRequests{0}; /**< Reset requests applied by the writer. */
+    };
+
+    /**
+     * A named counter.
+     */
+    struct Counter
+    {
+        std::string name; /**< Name of the counter. */
+        std::atomic<std::uint64_t> value{0}; /**< Value of the counter. */
+        std::uint64_t handledResetRequests{0}; /**< Reset requests applied by the writer. */
+    };
+
+    std::vector<std::unique_ptr<Stage>> m_stages; /**< Stages. */
+    std::vector<std::unique_ptr<Counter>> m_counters; /**< Counters. */
+    std::atomic<std::uint64_t> m_resetRequests{0}; /**< Number of reset requests. */
+
+    yarp::os::RpcServer m_rpcPort; /**< RPC port used to query the statistics. */
+
+public:
+    /**
+     * Add a stage.
+     * @param name name of the stage.
+     * @return the index of the stage.
+     */
+    std::size_t addStage(const std::string& name);
+
+    /**
+     * Add a counter.
+     * @param name name of the counter.
+     * @return the index of the counter.
+     */
+    std::size_t addCounter(const std::string& name);
+
+    /**
+     * Record the duration of a stage.
+     * @param stage index of the stage;
+     * @param duration the duration in nanoseconds.
+     */
+    void record(const std::size_t& stage, std::uint64_t duration);
+
+    /**
+     * Increment a counter.
+     * @param counter index of the counter;
+     * @param value the increment.
+     */
+    void increment(const std::size_t& counter, std::uint64_t value = 1);
+
+    /**
+     * Open the RPC port. If the project is compiled without ENABLE_INSTRUMENTATION the port is
+     * not opened.
+     * @param portName name of the port.
+     * @return true in case of success and false otherwise.
+     */
+    bool open(const std::string& portName);
+
+    /**
+     * Close the RPC port.
+     */
+    void close();
+
+    /**
+     * Request the reset of the histograms and the counters. The request is applied by the
+     * threads that update them, so it can be called from any thread.
+     */
+    void requestReset();
+
+    /**
+     * Fill a bottle with the statistics of the stages and the values of the counters.
+     * @param statistics the bottle.
+     */
+    void getStatistics(yarp::os::Bottle& statistics) const;
+
+    /**
+     * Callback of the RPC port.
+     * @param connection the connection reader.
+     * @return true in case of success and false otherwise.
+     */
+    bool read(yarp::os::ConnectionReader& connection) override;
+};
+
+/**
+ * ScopedStageTimer records in a StageProfiler the time elapsed between its construction and its
+ * destruction.
+ */
+class ScopedStageTimer
+{
+    typedef std::chrono::steady_clock Clock;
+
+    StageProfiler& m_profiler; /**< The profiler. */
+    std::size_t m_stage; /**< Index of the stage. */
+    Clock::time_point m_start; /**< Construction time. */
+
+public:
+    /**
+     * Constructor.
+     * @param profiler the profiler;
+     * @param stage index of the stage.
+     */
+    ScopedStageTimer(StageProfiler& profiler, const std::size_t& stage)
+        : m_profiler(profiler)
+        , m_stage(stage)
+        , m_start(Clock::now())
+    {
+    }
+
+    /**
+     * Destructor. It records the duration of the scope.
+     */
+    ~ScopedStageTimer()
+    {
+        m_profiler.record(m_stage,
+                          std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now()
+                                                                               - m_start)
+                              .count());
+    }
+
+    ScopedStageTimer(const ScopedStageTimer&) = delete;
+    ScopedStageTimer& operator=(const ScopedStageTimer&) = delete;
+};
+
+#define INSTRUMENTATION_CONCATENATE_IMPL(a, b) a##b
+#define INSTRUMENTATION_CONCATENATE(a, b) INSTRUMENTATION_CONCATENATE_IMPL(a, b)
+
+#ifdef ENABLE_INSTRUMENTATION
+/**
+ * Record the duration of the enclosing scope in a stage of a profiler.
+ */
+#define INSTRUMENTATION_SCOPE(profiler, stage)                                                     \
+    ScopedStageTimer INSTRUMENTATION_CONCATENATE(scopedStageTimer, __LINE__)(profiler, stage)
+
+/**
+ * Increment a counter of a profiler.
+ */
+#define INSTRUMENTATION_COUNT(profiler, counter) (profiler).increment(counter)
+#else
+#define INSTRUMENTATION_SCOPE(profiler, stage)
+#define INSTRUMENTATION_COUNT(profiler, counter)
+#endif
+
+#endif
@@ -0,0 +1,150 @@
+/**
+ * @file JoypadSampler.hpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+#ifndef WALKING_JOYPAD_SAMPLER_HPP
+#define WALKING_JOYPAD_SAMPLER_HPP
+
+// std
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+// YARP
+#include <yarp/dev/IJoypadController.h>
+
+#include <LockFree.hpp>
+
+/**
+ * JoypadSampler reads all the axes and the buttons of a joypad in its own thread at a fixed rate.
+ * The latest values are published in a lock-free mailbox, so the control loop reads all of them
+ * with a single cheap call instead of querying the joypad client axis by axis. The changes of the
+ * buttons (press and release) are queued as events, so a press shorter than a cycle of the
+ * control loop is not lost.
+ * The sampler thread is the only one that uses the joypad interface. The snapshot and the events
+ * have to be read by a single thread.
+ */
+class JoypadSampler
+{
+public:
+    /** Maximum number of axes. */
+    static constexpr std::size_t maxAxes = 16;
+
+    /** Maximum number of buttons. */
+    static constexpr std::size_t maxButtons = 32;
+
+    /**
+     * Values of the axes and of the buttons read in a sample.
+     */
+    struct Snapshot
+    {
+        std::array<double, maxAxes> axes{}; /**< Values of the axes. */
+        std::array<float, maxButtons> buttons{}; /**< Values of the buttons. */
+        std::size_t numberOfAxes{0}; /**< Number of valid axes. */
+        std::size_t numberOfButtons{0}; /**< Number of valid buttons. */
+        double time{-1}; /**< Time of the sample in seconds (negative if never sampled). */
+    };
+
+    /**
+     * Change of a button.
+     */
+    struct ButtonEvent
+    {
+        std::size_t button{0}; /**< Index of the button. */
+        bool isPressed{false}; /**< True if the button was pressed, false if released. */
+        double time{0}; /**< Time of the sample in which the change was detected in seconds. */
+    };
+
+private:
+    /** Number of events that can be queued. */
+    static constexpr std::size_t eventsCapacity = 256;
+
+    yarp::dev::IJoypadController* m_joypad{nullptr}; /**< Joypad interface. */
+    std::chrono::nanoseconds m_period{0}; /**< Sampling period. */
+
+    std::thread m_sampler; /**< Sampler thread. */
+    std::atomic<bool> m_isRunning{false}; /**< True if the sampler thread is running. */
+
+    Snapshot m_sample; /**< Last sample (sampler side). */
+    LockFree::SeqLock<Snapshot> m_snapshot; /**< Latest sample (reader side). */
+    LockFree::SPSCRingBuffer<ButtonEvent, eventsCapacity> m_events; /**< Button events. */
+
+    std::atomic<std::uint64_t> m_numberOfSamples{0}; /**< Number of samples. */
+    std::atomic<std::uint64_t> m_numberOfFailedReads{0}; /**< Number of failed samples. */
+    std::atomic<std::uint64_t> m_droppedEvents{0}; /**< Events lost because the queue was full. */
+
+    /**
+     * Read all the axes and the buttons and queue the changes of the buttons.
+     * @return true in case of success and false otherwise.
+     */
+    bool sample();
+
+    /**
+     * Loop of the sampler thread.
+     */
+    void samplerLoop();
+
+public:
+    ~JoypadSampler();
+
+    /**
+     * Start the sampler thread. The number of axes and buttons is read from the joypad, the
+     * exceeding ones are neglected.
+     * @param joypad joypad interface (it must be valid until stop() is called);
+     * @param samplingTime sampling time in seconds.
+     * @return true in case of success and false otherwise.
+     */
+    bool start(yarp::dev::IJoypadController* joypad, const double& samplingTime);
+
+    /**
+     * Stop the sampler thread.
+     */
+    void stop();
+
+    /**
+     * Check if the sampler thread is running.
+     * @return true if the thread is running.
+     */
+    bool isRunning() const;
+
+    /**
+     * Get the latest sample. It never blocks the sampler.
+     * @param snapshot the latest sample.
+     * @return true if a new sample was taken since the previous call.
+     */
+    bool read(Snapshot& snapshot);
+
+    /**
+     * Get the oldest queued button event.
+     * @param event the event.
+     * @return false if no event is queued.
+     */
+    bool popEvent(ButtonEvent& event);
+
+    /**
+     * Get the number of samples.
+     * @return the number of samples.
+     */
+    std::uint64_t numberOfSamples() const;
+
+    /**
+     * Get the number of samples in which the joypad could not be read.
+     * @return the number of failed samples.
+     */
+    std::uint64_t numberOfFailedReads() const;
+
+    /**
+     * Get the number of events lost because the reader did not pop them.
+     * @return the number of dropped events.
+     */
+    std::uint64_t droppedEvents() const;
+};
+
+#endif
@@ -0,0 +1,186 @@
+/**
+ * @file LockFree.hpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+#ifndef WALKING_LOCK_FREE_HPP
+#define WALKING_LOCK_FREE_HPP
+
+// std
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// YARP
+#include <yarp/os/BufferedPort.h>
+
+namespace LockFree
+{
+/** Size used to keep the indices of the producer and of the consumer on different cache lines. */
+constexpr std::size_t cacheLineSize = 64;
+
+/**
+ * Single-producer single-consumer ring buffer. The storage is preallocated, hence pushing and
+ * popping an element do not allocate memory (the elements are copy-assigned, so vectors reuse
+ * their capacity once they reached the steady-state size).
+ * push() must be called by a single thread and pop() by another single thread.
+ * @tparam T type of the elements;
+ * @tparam Capacity number of elements. It must be a power of two.
+ */
+template <typename T, std::size_t Capacity> class SPSCRingBuffer
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                  "The capacity of the SPSCRingBuffer must be a power of two.");
+
+    static constexpr std::size_t mask = Capacity - 1;
+
+    std::array<T, Capacity> m_buffer; /**< Elements. */
+
+    std::atomic<std::size_t> m_head{0}; /**< Index of the next element written by the producer. */
+    std::size_t m_cachedTail{0}; /**< Copy of the tail owned by the producer. */
+    char m_producerPadding[cacheLineSize];
+
+    std::atomic<std::size_t> m_tail{0}; /**< Index of the next element read by the consumer. */
+    std::size_t m_cachedHead{0}; /**< Copy of the head owned by the consumer. */
+    char m_consumerPadding[cacheLineSize];
+
+public:
+    /**
+     * Push an element (producer side).
+     * @param element the element.
+     * @return false if the buffer is full.
+     */
+    bool push(const T& element);
+
+    /**
+     * Pop an element (consumer side).
+     * @param element the element.
+     * @return false if the buffer is empty.
+     */
+    bool pop(T& element);
+
+    /**
+     * Get the number of elements in the buffer. The value is approximated if the buffer is
+     * accessed at the same time.
+     * @return the number of elements.
+     */
+    std::size_t size() const;
+
+    /**
+     * Get the capacity of the buffer.
+     * @return the capacity.
+     */
+    static constexpr std::size_t capacity();
+};
+
+/**
+ * Seqlock-based mailbox holding the latest value written by a single producer. The reader never
+ * blocks the writer, if the value changes while it is read the read is repeated.
+ * @tparam T type of the value. It must be trivially copyable.
+ */
+template <typename T> class SeqLock
+{
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "The SeqLock can be used only with trivially copyable types. Use a "
+                  "TripleBuffer instead.");
+
+    std::atomic<std::uint64_t> m_sequence{0}; /**< Odd while the value is written. */
+    T m_value{}; /**< Stored value. */
+
+public:
+    /**
+     * Store a new value (writer side).
+     * @param value the value.
+     */
+    void write(const T& value);
+
+    /**
+     * Get the latest value (reader side).
+     * @param value the value.
+     * @return true if the value changed since the previous read.
+     */
+    bool read(T& value);
+
+private:
+    std::uint64_t m_lastReadSequence{0}; /**< Sequence of the latest read (reader side). */
+};
+
+/**
+ * Lock-free mailbox holding the latest value written by a single producer. It uses three buffers:
+ * the producer writes in its own buffer and swaps it with the shared one, the consumer swaps the
+ * shared buffer with its own when new data is available. It can be used with any type (e.g.
+ * vectors) and neither the producer nor the consumer ever waits for the other.
+ * @tparam T type of the value.
+ */
+template <typename T> class TripleBuffer
+{
+    static constexpr unsigned int indexMask = 0x3;
+    static constexpr unsigned int newDataFlag = 0x4;
+
+    std::array<T, 3> m_buffers; /**< Buffers. */
+    std::atomic<unsigned int> m_shared{2}; /**< Index of the shared buffer and new data flag. */
+    unsigned int m_back{0}; /**< Index of the buffer owned by the producer. */
+    unsigned int m_front{1}; /**< Index of the buffer owned by the consumer. */
+
+public:
+    /**
+     * Get the buffer owned by the producer. It can be filled in place before calling publish().
+     * @return the reference to the buffer.
+     */
+    T& writeBuffer();
+
+    /**
+     * Publish the buffer owned by the producer.
+     */
+    void publish();
+
+    /**
+     * Copy a value in the buffer owned by the producer and publish it.
+     * @param value the value.
+     */
+    void write(const T& value);
+
+    /**
+     * Get the latest value (consumer side).
+     * @return the pointer to the latest value if a new value was published since the previous
+     * call, nullptr otherwise. The pointed value is valid until the next call.
+     */
+    const T* read();
+};
+
+/**
+ * Callback of a BufferedPort that publishes the received data in a TripleBuffer.
+ * The control thread calls read() that never blocks and returns nullptr if no new data arrived,
+ * as BufferedPort::read(false).
+ * @tparam T type of the data received by the port.
+ */
+template <typename T> class PortMailbox : public yarp::os::TypedReaderCallback<T>
+{
+    TripleBuffer<T> m_buffer; /**< Latest received data. */
+
+public:
+    using yarp::os::TypedReaderCallback<T>::onRead;
+
+    /**
+     * Callback called by the port thread.
+     * @param data the received data.
+     */
+    void onRead(T& data) override;
+
+    /**
+     * Get the latest data.
+     * @return the pointer to the latest data if new data arrived since the previous call,
+     * nullptr otherwise.
+     */
+    const T* read();
+};
+} // namespace LockFree
+
+#include "LockFree.tpp"
+
+#endif
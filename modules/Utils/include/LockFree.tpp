@@ -0,0 +1,125 @@
+/**
+ * @file LockFree.tpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+// std
+#include <cstring>
+
+template <typename T, std::size_t Capacity>
+constexpr std::size_t LockFree::SPSCRingBuffer<T, Capacity>::mask;
+
+template <typename T, std::size_t Capacity>
+bool LockFree::SPSCRingBuffer<T, Capacity>::push(const T& element)
+{
+    const std::size_t head = m_head.load(std::memory_order_relaxed);
+    if (head - m_cachedTail == Capacity)
+    {
+        m_cachedTail = m_tail.load(std::memory_order_acquire);
+        if (head - m_cachedTail == Capacity)
+            return false;
+    }
+
+    m_buffer[head & mask] = element;
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T, std::size_t Capacity>
+bool LockFree::SPSCRingBuffer<T, Capacity>::pop(T& element)
+{
+    const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+    if (tail == m_cachedHead)
+    {
+        m_cachedHead = m_head.load(std::memory_order_acquire);
+        if (tail == m_cachedHead)
+            return false;
+    }
+
+    element = m_buffer[tail & mask];
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T, std::size_t Capacity>
+std::size_t LockFree::SPSCRingBuffer<T, Capacity>::size() const
+{
+    return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire);
+}
+
+template <typename T, std::size_t Capacity>
+constexpr std::size_t LockFree::SPSCRingBuffer<T, Capacity>::capacity()
+{
+    return Capacity;
+}
+
+template <typename T> void LockFree::SeqLock<T>::write(const T& value)
+{
+    const std::uint64_t sequence = m_sequence.load(std::memory_order_relaxed);
+    m_sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    std::memcpy(&m_value, &value, sizeof(T));
+
+    m_sequence.store(sequence + 2, std::memory_order_release);
+}
+
+template <typename T> bool LockFree::SeqLock<T>::read(T& value)
+{
+    std::uint64_t sequenceBefore, sequenceAfter;
+    do
+    {
+        sequenceBefore = m_sequence.load(std::memory_order_acquire);
+        std::memcpy(&value, &m_value, sizeof(T));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        sequenceAfter = m_sequence.load(std::memory_order_relaxed);
+    } while ((sequenceBefore & 1) != 0 || sequenceBefore != sequenceAfter);
+
+    const bool isNew = sequenceBefore != m_lastReadSequence;
+    m_lastReadSequence = sequenceBefore;
+    return isNew;
+}
+
+template <typename T> constexpr unsigned int LockFree::TripleBuffer<T>::indexMask;
+template <typename T> constexpr unsigned int LockFree::TripleBuffer<T>::newDataFlag;
+
+template <typename T> T& LockFree::TripleBuffer<T>::writeBuffer()
+{
+    return m_buffers[m_back];
+}
+
+template <typename T> void LockFree::TripleBuffer<T>::publish()
+{
+    const unsigned int previous
+        = m_shared.exchange(m_back | newDataFlag, std::memory_order_acq_rel);
+    m_back = previous & indexMask;
+}
+
+template <typename T> void LockFree::TripleBuffer<T>::write(const T& value)
+{
+    writeBuffer() = value;
+    publish();
+}
+
+template <typename T> const T* LockFree::TripleBuffer<T>::read()
+{
+    if ((m_shared.load(std::memory_order_relaxed) & newDataFlag) == 0)
+        return nullptr;
+
+    const unsigned int previous = m_shared.exchange(m_front, std::memory_order_acq_rel);
+    m_front = previous & indexMask;
+    return &m_buffers[m_front];
+}
+
+template <typename T> void LockFree::PortMailbox<T>::onRead(T& data)
+{
+    m_buffer.write(data);
+}
+
+template <typename T> const T* LockFree::PortMailbox<T>::read()
+{
+    return m_buffer.read();
+}
@@ -0,0 +1,121 @@
+/**
+ * @file OrientationPredictor.hpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+#ifndef WALKING_ORIENTATION_PREDICTOR_HPP
+#define WALKING_ORIENTATION_PREDICTOR_HPP
+
+// std
+#include <array>
+#include <cstddef>
+
+// Eigen
+#include <Eigen/Dense>
+
+/**
+ * OrientationPredictor extrapolates a sampled orientation forward in time. The angular velocity
+ * is estimated on SO(3) from two consecutive samples (w = log(R_{k-1}^T R_k) / dt, expressed in
+ * the body frame) and it is low-pass filtered. The predicted orientation is
+ * R_k exp(w * horizon), and the predicted rotation is saturated to a maximum angle.
+ * Each prediction is compared with the sample received one horizon later. The angle between
+ * them is the prediction error. The angle between that sample and the sample one horizon
+ * earlier is the error without prediction. Both errors are stored, so the benefit of the
+ * prediction can be evaluated.
+ */
+class OrientationPredictor
+{
+public:
+    /** Maximum number of samples in the prediction horizon. */
+    static constexpr std::size_t maxHorizonSamples = 63;
+
+private:
+    double m_samplingTime{0}; /**< Sampling time in seconds. */
+    double m_horizon{0}; /**< Prediction horizon in seconds. */
+    double m_filterGain{1}; /**< Gain of the angular velocity filter (1 means no filter). */
+    double m_maxAngle{0}; /**< Maximum predicted rotation in radians. */
+    std::size_t m_horizonSamples{0}; /**< Prediction horizon in samples. */
+
+    Eigen::Vector3d m_angularVelocity{Eigen::Vector3d::Zero()}; /**< Filtered velocity. */
+
+    /** Last samples and the predictions made at the same time (circular buffers). */
+    std::array<Eigen::Matrix3d, maxHorizonSamples + 1> m_samples;
+    std::array<Eigen::Matrix3d, maxHorizonSamples + 1> m_predictions;
+    std::size_t m_numberOfSamples{0}; /**< Number of samples received since the reset. */
+
+    double m_predictionError{0}; /**< Last prediction error in radians. */
+    double m_baselineError{0}; /**< Last error without prediction in radians. */
+    double m_predictionSquaredErrors{0}; /**< Sum of the squared prediction errors. */
+    double m_baselineSquaredErrors{0}; /**< Sum of the squared errors without prediction. */
+    std::size_t m_numberOfErrors{0}; /**< Number of evaluated errors. */
+
+    /**
+     * Angle of a rotation matrix.
+     * @param rotation the rotation matrix.
+     * @return the angle in radians in [0, pi].
+     */
+    static double angle(const Eigen::Matrix3d& rotation);
+
+public:
+    /**
+     * Configure the predictor.
+     * @param samplingTime sampling time in seconds;
+     * @param horizon prediction horizon in seconds (the errors are evaluated with the samples
+     * received round(horizon / samplingTime) samples later);
+     * @param filterGain gain of the first order filter of the angular velocity in (0, 1]
+     * (1 means no filter);
+     * @param maxAngle maximum predicted rotation in radians.
+     * @return true in case of success and false otherwise.
+     */
+    bool configure(const double& samplingTime,
+                   const double& horizon,
+                   const double& filterGain,
+                   const double& maxAngle);
+
+    /**
+     * Reset the state of the predictor and the errors.
+     */
+    void reset();
+
+    /**
+     * Add a sample and predict the orientation.
+     * @param rotation sampled orientation;
+     * @param predictedRotation predicted orientation (it can be the same object of rotation).
+     */
+    void predict(const Eigen::Matrix3d& rotation, Eigen::Matrix3d& predictedRotation);
+
+    /**
+     * Get the estimated angular velocity.
+     * @return the angular velocity in the body frame in radians per second.
+     */
+    const Eigen::Vector3d& angularVelocity() const;
+
+    /**
+     * Get the last prediction error.
+     * @return the angle in radians (0 if no error was evaluated).
+     */
+    double predictionError() const;
+
+    /**
+     * Get the last error without prediction.
+     * @return the angle in radians (0 if no error was evaluated).
+     */
+    double baselineError() const;
+
+    /**
+     * Get the root mean square of the prediction errors since the reset.
+     * @return the angle in radians.
+     */
+    double rmsPredictionError() const;
+
+    /**
+     * Get the root mean square of the errors without prediction since the reset.
+     * @return the angle in radians.
+     */
+    double rmsBaselineError() const;
+};
+
+#endif
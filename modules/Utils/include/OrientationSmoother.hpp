@@ -0,0 +1,66 @@
+/**
+ * @file OrientationSmoother.hpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+#ifndef WALKING_ORIENTATION_SMOOTHER_HPP
+#define WALKING_ORIENTATION_SMOOTHER_HPP
+
+// std
+#include <array>
+#include <cstddef>
+
+// Eigen
+#include <Eigen/Dense>
+
+/**
+ * OrientationSmoother smooths a sampled orientation on SO(3). It is a cascade of first order
+ * filters, each stage moves its orientation along the geodesic towards the output of the
+ * previous stage (q_i = slerp(q_i, q_{i-1}, gain)). The smoother is a third order low-pass
+ * filter with a triple pole, so a step of the input is followed with a smooth trajectory (as the
+ * minimum jerk trajectory generator) that reaches the 98% of the step in the smoothing time.
+ * Since the filter works on the rotation, it does not depend on the Euler angles used by the
+ * inverse kinematics and it is not affected by their singularities. The gain of the stages is
+ * evaluated once for the sampling time and the smoother does not allocate memory.
+ */
+class OrientationSmoother
+{
+public:
+    /** Number of first order filters in the cascade. */
+    static constexpr std::size_t numberOfStages = 3;
+
+private:
+    double m_gain{1}; /**< Gain of each stage in (0, 1] (1 means no smoothing). */
+    std::array<Eigen::Quaterniond, numberOfStages> m_stages; /**< Orientation of the stages. */
+
+public:
+    OrientationSmoother();
+
+    /**
+     * Configure the smoother. The state is set to the identity.
+     * @param samplingTime sampling time in seconds;
+     * @param smoothingTime time needed to reach the 98% of a step in seconds (0 means no
+     * smoothing).
+     * @return true in case of success and false otherwise.
+     */
+    bool configure(const double& samplingTime, const double& smoothingTime);
+
+    /**
+     * Set the state of the smoother to a rotation (the output is constant if the input is
+     * equal to it).
+     * @param rotation the rotation matrix.
+     */
+    void reset(const Eigen::Matrix3d& rotation);
+
+    /**
+     * Smooth a new sample.
+     * @param rotation the new sample;
+     * @param smoothedRotation the smoothed rotation (it can be the same object of the sample).
+     */
+    void smooth(const Eigen::Matrix3d& rotation, Eigen::Matrix3d& smoothedRotation);
+};
+
+#endif
@@ -0,0 +1,134 @@
+/**
+ * @file PeriodicExecutor.hpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+#ifndef WALKING_PERIODIC_EXECUTOR_HPP
+#define WALKING_PERIODIC_EXECUTOR_HPP
+
+// std
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+// YARP
+#include <yarp/os/Bottle.h>
+#include <yarp/os/PortReader.h>
+#include <yarp/os/RFModule.h>
+#include <yarp/os/ResourceFinder.h>
+#include <yarp/os/RpcServer.h>
+#include <yarp/os/Searchable.h>
+
+#include <Histogram.hpp>
+
+/**
+ * PeriodicExecutor runs a function at a fixed rate. The next activation is computed as an
+ * absolute time (clock_nanosleep with TIMER_ABSTIME on Linux), so the period does not drift
+ * with the computation time. Optionally the thread can be scheduled with SCHED_FIFO and pinned
+ * to a CPU. The execution time, the wake-up latency and the overruns are stored in histograms
+ * that can be queried through an RPC port with the commands "stats" and "reset".
+ */
+class PeriodicExecutor : public yarp::os::PortReader
+{
+    typedef std::chrono::steady_clock Clock;
+
+    std::chrono::nanoseconds m_period; /**< Period of the loop. */
+    int m_priority{0}; /**< SCHED_FIFO priority (0 means default scheduling). */
+    int m_cpu{-1}; /**< CPU used by the loop (-1 means no affinity). */
+
+    std::atomic<bool> m_isRunning{false}; /**< True if the loop is running. */
+
+    LatencyHistogram m_executionTime; /**< Time spent in the function. */
+    LatencyHistogram m_wakeUpLatency; /**< Delay between the deadline and the wake up. */
+    LatencyHistogram m_overrunTime; /**< Time exceeding the period in case of overrun. */
+    std::atomic<std::uint64_t> m_numberOfCycles{0}; /**< Number of executed cycles. */
+    std::atomic<std::uint64_t> m_numberOfOverruns{0}; /**< Number of missed deadlines. */
+
+    yarp::os::RpcServer m_rpcPort; /**< RPC port used to query the statistics. */
+
+    /**
+     * Apply the scheduling policy and the CPU affinity to the calling thread.
+     * @return true in case of success and false otherwise.
+     */
+    bool setupThread();
+
+    /**
+     * Sleep until an absolute time.
+     * @param wakeUpTime the time point.
+     */
+    static void sleepUntil(const Clock::time_point& wakeUpTime);
+
+public:
+    /**
+     * Configure the executor.
+     * The following parameters are read from the configuration object:
+     * - priority: SCHED_FIFO priority (optional, default 0, i.e. no real-time scheduling);
+     * - cpu: CPU the loop is pinned to (optional, default -1, i.e. no affinity);
+     * - rpc_port_name: name of the RPC port (optional, default /<name>/executor/rpc).
+     * @param config configuration object;
+     * @param period period of the loop in seconds (if zero the cycles run back to back, as in
+     * the RFModule);
+     * @param name name of the module.
+     * @return true in case of success and false otherwise.
+     */
+    bool configure(const yarp::os::Searchable& config,
+                   const double& period,
+                   const std::string& name);
+
+    /**
+     * Run the loop in the calling thread. It returns when the function returns false or when
+     * stop() is called.
+     * @param function the function called every period.
+     * @return false if the scheduling policy or the CPU affinity cannot be applied.
+     */
+    bool run(const std::function<bool()>& function);
+
+    /**
+     * Stop the loop. It is async-signal-safe.
+     */
+    void stop();
+
+    /**
+     * Close the RPC port.
+     */
+    void close();
+
+    /**
+     * Reset the statistics.
+     */
+    void resetStatistics();
+
+    /**
+     * Fill a bottle with the statistics of the loop.
+     * @param statistics the bottle.
+     */
+    void getStatistics(yarp::os::Bottle& statistics) const;
+
+    /**
+     * Callback of the RPC port.
+     * @param connection the connection reader.
+     * @return true in case of success and false otherwise.
+     */
+    bool read(yarp::os::ConnectionReader& connection) override;
+};
+
+namespace YarpHelper
+{
+/**
+ * Run an RFModule. If the group EXECUTOR of the resource finder contains "enable true", the
+ * updateModule() is called by a PeriodicExecutor, otherwise the standard RFModule loop is used.
+ * The executor stops when the module is stopped through stopModule() or when updateModule()
+ * returns false. Then interruptModule() and close() are called as in the RFModule loop.
+ * @param module the module;
+ * @param rf the resource finder.
+ * @return the exit code of the module.
+ */
+int runModule(yarp::os::RFModule& module, yarp::os::ResourceFinder& rf);
+} // namespace YarpHelper
+
+#endif
@@ -0,0 +1,91 @@
+/**
+ * @file RateScheduler.hpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+#ifndef WALKING_RATE_SCHEDULER_HPP
+#define WALKING_RATE_SCHEDULER_HPP
+
+// std
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// YARP
+#include <yarp/os/Searchable.h>
+
+/**
+ * RateScheduler decides which subsystems of a module run in the current cycle. The module runs
+ * at a base sampling time and each subsystem runs once every "divisor" cycles, i.e. with a
+ * sampling time equal to divisor * base sampling time. The subsystems with the same divisor are
+ * activated in different cycles (when possible), so the computational load is spread over the
+ * cycles.
+ * The schedule depends on the number of cycles only, so it is the same when the inputs of the
+ * module are replayed.
+ */
+class RateScheduler
+{
+    /**
+     * Subsystem of the module.
+     */
+    struct Subsystem
+    {
+        std::string name; /**< Name of the subsystem. */
+        unsigned divisor; /**< Number of base cycles between two activations. */
+        unsigned phase; /**< Offset of the activations in base cycles. */
+    };
+
+    double m_baseSamplingTime{0}; /**< Sampling time of the module in seconds. */
+    std::vector<Subsystem> m_subsystems; /**< Subsystems of the module. */
+    std::uint64_t m_numberOfCycles{0}; /**< Number of cycles started since the reset. */
+
+public:
+    /**
+     * Configure the scheduler.
+     * @param baseSamplingTime sampling time of the module in seconds.
+     * @return true in case of success and false otherwise.
+     */
+    bool configure(const double& baseSamplingTime);
+
+    /**
+     * Add a subsystem. The divisor is the parameter "<name>RateDivisor" of the configuration
+     * object (optional, default 1, i.e. the subsystem runs in every cycle).
+     * @param config configuration object;
+     * @param name name of the subsystem;
+     * @param index index of the subsystem.
+     * @return true in case of success and false otherwise.
+     */
+    bool addSubsystem(const yarp::os::Searchable& config,
+                      const std::string& name,
+                      std::size_t& index);
+
+    /**
+     * Start a new cycle.
+     */
+    void startCycle();
+
+    /**
+     * Restart the schedule from the first cycle.
+     */
+    void reset();
+
+    /**
+     * Check if a subsystem runs in the current cycle.
+     * @param index index of the subsystem.
+     * @return true if the subsystem runs in the current cycle and false otherwise.
+     */
+    bool isActive(const std::size_t& index) const;
+
+    /**
+     * Get the sampling time of a subsystem.
+     * @param index index of the subsystem.
+     * @return the sampling time in seconds.
+     */
+    double samplingTime(const std::size_t& index) const;
+};
+
+#endif
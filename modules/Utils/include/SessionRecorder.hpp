@@ -0,0 +1,245 @@
+/**
+ * @file SessionRecorder.hpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+#ifndef WALKING_SESSION_RECORDER_HPP
+#define WALKING_SESSION_RECORDER_HPP
+
+// std
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <Utils.hpp>
+
+/**
+ * Description of a channel of a session record. The values of a matrix channel are stored in
+ * column-major order.
+ */
+struct SessionRecordChannel
+{
+    std::string name; /**< Name of the channel. */
+    std::size_t rows; /**< Number of rows. */
+    std::size_t cols; /**< Number of columns. */
+    std::size_t offset; /**< Position of the first value in the record. */
+
+    /**
+     * Get the number of values of the channel.
+     * @return rows * cols.
+     */
+    std::size_t size() const
+    {
+        return rows * cols;
+    }
+};
+
+/**
+ * SessionRecorder writes a fixed-schema binary record of double values per cycle. The channels
+ * are added before opening the file, then the control loop copies its data in a preallocated
+ * record with set() and commit() appends the whole record to a memory-mapped file with a single
+ * memcpy. Neither set() nor commit() allocate memory or build strings; when the file is full it
+ * is enlarged by its initial capacity.
+ * The number of stored records is kept updated in the file header, so the file is readable even
+ * if the process does not close the recorder (on Windows the file is written with buffered I/O
+ * and the header is updated by close()). The file can be converted to .mat or CSV with the
+ * SessionRecordConverter application.
+ * Optionally the file is written by a background thread (see startWriter()). In this case
+ * commit() only copies the record in a preallocated queue, so the control loop never touches the
+ * file (page faults of the mapping, enlargement of the file or buffered I/O).
+ */
+class SessionRecorder
+{
+public:
+    typedef std::size_t Channel; /**< Handle of a channel. */
+
+private:
+    std::vector<SessionRecordChannel> m_channels; /**< Schema of the record. */
+    std::vector<double> m_record; /**< Record filled by set(). */
+
+    std::string m_fileName; /**< Name of the file. */
+    std::size_t m_headerSize{0}; /**< Size of the header in bytes (multiple of 8). */
+    std::size_t m_capacity{0}; /**< Number of records that fit in the file. */
+    std::size_t m_capacityIncrement{0}; /**< Number of records added when the file is full. */
+    std::atomic<std::size_t> m_numberOfRecords{0}; /**< Number of stored records. */
+    bool m_isOpen{false}; /**< True if the file is open. */
+
+    std::vector<double> m_queue; /**< Records waiting for the writer thread (circular buffer). */
+    std::size_t m_queueCapacity{0}; /**< Number of records of the queue. */
+    std::atomic<std::size_t> m_queueHead{0}; /**< Number of records pushed by commit(). */
+    std::atomic<std::size_t> m_queueTail{0}; /**< Number of records stored by the writer. */
+    std::size_t m_droppedRecords{0}; /**< Number of records dropped because of a full queue. */
+    std::thread m_writer; /**< Writer thread. */
+    std::atomic<bool> m_isWriterRunning{false}; /**< False if the writer has to stop. */
+    std::atomic<bool> m_isWriterFailed{false}; /**< True if a record could not be written. */
+
+#ifdef _WIN32
+    std::FILE* m_file{nullptr}; /**< File handle. */
+#else
+    int m_fileDescriptor{-1}; /**< File descriptor. */
+    char* m_mapping{nullptr}; /**< Memory mapping of the file. */
+    std::size_t m_mappingSize{0}; /**< Size of the memory mapping in bytes. */
+
+    /**
+     * Resize the file and map it in memory.
+     * @param capacity number of records.
+     * @return true in case of success and false otherwise.
+     */
+    bool map(std::size_t capacity);
+#endif
+
+    /**
+     * Serialize the header of the file.
+     * @return the header.
+     */
+    std::vector<char> header() const;
+
+    /**
+     * Append a record to the file.
+     * @param record pointer to the values of the record.
+     * @return true in case of success and false otherwise.
+     */
+    bool write(const double* record);
+
+    /**
+     * Loop of the writer thread. The queued records are stored periodically and when the writer
+     * is stopped.
+     */
+    void writerLoop();
+
+public:
+    ~SessionRecorder();
+
+    /**
+     * Add a channel. It has to be called before open().
+     * @param name name of the channel;
+     * @param rows number of rows;
+     * @param cols number of columns.
+     * @return the handle of the channel.
+     */
+    Channel addChannel(const std::string& name, std::size_t rows, std::size_t cols = 1);
+
+    /**
+     * Open the file.
+     * @param fileName name of the file;
+     * @param capacity initial number of records.
+     * @return true in case of success and false otherwise.
+     */
+    bool open(const std::string& fileName, std::size_t capacity);
+
+    /**
+     * Set the value of a scalar channel.
+     * @param channel handle of the channel;
+     * @param value the value.
+     */
+    void set(const Channel& channel, double value);
+
+    /**
+     * Set the values of a channel. If the size of the vector is different from the size of the
+     * channel the values are not set.
+     * @param channel handle of the channel;
+     * @param vector vector (std, yarp, iDynTree or Eigen) containing the values.
+     * @return true in case of success and false otherwise.
+     */
+    template <typename T> bool set(const Channel& channel, const T& vector);
+
+    /**
+     * Append the current record to the file. The values of the record are kept, so the channels
+     * that are not set in the next cycle keep their value.
+     * @return true in case of success and false otherwise (e.g. if the record is dropped because
+     * the queue of the writer thread is full or because the file can no longer be written, see
+     * isWriterFailed()).
+     */
+    bool commit();
+
+    /**
+     * Start a thread writing the records to the file. It has to be called after open(), then
+     * commit() copies the record in a queue and never waits for the file.
+     * @param queueCapacity maximum number of records waiting to be written. If the queue is full
+     * the committed records are dropped.
+     * @return true in case of success and false otherwise.
+     */
+    bool startWriter(std::size_t queueCapacity);
+
+    /**
+     * Close the file. The records in the queue of the writer thread are stored before stopping
+     * it. The file is truncated to the stored records.
+     * @return true in case of success and false otherwise.
+     */
+    bool close();
+
+    /**
+     * Get the name of the file.
+     * @return the name of the file.
+     */
+    const std::string& fileName() const;
+
+    /**
+     * Get the number of stored records.
+     * @return the number of records.
+     */
+    std::size_t numberOfRecords() const;
+
+    /**
+     * Get the number of records dropped because the queue of the writer thread was full.
+     * @return the number of records.
+     */
+    std::size_t droppedRecords() const;
+
+    /**
+     * Check if a record could not be written to the file. In this case the error is logged once
+     * and all the following records are dropped by commit().
+     * @return true if the file can no longer be written.
+     */
+    bool isWriterFailed() const;
+};
+
+/**
+ * SessionRecordReader loads a file written by a SessionRecorder.
+ */
+class SessionRecordReader
+{
+    std::vector<SessionRecordChannel> m_channels; /**< Schema of the record. */
+    std::vector<double> m_data; /**< Records. */
+    std::size_t m_recordSize{0}; /**< Number of values of a record. */
+    std::size_t m_numberOfRecords{0}; /**< Number of records. */
+
+public:
+    /**
+     * Load a file.
+     * @param fileName name of the file.
+     * @return true in case of success and false otherwise.
+     */
+    bool open(const std::string& fileName);
+
+    /**
+     * Get the channels.
+     * @return the vector containing the description of the channels.
+     */
+    const std::vector<SessionRecordChannel>& channels() const;
+
+    /**
+     * Get the number of records.
+     * @return the number of records.
+     */
+    std::size_t numberOfRecords() const;
+
+    /**
+     * Get the values of a channel in a record.
+     * @param record index of the record;
+     * @param channel index of the channel.
+     * @return pointer to the first value (the values of a matrix are column-major).
+     */
+    const double* data(std::size_t record, std::size_t channel) const;
+};
+
+#include "SessionRecorder.tpp"
+
+#endif
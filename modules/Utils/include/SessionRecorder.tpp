@@ -0,0 +1,17 @@
+/**
+ * @file SessionRecorder.tpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+template <typename T> bool SessionRecorder::set(const Channel& channel, const T& vector)
+{
+    const SessionRecordChannel& description = m_channels[channel];
+    if (YarpHelper::VectorTraits<T>::size(vector) != description.size())
+        return false;
+
+    YarpHelper::VectorTraits<T>::copy(vector, m_record.data() + description.offset);
+    return true;
+}
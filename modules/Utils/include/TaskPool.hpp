@@ -0,0 +1,125 @@
+/**
+ * @file TaskPool.hpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+#ifndef WALKING_TASK_POOL_HPP
+#define WALKING_TASK_POOL_HPP
+
+// std
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * TaskPool runs a fixed set of independent tasks once per cycle on a fixed number of threads.
+ * The tasks are registered before starting the pool. run() dispatches all the tasks, executes
+ * some of them in the calling thread and returns when all of them are completed (i.e. it is a
+ * barrier), so the duration of a cycle is the duration of the longest task (if there are enough
+ * threads) instead of the sum of the durations. Without worker threads the tasks are executed in
+ * sequence in the calling thread, in the order they were added.
+ * With dedicated workers (see startDedicated()) each task is always executed by its own worker
+ * thread, which can be pinned to a CPU, and the calling thread of run() only waits for them.
+ * The tasks must not access the same data, except for read-only data written before run().
+ */
+class TaskPool
+{
+public:
+    typedef std::function<bool()> Task; /**< A task returns false in case of failure. */
+
+private:
+    std::vector<Task> m_tasks; /**< Tasks executed in each cycle. */
+    std::vector<std::thread> m_workers; /**< Worker threads. */
+
+    std::mutex m_mutex; /**< Mutex protecting the state of the cycle. */
+    std::condition_variable m_cycleStarted; /**< Notified when a cycle starts. */
+    std::condition_variable m_cycleCompleted; /**< Notified when all the tasks are completed. */
+    std::size_t m_nextTask{0}; /**< Index of the next task to be executed in the cycle. */
+    std::size_t m_completedTasks{0}; /**< Number of completed tasks in the cycle. */
+    std::uint64_t m_numberOfCycles{0}; /**< Number of cycles started by run(). */
+    bool m_isFailed{false}; /**< True if a task of the cycle failed. */
+    bool m_isClosing{false}; /**< True if the workers have to stop. */
+    bool m_isDedicated{false}; /**< True if each task has its own worker thread. */
+
+    /**
+     * Execute the next task of the cycle. The mutex is released while the task is executed.
+     * @param lock lock of the mutex (locked).
+     */
+    void executeNextTask(std::unique_lock<std::mutex>& lock);
+
+    /**
+     * Mark a task of the cycle as completed.
+     * @param isSucceeded true if the task succeeded.
+     */
+    void completeTask(bool isSucceeded);
+
+    /**
+     * Loop of the worker threads.
+     */
+    void workerLoop();
+
+    /**
+     * Loop of a dedicated worker thread.
+     * @param task index of the task executed by the thread;
+     * @param numberOfCycles number of cycles started before the thread was created.
+     */
+    void dedicatedWorkerLoop(std::size_t task, std::uint64_t numberOfCycles);
+
+    /**
+     * Pin a worker thread to a CPU (only on Linux).
+     * @param worker the worker thread;
+     * @param cpu the CPU (-1 means no affinity).
+     * @return true in case of success and false otherwise.
+     */
+    static bool pinWorker(std::thread& worker, int cpu);
+
+public:
+    /**
+     * Destructor. The worker threads are stopped.
+     */
+    ~TaskPool();
+
+    /**
+     * Add a task. The tasks can be added only before starting the pool.
+     * @param task the task.
+     * @return true in case of success and false otherwise.
+     */
+    bool addTask(const Task& task);
+
+    /**
+     * Start the worker threads.
+     * @param numberOfThreads number of worker threads (the calling thread of run() executes
+     * tasks as well, hence more than number of tasks - 1 threads are never used).
+     * @return true in case of success and false otherwise.
+     */
+    bool start(std::size_t numberOfThreads);
+
+    /**
+     * Start a dedicated worker thread for each task.
+     * @param cpus CPU of the worker of each task, in the order the tasks were added (optional,
+     * -1 or a missing element means no affinity). The CPU affinity is supported only on Linux.
+     * @return true in case of success and false otherwise.
+     */
+    bool startDedicated(const std::vector<int>& cpus = std::vector<int>());
+
+    /**
+     * Execute all the tasks and wait for their completion.
+     * @return false if at least one task failed and true otherwise.
+     */
+    bool run();
+
+    /**
+     * Stop the worker threads. The tasks are kept, so the pool can be started again (until then
+     * run() executes them in the calling thread).
+     */
+    void close();
+};
+
+#endif
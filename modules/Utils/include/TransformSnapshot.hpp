@@ -0,0 +1,128 @@
+/**
+ * @file TransformSnapshot.hpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+#ifndef WALKING_TRANSFORM_SNAPSHOT_HPP
+#define WALKING_TRANSFORM_SNAPSHOT_HPP
+
+// std
+#include <array>
+#include <cstddef>
+#include <string>
+
+// YARP
+#include <yarp/dev/IFrameTransform.h>
+#include <yarp/sig/Matrix.h>
+
+/**
+ * Snapshot of the transformations between a set of frames and a root frame. The frames are
+ * registered once at configuration time and all the transformations are read in a single pass
+ * over preallocated storage. A frame is looked up in the frame tree only until it is found
+ * (and again if its transformation cannot be evaluated anymore), so in the steady state the
+ * transform client is queried once per frame and per cycle.
+ * The transform client does not provide the time at which a transformation was published,
+ * hence the timestamp of a frame is the time of the update in which its transformation changed.
+ * A frame is stale if its transformation did not change for longer than the timeout.
+ */
+class TransformSnapshot
+{
+public:
+    /** Maximum number of frames in the snapshot. */
+    static constexpr std::size_t maxFrames = 8;
+
+private:
+    /**
+     * Transformation between a frame and the root frame.
+     */
+    struct Frame
+    {
+        std::string name; /**< Name of the frame. */
+        yarp::sig::Matrix root_T_frame; /**< Homogeneous transformation. */
+        double timestamp{-1}; /**< Time of the last change of the transformation. */
+        bool isResolved{false}; /**< True if the frame was found in the frame tree. */
+        bool isValid{false}; /**< True if the transformation was read in the last update. */
+        bool isStale{false}; /**< True if the transformation is older than the timeout. */
+    };
+
+    std::array<Frame, maxFrames> m_frames; /**< Frames of the snapshot. */
+    std::size_t m_numberOfFrames{0}; /**< Number of registered frames. */
+
+    std::string m_rootFrameName; /**< Name of the root frame. */
+    bool m_isRootResolved{false}; /**< True if the root frame was found in the frame tree. */
+    double m_timeout{0}; /**< Staleness timeout in seconds (disabled if not positive). */
+
+    yarp::sig::Matrix m_buffer; /**< Transformation read from the transform client. */
+
+public:
+    /**
+     * Constructor.
+     */
+    TransformSnapshot();
+
+    /**
+     * Configure the snapshot. The registered frames are removed.
+     * @param rootFrameName name of the root frame;
+     * @param timeout staleness timeout in seconds (the staleness is not detected if the timeout
+     * is not positive).
+     * @return true in case of success and false otherwise.
+     */
+    bool configure(const std::string& rootFrameName, const double& timeout);
+
+    /**
+     * Register a frame.
+     * @param frameName name of the frame;
+     * @param index index of the frame in the snapshot.
+     * @return true in case of success and false otherwise.
+     */
+    bool addFrame(const std::string& frameName, std::size_t& index);
+
+    /**
+     * Read the transformations of all the frames.
+     * @param frameTransform the frame transform interface;
+     * @param time current time in seconds.
+     * @return false if the root frame does not exist and true otherwise. The validity of each
+     * transformation is returned by isValid().
+     */
+    bool update(yarp::dev::IFrameTransform& frameTransform, const double& time);
+
+    /**
+     * Check if the transformation of a frame was read in the last update.
+     * @param index index of the frame.
+     * @return true if the transformation is valid.
+     */
+    bool isValid(const std::size_t& index) const;
+
+    /**
+     * Check if the transformation of a frame did not change for longer than the timeout.
+     * @param index index of the frame.
+     * @return true if the transformation is stale.
+     */
+    bool isStale(const std::size_t& index) const;
+
+    /**
+     * Get the time of the last change of the transformation of a frame.
+     * @param index index of the frame.
+     * @return the time in seconds (negative if the transformation was never read).
+     */
+    double timestamp(const std::size_t& index) const;
+
+    /**
+     * Get the transformation between a frame and the root frame.
+     * @param index index of the frame.
+     * @return the homogeneous transformation.
+     */
+    const yarp::sig::Matrix& transform(const std::size_t& index) const;
+
+    /**
+     * Get the name of a frame.
+     * @param index index of the frame.
+     * @return the name of the frame.
+     */
+    const std::string& frameName(const std::size_t& index) const;
+};
+
+#endif
@@ -10,9 +10,13 @@
 #define WALKING_UTILS_HPP
 
 // std
+#include <cstddef>
 #include <deque>
 #include <vector>
 
+// Eigen
+#include <Eigen/Dense>
+
 // YARP
 #include <yarp/os/BufferedPort.h>
 #include <yarp/os/Property.h>
@@ -41,6 +45,43 @@ double shortestAngularDistance(const double& fromRad, const double& toRad);
  * @return the wrapped angle
  */
 double normalizeAngle(const double& angle);
+
+/**
+ * Normalize a vector of angles between -pi <= angle <= pi.
+ * The angles are wrapped without branches so that the loop can be vectorized.
+ * @param angles is the vector of angles. It is normalized in place.
+ */
+void normalizeAngles(Eigen::Ref<Eigen::VectorXd> angles);
+
+/**
+ * Normalize a span of angles between -pi <= angle <= pi.
+ * @param angles is the pointer to the first angle. The angles are normalized in place;
+ * @param size is the number of angles.
+ */
+void normalizeAngles(double* angles, const std::size_t& size);
+
+/**
+ * Given 2 vectors of angles, it returns the element-wise shortest angular difference.
+ * Each element of the result would always be -pi <= result <= pi.
+ * @param fromRad is the vector of starting angles expressed in radians;
+ * @param toRad is the vector of final angles expressed in radians;
+ * @param distances is the vector of the shortest angular distances.
+ */
+void shortestAngularDistances(const Eigen::Ref<const Eigen::VectorXd>& fromRad,
+                              const Eigen::Ref<const Eigen::VectorXd>& toRad,
+                              Eigen::Ref<Eigen::VectorXd> distances);
+
+/**
+ * Given 2 spans of angles, it returns the element-wise shortest angular difference.
+ * @param fromRad is the pointer to the first starting angle expressed in radians;
+ * @param toRad is the pointer to the first final angle expressed in radians;
+ * @param distances is the pointer to the first shortest angular distance;
+ * @param size is the number of angles.
+ */
+void shortestAngularDistances(const double* fromRad,
+                              const double* toRad,
+                              double* distances,
+                              const std::size_t& size);
 } // namespace Angles
 
 /**
@@ -164,6 +205,14 @@ bool getVectorFromSearchable(const yarp::os::Searchable& config,
                              const std::string& key,
                              std::vector<int>& output);
 
+/**
+ * Traits used to access the elements of a generic vector (yarp, Eigen, std and iDynTree vectors)
+ * when it is merged into a yarp::sig::Vector. If the type exposes a contiguous storage through
+ * data() the elements are copied in one block, otherwise they are accessed with operator().
+ * The trait can be specialized for any other vector type.
+ */
+template <typename T, typename = void> struct VectorTraits;
+
 /**
  * Merge two vectors. vector = [vector, t]
  * @param vector the original vector. The new elements will be add at the end of
@@ -185,9 +234,11 @@ template <typename T, typename... Args>
 void mergeSigVector(yarp::sig::Vector& vector, const T& t, const Args&... args);
 
 /**
- * Send a variadic vector through a yarp buffered port
+ * Send a variadic vector through a yarp buffered port.
+ * The prepared vector is resized only when the total size changes, so in steady state no heap
+ * allocation is performed.
  * @param port is a Yarp buffered port
- * @param args list containing all the vector that will be send.
+ * @param args list containing all the vectors (or scalars) that will be send.
  */
 template <typename... Args>
 void sendVariadicVector(yarp::os::BufferedPort<yarp::sig::Vector>& port, const Args&... args);
@@ -7,15 +7,142 @@
  */
 
 // std
+#include <algorithm>
+#include <cstddef>
 #include <iostream>
+#include <type_traits>
+#include <utility>
 
 // YARP
 #include <yarp/os/LogStream.h>
 
+namespace YarpHelper
+{
+namespace detail
+{
+template <typename... Ts> struct MakeVoid
+{
+    typedef void type;
+};
+
+template <typename... Ts> using VoidT = typename MakeVoid<Ts...>::type;
+
+// true if the vector exposes its inner stride (i.e. Eigen objects)
+template <typename T, typename = void> struct HasInnerStride : std::false_type
+{
+};
+
+template <typename T>
+struct HasInnerStride<T, VoidT<decltype(std::declval<const T&>().innerStride())>> : std::true_type
+{
+};
+
+inline std::size_t totalSize()
+{
+    return 0;
+}
+
+template <typename T, typename... Args> std::size_t totalSize(const T& t, const Args&... args)
+{
+    return VectorTraits<T>::size(t) + totalSize(args...);
+}
+
+inline void copyToBuffer(double*)
+{
+}
+
+template <typename T, typename... Args>
+void copyToBuffer(double* buffer, const T& t, const Args&... args)
+{
+    VectorTraits<T>::copy(t, buffer);
+    copyToBuffer(buffer + VectorTraits<T>::size(t), args...);
+}
+} // namespace detail
+
+// generic vector accessed element by element (i.e. Eigen expressions)
+template <typename T, typename> struct VectorTraits
+{
+    static std::size_t size(const T& t)
+    {
+        return static_cast<std::size_t>(t.size());
+    }
+
+    static void copy(const T& t, double* buffer)
+    {
+        for (std::size_t i = 0; i < size(t); i++)
+            buffer[i] = t(i);
+    }
+};
+
+// vector with a contiguous storage (yarp, std, iDynTree and Eigen plain vectors)
+template <typename T>
+struct VectorTraits<T, detail::VoidT<decltype(std::declval<const T&>().data())>>
+{
+    static std::size_t size(const T& t)
+    {
+        return static_cast<std::size_t>(t.size());
+    }
+
+    static void copy(const T& t, double* buffer)
+    {
+        copy(t, buffer, detail::HasInnerStride<T>{});
+    }
+
+private:
+    static void copy(const T& t, double* buffer, std::false_type)
+    {
+        std::copy_n(t.data(), size(t), buffer);
+    }
+
+    static void copy(const T& t, double* buffer, std::true_type)
+    {
+        // a block of an Eigen matrix may not be contiguous
+        if (t.innerStride() == 1)
+        {
+            std::copy_n(t.data(), size(t), buffer);
+            return;
+        }
+
+        for (std::size_t i = 0; i < size(t); i++)
+            buffer[i] = t(i);
+    }
+};
+
+// a scalar is a vector with one element
+template <> struct VectorTraits<double>
+{
+    static std::size_t size(const double&)
+    {
+        return 1;
+    }
+
+    static void copy(const double& t, double* buffer)
+    {
+        buffer[0] = t;
+    }
+};
+
+// std::vector<bool> does not store its elements contiguously
+template <> struct VectorTraits<std::vector<bool>>
+{
+    static std::size_t size(const std::vector<bool>& t)
+    {
+        return t.size();
+    }
+
+    static void copy(const std::vector<bool>& t, double* buffer)
+    {
+        for (std::size_t i = 0; i < t.size(); i++)
+            buffer[i] = t[i] ? 1.0 : 0.0;
+    }
+};
+} // namespace YarpHelper
+
 template <typename T> void YarpHelper::mergeSigVector(yarp::sig::Vector& vector, const T& t)
 {
-    for (int i = 0; i < t.size(); i++)
-        vector.push_back(t(i));
+    const std::size_t offset = vector.size();
+    vector.resize(offset + VectorTraits<T>::size(t));
+    VectorTraits<T>::copy(t, vector.data() + offset);
 
     return;
 }
@@ -23,10 +150,10 @@ template <typename T> void YarpHelper::mergeSigVector(yarp::sig::Vector& vector,
 template <typename T, typename... Args>
 void YarpHelper::mergeSigVector(yarp::sig::Vector& vector, const T& t, const Args&... args)
 {
-    for (int i = 0; i < t.size(); i++)
-        vector.push_back(t(i));
-
-    mergeSigVector(vector, args...);
+    // the vector is resized once and each argument is copied in a single block
+    const std::size_t offset = vector.size();
+    vector.resize(offset + detail::totalSize(t, args...));
+    detail::copyToBuffer(vector.data() + offset, t, args...);
 
     return;
 }
@@ -36,9 +163,14 @@ void YarpHelper::sendVariadicVector(yarp::os::BufferedPort<yarp::sig::Vector>& p
                                     const Args&... args)
 {
     yarp::sig::Vector& vector = port.prepare();
-    vector.clear();
 
-    mergeSigVector(vector, args...);
+    // the prepared vector keeps its capacity, the resize allocates memory only if the size of
+    // the message changes
+    const std::size_t size = detail::totalSize(args...);
+    if (vector.size() != size)
+        vector.resize(size);
+
+    detail::copyToBuffer(vector.data(), args...);
 
     port.write();
 }
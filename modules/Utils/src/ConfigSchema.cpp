@@ -0,0 +1,217 @@
+/**
+ * @file ConfigSchema.cpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+// YARP
+#include <yarp/os/Bottle.h>
+
+#include "ConfigSchema.hpp"
+
+using namespace YarpHelper;
+
+ParameterParser::ParameterParser(const yarp::os::Searchable& config)
+    : m_config(config)
+{
+}
+
+yarp::os::Value* ParameterParser::find(const char* key)
+{
+    yarp::os::Value* value;
+    if (!m_config.check(key, value))
+    {
+        addError(key, "missing field");
+        return nullptr;
+    }
+    return value;
+}
+
+void ParameterParser::addError(const char* key, const std::string& message)
+{
+    m_errors.push_back(std::string(key) + ": " + message + ".");
+}
+
+const std::vector<std::string>& ParameterParser::errors() const
+{
+    return m_errors;
+}
+
+void ParameterParser::operator()(const char* key, std::string& value)
+{
+    yarp::os::Value* input = find(key);
+    if (input == nullptr)
+        return;
+
+    if (!input->isString())
+    {
+        addError(key, "the value is not a string");
+        return;
+    }
+    value = input->asString();
+}
+
+void ParameterParser::operator()(const char* key, double& value)
+{
+    yarp::os::Value* input = find(key);
+    if (input == nullptr)
+        return;
+
+    if (!input->isFloat64() && !input->isInt32())
+    {
+        addError(key, "the value is not a double");
+        return;
+    }
+    value = input->asFloat64();
+}
+
+void ParameterParser::operator()(const char* key, int& value)
+{
+    yarp::os::Value* input = find(key);
+    if (input == nullptr)
+        return;
+
+    if (!input->isInt32())
+    {
+        addError(key, "the value is not an int");
+        return;
+    }
+    value = input->asInt32();
+}
+
+void ParameterParser::operator()(const char* key, unsigned int& value)
+{
+    int signedValue = 0;
+    const std::size_t numberOfErrors = m_errors.size();
+    (*this)(key, signedValue);
+    if (m_errors.size() != numberOfErrors)
+        return;
+
+    if (signedValue < 0)
+    {
+        addError(key, "the value is lower than zero");
+        return;
+    }
+    value = static_cast<unsigned int>(signedValue);
+}
+
+void ParameterParser::operator()(const char* key, bool& value)
+{
+    yarp::os::Value* input = find(key);
+    if (input == nullptr)
+        return;
+
+    // the configuration files also use 0 and 1 for the booleans
+    if (input->isBool() || input->isInt32())
+    {
+        value = input->asBool();
+        return;
+    }
+
+    if (input->isString() && (input->asString() == "true" || input->asString() == "false"))
+    {
+        value = input->asString() == "true";
+        return;
+    }
+
+    addError(key, "the value is not a bool");
+}
+
+void ParameterParser::operator()(const char* key, std::vector<double>& value)
+{
+    yarp::os::Value* input = find(key);
+    if (input == nullptr)
+        return;
+
+    if (!input->isList())
+    {
+        addError(key, "the value is not a list");
+        return;
+    }
+
+    yarp::os::Bottle* list = input->asList();
+    value.resize(list->size());
+    for (std::size_t i = 0; i < list->size(); i++)
+    {
+        if (!list->get(i).isFloat64() && !list->get(i).isInt32())
+        {
+            addError(key, "the element " + std::to_string(i) + " is not a double or an int");
+            return;
+        }
+        value[i] = list->get(i).asFloat64();
+    }
+}
+
+void ParameterParser::operator()(const char* key, std::vector<int>& value)
+{
+    yarp::os::Value* input = find(key);
+    if (input == nullptr)
+        return;
+
+    if (!input->isList())
+    {
+        addError(key, "the value is not a list");
+        return;
+    }
+
+    yarp::os::Bottle* list = input->asList();
+    value.resize(list->size());
+    for (std::size_t i = 0; i < list->size(); i++)
+    {
+        if (!list->get(i).isInt32())
+        {
+            addError(key, "the element " + std::to_string(i) + " is not an int");
+            return;
+        }
+        value[i] = list->get(i).asInt32();
+    }
+}
+
+void ParameterParser::operator()(const char* key, std::vector<std::string>& value)
+{
+    yarp::os::Value* input = find(key);
+    if (input == nullptr)
+        return;
+
+    if (!input->isList())
+    {
+        addError(key, "the value is not a list");
+        return;
+    }
+
+    yarp::os::Bottle* list = input->asList();
+    value.resize(list->size());
+    for (std::size_t i = 0; i < list->size(); i++)
+    {
+        if (!list->get(i).isString())
+        {
+            addError(key, "the element " + std::to_string(i) + " is not a string");
+            return;
+        }
+        value[i] = list->get(i).asString();
+    }
+}
+
+void ParameterParser::operator()(const char* key, yarp::sig::Vector& value)
+{
+    std::vector<double> buffer;
+    const std::size_t numberOfErrors = m_errors.size();
+    (*this)(key, buffer);
+    if (m_errors.size() != numberOfErrors)
+        return;
+
+    // a non empty vector fixes the expected size of the list
+    if (value.size() != 0 && value.size() != buffer.size())
+    {
+        addError(key,
+                 "expected " + std::to_string(value.size()) + " elements, found "
+                     + std::to_string(buffer.size()));
+        return;
+    }
+
+    value.resize(buffer.size());
+    for (std::size_t i = 0; i < buffer.size(); i++)
+        value[i] = buffer[i];
+}
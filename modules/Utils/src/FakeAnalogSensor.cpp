@@ -0,0 +1,79 @@
+/**
+ * @file FakeAnalogSensor.cpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+// YARP
+#include <yarp/os/LogStream.h>
+#include <yarp/os/Time.h>
+
+#include <FakeAnalogSensor.hpp>
+
+bool FakeAnalogSensor::open(yarp::os::Searchable& config)
+{
+    m_channels = config.check("channels", yarp::os::Value(0)).asInt32();
+    if (m_channels < 0)
+    {
+        yError() << "[FakeAnalogSensor::open] The number of channels cannot be negative.";
+        return false;
+    }
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_signal.configure(config, "analog", 127.5, 100.0);
+    m_startTime = yarp::os::Time::now();
+    return true;
+}
+
+bool FakeAnalogSensor::close()
+{
+    return true;
+}
+
+int FakeAnalogSensor::read(yarp::sig::Vector& out)
+{
+    if (m_channels > 0 && static_cast<int>(out.size()) != m_channels)
+        out.resize(m_channels);
+
+    if (out.size() == 0)
+        return AS_ERROR;
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    const double time = yarp::os::Time::now() - m_startTime;
+    for (std::size_t i = 0; i < out.size(); i++)
+        out[i] = m_signal(time, i);
+
+    return AS_OK;
+}
+
+int FakeAnalogSensor::getState(int ch)
+{
+    return AS_OK;
+}
+
+int FakeAnalogSensor::getChannels()
+{
+    return m_channels;
+}
+
+int FakeAnalogSensor::calibrateSensor()
+{
+    return AS_OK;
+}
+
+int FakeAnalogSensor::calibrateSensor(const yarp::sig::Vector& value)
+{
+    return AS_OK;
+}
+
+int FakeAnalogSensor::calibrateChannel(int ch)
+{
+    return AS_OK;
+}
+
+int FakeAnalogSensor::calibrateChannel(int ch, double value)
+{
+    return AS_OK;
+}
@@ -0,0 +1,940 @@
+/**
+ * @file FakeControlBoard.cpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+// std
+#include <algorithm>
+#include <cmath>
+
+// YARP
+#include <yarp/os/LogStream.h>
+#include <yarp/os/Time.h>
+
+#include <FakeControlBoard.hpp>
+#include <Utils.hpp>
+
+template <typename F> bool FakeControlBoard::forEachJoint(F&& function)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    update();
+    for (std::size_t i = 0; i < m_joints.size(); i++)
+        if (!function(m_joints[i], i))
+            return false;
+    return true;
+}
+
+template <typename F> bool FakeControlBoard::forJoints(int n, const int* joints, F&& function)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    update();
+    for (int i = 0; i < n; i++)
+        if (!isValid(joints[i]) || !function(m_joints[joints[i]], i))
+            return false;
+    return true;
+}
+
+bool FakeControlBoard::isValid(int j) const
+{
+    return j >= 0 && j < static_cast<int>(m_joints.size());
+}
+
+double FakeControlBoard::positionError(const Joint& joint) const
+{
+    if (joint.controlMode == VOCAB_CM_POSITION)
+        return joint.targetPosition - joint.position;
+
+    if (joint.controlMode == VOCAB_CM_POSITION_DIRECT)
+        return joint.positionReference - joint.position;
+
+    return 0;
+}
+
+void FakeControlBoard::update()
+{
+    const double now = yarp::os::Time::now();
+    const double dT = now - m_lastUpdateTime;
+    if (dT <= 0)
+        return;
+
+    m_lastUpdateTime = now;
+    m_stamp.update(now);
+
+    const double filterGain = 1 - std::exp(-dT / m_timeConstant);
+    for (auto& joint : m_joints)
+    {
+        double velocity = 0;
+        switch (joint.controlMode)
+        {
+        case VOCAB_CM_POSITION_DIRECT:
+            velocity = (joint.positionReference - joint.position) * filterGain / dT;
+            break;
+
+        case VOCAB_CM_POSITION:
+            velocity = (joint.targetPosition - joint.position) * filterGain / dT;
+            velocity = std::max(-joint.referenceSpeed, std::min(joint.referenceSpeed, velocity));
+            break;
+
+        case VOCAB_CM_VELOCITY:
+            velocity = joint.velocityReference;
+            break;
+
+        case VOCAB_CM_CURRENT:
+            velocity = m_currentToVelocity * joint.currentReference;
+            break;
+
+        case VOCAB_CM_PWM:
+            velocity = m_pwmToVelocity * joint.dutyCycleReference;
+            break;
+
+        default:
+            break;
+        }
+
+        velocity = std::max(-joint.velocityLimit, std::min(joint.velocityLimit, velocity));
+        const double position
+            = std::max(joint.minLimit, std::min(joint.maxLimit, joint.position + velocity * dT));
+
+        velocity = (position - joint.position) / dT;
+        joint.acceleration = (velocity - joint.velocity) / dT;
+        joint.velocity = velocity;
+        joint.position = position;
+    }
+}
+
+bool FakeControlBoard::open(yarp::os::Searchable& config)
+{
+    std::vector<std::string> axesNames;
+    if (!YarpHelper::getVectorFromSearchable(config, "axesNames", axesNames))
+    {
+        yError() << "[FakeControlBoard::open] Unable to find the list axesNames.";
+        return false;
+    }
+
+    std::vector<double> jointLimits{-90.0, 90.0};
+    if (config.check("joint_limits")
+        && (!YarpHelper::getVectorFromSearchable(config, "joint_limits", jointLimits)
+            || jointLimits.size() != 2 || jointLimits[0] > jointLimits[1]))
+    {
+        yError() << "[FakeControlBoard::open] joint_limits has to contain the lower and the upper "
+                    "limits.";
+        return false;
+    }
+
+    const double velocityLimit = config.check("velocity_limit", yarp::os::Value(100.0)).asFloat64();
+    m_timeConstant = config.check("time_constant", yarp::os::Value(0.05)).asFloat64();
+    m_currentToVelocity = config.check("current_to_velocity", yarp::os::Value(10.0)).asFloat64();
+    m_pwmToVelocity = config.check("pwm_to_velocity", yarp::os::Value(10.0)).asFloat64();
+    m_errorToCurrent = config.check("error_to_current", yarp::os::Value(1.0)).asFloat64();
+    m_errorToPwm = config.check("error_to_pwm", yarp::os::Value(1.0)).asFloat64();
+    m_encoderNoise = config.check("encoder_noise", yarp::os::Value(0.0)).asFloat64();
+    m_noise.configure(config, "encoder", 0.0, 0.0);
+
+    if (m_timeConstant <= 0)
+    {
+        yError() << "[FakeControlBoard::open] The time constant has to be positive.";
+        return false;
+    }
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_joints.resize(axesNames.size());
+    for (std::size_t i = 0; i < m_joints.size(); i++)
+    {
+        Joint& joint = m_joints[i];
+        joint.name = axesNames[i];
+        joint.minLimit = jointLimits[0];
+        joint.maxLimit = jointLimits[1];
+        joint.velocityLimit = velocityLimit;
+        joint.position = std::max(joint.minLimit, std::min(joint.maxLimit, 0.0));
+        joint.positionReference = joint.position;
+        joint.targetPosition = joint.position;
+    }
+
+    m_lastUpdateTime = yarp::os::Time::now();
+    m_stamp.update(m_lastUpdateTime);
+
+    yInfo() << "[FakeControlBoard::open] Fake control board with" << m_joints.size() << "axes.";
+    return true;
+}
+
+bool FakeControlBoard::close()
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_joints.clear();
+    return true;
+}
+
+bool FakeControlBoard::getAxes(int* ax)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    *ax = static_cast<int>(m_joints.size());
+    return true;
+}
+
+bool FakeControlBoard::resetEncoder(int j)
+{
+    return setEncoder(j, 0.0);
+}
+
+bool FakeControlBoard::resetEncoders()
+{
+    return forEachJoint([](Joint& joint, std::size_t) {
+        joint.position = 0.0;
+        return true;
+    });
+}
+
+bool FakeControlBoard::setEncoder(int j, double val)
+{
+    return forJoints(1, &j, [val](Joint& joint, std::size_t) {
+        joint.position = val;
+        return true;
+    });
+}
+
+bool FakeControlBoard::setEncoders(const double* vals)
+{
+    return forEachJoint([vals](Joint& joint, std::size_t i) {
+        joint.position = vals[i];
+        return true;
+    });
+}
+
+bool FakeControlBoard::getEncoder(int j, double* v)
+{
+    return forJoints(1, &j, [this, v](Joint& joint, std::size_t) {
+        *v = joint.position + m_noise.noise(m_encoderNoise);
+        return true;
+    });
+}
+
+bool FakeControlBoard::getEncoders(double* encs)
+{
+    return forEachJoint([this, encs](Joint& joint, std::size_t i) {
+        encs[i] = joint.position + m_noise.noise(m_encoderNoise);
+        return true;
+    });
+}
+
+bool FakeControlBoard::getEncoderSpeed(int j, double* sp)
+{
+    return forJoints(1, &j, [sp](Joint& joint, std::size_t) {
+        *sp = joint.velocity;
+        return true;
+    });
+}
+
+bool FakeControlBoard::getEncoderSpeeds(double* spds)
+{
+    return forEachJoint([spds](Joint& joint, std::size_t i) {
+        spds[i] = joint.velocity;
+        return true;
+    });
+}
+
+bool FakeControlBoard::getEncoderAcceleration(int j, double* spds)
+{
+    return forJoints(1, &j, [spds](Joint& joint, std::size_t) {
+        *spds = joint.acceleration;
+        return true;
+    });
+}
+
+bool FakeControlBoard::getEncoderAccelerations(double* accs)
+{
+    return forEachJoint([accs](Joint& joint, std::size_t i) {
+        accs[i] = joint.acceleration;
+        return true;
+    });
+}
+
+bool FakeControlBoard::getEncodersTimed(double* encs, double* time)
+{
+    const double now = yarp::os::Time::now();
+    return forEachJoint([this, encs, time, now](Joint& joint, std::size_t i) {
+        encs[i] = joint.position + m_noise.noise(m_encoderNoise);
+        time[i] = now;
+        return true;
+    });
+}
+
+bool FakeControlBoard::getEncoderTimed(int j, double* encs, double* time)
+{
+    *time = yarp::os::Time::now();
+    return getEncoder(j, encs);
+}
+
+bool FakeControlBoard::positionMove(int j, double ref)
+{
+    return positionMove(1, &j, &ref);
+}
+
+bool FakeControlBoard::positionMove(const double* refs)
+{
+    return forEachJoint([refs](Joint& joint, std::size_t i) {
+        joint.targetPosition = refs[i];
+        return true;
+    });
+}
+
+bool FakeControlBoard::positionMove(const int n_joint, const int* joints, const double* refs)
+{
+    return forJoints(n_joint, joints, [refs](Joint& joint, std::size_t i) {
+        joint.targetPosition = refs[i];
+        return true;
+    });
+}
+
+bool FakeControlBoard::relativeMove(int j, double delta)
+{
+    return relativeMove(1, &j, &delta);
+}
+
+bool FakeControlBoard::relativeMove(const double* deltas)
+{
+    return forEachJoint([deltas](Joint& joint, std::size_t i) {
+        joint.targetPosition += deltas[i];
+        return true;
+    });
+}
+
+bool FakeControlBoard::relativeMove(const int n_joint, const int* joints, const double* deltas)
+{
+    return forJoints(n_joint, joints, [deltas](Joint& joint, std::size_t i) {
+        joint.targetPosition += deltas[i];
+        return true;
+    });
+}
+
+bool FakeControlBoard::checkMotionDone(int j, bool* flag)
+{
+    return checkMotionDone(1, &j, flag);
+}
+
+bool FakeControlBoard::checkMotionDone(bool* flag)
+{
+    *flag = true;
+    return forEachJoint([flag](Joint& joint, std::size_t) {
+        *flag = *flag && std::abs(joint.targetPosition - joint.position) < 0.1;
+        return true;
+    });
+}
+
+bool FakeControlBoard::checkMotionDone(const int n_joint, const int* joints, bool* flag)
+{
+    *flag = true;
+    return forJoints(n_joint, joints, [flag](Joint& joint, std::size_t) {
+        *flag = *flag && std::abs(joint.targetPosition - joint.position) < 0.1;
+        return true;
+    });
+}
+
+bool FakeControlBoard::setRefSpeed(int j, double sp)
+{
+    return setRefSpeeds(1, &j, &sp);
+}
+
+bool FakeControlBoard::setRefSpeeds(const double* spds)
+{
+    return forEachJoint([spds](Joint& joint, std::size_t i) {
+        joint.referenceSpeed = std::abs(spds[i]);
+        return true;
+    });
+}
+
+bool FakeControlBoard::setRefSpeeds(const int n_joint, const int* joints, const double* spds)
+{
+    return forJoints(n_joint, joints, [spds](Joint& joint, std::size_t i) {
+        joint.referenceSpeed = std::abs(spds[i]);
+        return true;
+    });
+}
+
+bool FakeControlBoard::getRefSpeed(int j, double* ref)
+{
+    return getRefSpeeds(1, &j, ref);
+}
+
+bool FakeControlBoard::getRefSpeeds(double* spds)
+{
+    return forEachJoint([spds](Joint& joint, std::size_t i) {
+        spds[i] = joint.referenceSpeed;
+        return true;
+    });
+}
+
+bool FakeControlBoard::getRefSpeeds(const int n_joint, const int* joints, double* spds)
+{
+    return forJoints(n_joint, joints, [spds](Joint& joint, std::size_t i) {
+        spds[i] = joint.referenceSpeed;
+        return true;
+    });
+}
+
+bool FakeControlBoard::getTargetPosition(const int joint, double* ref)
+{
+    return getTargetPositions(1, &joint, ref);
+}
+
+bool FakeControlBoard::getTargetPositions(double* refs)
+{
+    return forEachJoint([refs](Joint& joint, std::size_t i) {
+        refs[i] = joint.targetPosition;
+        return true;
+    });
+}
+
+bool FakeControlBoard::getTargetPositions(const int n_joint, const int* joints, double* refs)
+{
+    return forJoints(n_joint, joints, [refs](Joint& joint, std::size_t i) {
+        refs[i] = joint.targetPosition;
+        return true;
+    });
+}
+
+bool FakeControlBoard::setRefAcceleration(int j, double acc)
+{
+    return setRefAccelerations(1, &j, &acc);
+}
+
+bool FakeControlBoard::setRefAccelerations(const double* accs)
+{
+    return forEachJoint([accs](Joint& joint, std::size_t i) {
+        joint.referenceAcceleration = accs[i];
+        return true;
+    });
+}
+
+bool FakeControlBoard::setRefAccelerations(const int n_joint, const int* joints, const double* accs)
+{
+    return forJoints(n_joint, joints, [accs](Joint& joint, std::size_t i) {
+        joint.referenceAcceleration = accs[i];
+        return true;
+    });
+}
+
+bool FakeControlBoard::getRefAcceleration(int j, double* acc)
+{
+    return getRefAccelerations(1, &j, acc);
+}
+
+bool FakeControlBoard::getRefAccelerations(double* accs)
+{
+    return forEachJoint([accs](Joint& joint, std::size_t i) {
+        accs[i] = joint.referenceAcceleration;
+        return true;
+    });
+}
+
+bool FakeControlBoard::getRefAccelerations(const int n_joint, const int* joints, double* accs)
+{
+    return forJoints(n_joint, joints, [accs](Joint& joint, std::size_t i) {
+        accs[i] = joint.referenceAcceleration;
+        return true;
+    });
+}
+
+bool FakeControlBoard::stop(int j)
+{
+    return stop(1, &j);
+}
+
+bool FakeControlBoard::stop()
+{
+    return forEachJoint([](Joint& joint, std::size_t) {
+        joint.targetPosition = joint.position;
+        joint.positionReference = joint.position;
+        joint.velocityReference = 0.0;
+        return true;
+    });
+}
+
+bool FakeControlBoard::stop(const int n_joint, const int* joints)
+{
+    return forJoints(n_joint, joints, [](Joint& joint, std::size_t) {
+        joint.targetPosition = joint.position;
+        joint.positionReference = joint.position;
+        joint.velocityReference = 0.0;
+        return true;
+    });
+}
+
+bool FakeControlBoard::setPosition(int j, double ref)
+{
+    return setPositions(1, &j, &ref);
+}
+
+bool FakeControlBoard::setPositions(const int n_joint, const int* joints, const double* refs)
+{
+    return forJoints(n_joint, joints, [refs](Joint& joint, std::size_t i) {
+        joint.positionReference = refs[i];
+        return true;
+    });
+}
+
+bool FakeControlBoard::setPositions(const double* refs)
+{
+    return forEachJoint([refs](Joint& joint, std::size_t i) {
+        joint.positionReference = refs[i];
+        return true;
+    });
+}
+
+bool FakeControlBoard::getRefPosition(const int joint, double* ref)
+{
+    return getRefPositions(1, &joint, ref);
+}
+
+bool FakeControlBoard::getRefPositions(double* refs)
+{
+    return forEachJoint([refs](Joint& joint, std::size_t i) {
+        refs[i] = joint.positionReference;
+        return true;
+    });
+}
+
+bool FakeControlBoard::getRefPositions(const int n_joint, const int* joints, double* refs)
+{
+    return forJoints(n_joint, joints, [refs](Joint& joint, std::size_t i) {
+        refs[i] = joint.positionReference;
+        return true;
+    });
+}
+
+bool FakeControlBoard::velocityMove(int j, double sp)
+{
+    return velocityMove(1, &j, &sp);
+}
+
+bool FakeControlBoard::velocityMove(const double* sp)
+{
+    return forEachJoint([sp](Joint& joint, std::size_t i) {
+        joint.velocityReference = sp[i];
+        return true;
+    });
+}
+
+bool FakeControlBoard::velocityMove(const int n_joint, const int* joints, const double* spds)
+{
+    return forJoints(n_joint, joints, [spds](Joint& joint, std::size_t i) {
+        joint.velocityReference = spds[i];
+        return true;
+    });
+}
+
+bool FakeControlBoard::getRefVelocity(const int joint, double* vel)
+{
+    return getRefVelocities(1, &joint, vel);
+}
+
+bool FakeControlBoard::getRefVelocities(double* vels)
+{
+    return forEachJoint([vels](Joint& joint, std::size_t i) {
+        vels[i] = joint.velocityReference;
+        return true;
+    });
+}
+
+bool FakeControlBoard::getRefVelocities(const int n_joint, const int* joints, double* vels)
+{
+    return forJoints(n_joint, joints, [vels](Joint& joint, std::size_t i) {
+        vels[i] = joint.velocityReference;
+        return true;
+    });
+}
+
+bool FakeControlBoard::getControlMode(int j, int* mode)
+{
+    return getControlModes(1, &j, mode);
+}
+
+bool FakeControlBoard::getControlModes(int* modes)
+{
+    return forEachJoint([modes](Joint& joint, std::size_t i) {
+        modes[i] = joint.controlMode;
+        return true;
+    });
+}
+
+bool FakeControlBoard::getControlModes(const int n_joint, const int* joints, int* modes)
+{
+    return forJoints(n_joint, joints, [modes](Joint& joint, std::size_t i) {
+        modes[i] = joint.controlMode;
+        return true;
+    });
+}
+
+bool FakeControlBoard::setControlMode(const int j, const int mode)
+{
+    int modes = mode;
+    return setControlModes(1, &j, &modes);
+}
+
+bool FakeControlBoard::setControlModes(const int n_joint, const int* joints, int* modes)
+{
+    return forJoints(n_joint, joints, [modes](Joint& joint, std::size_t i) {
+        // the references of the new control mode start from the current state of the joint
+        joint.controlMode = modes[i];
+        joint.targetPosition = joint.position;
+        joint.positionReference = joint.position;
+        joint.velocityReference = 0.0;
+        joint.currentReference = 0.0;
+        joint.dutyCycleReference = 0.0;
+        return true;
+    });
+}
+
+bool FakeControlBoard::setControlModes(int* modes)
+{
+    return forEachJoint([modes](Joint& joint, std::size_t i) {
+        joint.controlMode = modes[i];
+        joint.targetPosition = joint.position;
+        joint.positionReference = joint.position;
+        joint.velocityReference = 0.0;
+        joint.currentReference = 0.0;
+        joint.dutyCycleReference = 0.0;
+        return true;
+    });
+}
+
+bool FakeControlBoard::setLimits(int axis, double min, double max)
+{
+    return forJoints(1, &axis, [min, max](Joint& joint, std::size_t) {
+        joint.minLimit = min;
+        joint.maxLimit = max;
+        return min <= max;
+    });
+}
+
+bool FakeControlBoard::getLimits(int axis, double* min, double* max)
+{
+    return forJoints(1, &axis, [min, max](Joint& joint, std::size_t) {
+        *min = joint.minLimit;
+        *max = joint.maxLimit;
+        return true;
+    });
+}
+
+bool FakeControlBoard::setVelLimits(int axis, double min, double max)
+{
+    return forJoints(1, &axis, [max](Joint& joint, std::size_t) {
+        joint.velocityLimit = std::abs(max);
+        return true;
+    });
+}
+
+bool FakeControlBoard::getVelLimits(int axis, double* min, double* max)
+{
+    return forJoints(1, &axis, [min, max](Joint& joint, std::size_t) {
+        *min = 0.0;
+        *max = joint.velocityLimit;
+        return true;
+    });
+}
+
+bool FakeControlBoard::getNumberOfMotors(int* ax)
+{
+    return getAxes(ax);
+}
+
+bool FakeControlBoard::getCurrent(int m, double* curr)
+{
+    return forJoints(1, &m, [this, curr](Joint& joint, std::size_t) {
+        *curr = joint.controlMode == VOCAB_CM_CURRENT ? joint.currentReference
+                                                      : m_errorToCurrent * positionError(joint);
+        return true;
+    });
+}
+
+bool FakeControlBoard::getCurrents(double* currs)
+{
+    return forEachJoint([this, currs](Joint& joint, std::size_t i) {
+        currs[i] = joint.controlMode == VOCAB_CM_CURRENT ? joint.currentReference
+                                                         : m_errorToCurrent * positionError(joint);
+        return true;
+    });
+}
+
+bool FakeControlBoard::getCurrentRange(int m, double* min, double* max)
+{
+    if (!isValid(m))
+        return false;
+
+    *min = -1000.0;
+    *max = 1000.0;
+    return true;
+}
+
+bool FakeControlBoard::getCurrentRanges(double* min, double* max)
+{
+    return forEachJoint([min, max](Joint&, std::size_t i) {
+        min[i] = -1000.0;
+        max[i] = 1000.0;
+        return true;
+    });
+}
+
+bool FakeControlBoard::setRefCurrents(const double* currs)
+{
+    return forEachJoint([currs](Joint& joint, std::size_t i) {
+        joint.currentReference = currs[i];
+        return true;
+    });
+}
+
+bool FakeControlBoard::setRefCurrent(int m, double curr)
+{
+    return setRefCurrents(1, &m, &curr);
+}
+
+bool FakeControlBoard::setRefCurrents(const int n_motor, const int* motors, const double* currs)
+{
+    return forJoints(n_motor, motors, [currs](Joint& joint, std::size_t i) {
+        joint.currentReference = currs[i];
+        return true;
+    });
+}
+
+bool FakeControlBoard::getRefCurrents(double* currs)
+{
+    return forEachJoint([currs](Joint& joint, std::size_t i) {
+        currs[i] = joint.currentReference;
+        return true;
+    });
+}
+
+bool FakeControlBoard::getRefCurrent(int m, double* curr)
+{
+    return forJoints(1, &m, [curr](Joint& joint, std::size_t) {
+        *curr = joint.currentReference;
+        return true;
+    });
+}
+
+bool FakeControlBoard::setRefDutyCycle(int m, double ref)
+{
+    return forJoints(1, &m, [ref](Joint& joint, std::size_t) {
+        joint.dutyCycleReference = ref;
+        return true;
+    });
+}
+
+bool FakeControlBoard::setRefDutyCycles(const double* refs)
+{
+    return forEachJoint([refs](Joint& joint, std::size_t i) {
+        joint.dutyCycleReference = refs[i];
+        return true;
+    });
+}
+
+bool FakeControlBoard::getRefDutyCycle(int m, double* ref)
+{
+    return forJoints(1, &m, [ref](Joint& joint, std::size_t) {
+        *ref = joint.dutyCycleReference;
+        return true;
+    });
+}
+
+bool FakeControlBoard::getRefDutyCycles(double* refs)
+{
+    return forEachJoint([refs](Joint& joint, std::size_t i) {
+        refs[i] = joint.dutyCycleReference;
+        return true;
+    });
+}
+
+bool FakeControlBoard::getDutyCycle(int m, double* val)
+{
+    return forJoints(1, &m, [this, val](Joint& joint, std::size_t) {
+        *val = joint.controlMode == VOCAB_CM_PWM ? joint.dutyCycleReference
+                                                 : m_errorToPwm * positionError(joint);
+        return true;
+    });
+}
+
+bool FakeControlBoard::getDutyCycles(double* vals)
+{
+    return forEachJoint([this, vals](Joint& joint, std::size_t i) {
+        vals[i] = joint.controlMode == VOCAB_CM_PWM ? joint.dutyCycleReference
+                                                    : m_errorToPwm * positionError(joint);
+        return true;
+    });
+}
+
+bool FakeControlBoard::setPid(const yarp::dev::PidControlTypeEnum& pidtype,
+                              int j,
+                              const yarp::dev::Pid& pid)
+{
+    return forJoints(1, &j, [&pid](Joint& joint, std::size_t) {
+        joint.pid = pid;
+        return true;
+    });
+}
+
+bool FakeControlBoard::setPids(const yarp::dev::PidControlTypeEnum& pidtype,
+                               const yarp::dev::Pid* pids)
+{
+    return forEachJoint([pids](Joint& joint, std::size_t i) {
+        joint.pid = pids[i];
+        return true;
+    });
+}
+
+bool FakeControlBoard::setPidReference(const yarp::dev::PidControlTypeEnum& pidtype,
+                                       int j,
+                                       double ref)
+{
+    return setPosition(j, ref);
+}
+
+bool FakeControlBoard::setPidReferences(const yarp::dev::PidControlTypeEnum& pidtype,
+                                        const double* refs)
+{
+    return setPositions(refs);
+}
+
+bool FakeControlBoard::setPidErrorLimit(const yarp::dev::PidControlTypeEnum& pidtype,
+                                        int j,
+                                        double limit)
+{
+    return isValid(j);
+}
+
+bool FakeControlBoard::setPidErrorLimits(const yarp::dev::PidControlTypeEnum& pidtype,
+                                         const double* limits)
+{
+    return true;
+}
+
+bool FakeControlBoard::getPidError(const yarp::dev::PidControlTypeEnum& pidtype,
+                                   int j,
+                                   double* err)
+{
+    return forJoints(1, &j, [this, err](Joint& joint, std::size_t) {
+        *err = positionError(joint);
+        return true;
+    });
+}
+
+bool FakeControlBoard::getPidErrors(const yarp::dev::PidControlTypeEnum& pidtype, double* errs)
+{
+    return forEachJoint([this, errs](Joint& joint, std::size_t i) {
+        errs[i] = positionError(joint);
+        return true;
+    });
+}
+
+bool FakeControlBoard::getPidOutput(const yarp::dev::PidControlTypeEnum& pidtype,
+                                    int j,
+                                    double* out)
+{
+    return getDutyCycle(j, out);
+}
+
+bool FakeControlBoard::getPidOutputs(const yarp::dev::PidControlTypeEnum& pidtype, double* outs)
+{
+    return getDutyCycles(outs);
+}
+
+bool FakeControlBoard::getPid(const yarp::dev::PidControlTypeEnum& pidtype,
+                              int j,
+                              yarp::dev::Pid* pid)
+{
+    return forJoints(1, &j, [pid](Joint& joint, std::size_t) {
+        *pid = joint.pid;
+        return true;
+    });
+}
+
+bool FakeControlBoard::getPids(const yarp::dev::PidControlTypeEnum& pidtype, yarp::dev::Pid* pids)
+{
+    return forEachJoint([pids](Joint& joint, std::size_t i) {
+        pids[i] = joint.pid;
+        return true;
+    });
+}
+
+bool FakeControlBoard::getPidReference(const yarp::dev::PidControlTypeEnum& pidtype,
+                                       int j,
+                                       double* ref)
+{
+    return getRefPosition(j, ref);
+}
+
+bool FakeControlBoard::getPidReferences(const yarp::dev::PidControlTypeEnum& pidtype,
+                                        double* refs)
+{
+    return getRefPositions(refs);
+}
+
+bool FakeControlBoard::getPidErrorLimit(const yarp::dev::PidControlTypeEnum& pidtype,
+                                        int j,
+                                        double* limit)
+{
+    if (!isValid(j))
+        return false;
+
+    *limit = 0.0;
+    return true;
+}
+
+bool FakeControlBoard::getPidErrorLimits(const yarp::dev::PidControlTypeEnum& pidtype,
+                                         double* limits)
+{
+    return forEachJoint([limits](Joint&, std::size_t i) {
+        limits[i] = 0.0;
+        return true;
+    });
+}
+
+bool FakeControlBoard::resetPid(const yarp::dev::PidControlTypeEnum& pidtype, int j)
+{
+    return isValid(j);
+}
+
+bool FakeControlBoard::disablePid(const yarp::dev::PidControlTypeEnum& pidtype, int j)
+{
+    return isValid(j);
+}
+
+bool FakeControlBoard::enablePid(const yarp::dev::PidControlTypeEnum& pidtype, int j)
+{
+    return isValid(j);
+}
+
+bool FakeControlBoard::setPidOffset(const yarp::dev::PidControlTypeEnum& pidtype, int j, double v)
+{
+    return isValid(j);
+}
+
+bool FakeControlBoard::isPidEnabled(const yarp::dev::PidControlTypeEnum& pidtype,
+                                    int j,
+                                    bool* enabled)
+{
+    *enabled = isValid(j);
+    return *enabled;
+}
+
+bool FakeControlBoard::getAxisName(int axis, std::string& name)
+{
+    return forJoints(1, &axis, [&name](Joint& joint, std::size_t) {
+        name = joint.name;
+        return true;
+    });
+}
+
+bool FakeControlBoard::getJointType(int axis, yarp::dev::JointTypeEnum& type)
+{
+    type = yarp::dev::VOCAB_JOINTTYPE_REVOLUTE;
+    return isValid(axis);
+}
+
+yarp::os::Stamp FakeControlBoard::getLastInputStamp()
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    update();
+    return m_stamp;
+}
@@ -0,0 +1,155 @@
+/**
+ * @file FakeDevices.cpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+// std
+#define _USE_MATH_DEFINES
+#include <cmath>
+#include <mutex>
+#include <unordered_map>
+
+// YARP
+#include <yarp/os/Bottle.h>
+#include <yarp/os/LogStream.h>
+
+#include <FakeAnalogSensor.hpp>
+#include <FakeControlBoard.hpp>
+#include <FakeDevices.hpp>
+#include <FakeFrameTransform.hpp>
+#include <FakeJoypad.hpp>
+
+void FakeSignal::configure(const yarp::os::Searchable& config,
+                           const std::string& prefix,
+                           const double& offset,
+                           const double& amplitude)
+{
+    m_offset = config.check(prefix + "_offset", yarp::os::Value(offset)).asFloat64();
+    m_amplitude = config.check(prefix + "_amplitude", yarp::os::Value(amplitude)).asFloat64();
+    m_frequency = config.check(prefix + "_frequency", yarp::os::Value(0.5)).asFloat64();
+    m_phaseShift = config.check(prefix + "_phase_shift", yarp::os::Value(0.5)).asFloat64();
+    m_noise = config.check(prefix + "_noise", yarp::os::Value(0.0)).asFloat64();
+    m_generator.seed(config.check("seed", yarp::os::Value(0)).asInt32());
+}
+
+double FakeSignal::operator()(const double& time, const std::size_t& channel)
+{
+    return m_offset
+           + m_amplitude * std::sin(2 * M_PI * m_frequency * time + m_phaseShift * channel)
+           + noise(m_noise);
+}
+
+double FakeSignal::noise(const double& standardDeviation)
+{
+    if (standardDeviation <= 0)
+        return 0;
+
+    return standardDeviation * m_noiseDistribution(m_generator);
+}
+
+namespace
+{
+/**
+ * State shared by the modules of the process.
+ */
+struct Registry
+{
+    std::mutex mutex; /**< Mutex protecting the registry. */
+    bool isEnabled{false}; /**< True if the fake devices are enabled. */
+    yarp::os::Bottle parameters; /**< Parameters passed to the fake devices. */
+    std::unordered_map<std::string, std::string> fakeDevices; /**< Fake device of each device. */
+};
+
+Registry& registry()
+{
+    static Registry registry;
+    return registry;
+}
+} // namespace
+
+bool FakeDevices::configure(const yarp::os::Searchable& config)
+{
+    const yarp::os::Bottle& options = config.findGroup("FAKE_DEVICES");
+    const bool isEnabled = options.check("enable", yarp::os::Value(false)).asBool();
+
+    {
+        std::lock_guard<std::mutex> guard(registry().mutex);
+        registry().isEnabled = isEnabled;
+
+        // the first element of the group is its name
+        registry().parameters = options.tail();
+    }
+
+    if (!isEnabled)
+        return true;
+
+    addDevice<FakeControlBoard>("remotecontrolboardremapper", "fake_controlboard");
+    addDevice<FakeControlBoard>("remote_controlboard", "fake_controlboard");
+    addDevice<FakeAnalogSensor>("analogsensorclient", "fake_analogsensor");
+    addDevice<FakeFrameTransform>("transformClient", "fake_transform");
+    addDevice<FakeJoypad>("JoypadControlClient", "fake_joypad");
+
+    yWarning() << "[FakeDevices::configure] The fake devices are enabled. The module does not "
+                  "use the robot.";
+    return true;
+}
+
+bool FakeDevices::isEnabled()
+{
+    std::lock_guard<std::mutex> guard(registry().mutex);
+    return registry().isEnabled;
+}
+
+void FakeDevices::addDeviceCreator(const std::string& device,
+                                   const std::string& fakeDevice,
+                                   yarp::dev::DriverCreator* creator)
+{
+    std::lock_guard<std::mutex> guard(registry().mutex);
+
+    // the same fake device may replace several devices, the factory owns the creator
+    bool isRegistered = false;
+    for (const auto& registered : registry().fakeDevices)
+        isRegistered = isRegistered || registered.second == fakeDevice;
+
+    registry().fakeDevices[device] = fakeDevice;
+    if (isRegistered)
+    {
+        delete creator;
+        return;
+    }
+
+    yarp::dev::Drivers::factory().add(creator);
+}
+
+bool FakeDevices::replaceDevice(yarp::os::Property& options)
+{
+    std::lock_guard<std::mutex> guard(registry().mutex);
+    if (!registry().isEnabled)
+        return false;
+
+    const std::string device = options.find("device").asString();
+    const auto fakeDevice = registry().fakeDevices.find(device);
+    if (fakeDevice == registry().fakeDevices.end())
+        return false;
+
+    options.put("device", fakeDevice->second);
+    for (std::size_t i = 0; i < registry().parameters.size(); i++)
+    {
+        const yarp::os::Bottle* parameter = registry().parameters.get(i).asList();
+        if (parameter == nullptr || parameter->size() < 2)
+            continue;
+
+        const std::string key = parameter->get(0).asString();
+        if (key == "enable" || options.check(key))
+            continue;
+
+        options.put(key, parameter->get(1));
+    }
+
+    yInfo() << "[FakeDevices::replaceDevice] The device" << device << "is replaced by"
+            << fakeDevice->second;
+    return true;
+}
@@ -0,0 +1,187 @@
+/**
+ * @file FakeFrameTransform.cpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+// Eigen
+#include <Eigen/Geometry>
+
+// YARP
+#include <yarp/os/LogStream.h>
+#include <yarp/os/Time.h>
+
+#include <FakeFrameTransform.hpp>
+
+bool FakeFrameTransform::open(yarp::os::Searchable& config)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_rotation.configure(config, "transform_rotation", 0.0, 0.2);
+    m_position.configure(config, "transform_position", 0.0, 0.1);
+    m_startTime = yarp::os::Time::now();
+    return true;
+}
+
+bool FakeFrameTransform::close()
+{
+    return clear();
+}
+
+bool FakeFrameTransform::allFramesAsString(std::string& all_frames)
+{
+    std::vector<std::string> ids;
+    getAllFrameIds(ids);
+
+    all_frames.clear();
+    for (const auto& id : ids)
+        all_frames += id + " ";
+    return true;
+}
+
+bool FakeFrameTransform::canTransform(const std::string& target_frame,
+                                      const std::string& source_frame)
+{
+    return true;
+}
+
+bool FakeFrameTransform::clear()
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_frames.clear();
+    m_transforms.clear();
+    return true;
+}
+
+bool FakeFrameTransform::frameExists(const std::string& frame_id)
+{
+    return true;
+}
+
+bool FakeFrameTransform::getAllFrameIds(std::vector<std::string>& ids)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    ids.clear();
+    for (const auto& frame : m_frames)
+        ids.push_back(frame.first);
+    for (const auto& transform : m_transforms)
+        ids.push_back(transform.first);
+    return true;
+}
+
+bool FakeFrameTransform::getParent(const std::string& frame_id, std::string& parent_frame_id)
+{
+    return false;
+}
+
+bool FakeFrameTransform::getTransform(const std::string& target_frame_id,
+                                      const std::string& source_frame_id,
+                                      yarp::sig::Matrix& transform)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+
+    const auto setTransform = m_transforms.find(target_frame_id);
+    if (setTransform != m_transforms.end())
+    {
+        transform = setTransform->second;
+        return true;
+    }
+
+    // each frame has its own channels of the synthetic signals
+    const auto frame = m_frames.emplace(target_frame_id, m_frames.size()).first;
+    const std::size_t channel = 3 * frame->second;
+    const double time = yarp::os::Time::now() - m_startTime;
+
+    const Eigen::Matrix3d rotation
+        = (Eigen::AngleAxisd(m_rotation(time, channel), Eigen::Vector3d::UnitZ())
+           * Eigen::AngleAxisd(m_rotation(time, channel + 1), Eigen::Vector3d::UnitY())
+           * Eigen::AngleAxisd(m_rotation(time, channel + 2), Eigen::Vector3d::UnitX()))
+              .toRotationMatrix();
+
+    if (transform.rows() != 4 || transform.cols() != 4)
+        transform.resize(4, 4);
+    transform.eye();
+    for (int i = 0; i < 3; i++)
+    {
+        for (int j = 0; j < 3; j++)
+            transform(i, j) = rotation(i, j);
+        transform(i, 3) = m_position(time, channel + i);
+    }
+
+    return true;
+}
+
+bool FakeFrameTransform::setTransform(const std::string& target_frame_id,
+                                      const std::string& source_frame_id,
+                                      const yarp::sig::Matrix& transform)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_transforms[target_frame_id] = transform;
+    return true;
+}
+
+bool FakeFrameTransform::setTransformStatic(const std::string& target_frame_id,
+                                            const std::string& source_frame_id,
+                                            const yarp::sig::Matrix& transform)
+{
+    return setTransform(target_frame_id, source_frame_id, transform);
+}
+
+bool FakeFrameTransform::deleteTransform(const std::string& target_frame_id,
+                                         const std::string& source_frame_id)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_transforms.erase(target_frame_id);
+    return true;
+}
+
+bool FakeFrameTransform::transformPoint(const std::string& target_frame_id,
+                                        const std::string& source_frame_id,
+                                        const yarp::sig::Vector& input_point,
+                                        yarp::sig::Vector& transformed_point)
+{
+    if (input_point.size() != 3)
+    {
+        yError() << "[FakeFrameTransform::transformPoint] The point has to contain 3 elements.";
+        return false;
+    }
+
+    yarp::sig::Matrix transform;
+    if (!getTransform(target_frame_id, source_frame_id, transform))
+        return false;
+
+    transformed_point.resize(3);
+    for (int i = 0; i < 3; i++)
+    {
+        transformed_point[i] = transform(i, 3);
+        for (int j = 0; j < 3; j++)
+            transformed_point[i] += transform(i, j) * input_point[j];
+    }
+    return true;
+}
+
+bool FakeFrameTransform::transformPose(const std::string& target_frame_id,
+                                       const std::string& source_frame_id,
+                                       const yarp::sig::Vector& input_pose,
+                                       yarp::sig::Vector& transformed_pose)
+{
+    yError() << "[FakeFrameTransform::transformPose] Not supported by the fake device.";
+    return false;
+}
+
+bool FakeFrameTransform::transformQuaternion(const std::string& target_frame_id,
+                                             const std::string& source_frame_id,
+                                             const yarp::math::Quaternion& input_quaternion,
+                                             yarp::math::Quaternion& transformed_quaternion)
+{
+    yError() << "[FakeFrameTransform::transformQuaternion] Not supported by the fake device.";
+    return false;
+}
+
+bool FakeFrameTransform::waitForTransform(const std::string& target_frame_id,
+                                          const std::string& source_frame_id,
+                                          const double& timeout)
+{
+    return true;
+}
@@ -0,0 +1,117 @@
+/**
+ * @file FakeJoypad.cpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+// std
+#include <algorithm>
+
+// YARP
+#include <yarp/os/Time.h>
+
+#include <FakeJoypad.hpp>
+
+bool FakeJoypad::open(yarp::os::Searchable& config)
+{
+    m_axes = config.check("joypad_axes", yarp::os::Value(8)).asInt32();
+    m_buttons = config.check("joypad_buttons", yarp::os::Value(8)).asInt32();
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_axis.configure(config, "joypad_axis", 0.0, 0.0);
+    m_button.configure(config, "joypad_button", 0.0, 0.0);
+    m_startTime = yarp::os::Time::now();
+    return true;
+}
+
+bool FakeJoypad::close()
+{
+    return true;
+}
+
+bool FakeJoypad::getAxisCount(unsigned int& axis_count)
+{
+    axis_count = m_axes;
+    return true;
+}
+
+bool FakeJoypad::getButtonCount(unsigned int& button_count)
+{
+    button_count = m_buttons;
+    return true;
+}
+
+bool FakeJoypad::getTrackballCount(unsigned int& Trackball_count)
+{
+    Trackball_count = 0;
+    return true;
+}
+
+bool FakeJoypad::getHatCount(unsigned int& Hat_count)
+{
+    Hat_count = 0;
+    return true;
+}
+
+bool FakeJoypad::getTouchSurfaceCount(unsigned int& touch_count)
+{
+    touch_count = 0;
+    return true;
+}
+
+bool FakeJoypad::getStickCount(unsigned int& stick_count)
+{
+    stick_count = 0;
+    return true;
+}
+
+bool FakeJoypad::getStickDoF(unsigned int stick_id, unsigned int& DoF)
+{
+    return false;
+}
+
+bool FakeJoypad::getButton(unsigned int button_id, float& value)
+{
+    if (button_id >= m_buttons)
+        return false;
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    const double time = yarp::os::Time::now() - m_startTime;
+    value = static_cast<float>(std::max(0.0, std::min(1.0, m_button(time, button_id))));
+    return true;
+}
+
+bool FakeJoypad::getTrackball(unsigned int trackball_id, yarp::sig::Vector& value)
+{
+    return false;
+}
+
+bool FakeJoypad::getHat(unsigned int hat_id, unsigned char& value)
+{
+    return false;
+}
+
+bool FakeJoypad::getAxis(unsigned int axis_id, double& value)
+{
+    if (axis_id >= m_axes)
+        return false;
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    const double time = yarp::os::Time::now() - m_startTime;
+    value = m_axis(time, axis_id);
+    return true;
+}
+
+bool FakeJoypad::getStick(unsigned int stick_id,
+                          yarp::sig::Vector& value,
+                          JoypadCtrl_coordinateMode coordinate_mode)
+{
+    return false;
+}
+
+bool FakeJoypad::getTouch(unsigned int touch_id, yarp::sig::Vector& value)
+{
+    return false;
+}
@@ -0,0 +1,95 @@
+/**
+ * @file GoalChannel.cpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+// YARP
+#include <yarp/os/LogStream.h>
+
+#include <GoalChannel.hpp>
+
+constexpr std::size_t GoalChannel::goalSize;
+
+bool GoalChannel::Publisher::open(const std::string& portName)
+{
+    if (!m_port.open(portName))
+    {
+        yError() << "[GoalChannel::Publisher::open] Unable to open the port" << portName;
+        return false;
+    }
+    return true;
+}
+
+void GoalChannel::Publisher::publish(const double& x, const double& y)
+{
+    yarp::sig::Vector& goal = m_port.prepare();
+    if (goal.size() != goalSize)
+        goal.resize(goalSize);
+    goal[0] = x;
+    goal[1] = y;
+
+    m_stamp.update();
+    m_port.setEnvelope(m_stamp);
+
+    // a non-strict write replaces the goal that is still waiting to be sent
+    m_port.write(false);
+}
+
+void GoalChannel::Publisher::close()
+{
+    m_port.close();
+}
+
+bool GoalChannel::Reader::open(const std::string& portName, const double& timeout)
+{
+    m_timeout = timeout;
+    m_receivedTime = -1;
+    m_x = 0;
+    m_y = 0;
+
+    // only the most recent goal is kept
+    m_port.setStrict(false);
+    if (!m_port.open(portName))
+    {
+        yError() << "[GoalChannel::Reader::open] Unable to open the port" << portName;
+        return false;
+    }
+    return true;
+}
+
+bool GoalChannel::Reader::read(const double& now, double& x, double& y)
+{
+    const yarp::sig::Vector* goal = m_port.read(false);
+    if (goal != nullptr)
+    {
+        if (goal->size() == goalSize)
+        {
+            m_x = (*goal)[0];
+            m_y = (*goal)[1];
+            m_receivedTime = now;
+        } else
+        {
+            yWarning() << "[GoalChannel::Reader::read] The goal has" << goal->size()
+                       << "elements, expected" << goalSize << ". The goal is ignored.";
+        }
+    }
+
+    if (m_receivedTime < 0 || now - m_receivedTime > m_timeout)
+    {
+        x = 0;
+        y = 0;
+        return false;
+    }
+
+    x = m_x;
+    y = m_y;
+    return true;
+}
+
+void GoalChannel::Reader::close()
+{
+    m_port.close();
+}
@@ -0,0 +1,133 @@
+/**
+ * @file Histogram.cpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+// std
+#include <algorithm>
+#include <cmath>
+
+#include "Histogram.hpp"
+
+constexpr unsigned int LatencyHistogram::subBucketBits;
+constexpr unsigned int LatencyHistogram::maxExponent;
+constexpr std::size_t LatencyHistogram::numberOfBuckets;
+
+LatencyHistogram::LatencyHistogram()
+{
+    reset();
+}
+
+std::size_t LatencyHistogram::bucketIndex(std::uint64_t value)
+{
+    constexpr std::uint64_t subBucketCount = 1ULL << subBucketBits;
+    if (value < subBucketCount)
+        return static_cast<std::size_t>(value);
+
+    // position of the most significant bit
+    unsigned int msb = 0;
+    for (std::uint64_t v = value; v > 1; v >>= 1)
+        msb++;
+
+    unsigned int exponent = msb - subBucketBits;
+    if (exponent > maxExponent)
+        return numberOfBuckets - 1;
+
+    const std::uint64_t subBucket = (value >> exponent) - subBucketCount;
+    return static_cast<std::size_t>(((exponent + 1) << subBucketBits) + subBucket);
+}
+
+std::uint64_t LatencyHistogram::bucketValue(std::size_t index)
+{
+    constexpr std::size_t subBucketCount = 1ULL << subBucketBits;
+    if (index < subBucketCount)
+        return index;
+
+    const std::size_t exponent = (index >> subBucketBits) - 1;
+    const std::uint64_t subBucket = (index & (subBucketCount - 1)) + subBucketCount;
+    return subBucket << exponent;
+}
+
+void LatencyHistogram::record(std::uint64_t value)
+{
+    // single writer: a relaxed load/store is enough and avoids locked instructions
+    std::atomic<std::uint64_t>& bucket = m_buckets[bucketIndex(value)];
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    m_count.store(m_count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    m_sum.store(m_sum.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    if (value > m_max.load(std::memory_order_relaxed))
+        m_max.store(value, std::memory_order_relaxed);
+}
+
+void LatencyHistogram::reset()
+{
+    for (auto& bucket : m_buckets)
+        bucket.store(0, std::memory_order_relaxed);
+    m_count.store(0, std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_relaxed);
+    m_sum.store(0, std::memory_order_relaxed);
+}
+
+std::uint64_t LatencyHistogram::count() const
+{
+    return m_count.load(std::memory_order_relaxed);
+}
+
+std::uint64_t LatencyHistogram::max() const
+{
+    return m_max.load(std::memory_order_relaxed);
+}
+
+double LatencyHistogram::mean() const
+{
+    const std::uint64_t numberOfValues = count();
+    if (numberOfValues == 0)
+        return 0;
+    return static_cast<double>(m_sum.load(std::memory_order_relaxed)) / numberOfValues;
+}
+
+std::uint64_t LatencyHistogram::percentile(double percentile) const
+{
+    const std::uint64_t numberOfValues = count();
+    if (numberOfValues == 0)
+        return 0;
+
+    if (percentile >= 100)
+        return max();
+
+    const std::uint64_t target = static_cast<std::uint64_t>(
+        std::ceil(percentile / 100.0 * static_cast<double>(numberOfValues)));
+
+    std::uint64_t cumulative = 0;
+    for (std::size_t i = 0; i < numberOfBuckets; i++)
+    {
+        cumulative += m_buckets[i].load(std::memory_order_relaxed);
+        if (cumulative >= target && cumulative > 0)
+            return std::min(bucketValue(i), max());
+    }
+    return max();
+}
+
+void YarpHelper::addHistogramToBottle(yarp::os::Bottle& bottle,
+                                      const std::string& name,
+                                      const LatencyHistogram& histogram)
+{
+    yarp::os::Bottle& list = bottle.addList();
+    list.addString(name);
+    yarp::os::Bottle& values = list.addList();
+    values.addString("count");
+    values.addInt64(histogram.count());
+    values.addString("mean");
+    values.addFloat64(histogram.mean() * 1e-3);
+    values.addString("p50");
+    values.addFloat64(histogram.percentile(50) * 1e-3);
+    values.addString("p99");
+    values.addFloat64(histogram.percentile(99) * 1e-3);
+    values.addString("p99.9");
+    values.addFloat64(histogram.percentile(99.9) * 1e-3);
+    values.addString("max");
+    values.addFloat64(histogram.max() * 1e-3);
+}
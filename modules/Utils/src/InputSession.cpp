@@ -0,0 +1,448 @@
+/**
+ * @file InputSession.cpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+// std
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+// YARP
+#include <yarp/os/Bottle.h>
+#include <yarp/os/LogStream.h>
+#include <yarp/os/Time.h>
+#include <yarp/os/Value.h>
+
+#include <InputSession.hpp>
+
+namespace
+{
+// layout of the file: magic (8 bytes) followed by a sequence of entries. Each entry is an
+// EntryHeader followed by a payload of EntryHeader::size bytes padded to 8 bytes.
+constexpr char magic[8] = {'W', 'T', 'I', 'N', 'P', '0', '1', '\0'};
+
+enum EntryType : std::uint32_t
+{
+    StreamEntry = 0, /**< Declaration of a stream, the payload is its name. */
+    ValuesEntry = 1, /**< Sample, the payload is a vector of doubles. */
+    LabelsEntry = 2, /**< Sample, the payload is a list of null-terminated strings. */
+    CycleEntry = 3 /**< Beginning of a cycle, no payload. */
+};
+
+struct EntryHeader
+{
+    std::uint32_t type;
+    std::uint32_t stream;
+    double timestamp;
+    std::uint64_t size;
+};
+
+std::size_t paddedSize(std::size_t size)
+{
+    return (size + 7) / 8 * 8;
+}
+} // namespace
+
+InputSession::~InputSession()
+{
+    close();
+}
+
+bool InputSession::isReplayRequested(const yarp::os::Searchable& config)
+{
+    const yarp::os::Bottle& options = config.findGroup("INPUT_SESSION");
+    return options.check("mode", yarp::os::Value("none")).asString() == "replay";
+}
+
+bool InputSession::configure(const yarp::os::Searchable& config, const std::string& name)
+{
+    const yarp::os::Bottle& options = config.findGroup("INPUT_SESSION");
+    const std::string mode = options.check("mode", yarp::os::Value("none")).asString();
+
+    if (mode == "none")
+    {
+        m_mode = Mode::Disabled;
+        return true;
+    }
+
+    if (mode == "record")
+    {
+        m_fileName = options
+                         .check("file",
+                                yarp::os::Value(name + "_inputs_"
+                                                + YarpHelper::getTimeDateMatExtension() + ".bin"))
+                         .asString();
+
+        m_file = std::fopen(m_fileName.c_str(), "wb");
+        if (m_file == nullptr)
+        {
+            yError() << "[InputSession::configure] Unable to open the file" << m_fileName;
+            return false;
+        }
+
+        // the samples of a cycle are small, a large buffer avoids a system call per sample
+        std::setvbuf(m_file, nullptr, _IOFBF, 1 << 20);
+        if (std::fwrite(magic, 1, sizeof(magic), m_file) != sizeof(magic))
+        {
+            yError() << "[InputSession::configure] Unable to write the file" << m_fileName;
+            return false;
+        }
+
+        m_mode = Mode::Record;
+        yInfo() << "[InputSession::configure] The inputs are recorded in" << m_fileName;
+        return true;
+    }
+
+    if (mode == "replay")
+    {
+        if (!YarpHelper::getStringFromSearchable(options, "file", m_fileName))
+        {
+            yError() << "[InputSession::configure] The file to be replayed is not specified.";
+            return false;
+        }
+
+        const std::string pace = options.check("pace", yarp::os::Value("realtime")).asString();
+        if (pace != "realtime" && pace != "fast")
+        {
+            yError() << "[InputSession::configure] Unknown pace" << pace
+                     << ". Available paces: realtime, fast.";
+            return false;
+        }
+        m_realTimePace = pace == "realtime";
+
+        if (!load())
+        {
+            yError() << "[InputSession::configure] Unable to load the file" << m_fileName;
+            return false;
+        }
+
+        m_mode = Mode::Replay;
+        yInfo() << "[InputSession::configure] Replaying" << m_cycleTimestamps.size()
+                << "cycles from" << m_fileName << "with" << pace << "pace.";
+        return true;
+    }
+
+    yError() << "[InputSession::configure] Unknown mode" << mode
+             << ". Available modes: none, record, replay.";
+    return false;
+}
+
+bool InputSession::load()
+{
+    std::ifstream file(m_fileName, std::ios::binary);
+    if (!file.is_open())
+    {
+        yError() << "[InputSession::load] Unable to open the file" << m_fileName;
+        return false;
+    }
+    const std::vector<char> data((std::istreambuf_iterator<char>(file)),
+                                 std::istreambuf_iterator<char>());
+
+    if (data.size() < sizeof(magic) || std::memcmp(data.data(), magic, sizeof(magic)) != 0)
+    {
+        yError() << "[InputSession::load] The file" << m_fileName << "is not an input session.";
+        return false;
+    }
+
+    // handles of the streams indexed by the identifiers used in the file
+    std::vector<Stream> streams;
+    std::size_t position = sizeof(magic);
+    while (position + sizeof(EntryHeader) <= data.size())
+    {
+        EntryHeader header;
+        std::memcpy(&header, data.data() + position, sizeof(header));
+        const std::size_t payloadPosition = position + sizeof(header);
+        if (payloadPosition + paddedSize(header.size) > data.size())
+            break;
+        const char* payload = data.data() + payloadPosition;
+
+        if (header.type != StreamEntry && header.type != CycleEntry
+            && header.stream >= streams.size())
+        {
+            yError() << "[InputSession::load] The file" << m_fileName
+                     << "contains a sample of an unknown stream.";
+            return false;
+        }
+
+        switch (header.type)
+        {
+        case StreamEntry:
+            streams.push_back(addStream(std::string(payload, header.size)));
+            break;
+
+        case ValuesEntry: {
+            Sample sample{m_cycle,
+                          header.timestamp,
+                          m_values.size(),
+                          header.size / sizeof(double),
+                          false};
+            m_values.resize(m_values.size() + sample.size);
+            std::memcpy(m_values.data() + sample.offset, payload, sample.size * sizeof(double));
+            m_streams[streams[header.stream]].samples.push_back(sample);
+            break;
+        }
+
+        case LabelsEntry: {
+            std::vector<std::string> labels;
+            for (std::size_t i = 0; i < header.size;)
+            {
+                labels.emplace_back(payload + i);
+                i += labels.back().size() + 1;
+            }
+            m_streams[streams[header.stream]].samples.push_back(
+                {m_cycle, header.timestamp, m_labels.size(), 0, true});
+            m_labels.push_back(std::move(labels));
+            break;
+        }
+
+        case CycleEntry:
+            m_cycleTimestamps.push_back(header.timestamp);
+            m_cycle++;
+            break;
+
+        default:
+            yError() << "[InputSession::load] The file" << m_fileName << "is corrupted.";
+            return false;
+        }
+
+        position = payloadPosition + paddedSize(header.size);
+    }
+
+    // the last entry may be incomplete if the recording process was killed
+    if (position != data.size())
+        yWarning() << "[InputSession::load] The last entry of the file" << m_fileName
+                   << "is incomplete and it will be ignored.";
+
+    m_cycle = 0;
+    return true;
+}
+
+InputSession::Mode InputSession::mode() const
+{
+    return m_mode;
+}
+
+bool InputSession::isRecording() const
+{
+    return m_mode == Mode::Record;
+}
+
+bool InputSession::isReplaying() const
+{
+    return m_mode == Mode::Replay;
+}
+
+double InputSession::period(double period) const
+{
+    return m_mode == Mode::Replay ? 0.0 : period;
+}
+
+InputSession::Stream InputSession::addStream(const std::string& name)
+{
+    auto stream = m_streamIndices.find(name);
+    if (stream != m_streamIndices.end())
+        return stream->second;
+
+    const Stream index = m_streamIndices.size();
+    m_streamIndices.emplace(name, index);
+
+    if (m_mode == Mode::Record)
+    {
+        write(StreamEntry, index, name.data(), name.size());
+        return index;
+    }
+
+    // the streams of the replayed file are added while loading it
+    if (m_mode == Mode::Replay)
+        yWarning() << "[InputSession::addStream] The stream" << name
+                   << "is not contained in the replayed file.";
+    m_streams.emplace_back();
+
+    return index;
+}
+
+bool InputSession::write(std::uint32_t type, Stream stream, const void* payload, std::size_t size)
+{
+    std::lock_guard<std::mutex> guard(m_fileMutex);
+    return writeEntry(type, stream, payload, size);
+}
+
+bool InputSession::writeEntry(std::uint32_t type,
+                              Stream stream,
+                              const void* payload,
+                              std::size_t size)
+{
+    if (m_file == nullptr)
+        return false;
+
+    const EntryHeader header{
+        type, static_cast<std::uint32_t>(stream), yarp::os::Time::now(), size};
+    constexpr char padding[8] = {};
+
+    bool ok = std::fwrite(&header, sizeof(header), 1, m_file) == 1;
+    ok = ok && (size == 0 || std::fwrite(payload, 1, size, m_file) == size);
+    const std::size_t paddingSize = paddedSize(size) - size;
+    ok = ok && (paddingSize == 0 || std::fwrite(padding, 1, paddingSize, m_file) == paddingSize);
+
+    if (!ok)
+    {
+        yError() << "[InputSession::writeEntry] Unable to write the file" << m_fileName
+                 << ". The recording will be stopped.";
+        close();
+    }
+    return ok;
+}
+
+void InputSession::writeValues(const Stream& stream, const double* values, std::size_t size)
+{
+    writeEntry(ValuesEntry, stream, values, size * sizeof(double));
+}
+
+void InputSession::recordValues(const Stream& stream, const double* values, std::size_t size)
+{
+    write(ValuesEntry, stream, values, size * sizeof(double));
+}
+
+void InputSession::record(const Stream& stream, double value)
+{
+    if (m_mode != Mode::Record)
+        return;
+
+    recordValues(stream, &value, 1);
+}
+
+void InputSession::recordLabels(const Stream& stream, const std::vector<std::string>& labels)
+{
+    if (m_mode != Mode::Record)
+        return;
+
+    std::string payload;
+    for (const auto& label : labels)
+    {
+        payload += label;
+        payload += '\0';
+    }
+    write(LabelsEntry, stream, payload.data(), payload.size());
+}
+
+bool InputSession::beginCycle()
+{
+    // a recording error does not stop the module, the recording is just interrupted
+    if (m_mode == Mode::Record)
+    {
+        write(CycleEntry, 0, nullptr, 0);
+        return true;
+    }
+
+    if (m_mode != Mode::Replay)
+        return true;
+
+    if (m_cycle >= m_cycleTimestamps.size())
+    {
+        yInfo() << "[InputSession::beginCycle] The replayed session ended.";
+        return false;
+    }
+
+    m_cycle++;
+    for (auto& stream : m_streams)
+    {
+        while (stream.next < stream.samples.size() && stream.samples[stream.next].cycle < m_cycle)
+            stream.next++;
+    }
+
+    if (m_realTimePace)
+    {
+        const double now = yarp::os::Time::now();
+        if (m_cycle == 1)
+            m_replayStartTime = now;
+
+        const double delay
+            = m_replayStartTime + m_cycleTimestamps[m_cycle - 1] - m_cycleTimestamps[0] - now;
+        if (delay > 0)
+            yarp::os::Time::delay(delay);
+    }
+
+    return true;
+}
+
+bool InputSession::hasSample(const Stream& stream) const
+{
+    if (m_mode != Mode::Replay)
+        return false;
+
+    const ReplayStream& replayStream = m_streams[stream];
+    return replayStream.next < replayStream.samples.size()
+           && replayStream.samples[replayStream.next].cycle == m_cycle;
+}
+
+const InputSession::Sample* InputSession::nextSample(const Stream& stream)
+{
+    if (!hasSample(stream))
+        return nullptr;
+
+    return &m_streams[stream].samples[m_streams[stream].next++];
+}
+
+const double* InputSession::replay(const Stream& stream, std::size_t& size)
+{
+    const Sample* sample = nextSample(stream);
+    if (sample == nullptr || sample->isLabels)
+        return nullptr;
+
+    size = sample->size;
+    return m_values.data() + sample->offset;
+}
+
+bool InputSession::replay(const Stream& stream, double* values, std::size_t size)
+{
+    std::size_t sampleSize;
+    const double* sample = replay(stream, sampleSize);
+    if (sample == nullptr || sampleSize != size)
+        return false;
+
+    std::copy_n(sample, size, values);
+    return true;
+}
+
+double InputSession::time(const Stream& stream)
+{
+    if (m_mode != Mode::Replay)
+    {
+        const double now = yarp::os::Time::now();
+        record(stream, now);
+        return now;
+    }
+
+    double now;
+    if (replay(stream, &now, 1))
+        return now;
+
+    // the configuration is replayed with the time of the first cycle
+    if (m_cycleTimestamps.empty())
+        return 0.0;
+    return m_cycleTimestamps[m_cycle == 0 ? 0 : m_cycle - 1];
+}
+
+bool InputSession::replayLabels(const Stream& stream, std::vector<std::string>& labels)
+{
+    const Sample* sample = nextSample(stream);
+    if (sample == nullptr || !sample->isLabels)
+        return false;
+
+    labels = m_labels[sample->offset];
+    return true;
+}
+
+void InputSession::close()
+{
+    if (m_file == nullptr)
+        return;
+
+    if (std::fclose(m_file) != 0)
+        yError() << "[InputSession::close] Unable to close the file" << m_fileName;
+    m_file = nullptr;
+}
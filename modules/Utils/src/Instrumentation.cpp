@@ -0,0 +1,125 @@
+/**
+ * @file Instrumentation.cpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+// YARP
+#include <yarp/os/ConnectionReader.h>
+#include <yarp/os/ConnectionWriter.h>
+#include <yarp/os/LogStream.h>
+
+#include <Instrumentation.hpp>
+
+std::size_t StageProfiler::addStage(const std::string& name)
+{
+    m_stages.push_back(std::make_unique<Stage>());
+    m_stages.back()->name = name;
+    return m_stages.size() - 1;
+}
+
+std::size_t StageProfiler::addCounter(const std::string& name)
+{
+    m_counters.push_back(std::make_unique<Counter>());
+    m_counters.back()->name = name;
+    return m_counters.size() - 1;
+}
+
+void StageProfiler::record(const std::size_t& stage, std::uint64_t duration)
+{
+    Stage& currentStage = *m_stages[stage];
+
+    // the histogram is cleared by its writer, never concurrently with record()
+    const std::uint64_t resetRequests = m_resetRequests.load(std::memory_order_relaxed);
+    if (currentStage.handledResetRequests != resetRequests)
+    {
+        currentStage.histogram.reset();
+        currentStage.handledResetRequests = resetRequests;
+    }
+
+    currentStage.histogram.record(duration);
+}
+
+void StageProfiler::increment(const std::size_t& counter, std::uint64_t value)
+{
+    Counter& currentCounter = *m_counters[counter];
+
+    // single writer: a relaxed load/store is enough and avoids locked instructions
+    std::uint64_t counterValue = currentCounter.value.load(std::memory_order_relaxed);
+    const std::uint64_t resetRequests = m_resetRequests.load(std::memory_order_relaxed);
+    if (currentCounter.handledResetRequests != resetRequests)
+    {
+        counterValue = 0;
+        currentCounter.handledResetRequests = resetRequests;
+    }
+
+    currentCounter.value.store(counterValue + value, std::memory_order_relaxed);
+}
+
+bool StageProfiler::open(const std::string& portName)
+{
+#ifdef ENABLE_INSTRUMENTATION
+    m_rpcPort.setReader(*this);
+    if (!m_rpcPort.open(portName))
+    {
+        yError() << "[StageProfiler::open] Unable to open the port" << portName;
+        return false;
+    }
+#else
+    yInfo() << "[StageProfiler::open] The instrumentation is disabled at compile time. The port"
+            << portName << "will not be opened.";
+#endif
+    return true;
+}
+
+void StageProfiler::close()
+{
+    m_rpcPort.close();
+}
+
+void StageProfiler::requestReset()
+{
+    m_resetRequests.fetch_add(1, std::memory_order_relaxed);
+}
+
+void StageProfiler::getStatistics(yarp::os::Bottle& statistics) const
+{
+    for (const auto& stage : m_stages)
+        YarpHelper::addHistogramToBottle(statistics, stage->name, stage->histogram);
+
+    for (const auto& counter : m_counters)
+    {
+        yarp::os::Bottle& list = statistics.addList();
+        list.addString(counter->name);
+        list.addInt64(counter->value.load(std::memory_order_relaxed));
+    }
+}
+
+bool StageProfiler::read(yarp::os::ConnectionReader& connection)
+{
+    yarp::os::Bottle command, reply;
+    if (!command.read(connection))
+        return false;
+
+    const std::string request = command.get(0).asString();
+    if (request == "stats")
+    {
+        getStatistics(reply);
+    } else if (request == "reset")
+    {
+        // the statistics are cleared at the next update of each stage and counter
+        requestReset();
+        reply.addString("ok");
+    } else
+    {
+        reply.addString("Unknown command. Available commands: stats, reset.");
+    }
+
+    yarp::os::ConnectionWriter* writer = connection.getWriter();
+    if (writer != nullptr)
+        reply.write(*writer);
+
+    return true;
+}
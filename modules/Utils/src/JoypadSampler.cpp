@@ -0,0 +1,180 @@
+/**
+ * @file JoypadSampler.cpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+// std
+#include <algorithm>
+
+// YARP
+#include <yarp/os/LogStream.h>
+#include <yarp/os/Time.h>
+
+#include <JoypadSampler.hpp>
+
+constexpr std::size_t JoypadSampler::maxAxes;
+constexpr std::size_t JoypadSampler::maxButtons;
+constexpr std::size_t JoypadSampler::eventsCapacity;
+
+JoypadSampler::~JoypadSampler()
+{
+    stop();
+}
+
+bool JoypadSampler::start(yarp::dev::IJoypadController* joypad, const double& samplingTime)
+{
+    if (m_sampler.joinable())
+    {
+        yError() << "[JoypadSampler::start] The sampler is already started.";
+        return false;
+    }
+
+    if (joypad == nullptr)
+    {
+        yError() << "[JoypadSampler::start] The joypad interface is not valid.";
+        return false;
+    }
+
+    if (samplingTime <= 0)
+    {
+        yError() << "[JoypadSampler::start] The sampling time must be positive.";
+        return false;
+    }
+
+    unsigned int numberOfAxes, numberOfButtons;
+    if (!joypad->getAxisCount(numberOfAxes) || !joypad->getButtonCount(numberOfButtons))
+    {
+        yError() << "[JoypadSampler::start] Unable to get the number of axes and buttons.";
+        return false;
+    }
+
+    if (numberOfAxes > maxAxes || numberOfButtons > maxButtons)
+        yWarning() << "[JoypadSampler::start] Only the first" << maxAxes << "axes and"
+                   << maxButtons << "buttons are sampled.";
+
+    m_joypad = joypad;
+    m_period = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::duration<double>(samplingTime));
+
+    m_sample = Snapshot();
+    m_sample.numberOfAxes = std::min<std::size_t>(numberOfAxes, maxAxes);
+    m_sample.numberOfButtons = std::min<std::size_t>(numberOfButtons, maxButtons);
+    m_numberOfSamples = 0;
+    m_numberOfFailedReads = 0;
+    m_droppedEvents = 0;
+
+    // the first sample is taken here, so the buttons held at startup are not considered pressed
+    // and the reader gets valid values from the first cycle
+    if (!sample())
+    {
+        yError() << "[JoypadSampler::start] Unable to read the joypad.";
+        return false;
+    }
+    ButtonEvent event;
+    while (m_events.pop(event))
+    {
+    }
+
+    m_isRunning = true;
+    m_sampler = std::thread(&JoypadSampler::samplerLoop, this);
+    return true;
+}
+
+void JoypadSampler::stop()
+{
+    if (!m_sampler.joinable())
+        return;
+
+    m_isRunning = false;
+    m_sampler.join();
+}
+
+bool JoypadSampler::isRunning() const
+{
+    return m_isRunning;
+}
+
+bool JoypadSampler::sample()
+{
+    bool ok = true;
+    for (std::size_t i = 0; i < m_sample.numberOfAxes; i++)
+        ok = m_joypad->getAxis(i, m_sample.axes[i]) && ok;
+
+    for (std::size_t i = 0; i < m_sample.numberOfButtons; i++)
+    {
+        float value;
+        if (!m_joypad->getButton(i, value))
+        {
+            ok = false;
+            continue;
+        }
+
+        // the button is pressed if its value is positive
+        const bool wasPressed = m_sample.buttons[i] > 0;
+        const bool isPressed = value > 0;
+        m_sample.buttons[i] = value;
+
+        if (wasPressed != isPressed)
+        {
+            ButtonEvent event;
+            event.button = i;
+            event.isPressed = isPressed;
+            event.time = yarp::os::Time::now();
+            if (!m_events.push(event))
+                m_droppedEvents++;
+        }
+    }
+
+    m_sample.time = yarp::os::Time::now();
+    m_snapshot.write(m_sample);
+
+    m_numberOfSamples++;
+    if (!ok)
+        m_numberOfFailedReads++;
+    return ok;
+}
+
+void JoypadSampler::samplerLoop()
+{
+    // the next sample is computed as an absolute time, so the period does not drift
+    auto wakeUpTime = std::chrono::steady_clock::now();
+    while (m_isRunning.load(std::memory_order_acquire))
+    {
+        sample();
+
+        // if the joypad client was slower than the period the missed samples are skipped
+        wakeUpTime += m_period;
+        const auto now = std::chrono::steady_clock::now();
+        if (wakeUpTime < now)
+            wakeUpTime = now;
+        std::this_thread::sleep_until(wakeUpTime);
+    }
+}
+
+bool JoypadSampler::read(Snapshot& snapshot)
+{
+    return m_snapshot.read(snapshot);
+}
+
+bool JoypadSampler::popEvent(ButtonEvent& event)
+{
+    return m_events.pop(event);
+}
+
+std::uint64_t JoypadSampler::numberOfSamples() const
+{
+    return m_numberOfSamples;
+}
+
+std::uint64_t JoypadSampler::numberOfFailedReads() const
+{
+    return m_numberOfFailedReads;
+}
+
+std::uint64_t JoypadSampler::droppedEvents() const
+{
+    return m_droppedEvents;
+}
@@ -0,0 +1,153 @@
+/**
+ * @file OrientationPredictor.cpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+// std
+#include <algorithm>
+#include <cmath>
+
+// YARP
+#include <yarp/os/LogStream.h>
+
+#include <OrientationPredictor.hpp>
+
+constexpr std::size_t OrientationPredictor::maxHorizonSamples;
+
+double OrientationPredictor::angle(const Eigen::Matrix3d& rotation)
+{
+    // trace(R) = 1 + 2 cos(angle)
+    const double cosine = 0.5 * (rotation.trace() - 1.0);
+    return std::acos(std::max(-1.0, std::min(1.0, cosine)));
+}
+
+bool OrientationPredictor::configure(const double& samplingTime,
+                                     const double& horizon,
+                                     const double& filterGain,
+                                     const double& maxAngle)
+{
+    if (samplingTime <= 0)
+    {
+        yError() << "[OrientationPredictor::configure] The sampling time must be positive.";
+        return false;
+    }
+
+    if (horizon < 0)
+    {
+        yError() << "[OrientationPredictor::configure] The horizon cannot be negative.";
+        return false;
+    }
+
+    if (filterGain <= 0 || filterGain > 1)
+    {
+        yError() << "[OrientationPredictor::configure] The filter gain must be in (0, 1].";
+        return false;
+    }
+
+    if (maxAngle < 0)
+    {
+        yError() << "[OrientationPredictor::configure] The maximum angle cannot be negative.";
+        return false;
+    }
+
+    const std::size_t horizonSamples
+        = static_cast<std::size_t>(std::round(horizon / samplingTime));
+    if (horizonSamples > maxHorizonSamples)
+    {
+        yError() << "[OrientationPredictor::configure] The horizon cannot be longer than"
+                 << maxHorizonSamples << "samples.";
+        return false;
+    }
+
+    m_samplingTime = samplingTime;
+    m_horizon = horizon;
+    m_filterGain = filterGain;
+    m_maxAngle = maxAngle;
+    m_horizonSamples = horizonSamples;
+
+    reset();
+    return true;
+}
+
+void OrientationPredictor::reset()
+{
+    m_angularVelocity.setZero();
+    m_numberOfSamples = 0;
+    m_predictionError = 0;
+    m_baselineError = 0;
+    m_predictionSquaredErrors = 0;
+    m_baselineSquaredErrors = 0;
+    m_numberOfErrors = 0;
+}
+
+void OrientationPredictor::predict(const Eigen::Matrix3d& rotation,
+                                   Eigen::Matrix3d& predictedRotation)
+{
+    constexpr std::size_t bufferSize = maxHorizonSamples + 1;
+    const std::size_t index = m_numberOfSamples % bufferSize;
+
+    // angular velocity in the body frame
+    if (m_numberOfSamples > 0)
+    {
+        const Eigen::Matrix3d& previousRotation = m_samples[(index + bufferSize - 1) % bufferSize];
+        const Eigen::AngleAxisd rotationIncrement(previousRotation.transpose() * rotation);
+        const Eigen::Vector3d angularVelocity
+            = rotationIncrement.angle() / m_samplingTime * rotationIncrement.axis();
+        m_angularVelocity = m_filterGain * angularVelocity + (1 - m_filterGain) * m_angularVelocity;
+    }
+
+    // compare the current sample with the prediction and the sample of one horizon ago
+    if (m_horizonSamples > 0 && m_numberOfSamples >= m_horizonSamples)
+    {
+        const std::size_t pastIndex = (index + bufferSize - m_horizonSamples) % bufferSize;
+        m_predictionError = angle(m_predictions[pastIndex].transpose() * rotation);
+        m_baselineError = angle(m_samples[pastIndex].transpose() * rotation);
+        m_predictionSquaredErrors += m_predictionError * m_predictionError;
+        m_baselineSquaredErrors += m_baselineError * m_baselineError;
+        m_numberOfErrors++;
+    }
+
+    m_samples[index] = rotation;
+
+    // extrapolate the rotation, the predicted rotation is saturated
+    double predictedAngle = m_angularVelocity.norm() * m_horizon;
+    if (predictedAngle > 0)
+    {
+        const Eigen::Vector3d axis = m_angularVelocity.normalized();
+        predictedAngle = std::min(predictedAngle, m_maxAngle);
+        m_predictions[index]
+            = rotation * Eigen::AngleAxisd(predictedAngle, axis).toRotationMatrix();
+    } else
+        m_predictions[index] = rotation;
+
+    m_numberOfSamples++;
+    predictedRotation = m_predictions[index];
+}
+
+const Eigen::Vector3d& OrientationPredictor::angularVelocity() const
+{
+    return m_angularVelocity;
+}
+
+double OrientationPredictor::predictionError() const
+{
+    return m_predictionError;
+}
+
+double OrientationPredictor::baselineError() const
+{
+    return m_baselineError;
+}
+
+double OrientationPredictor::rmsPredictionError() const
+{
+    return m_numberOfErrors > 0 ? std::sqrt(m_predictionSquaredErrors / m_numberOfErrors) : 0;
+}
+
+double OrientationPredictor::rmsBaselineError() const
+{
+    return m_numberOfErrors > 0 ? std::sqrt(m_baselineSquaredErrors / m_numberOfErrors) : 0;
+}
@@ -0,0 +1,76 @@
+/**
+ * @file OrientationSmoother.cpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+// std
+#include <cmath>
+
+// YARP
+#include <yarp/os/LogStream.h>
+
+#include <OrientationSmoother.hpp>
+
+constexpr std::size_t OrientationSmoother::numberOfStages;
+
+namespace
+{
+// the step response of three cascaded first order filters with pole p is
+// 1 - exp(-p t) (1 + p t + (p t)^2 / 2), it reaches the 98% when p t = 7.5
+constexpr double settlingTimeConstants = 7.5;
+} // namespace
+
+OrientationSmoother::OrientationSmoother()
+{
+    m_stages.fill(Eigen::Quaterniond::Identity());
+}
+
+bool OrientationSmoother::configure(const double& samplingTime, const double& smoothingTime)
+{
+    if (samplingTime <= 0)
+    {
+        yError() << "[OrientationSmoother::configure] The sampling time must be positive.";
+        return false;
+    }
+
+    if (smoothingTime < 0)
+    {
+        yError() << "[OrientationSmoother::configure] The smoothing time cannot be negative.";
+        return false;
+    }
+
+    // exact discretization of the first order filter with pole p
+    if (smoothingTime > 0)
+    {
+        const double pole = settlingTimeConstants / smoothingTime;
+        m_gain = 1 - std::exp(-pole * samplingTime);
+    } else
+        m_gain = 1;
+
+    reset(Eigen::Matrix3d::Identity());
+    return true;
+}
+
+void OrientationSmoother::reset(const Eigen::Matrix3d& rotation)
+{
+    m_stages.fill(Eigen::Quaterniond(rotation).normalized());
+}
+
+void OrientationSmoother::smooth(const Eigen::Matrix3d& rotation,
+                                 Eigen::Matrix3d& smoothedRotation)
+{
+    // slerp follows the shortest path, so the sign of the quaternions does not matter
+    const Eigen::Quaterniond sample(rotation);
+    m_stages[0] = m_stages[0].slerp(m_gain, sample);
+    for (std::size_t i = 1; i < numberOfStages; i++)
+        m_stages[i] = m_stages[i].slerp(m_gain, m_stages[i - 1]);
+
+    // the numerical errors accumulated by the stages are removed
+    for (auto& stage : m_stages)
+        stage.normalize();
+
+    smoothedRotation = m_stages[numberOfStages - 1].toRotationMatrix();
+}
@@ -0,0 +1,269 @@
+/**
+ * @file PeriodicExecutor.cpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+// std
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#endif
+
+// YARP
+#include <yarp/os/Bottle.h>
+#include <yarp/os/ConnectionReader.h>
+#include <yarp/os/ConnectionWriter.h>
+#include <yarp/os/LogStream.h>
+#include <yarp/os/Time.h>
+
+#include <PeriodicExecutor.hpp>
+
+bool PeriodicExecutor::configure(const yarp::os::Searchable& config,
+                                 const double& period,
+                                 const std::string& name)
+{
+    if (period < 0)
+    {
+        yError() << "[PeriodicExecutor::configure] The period must not be negative.";
+        return false;
+    }
+    m_period = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::duration<double>(period));
+
+    m_priority = config.check("priority", yarp::os::Value(0)).asInt32();
+    m_cpu = config.check("cpu", yarp::os::Value(-1)).asInt32();
+
+#ifndef __linux__
+    if (m_priority > 0 || m_cpu >= 0)
+    {
+        yWarning() << "[PeriodicExecutor::configure] The real-time priority and the CPU affinity "
+                      "are supported only on Linux. They will be ignored.";
+        m_priority = 0;
+        m_cpu = -1;
+    }
+#endif
+
+    std::string portName
+        = config.check("rpc_port_name", yarp::os::Value("/" + name + "/executor/rpc")).asString();
+    m_rpcPort.setReader(*this);
+    if (!m_rpcPort.open(portName))
+    {
+        yError() << "[PeriodicExecutor::configure] Unable to open the port" << portName;
+        return false;
+    }
+
+    return true;
+}
+
+bool PeriodicExecutor::setupThread()
+{
+#ifdef __linux__
+    if (m_cpu >= 0)
+    {
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        CPU_SET(m_cpu, &cpuSet);
+        int error = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet);
+        if (error != 0)
+        {
+            yError() << "[PeriodicExecutor::setupThread] Unable to pin the thread to the CPU"
+                     << m_cpu << ":" << std::strerror(error);
+            return false;
+        }
+    }
+
+    if (m_priority > 0)
+    {
+        sched_param parameters;
+        parameters.sched_priority = m_priority;
+        int error = pthread_setschedparam(pthread_self(), SCHED_FIFO, &parameters);
+        if (error != 0)
+        {
+            yError() << "[PeriodicExecutor::setupThread] Unable to set the SCHED_FIFO priority"
+                     << m_priority << ":" << std::strerror(error);
+            return false;
+        }
+    }
+#endif
+    return true;
+}
+
+void PeriodicExecutor::sleepUntil(const Clock::time_point& wakeUpTime)
+{
+#ifdef __linux__
+    // std::chrono::steady_clock is based on CLOCK_MONOTONIC
+    const auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                 wakeUpTime.time_since_epoch())
+                                 .count();
+    timespec time;
+    time.tv_sec = static_cast<time_t>(nanoseconds / 1000000000);
+    time.tv_nsec = static_cast<long>(nanoseconds % 1000000000);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &time, nullptr) == EINTR)
+    {
+    }
+#else
+    std::this_thread::sleep_until(wakeUpTime);
+#endif
+}
+
+bool PeriodicExecutor::run(const std::function<bool()>& function)
+{
+    if (!setupThread())
+        return false;
+
+    m_isRunning = true;
+    Clock::time_point deadline = Clock::now();
+    while (m_isRunning)
+    {
+        const Clock::time_point start = Clock::now();
+        m_wakeUpLatency.record(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(start - deadline).count());
+
+        // as in the RFModule, the loop ends when the function returns false
+        if (!function())
+            break;
+
+        const Clock::time_point end = Clock::now();
+        m_executionTime.record(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        m_numberOfCycles.store(m_numberOfCycles.load(std::memory_order_relaxed) + 1,
+                               std::memory_order_relaxed);
+
+        if (m_period.count() == 0)
+        {
+            deadline = end;
+            continue;
+        }
+
+        deadline += m_period;
+        if (end > deadline)
+        {
+            m_overrunTime.record(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(end - deadline).count());
+            m_numberOfOverruns.store(m_numberOfOverruns.load(std::memory_order_relaxed) + 1,
+                                     std::memory_order_relaxed);
+
+            // the missed activations are skipped instead of running a burst of cycles
+            const auto missedPeriods = (end - deadline) / m_period + 1;
+            deadline += missedPeriods * m_period;
+        }
+
+        sleepUntil(deadline);
+    }
+
+    m_isRunning = false;
+    return true;
+}
+
+void PeriodicExecutor::stop()
+{
+    m_isRunning = false;
+}
+
+void PeriodicExecutor::close()
+{
+    m_rpcPort.close();
+}
+
+void PeriodicExecutor::resetStatistics()
+{
+    m_executionTime.reset();
+    m_wakeUpLatency.reset();
+    m_overrunTime.reset();
+    m_numberOfCycles = 0;
+    m_numberOfOverruns = 0;
+}
+
+void PeriodicExecutor::getStatistics(yarp::os::Bottle& statistics) const
+{
+    yarp::os::Bottle& period = statistics.addList();
+    period.addString("period_us");
+    period.addFloat64(m_period.count() * 1e-3);
+
+    yarp::os::Bottle& cycles = statistics.addList();
+    cycles.addString("cycles");
+    cycles.addInt64(m_numberOfCycles.load(std::memory_order_relaxed));
+
+    yarp::os::Bottle& overruns = statistics.addList();
+    overruns.addString("overruns");
+    overruns.addInt64(m_numberOfOverruns.load(std::memory_order_relaxed));
+
+    YarpHelper::addHistogramToBottle(statistics, "execution_time_us", m_executionTime);
+    YarpHelper::addHistogramToBottle(statistics, "wake_up_latency_us", m_wakeUpLatency);
+    YarpHelper::addHistogramToBottle(statistics, "overrun_time_us", m_overrunTime);
+}
+
+bool PeriodicExecutor::read(yarp::os::ConnectionReader& connection)
+{
+    yarp::os::Bottle command, reply;
+    if (!command.read(connection))
+        return false;
+
+    const std::string request = command.get(0).asString();
+    if (request == "stats")
+    {
+        getStatistics(reply);
+    } else if (request == "reset")
+    {
+        resetStatistics();
+        reply.addString("ok");
+    } else
+    {
+        reply.addString("Unknown command. Available commands: stats, reset.");
+    }
+
+    yarp::os::ConnectionWriter* writer = connection.getWriter();
+    if (writer != nullptr)
+        reply.write(*writer);
+
+    return true;
+}
+
+int YarpHelper::runModule(yarp::os::RFModule& module, yarp::os::ResourceFinder& rf)
+{
+    const yarp::os::Bottle& options = rf.findGroup("EXECUTOR");
+    if (!options.check("enable", yarp::os::Value(false)).asBool())
+        return module.runModule(rf);
+
+    if (!yarp::os::Time::isSystemClock())
+    {
+        yWarning() << "[YarpHelper::runModule] The PeriodicExecutor uses the system clock. Since "
+                      "a network clock is used, the standard RFModule loop will be used.";
+        return module.runModule(rf);
+    }
+
+    if (!module.configure(rf))
+    {
+        yError() << "[YarpHelper::runModule] Unable to configure the module.";
+        return EXIT_FAILURE;
+    }
+
+    PeriodicExecutor executor;
+    if (!executor.configure(options, module.getPeriod(), module.getName()))
+    {
+        yError() << "[YarpHelper::runModule] Unable to configure the periodic executor.";
+        module.close();
+        return EXIT_FAILURE;
+    }
+
+    // the loop ends when the module is stopped (stopModule()) or when updateModule() fails
+    bool ok = executor.run([&module]() { return !module.isStopping() && module.updateModule(); });
+
+    // the module is shut down as in the RFModule loop: the blocked ports and threads are
+    // released by interruptModule() before close()
+    module.stopModule();
+    executor.close();
+    module.interruptModule();
+    module.close();
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,86 @@
+/**
+ * @file RateScheduler.cpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+// std
+#include <algorithm>
+
+// YARP
+#include <yarp/os/LogStream.h>
+
+#include <RateScheduler.hpp>
+
+bool RateScheduler::configure(const double& baseSamplingTime)
+{
+    if (baseSamplingTime <= 0)
+    {
+        yError() << "[RateScheduler::configure] The sampling time must be positive.";
+        return false;
+    }
+
+    m_baseSamplingTime = baseSamplingTime;
+    m_subsystems.clear();
+    reset();
+    return true;
+}
+
+bool RateScheduler::addSubsystem(const yarp::os::Searchable& config,
+                                 const std::string& name,
+                                 std::size_t& index)
+{
+    const std::string key = name + "RateDivisor";
+    const int divisor = config.check(key, yarp::os::Value(1)).asInt32();
+    if (divisor < 1)
+    {
+        yError() << "[RateScheduler::addSubsystem] The parameter" << key
+                 << "must be a positive integer.";
+        return false;
+    }
+
+    // the subsystems with the same divisor are shifted by one cycle each
+    const unsigned subsystemsWithSameDivisor
+        = std::count_if(m_subsystems.begin(), m_subsystems.end(), [divisor](const Subsystem& s) {
+              return s.divisor == static_cast<unsigned>(divisor);
+          });
+
+    Subsystem subsystem;
+    subsystem.name = name;
+    subsystem.divisor = divisor;
+    subsystem.phase = subsystemsWithSameDivisor % subsystem.divisor;
+
+    index = m_subsystems.size();
+    m_subsystems.push_back(subsystem);
+
+    yInfo() << "[RateScheduler::addSubsystem]" << name << "runs every" << divisor
+            << "cycles (sampling time" << samplingTime(index) << "s).";
+    return true;
+}
+
+void RateScheduler::startCycle()
+{
+    m_numberOfCycles++;
+}
+
+void RateScheduler::reset()
+{
+    m_numberOfCycles = 0;
+}
+
+bool RateScheduler::isActive(const std::size_t& index) const
+{
+    // before the first cycle no subsystem is active
+    if (m_numberOfCycles == 0)
+        return false;
+
+    const Subsystem& subsystem = m_subsystems[index];
+    return (m_numberOfCycles - 1 + subsystem.phase) % subsystem.divisor == 0;
+}
+
+double RateScheduler::samplingTime(const std::size_t& index) const
+{
+    return m_subsystems[index].divisor * m_baseSamplingTime;
+}
@@ -0,0 +1,449 @@
+/**
+ * @file SessionRecorder.cpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+// std
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// YARP
+#include <yarp/os/LogStream.h>
+
+#include <SessionRecorder.hpp>
+
+namespace
+{
+// layout of the header:
+// magic (8 bytes), header size, record size, number of records, number of channels and, for each
+// channel, rows, cols, offset, name length and name. All the integers are uint64.
+constexpr char magic[8] = {'W', 'T', 'R', 'E', 'C', '0', '1', '\0'};
+constexpr std::size_t numberOfRecordsPosition = 3 * sizeof(std::uint64_t);
+
+// period of the writer thread
+constexpr std::chrono::milliseconds writerPeriod(5);
+
+void appendInteger(std::vector<char>& buffer, std::uint64_t value)
+{
+    const char* bytes = reinterpret_cast<const char*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(value));
+}
+
+bool readInteger(std::istream& stream, std::uint64_t& value)
+{
+    return static_cast<bool>(stream.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+} // namespace
+
+SessionRecorder::~SessionRecorder()
+{
+    close();
+}
+
+SessionRecorder::Channel
+SessionRecorder::addChannel(const std::string& name, std::size_t rows, std::size_t cols)
+{
+    SessionRecordChannel channel;
+    channel.name = name;
+    channel.rows = rows;
+    channel.cols = cols;
+    channel.offset = m_record.size();
+
+    m_channels.push_back(channel);
+    m_record.resize(m_record.size() + channel.size(), 0.0);
+    return m_channels.size() - 1;
+}
+
+std::vector<char> SessionRecorder::header() const
+{
+    std::vector<char> buffer(magic, magic + sizeof(magic));
+    // the size of the header is written at the end
+    appendInteger(buffer, 0);
+    appendInteger(buffer, m_record.size());
+    appendInteger(buffer, m_numberOfRecords);
+    appendInteger(buffer, m_channels.size());
+    for (const auto& channel : m_channels)
+    {
+        appendInteger(buffer, channel.rows);
+        appendInteger(buffer, channel.cols);
+        appendInteger(buffer, channel.offset);
+        appendInteger(buffer, channel.name.size());
+        buffer.insert(buffer.end(), channel.name.begin(), channel.name.end());
+    }
+
+    // the records are aligned to 8 bytes
+    buffer.resize((buffer.size() + 7) / 8 * 8, '\0');
+    const std::uint64_t headerSize = buffer.size();
+    std::memcpy(buffer.data() + sizeof(magic), &headerSize, sizeof(headerSize));
+    return buffer;
+}
+
+bool SessionRecorder::open(const std::string& fileName, std::size_t capacity)
+{
+    if (m_isOpen)
+    {
+        yError() << "[SessionRecorder::open] The file" << m_fileName << "is already open.";
+        return false;
+    }
+
+    if (m_record.empty())
+    {
+        yError() << "[SessionRecorder::open] No channel has been added.";
+        return false;
+    }
+
+    m_fileName = fileName;
+    m_numberOfRecords = 0;
+    m_isWriterFailed = false;
+    m_capacityIncrement = capacity > 0 ? capacity : 1;
+    const std::vector<char> fileHeader = header();
+    m_headerSize = fileHeader.size();
+
+#ifdef _WIN32
+    m_file = std::fopen(fileName.c_str(), "wb");
+    if (m_file == nullptr)
+    {
+        yError() << "[SessionRecorder::open] Unable to open the file" << fileName;
+        return false;
+    }
+    std::fwrite(fileHeader.data(), 1, fileHeader.size(), m_file);
+#else
+    m_fileDescriptor = ::open(fileName.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (m_fileDescriptor < 0)
+    {
+        yError() << "[SessionRecorder::open] Unable to open the file" << fileName << ":"
+                 << std::strerror(errno);
+        return false;
+    }
+
+    if (!map(m_capacityIncrement))
+    {
+        ::close(m_fileDescriptor);
+        m_fileDescriptor = -1;
+        return false;
+    }
+    std::memcpy(m_mapping, fileHeader.data(), fileHeader.size());
+#endif
+
+    m_isOpen = true;
+    return true;
+}
+
+#ifndef _WIN32
+bool SessionRecorder::map(std::size_t capacity)
+{
+    const std::size_t size = m_headerSize + capacity * m_record.size() * sizeof(double);
+    if (ftruncate(m_fileDescriptor, static_cast<off_t>(size)) != 0)
+    {
+        yError() << "[SessionRecorder::map] Unable to resize the file" << m_fileName << ":"
+                 << std::strerror(errno);
+        return false;
+    }
+
+    if (m_mapping != nullptr)
+        munmap(m_mapping, m_mappingSize);
+
+    void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fileDescriptor, 0);
+    if (mapping == MAP_FAILED)
+    {
+        m_mapping = nullptr;
+        yError() << "[SessionRecorder::map] Unable to map the file" << m_fileName << ":"
+                 << std::strerror(errno);
+        return false;
+    }
+
+    m_mapping = static_cast<char*>(mapping);
+    m_mappingSize = size;
+    m_capacity = capacity;
+    return true;
+}
+#endif
+
+void SessionRecorder::set(const Channel& channel, double value)
+{
+    m_record[m_channels[channel].offset] = value;
+}
+
+bool SessionRecorder::write(const double* record)
+{
+    const std::size_t recordBytes = m_record.size() * sizeof(double);
+
+#ifdef _WIN32
+    if (std::fwrite(record, 1, recordBytes, m_file) != recordBytes)
+    {
+        yError() << "[SessionRecorder::write] Unable to write the file" << m_fileName;
+        return false;
+    }
+#else
+    if (m_numberOfRecords == m_capacity)
+    {
+        // rare case: the file is enlarged
+        if (!map(m_capacity + m_capacityIncrement))
+        {
+            yError() << "[SessionRecorder::write] Unable to enlarge the file" << m_fileName;
+            return false;
+        }
+    }
+
+    std::memcpy(m_mapping + m_headerSize + m_numberOfRecords * recordBytes, record, recordBytes);
+#endif
+
+    m_numberOfRecords++;
+
+#ifndef _WIN32
+    const std::uint64_t numberOfRecords = m_numberOfRecords;
+    std::memcpy(m_mapping + numberOfRecordsPosition, &numberOfRecords, sizeof(numberOfRecords));
+#endif
+    return true;
+}
+
+bool SessionRecorder::commit()
+{
+    if (!m_isOpen)
+        return false;
+
+    if (!m_writer.joinable())
+    {
+        if (!write(m_record.data()))
+        {
+            yError() << "[SessionRecorder::commit] The recorder will be closed.";
+            m_isWriterFailed = true;
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    if (m_isWriterFailed)
+        return false;
+
+    const std::size_t head = m_queueHead.load(std::memory_order_relaxed);
+    if (head - m_queueTail.load(std::memory_order_acquire) == m_queueCapacity)
+    {
+        m_droppedRecords++;
+        return false;
+    }
+
+    std::copy(m_record.begin(),
+              m_record.end(),
+              m_queue.begin() + (head % m_queueCapacity) * m_record.size());
+    m_queueHead.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+bool SessionRecorder::startWriter(std::size_t queueCapacity)
+{
+    if (!m_isOpen)
+    {
+        yError() << "[SessionRecorder::startWriter] The file has to be opened before starting the "
+                    "writer.";
+        return false;
+    }
+
+    if (m_writer.joinable())
+    {
+        yError() << "[SessionRecorder::startWriter] The writer is already started.";
+        return false;
+    }
+
+    if (queueCapacity == 0)
+    {
+        yError() << "[SessionRecorder::startWriter] The capacity of the queue must be positive.";
+        return false;
+    }
+
+    // the queue is allocated (and its memory touched) here, not in the control loop
+    m_queueCapacity = queueCapacity;
+    m_queue.assign(queueCapacity * m_record.size(), 0.0);
+    m_queueHead = 0;
+    m_queueTail = 0;
+    m_droppedRecords = 0;
+    m_isWriterFailed = false;
+    m_isWriterRunning = true;
+    m_writer = std::thread(&SessionRecorder::writerLoop, this);
+    return true;
+}
+
+void SessionRecorder::writerLoop()
+{
+    const std::size_t recordSize = m_record.size();
+    bool isRunning = true;
+    while (isRunning)
+    {
+        // the records committed before the stop request are stored as well
+        isRunning = m_isWriterRunning.load(std::memory_order_acquire);
+
+        std::size_t tail = m_queueTail.load(std::memory_order_relaxed);
+        const std::size_t head = m_queueHead.load(std::memory_order_acquire);
+        for (; tail != head; tail++)
+        {
+            if (!write(m_queue.data() + (tail % m_queueCapacity) * recordSize))
+            {
+                // the error is logged only here, commit() drops the following records silently
+                yError() << "[SessionRecorder::writerLoop] The writer is stopped, the records "
+                            "committed from now on are dropped.";
+                m_isWriterFailed = true;
+                return;
+            }
+            m_queueTail.store(tail + 1, std::memory_order_release);
+        }
+
+        if (isRunning)
+            std::this_thread::sleep_for(writerPeriod);
+    }
+}
+
+bool SessionRecorder::close()
+{
+    if (!m_isOpen)
+        return true;
+    m_isOpen = false;
+
+    if (m_writer.joinable())
+    {
+        m_isWriterRunning = false;
+        m_writer.join();
+        if (m_droppedRecords > 0)
+            yWarning() << "[SessionRecorder::close]" << m_droppedRecords
+                       << "records were dropped because the writer was too slow.";
+    }
+
+    bool ok = true;
+    const std::uint64_t numberOfRecords = m_numberOfRecords;
+#ifdef _WIN32
+    ok = std::fseek(m_file, numberOfRecordsPosition, SEEK_SET) == 0
+         && std::fwrite(&numberOfRecords, sizeof(numberOfRecords), 1, m_file) == 1;
+    ok = std::fclose(m_file) == 0 && ok;
+    m_file = nullptr;
+#else
+    if (m_mapping != nullptr)
+    {
+        std::memcpy(m_mapping + numberOfRecordsPosition, &numberOfRecords, sizeof(numberOfRecords));
+        munmap(m_mapping, m_mappingSize);
+        m_mapping = nullptr;
+    }
+
+    const std::size_t size = m_headerSize + m_numberOfRecords * m_record.size() * sizeof(double);
+    ok = ftruncate(m_fileDescriptor, static_cast<off_t>(size)) == 0;
+    ok = ::close(m_fileDescriptor) == 0 && ok;
+    m_fileDescriptor = -1;
+#endif
+
+    if (!ok)
+        yError() << "[SessionRecorder::close] Unable to finalize the file" << m_fileName;
+    return ok;
+}
+
+const std::string& SessionRecorder::fileName() const
+{
+    return m_fileName;
+}
+
+std::size_t SessionRecorder::numberOfRecords() const
+{
+    return m_numberOfRecords;
+}
+
+std::size_t SessionRecorder::droppedRecords() const
+{
+    return m_droppedRecords;
+}
+
+bool SessionRecorder::isWriterFailed() const
+{
+    return m_isWriterFailed;
+}
+
+bool SessionRecordReader::open(const std::string& fileName)
+{
+    std::ifstream file(fileName, std::ios::binary);
+    if (!file.is_open())
+    {
+        yError() << "[SessionRecordReader::open] Unable to open the file" << fileName;
+        return false;
+    }
+
+    char fileMagic[sizeof(magic)];
+    if (!file.read(fileMagic, sizeof(fileMagic))
+        || std::memcmp(fileMagic, magic, sizeof(magic)) != 0)
+    {
+        yError() << "[SessionRecordReader::open] The file" << fileName
+                 << "is not a session record.";
+        return false;
+    }
+
+    std::uint64_t headerSize, recordSize, numberOfRecords, numberOfChannels;
+    if (!readInteger(file, headerSize) || !readInteger(file, recordSize)
+        || !readInteger(file, numberOfRecords) || !readInteger(file, numberOfChannels))
+    {
+        yError() << "[SessionRecordReader::open] The header of the file" << fileName
+                 << "is corrupted.";
+        return false;
+    }
+
+    m_channels.clear();
+    for (std::uint64_t i = 0; i < numberOfChannels; i++)
+    {
+        std::uint64_t rows, cols, offset, nameLength;
+        if (!readInteger(file, rows) || !readInteger(file, cols) || !readInteger(file, offset)
+            || !readInteger(file, nameLength))
+        {
+            yError() << "[SessionRecordReader::open] The header of the file" << fileName
+                     << "is corrupted.";
+            return false;
+        }
+
+        SessionRecordChannel channel;
+        channel.rows = rows;
+        channel.cols = cols;
+        channel.offset = offset;
+        channel.name.resize(nameLength);
+        if (!file.read(&channel.name[0], nameLength) || offset + rows * cols > recordSize)
+        {
+            yError() << "[SessionRecordReader::open] The header of the file" << fileName
+                     << "is corrupted.";
+            return false;
+        }
+        m_channels.push_back(channel);
+    }
+
+    m_recordSize = recordSize;
+    m_data.resize(numberOfRecords * recordSize);
+    file.seekg(headerSize);
+    file.read(reinterpret_cast<char*>(m_data.data()), m_data.size() * sizeof(double));
+
+    // if the recorder was not closed the last record may be incomplete
+    m_numberOfRecords = recordSize > 0 ? file.gcount() / sizeof(double) / recordSize : 0;
+    if (m_numberOfRecords != numberOfRecords)
+        yWarning() << "[SessionRecordReader::open] The file" << fileName << "contains"
+                   << m_numberOfRecords << "complete records instead of" << numberOfRecords;
+
+    return true;
+}
+
+const std::vector<SessionRecordChannel>& SessionRecordReader::channels() const
+{
+    return m_channels;
+}
+
+std::size_t SessionRecordReader::numberOfRecords() const
+{
+    return m_numberOfRecords;
+}
+
+const double* SessionRecordReader::data(std::size_t record, std::size_t channel) const
+{
+    return m_data.data() + record * m_recordSize + m_channels[channel].offset;
+}
@@ -0,0 +1,215 @@
+/**
+ * @file TaskPool.cpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+// std
+#include <algorithm>
+#include <cstring>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// YARP
+#include <yarp/os/LogStream.h>
+
+#include <TaskPool.hpp>
+
+TaskPool::~TaskPool()
+{
+    close();
+}
+
+bool TaskPool::addTask(const Task& task)
+{
+    if (!m_workers.empty())
+    {
+        yError() << "[TaskPool::addTask] The tasks cannot be added after starting the pool.";
+        return false;
+    }
+
+    m_tasks.push_back(task);
+    return true;
+}
+
+bool TaskPool::start(std::size_t numberOfThreads)
+{
+    if (!m_workers.empty())
+    {
+        yError() << "[TaskPool::start] The pool is already started.";
+        return false;
+    }
+
+    // the calling thread of run() executes tasks as well
+    if (!m_tasks.empty())
+        numberOfThreads = std::min(numberOfThreads, m_tasks.size() - 1);
+
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_isClosing = false;
+        m_isDedicated = false;
+        m_nextTask = m_tasks.size();
+        m_completedTasks = m_tasks.size();
+    }
+
+    for (std::size_t i = 0; i < numberOfThreads; i++)
+        m_workers.emplace_back(&TaskPool::workerLoop, this);
+
+    return true;
+}
+
+bool TaskPool::startDedicated(const std::vector<int>& cpus)
+{
+    if (!m_workers.empty())
+    {
+        yError() << "[TaskPool::startDedicated] The pool is already started.";
+        return false;
+    }
+
+    if (cpus.size() > m_tasks.size())
+        yWarning() << "[TaskPool::startDedicated] The pool has" << m_tasks.size()
+                   << "tasks, only the first CPUs are used.";
+
+    std::uint64_t numberOfCycles;
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_isClosing = false;
+        m_isDedicated = true;
+        m_nextTask = m_tasks.size();
+        m_completedTasks = m_tasks.size();
+        numberOfCycles = m_numberOfCycles;
+    }
+
+    for (std::size_t i = 0; i < m_tasks.size(); i++)
+    {
+        m_workers.emplace_back(&TaskPool::dedicatedWorkerLoop, this, i, numberOfCycles);
+        if (i < cpus.size() && !pinWorker(m_workers.back(), cpus[i]))
+        {
+            close();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool TaskPool::pinWorker(std::thread& worker, int cpu)
+{
+    if (cpu < 0)
+        return true;
+
+#ifdef __linux__
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(cpu, &cpuSet);
+    int error = pthread_setaffinity_np(worker.native_handle(), sizeof(cpu_set_t), &cpuSet);
+    if (error != 0)
+    {
+        yError() << "[TaskPool::pinWorker] Unable to pin the worker to the CPU" << cpu << ":"
+                 << std::strerror(error);
+        return false;
+    }
+#else
+    yWarning() << "[TaskPool::pinWorker] The CPU affinity is supported only on Linux. It will be "
+                  "ignored.";
+#endif
+    return true;
+}
+
+void TaskPool::completeTask(bool isSucceeded)
+{
+    m_isFailed = m_isFailed || !isSucceeded;
+    if (++m_completedTasks == m_tasks.size())
+        m_cycleCompleted.notify_all();
+}
+
+void TaskPool::executeNextTask(std::unique_lock<std::mutex>& lock)
+{
+    const Task& task = m_tasks[m_nextTask++];
+
+    lock.unlock();
+    const bool isSucceeded = task();
+    lock.lock();
+
+    completeTask(isSucceeded);
+}
+
+void TaskPool::workerLoop()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_cycleStarted.wait(lock, [this] { return m_isClosing || m_nextTask < m_tasks.size(); });
+        if (m_isClosing)
+            return;
+
+        while (m_nextTask < m_tasks.size())
+            executeNextTask(lock);
+    }
+}
+
+void TaskPool::dedicatedWorkerLoop(std::size_t task, std::uint64_t numberOfCycles)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_cycleStarted.wait(lock,
+                            [&] { return m_isClosing || m_numberOfCycles != numberOfCycles; });
+        if (m_isClosing)
+            return;
+        numberOfCycles = m_numberOfCycles;
+
+        lock.unlock();
+        const bool isSucceeded = m_tasks[task]();
+        lock.lock();
+
+        completeTask(isSucceeded);
+    }
+}
+
+bool TaskPool::run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_completedTasks = 0;
+    m_isFailed = false;
+    m_numberOfCycles++;
+
+    if (m_isDedicated)
+    {
+        // each task is executed by its own worker
+        m_cycleStarted.notify_all();
+    } else
+    {
+        m_nextTask = 0;
+        if (!m_workers.empty())
+            m_cycleStarted.notify_all();
+
+        while (m_nextTask < m_tasks.size())
+            executeNextTask(lock);
+    }
+
+    // barrier: wait for the tasks executed by the workers
+    m_cycleCompleted.wait(lock, [this] { return m_completedTasks == m_tasks.size(); });
+    return !m_isFailed;
+}
+
+void TaskPool::close()
+{
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_isClosing = true;
+    }
+    m_cycleStarted.notify_all();
+
+    for (std::thread& worker : m_workers)
+        worker.join();
+    m_workers.clear();
+
+    // without workers the tasks are executed in the calling thread
+    m_isDedicated = false;
+}
@@ -0,0 +1,141 @@
+/**
+ * @file TransformSnapshot.cpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+// std
+#include <algorithm>
+
+// YARP
+#include <yarp/os/LogStream.h>
+
+#include <TransformSnapshot.hpp>
+
+constexpr std::size_t TransformSnapshot::maxFrames;
+
+TransformSnapshot::TransformSnapshot()
+{
+    m_buffer.resize(4, 4);
+    m_buffer.eye();
+    for (Frame& frame : m_frames)
+    {
+        frame.root_T_frame.resize(4, 4);
+        frame.root_T_frame.eye();
+    }
+}
+
+bool TransformSnapshot::configure(const std::string& rootFrameName, const double& timeout)
+{
+    if (rootFrameName.empty())
+    {
+        yError() << "[TransformSnapshot::configure] The name of the root frame is empty.";
+        return false;
+    }
+
+    m_rootFrameName = rootFrameName;
+    m_timeout = timeout;
+    m_isRootResolved = false;
+    m_numberOfFrames = 0;
+    return true;
+}
+
+bool TransformSnapshot::addFrame(const std::string& frameName, std::size_t& index)
+{
+    if (m_numberOfFrames >= maxFrames)
+    {
+        yError() << "[TransformSnapshot::addFrame] Unable to add the frame" << frameName
+                 << ". The snapshot contains at most" << maxFrames << "frames.";
+        return false;
+    }
+
+    index = m_numberOfFrames++;
+    Frame& frame = m_frames[index];
+    frame.name = frameName;
+    frame.root_T_frame.eye();
+    frame.timestamp = -1;
+    frame.isResolved = false;
+    frame.isValid = false;
+    frame.isStale = false;
+    return true;
+}
+
+bool TransformSnapshot::update(yarp::dev::IFrameTransform& frameTransform, const double& time)
+{
+    if (!m_isRootResolved)
+        m_isRootResolved = frameTransform.frameExists(m_rootFrameName);
+
+    if (!m_isRootResolved)
+    {
+        for (std::size_t i = 0; i < m_numberOfFrames; i++)
+            m_frames[i].isValid = false;
+        return false;
+    }
+
+    bool isAnyFrameValid = false;
+    for (std::size_t i = 0; i < m_numberOfFrames; i++)
+    {
+        Frame& frame = m_frames[i];
+
+        if (!frame.isResolved)
+            frame.isResolved = frameTransform.frameExists(frame.name);
+
+        frame.isValid = frame.isResolved
+                        && frameTransform.getTransform(frame.name, m_rootFrameName, m_buffer)
+                        && m_buffer.rows() == 4 && m_buffer.cols() == 4;
+        if (!frame.isValid)
+        {
+            // the frame (or the root) may have been removed from the tree
+            frame.isResolved = false;
+            continue;
+        }
+        isAnyFrameValid = true;
+
+        if (frame.timestamp < 0
+            || !std::equal(m_buffer.data(), m_buffer.data() + 16, frame.root_T_frame.data()))
+        {
+            std::copy(m_buffer.data(), m_buffer.data() + 16, frame.root_T_frame.data());
+            frame.timestamp = time;
+        }
+
+        const bool isStale = m_timeout > 0 && time - frame.timestamp > m_timeout;
+        if (isStale && !frame.isStale)
+            yWarning() << "[TransformSnapshot::update] The transformation of the frame"
+                       << frame.name << "did not change in the last" << time - frame.timestamp
+                       << "seconds.";
+        frame.isStale = isStale;
+    }
+
+    // if no frame is found the root may have been removed from the tree
+    if (m_numberOfFrames > 0 && !isAnyFrameValid)
+        m_isRootResolved = false;
+
+    return true;
+}
+
+bool TransformSnapshot::isValid(const std::size_t& index) const
+{
+    return index < m_numberOfFrames && m_frames[index].isValid;
+}
+
+bool TransformSnapshot::isStale(const std::size_t& index) const
+{
+    return index < m_numberOfFrames && m_frames[index].isStale;
+}
+
+double TransformSnapshot::timestamp(const std::size_t& index) const
+{
+    return m_frames[index].timestamp;
+}
+
+const yarp::sig::Matrix& TransformSnapshot::transform(const std::size_t& index) const
+{
+    return m_frames[index].root_T_frame;
+}
+
+const std::string& TransformSnapshot::frameName(const std::size_t& index) const
+{
+    return m_frames[index].name;
+}
@@ -268,6 +268,37 @@ double Angles::shortestAngularDistance(const double& fromRad, const double& toRa
     return normalizeAngle(toRad - fromRad);
 }
 
+void Angles::normalizeAngles(Eigen::Ref<Eigen::VectorXd> angles)
+{
+    // a + 2pi * floor((pi - a) / 2pi) belongs to (-pi, pi]. floor is vectorized by Eigen so
+    // the whole vector is wrapped without branches
+    constexpr double twoPi = 2.0 * M_PI;
+    angles.array() += twoPi * ((M_PI - angles.array()) * (1.0 / twoPi)).floor();
+}
+
+void Angles::normalizeAngles(double* angles, const std::size_t& size)
+{
+    normalizeAngles(Eigen::Map<Eigen::VectorXd>(angles, size));
+}
+
+void Angles::shortestAngularDistances(const Eigen::Ref<const Eigen::VectorXd>& fromRad,
+                                      const Eigen::Ref<const Eigen::VectorXd>& toRad,
+                                      Eigen::Ref<Eigen::VectorXd> distances)
+{
+    distances = toRad - fromRad;
+    normalizeAngles(distances);
+}
+
+void Angles::shortestAngularDistances(const double* fromRad,
+                                      const double* toRad,
+                                      double* distances,
+                                      const std::size_t& size)
+{
+    shortestAngularDistances(Eigen::Map<const Eigen::VectorXd>(fromRad, size),
+                             Eigen::Map<const Eigen::VectorXd>(toRad, size),
+                             Eigen::Map<Eigen::VectorXd>(distances, size));
+}
+
 bool YarpHelper::getIntFromSearchable(const yarp::os::Searchable& config,
                                       const std::string& key,
                                       int& number)
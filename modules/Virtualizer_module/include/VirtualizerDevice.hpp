@@ -0,0 +1,135 @@
+/**
+ * @file VirtualizerDevice.hpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ *          Mohamed Babiker Mohamed Elobaid <mohamed.elobaid@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+#ifndef RETARGETING_VIRTUALIZER_DEVICE_HPP
+#define RETARGETING_VIRTUALIZER_DEVICE_HPP
+
+// YARP
+#include <yarp/os/Searchable.h>
+
+#include <FakeDevices.hpp>
+
+namespace CybSDK
+{
+class VirtDevice;
+} // namespace CybSDK
+
+/**
+ * Interface of the Cyberith virtualizer used by the VirtualizerModule.
+ */
+class VirtualizerDevice
+{
+public:
+    virtual ~VirtualizerDevice() = default;
+
+    /**
+     * Establish the connection with the virtualizer.
+     * @return true in case of success and false otherwise.
+     */
+    virtual bool open() = 0;
+
+    /**
+     * Set the current orientation of the player as the zero orientation.
+     */
+    virtual void resetPlayerOrientation() = 0;
+
+    /**
+     * Set the current height of the player as the zero height.
+     */
+    virtual void resetPlayerHeight() = 0;
+
+    /**
+     * Get the orientation of the player.
+     * @return the orientation, a number from 0 to 1 (positive clockwise).
+     */
+    virtual double getPlayerOrientation() = 0;
+
+    /**
+     * Get the height of the player relative to the zero height.
+     * @return the height in centimeters (positive upward).
+     */
+    virtual double getPlayerHeight() = 0;
+
+    /**
+     * Get the movement speed of the player.
+     * @return the speed.
+     */
+    virtual double getMovementSpeed() = 0;
+
+    /**
+     * Get the movement direction of the player.
+     * @return 0 if the player is walking forward and -1 if backward.
+     */
+    virtual double getMovementDirection() = 0;
+};
+
+/**
+ * Virtualizer accessed through the Cyberith SDK.
+ */
+class CybVirtualizerDevice : public VirtualizerDevice
+{
+    CybSDK::VirtDevice* m_device{nullptr}; /**< Virtualizer device. */
+
+public:
+    ~CybVirtualizerDevice() override;
+
+    bool open() override;
+    void resetPlayerOrientation() override;
+    void resetPlayerHeight() override;
+    double getPlayerOrientation() override;
+    double getPlayerHeight() override;
+    double getMovementSpeed() override;
+    double getMovementDirection() override;
+};
+
+/**
+ * In-process virtualizer used when the fake devices are enabled. The orientation, the height and
+ * the speed of the player are sinusoids (see FakeSignal) and the player walks forward.
+ *
+ * The following parameters are read from the FAKE_DEVICES group:
+ * - virtualizer_orientation_offset, virtualizer_orientation_amplitude, ...: parameters of the
+ *   orientation, a number from 0 to 1 (default offset 0.0 and amplitude 0.05);
+ * - virtualizer_height_offset, virtualizer_height_amplitude, ...: parameters of the height in
+ *   centimeters (default offset 0.0 and amplitude 2.0);
+ * - virtualizer_speed_offset, virtualizer_speed_amplitude, ...: parameters of the speed, it is
+ *   saturated to zero (default offset 0.5 and amplitude 0.5);
+ * - seed: seed of the random number generator (default 0).
+ */
+class FakeVirtualizerDevice : public VirtualizerDevice
+{
+    double m_startTime{0.0}; /**< Time at which the device has been opened. */
+    double m_zeroOrientation{0.0}; /**< Orientation set as zero. */
+    double m_zeroHeight{0.0}; /**< Height set as zero. */
+    FakeSignal m_orientation; /**< Signal of the orientation. */
+    FakeSignal m_height; /**< Signal of the height. */
+    FakeSignal m_speed; /**< Signal of the speed. */
+
+    /**
+     * Get the time elapsed from the opening of the device.
+     * @return the time in seconds.
+     */
+    double time() const;
+
+public:
+    /**
+     * Constructor.
+     * @param config the FAKE_DEVICES group.
+     */
+    explicit FakeVirtualizerDevice(const yarp::os::Searchable& config);
+
+    bool open() override;
+    void resetPlayerOrientation() override;
+    void resetPlayerHeight() override;
+    double getPlayerOrientation() override;
+    double getPlayerHeight() override;
+    double getMovementSpeed() override;
+    double getMovementDirection() override;
+};
+
+#endif
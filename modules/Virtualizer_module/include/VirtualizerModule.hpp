@@ -10,9 +10,9 @@
 #ifndef RETARGETING_VIRTUALIZER_MODULE_HPP
 #define RETARGETING_VIRTUALIZER_MODULE_HPP
 
-#include <mutex>
-
 #include <deque>
+#include <memory>
+#include <mutex>
 
 // YARP
 #include <yarp/os/Bottle.h>
@@ -25,8 +25,8 @@
 #include <yarp/dev/IControlMode.h>
 #include <yarp/dev/IFrameTransform.h>
 
-#include <CVirt.h>
-#include <CVirtDevice.h>
+#include "VirtualizerDevice.hpp"
+#include <GoalChannel.hpp>
 
 #include <thrift/VirtualizerCommands.h>
 
@@ -47,7 +47,7 @@ private:
     yarp::os::Port
         m_rpcServerPort; /**< Port used to send command to the virtualizer application. */
 
-    yarp::os::BufferedPort<yarp::sig::Vector> m_robotGoalPort; /**< Port used to specify the desired goal position. */
+    GoalChannel::Publisher m_robotGoalPort; /**< Port used to specify the desired goal position. */
 
     yarp::os::BufferedPort<yarp::sig::Vector> m_playerOrientationPort; /**< Used to send the player
                                                                           orientation [-pi +pi]. */
@@ -55,7 +55,7 @@ private:
                                                                          orientation. */
 
     std::mutex m_mutex; /**< Internal mutex. */
-    CybSDK::VirtDevice* m_cvirtDeviceID = nullptr; /**< Virtualizer device. */
+    std::unique_ptr<VirtualizerDevice> m_virtualizerDevice; /**< Virtualizer device. */
 
     bool m_useRingVelocity;  /**< Flag to use the ring velocity instead of the position error. */
     unsigned int m_movingAverageWindowSize; /**< Window size for the moving average that filters the ring velocity. */
@@ -97,10 +97,12 @@ private:
     yarp::sig::Matrix m_tfMatrix; /**< Buffer to publish the transform. */
 
     /**
-     * Establish the connection with the virtualizer.
+     * Establish the connection with the virtualizer (or open the fake virtualizer if the fake
+     * devices are enabled).
+     * @param config configuration object.
      * @return true in case of success and false otherwise.
      */
-    bool configureVirtualizer();
+    bool configureVirtualizer(const yarp::os::Searchable& config);
 
     /**
      * @brief Configure the parameters relative to the ring velocity estimation
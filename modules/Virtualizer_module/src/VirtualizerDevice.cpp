@@ -0,0 +1,133 @@
+/**
+ * @file VirtualizerDevice.cpp
+ * @authors Giulio Romualdi <giulio.romualdi@iit.it>
+ *          Mohamed Babiker Mohamed Elobaid <mohamed.elobaid@iit.it>
+ * @copyright 2018 iCub Facility - Istituto Italiano di Tecnologia
+ *            Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ * @date 2018
+ */
+
+// std
+#include <algorithm>
+#include <cmath>
+
+// YARP
+#include <yarp/os/LogStream.h>
+#include <yarp/os/Time.h>
+
+// Cyberith SDK
+#include <CVirt.h>
+#include <CVirtDevice.h>
+
+#include "VirtualizerDevice.hpp"
+
+CybVirtualizerDevice::~CybVirtualizerDevice()
+{
+    delete m_device;
+}
+
+bool CybVirtualizerDevice::open()
+{
+    // try to connect to the virtualizer
+    int maxAttempt = 5;
+    for (int i = 0; i < maxAttempt; i++)
+    {
+        m_device = CybSDK::Virt::FindDevice();
+        if (m_device != nullptr)
+        {
+            if (!m_device->Open())
+            {
+                yError() << "[CybVirtualizerDevice::open] Unable to open the device";
+                return false;
+            }
+
+            return true;
+        }
+        // wait one millisecond
+        yarp::os::Time::delay(0.001);
+    }
+
+    yError() << "[CybVirtualizerDevice::open] Unable to find the virtualizer";
+    return false;
+}
+
+void CybVirtualizerDevice::resetPlayerOrientation()
+{
+    m_device->ResetPlayerOrientation();
+}
+
+void CybVirtualizerDevice::resetPlayerHeight()
+{
+    m_device->ResetPlayerHeight();
+}
+
+double CybVirtualizerDevice::getPlayerOrientation()
+{
+    return m_device->GetPlayerOrientation();
+}
+
+double CybVirtualizerDevice::getPlayerHeight()
+{
+    return m_device->GetPlayerHeight();
+}
+
+double CybVirtualizerDevice::getMovementSpeed()
+{
+    return m_device->GetMovementSpeed();
+}
+
+double CybVirtualizerDevice::getMovementDirection()
+{
+    return m_device->GetMovementDirection();
+}
+
+FakeVirtualizerDevice::FakeVirtualizerDevice(const yarp::os::Searchable& config)
+{
+    m_orientation.configure(config, "virtualizer_orientation", 0.0, 0.05);
+    m_height.configure(config, "virtualizer_height", 0.0, 2.0);
+    m_speed.configure(config, "virtualizer_speed", 0.5, 0.5);
+}
+
+double FakeVirtualizerDevice::time() const
+{
+    return yarp::os::Time::now() - m_startTime;
+}
+
+bool FakeVirtualizerDevice::open()
+{
+    m_startTime = yarp::os::Time::now();
+    yWarning() << "[FakeVirtualizerDevice::open] Using the fake virtualizer.";
+    return true;
+}
+
+void FakeVirtualizerDevice::resetPlayerOrientation()
+{
+    m_zeroOrientation = m_orientation(time(), 0);
+}
+
+void FakeVirtualizerDevice::resetPlayerHeight()
+{
+    m_zeroHeight = m_height(time(), 0);
+}
+
+double FakeVirtualizerDevice::getPlayerOrientation()
+{
+    // the orientation of the virtualizer is a number from 0 to 1
+    const double orientation = m_orientation(time(), 0) - m_zeroOrientation;
+    return orientation - std::floor(orientation);
+}
+
+double FakeVirtualizerDevice::getPlayerHeight()
+{
+    return m_height(time(), 0) - m_zeroHeight;
+}
+
+double FakeVirtualizerDevice::getMovementSpeed()
+{
+    return std::max(0.0, m_speed(time(), 0));
+}
+
+double FakeVirtualizerDevice::getMovementDirection()
+{
+    return 0.0;
+}
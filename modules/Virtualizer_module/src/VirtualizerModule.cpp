@@ -16,84 +16,168 @@
 #include <yarp/os/Property.h>
 #include <yarp/dev/IAxisInfo.h>
 
+#include "ConfigSchema.hpp"
+#include "FakeDevices.hpp"
 #include "Utils.hpp"
 #include "VirtualizerModule.hpp"
 
 #include <Eigen/Core>
 #include <Eigen/Geometry>
 
-bool VirtualizerModule::configureVirtualizer()
+namespace
 {
-    // try to connect to the virtualizer
-    int maxAttempt = 5;
-    for (int i = 0; i < maxAttempt; i++)
-    {
-        m_cvirtDeviceID = CybSDK::Virt::FindDevice();
-        if (m_cvirtDeviceID != nullptr)
-        {
-            if (!m_cvirtDeviceID->Open())
-            {
-                yError() << "[configureVirtualizer] Unable to open the device";
-                return false;
-            }
-
-            return true;
-        }
-        // wait one millisecond
-        yarp::os::Time::delay(0.001);
-    }
+/**
+ * Parameters of the virtualizer module.
+ */
+struct VirtualizerParameters
+{
+    double period;
+    std::string name;
+    double scaleX;
+    double scaleY;
+    double angleDeadzone;
+    double speedDeadzone;
+    std::string playerOrientationPortName;
+    std::string robotOrientationPortName;
+    std::string goalWalkingPortName;
+    bool useRingVelocity;
+    bool useHeadForTurning;
+    bool useTransformServer;
+
+    template <typename Visitor> void visit(Visitor& v)
+    {
+        v("period", period, 0.1);
+        v("name", name);
+        v("scale_X", scaleX);
+        v("scale_Y", scaleY);
+        v("angle_deadzone", angleDeadzone);
+        v("speed_deadzone", speedDeadzone);
+        v("playerOrientationPort_name", playerOrientationPortName);
+        v("robotOrientationPort_name", robotOrientationPortName);
+        v("goalWalkingPort_name", goalWalkingPortName);
+        v("y_use_ring_velocity", useRingVelocity, false);
+        v("use_head_for_turning", useHeadForTurning, false);
+        v("use_transform_server", useTransformServer, false);
+    }
+};
 
-    yError() << "[configureVirtualizer] I'm not able to configure the virtualizer";
-    return false;
-}
+/**
+ * Parameters of the ring velocity (RING_VELOCITY group).
+ */
+struct RingVelocityParameters
+{
+    unsigned int movingAverageWindow;
+    double velocityDeadzone;
+    double velocityScaling;
+    double angleThresholdStill;
+    double angleThresholdMoving;
+    double timeThresholdMoving;
+    bool useSignOnly;
+    double jammedMovingTime;
+    double jammedMovingRobotAngle;
+
+    template <typename Visitor> void visit(Visitor& v)
+    {
+        v("moving_average_window", movingAverageWindow);
+        v("velocity_deadzone", velocityDeadzone);
+        v("velocity_scaling", velocityScaling);
+        v("angle_threshold_still_rad", angleThresholdStill);
+        v("angle_threshold_moving_rad", angleThresholdMoving);
+        v("time_threshold_moving_s", timeThresholdMoving);
+        v("use_sign_only", useSignOnly);
+        v("jammed_moving_time_s", jammedMovingTime);
+        v("jammed_moving_robot_angle_rad", jammedMovingRobotAngle);
+    }
+};
 
-bool VirtualizerModule::configureRingVelocity(const yarp::os::Bottle &ringVelocityGroup)
+/**
+ * Parameters of the transform server (TF group).
+ */
+struct TransformServerParameters
 {
-    if (ringVelocityGroup.isNull())
-    {
-        yError() << "y_use_ring_velocity is set to true but the RING_VELOCITY group is empty.";
-        return false;
-    }
+    std::string remote;
+    std::string rootFrameName;
+    std::string frameName;
 
-    if (!YarpHelper::getUnsignedIntFromSearchable(ringVelocityGroup, "moving_average_window", m_movingAverageWindowSize))
+    template <typename Visitor> void visit(Visitor& v)
     {
-        yError() << "Failed to read moving_average_window";
-        return false;
+        v("remote", remote);
+        v("root_frame_name", rootFrameName);
+        v("frame_name", frameName);
     }
+};
 
-    m_movingAverage.clear();
-    m_movingAverage.resize(m_movingAverageWindowSize, 0.0);
+/**
+ * Parameters of the head control (HEAD_CONTROL group).
+ */
+struct HeadControlParameters
+{
+    std::string robot;
+    std::string remoteControlBoard;
+    std::string neckYawName;
+    bool yawAxisPointsUp;
+    double neckYawScaling;
+    double neckYawDeadzone;
+    bool useOnlyHeadToTurn;
 
-    if (!YarpHelper::getDoubleFromSearchable(ringVelocityGroup, "velocity_deadzone", m_velocityDeadzone))
+    template <typename Visitor> void visit(Visitor& v)
     {
-        yError() << "Failed to read velocity_deadzone";
-        return false;
+        v("robot", robot);
+        v("remote_control_board", remoteControlBoard);
+        v("neck_yaw_name", neckYawName);
+        v("yaw_axis_points_up", yawAxisPointsUp);
+        v("neck_yaw_scaling", neckYawScaling);
+        v("neck_yaw_deadzone", neckYawDeadzone);
+        v("use_only_head_to_turn", useOnlyHeadToTurn);
     }
+};
+} // namespace
 
-    if (!YarpHelper::getDoubleFromSearchable(ringVelocityGroup, "velocity_scaling", m_velocityScaling))
+bool VirtualizerModule::configureVirtualizer(const yarp::os::Searchable& config)
+{
+    if (FakeDevices::isEnabled())
     {
-        yError() << "Failed to read velocity_scaling";
-        return false;
+        const yarp::os::Bottle& fakeDevicesOptions = config.findGroup("FAKE_DEVICES");
+        m_virtualizerDevice = std::make_unique<FakeVirtualizerDevice>(fakeDevicesOptions);
+    } else
+    {
+        m_virtualizerDevice = std::make_unique<CybVirtualizerDevice>();
     }
 
-    if (!YarpHelper::getDoubleFromSearchable(ringVelocityGroup, "angle_threshold_still_rad", m_angleThresholdOperatorStill))
+    if (!m_virtualizerDevice->open())
     {
-        yError() << "Failed to read angle_threshold_still_rad";
+        yError() << "[configureVirtualizer] I'm not able to configure the virtualizer";
         return false;
     }
 
-    if (!YarpHelper::getDoubleFromSearchable(ringVelocityGroup, "angle_threshold_moving_rad", m_angleThresholdOperatorMoving))
+    return true;
+}
+
+bool VirtualizerModule::configureRingVelocity(const yarp::os::Bottle &ringVelocityGroup)
+{
+    if (ringVelocityGroup.isNull())
     {
-        yError() << "Failed to read angle_threshold_moving_rad";
+        yError() << "y_use_ring_velocity is set to true but the RING_VELOCITY group is empty.";
         return false;
     }
 
-    if (!YarpHelper::getDoubleFromSearchable(ringVelocityGroup, "time_threshold_moving_s", m_operatorStillTimeThreshold))
+    RingVelocityParameters parameters;
+    if (!YarpHelper::parseParameters(ringVelocityGroup, parameters, "[configureRingVelocity]"))
     {
-        yError() << "Failed to read time_threshold_moving_s";
+        yError() << "Failed to read the RING_VELOCITY group";
         return false;
     }
 
+    m_movingAverageWindowSize = parameters.movingAverageWindow;
+    m_movingAverage.clear();
+    m_movingAverage.resize(m_movingAverageWindowSize, 0.0);
+
+    m_velocityDeadzone = parameters.velocityDeadzone;
+    m_velocityScaling = parameters.velocityScaling;
+    m_angleThresholdOperatorStill = parameters.angleThresholdStill;
+    m_angleThresholdOperatorMoving = parameters.angleThresholdMoving;
+    m_operatorStillTimeThreshold = parameters.timeThresholdMoving;
+
     m_operatorCurrentStillAngle = 0.0;
     m_operatorStillTime = -1.0;
     m_operatorMoving = true;
@@ -110,23 +194,9 @@ bool VirtualizerModule::configureRingVelocity(const yarp::os::Bottle &ringVeloci
         return false;
     }
 
-    if (!YarpHelper::getBooleanFromSearchable(ringVelocityGroup, "use_sign_only", m_useVelocitySignOnly))
-    {
-        yError() << "Failed to read use_sign_only";
-        return false;
-    }
-
-    if (!YarpHelper::getDoubleFromSearchable(ringVelocityGroup, "jammed_moving_time_s", m_jammedMovingTime))
-    {
-        yError() << "Failed to read jammed_moving_time_s";
-        return false;
-    }
-
-    if (!YarpHelper::getDoubleFromSearchable(ringVelocityGroup, "jammed_moving_robot_angle_rad", m_jammedMovingRobotAngle))
-    {
-        yError() << "Failed to read jammed_moving_robot_angle_rad";
-        return false;
-    }
+    m_useVelocitySignOnly = parameters.useSignOnly;
+    m_jammedMovingTime = parameters.jammedMovingTime;
+    m_jammedMovingRobotAngle = parameters.jammedMovingRobotAngle;
 
     if (m_jammedMovingTime > 0 && m_jammedMovingRobotAngle > 0)
     {
@@ -146,30 +216,22 @@ bool VirtualizerModule::configureRingVelocity(const yarp::os::Bottle &ringVeloci
 
 bool VirtualizerModule::configureTransformServer(const yarp::os::Bottle &tfGroup)
 {
-    std::string tfRemote;
-    if (!YarpHelper::getStringFromSearchable(tfGroup, "remote", tfRemote))
-    {
-        yError() << "Failed while reading tf_remote parameter.";
-        return false;
-    }
-
-    if (!YarpHelper::getStringFromSearchable(tfGroup, "root_frame_name", m_tfRootFrame))
-    {
-        yError() << "Failed while reading root_frame_name parameter.";
-        return false;
-    }
-
-    if (!YarpHelper::getStringFromSearchable(tfGroup, "frame_name", m_tfFrameName))
+    TransformServerParameters parameters;
+    if (!YarpHelper::parseParameters(tfGroup, parameters, "[configureTransformServer]"))
     {
-        yError() << "Failed while reading frame_name parameter.";
+        yError() << "Failed while reading the TF group.";
         return false;
     }
+    const std::string& tfRemote = parameters.remote;
+    m_tfRootFrame = parameters.rootFrameName;
+    m_tfFrameName = parameters.frameName;
 
     //opening tf client
     yarp::os::Property tfClientCfg;
     tfClientCfg.put("device", "transformClient");
     tfClientCfg.put("local",  "/" + getName() + "/tf");
     tfClientCfg.put("remote", tfRemote);
+    FakeDevices::replaceDevice(tfClientCfg);
 
     if (!m_tfDriver.open(tfClientCfg))
     {
@@ -197,55 +259,25 @@ bool VirtualizerModule::configureHeadControl(const yarp::os::Bottle &headControl
         return false;
     }
 
-    std::string robot;
-    if (!YarpHelper::getStringFromSearchable(headControlGroup, "robot", robot))
-    {
-        yError() << "Failed while reading robot parameter.";
-        return false;
-    }
-
-    std::string remoteControlBoard;
-    if (!YarpHelper::getStringFromSearchable(headControlGroup, "remote_control_board", remoteControlBoard))
-    {
-        yError() << "Failed while reading remote_control_board parameter.";
-        return false;
-    }
-
-    std::string neckYawName;
-    if (!YarpHelper::getStringFromSearchable(headControlGroup, "neck_yaw_name", neckYawName))
-    {
-        yError() << "Failed while reading neck_yaw_name parameter.";
-        return false;
-    }
-
-    if (!YarpHelper::getBooleanFromSearchable(headControlGroup, "yaw_axis_points_up", m_yawAxisPointsUp))
-    {
-        yError() << "Failed while reading yaw_axis_points_up parameter.";
-        return false;
-    }
-
-    if (!YarpHelper::getDoubleFromSearchable(headControlGroup, "neck_yaw_scaling", m_neckYawScaling))
-    {
-        yError() << "Failed to read neck_yaw_scaling";
-        return false;
-    }
-
-    if (!YarpHelper::getDoubleFromSearchable(headControlGroup, "neck_yaw_deadzone", m_neckYawDeadzone))
-    {
-        yError() << "Failed to read neck_yaw_deadzone";
-        return false;
-    }
-
-    if (!YarpHelper::getBooleanFromSearchable(headControlGroup, "use_only_head_to_turn", m_useOnlyHeadForTurning))
+    HeadControlParameters parameters;
+    if (!YarpHelper::parseParameters(headControlGroup, parameters, "[configureHeadControl]"))
     {
-        yError() << "Failed while reading yaw_axis_points_up parameter.";
+        yError() << "Failed while reading the HEAD_CONTROL group.";
         return false;
     }
+    const std::string& robot = parameters.robot;
+    const std::string& remoteControlBoard = parameters.remoteControlBoard;
+    const std::string& neckYawName = parameters.neckYawName;
+    m_yawAxisPointsUp = parameters.yawAxisPointsUp;
+    m_neckYawScaling = parameters.neckYawScaling;
+    m_neckYawDeadzone = parameters.neckYawDeadzone;
+    m_useOnlyHeadForTurning = parameters.useOnlyHeadToTurn;
 
     yarp::os::Property options;
     options.put("device", "remote_controlboard");
     options.put("local", "/" + getName() + "/neckControlBoard");
     options.put("remote", "/" + robot + "/" + remoteControlBoard);
+    FakeDevices::replaceDevice(options);
 
     if (!m_headDevice.open(options))
     {
@@ -317,74 +349,49 @@ bool VirtualizerModule::configure(yarp::os::ResourceFinder& rf)
         return false;
     }
 
+    VirtualizerParameters parameters;
+    if (!YarpHelper::parseParameters(rf, parameters, "[configure]"))
+    {
+        yError() << "[configure] Unable to parse the virtualizer parameters";
+        return false;
+    }
+
     // get the period
-    m_dT = rf.check("period", yarp::os::Value(0.1)).asFloat64();
+    m_dT = parameters.period;
 
     // set the module name
-    std::string name;
-    if (!YarpHelper::getStringFromSearchable(rf, "name", name))
+    setName(parameters.name.c_str());
+
+    if (!FakeDevices::configure(rf))
     {
-        yError() << "[configure] Unable to get a string from a searchable";
+        yError() << "[configure] Unable to configure the fake devices";
         return false;
     }
-    setName(name.c_str());
 
     // set scales for walking
-    if (!YarpHelper::getDoubleFromSearchable(rf, "scale_X", m_scale_X))
-    {
-        yError() << "[configure] Unable to get scale_X from a searchable";
-        return false;
-    }
-    if (!YarpHelper::getDoubleFromSearchable(rf, "scale_Y", m_scale_Y))
-    {
-        yError() << "[configure] Unable to get scale_Y from a searchable";
-        return false;
-    }
+    m_scale_X = parameters.scaleX;
+    m_scale_Y = parameters.scaleY;
 
     // set deadzone
-    if (!YarpHelper::getDoubleFromSearchable(rf, "angle_deadzone", m_angleDeadzone))
-    {
-        yError() << "[configure] Unable to get a double from a searchable";
-        return false;
-    }
-
-    if (!YarpHelper::getDoubleFromSearchable(rf, "speed_deadzone", m_speedDeadzone))
-    {
-        yError() << "Failed to read speed_deadzone";
-        return false;
-    }
+    m_angleDeadzone = parameters.angleDeadzone;
+    m_speedDeadzone = parameters.speedDeadzone;
 
     // open ports
-    std::string portName;
-    if (!YarpHelper::getStringFromSearchable(rf, "playerOrientationPort_name", portName))
-    {
-        yError() << "[configure] Unable to get a string from a searchable";
-        return false;
-    }
-
+    std::string portName = parameters.playerOrientationPortName;
     if (!m_playerOrientationPort.open("/" + getName() + portName))
     {
         yError() << "[configure] " << portName << " port already open.";
         return false;
     }
 
-    if (!YarpHelper::getStringFromSearchable(rf, "robotOrientationPort_name", portName))
-    {
-        yError() << "[configure] Unable to get a string from a searchable";
-        return false;
-    }
-
+    portName = parameters.robotOrientationPortName;
     if (!m_robotOrientationPort.open("/" + getName() + portName))
     {
         yError() << "[configure] " << portName << " port already open.";
         return false;
     }
 
-    if (!YarpHelper::getStringFromSearchable(rf, "goalWalkingPort_name", portName))
-    {
-        yError() << "[configure] Unable to get a string from a searchable";
-        return false;
-    }
+    portName = parameters.goalWalkingPortName;
     if (!m_robotGoalPort.open("/" + getName() + portName))
     {
         yError() << "[configure] " << portName << " port already open.";
@@ -400,7 +407,7 @@ bool VirtualizerModule::configure(yarp::os::ResourceFinder& rf)
         return false;
     }
 
-    m_useRingVelocity = rf.check("y_use_ring_velocity", yarp::os::Value(false)).asBool();
+    m_useRingVelocity = parameters.useRingVelocity;
 
     if (m_useRingVelocity)
     {
@@ -411,7 +418,7 @@ bool VirtualizerModule::configure(yarp::os::ResourceFinder& rf)
         }
     }
 
-    m_useHeadForTurning = rf.check("use_head_for_turning", yarp::os::Value(false)).asBool();
+    m_useHeadForTurning = parameters.useHeadForTurning;
 
     if (m_useHeadForTurning)
     {
@@ -422,7 +429,7 @@ bool VirtualizerModule::configure(yarp::os::ResourceFinder& rf)
         }
     }
 
-    m_useTf = rf.check("use_transform_server", yarp::os::Value(false)).asBool();
+    m_useTf = parameters.useTransformServer;
     if (m_useTf)
     {
         if (!configureTransformServer(rf.findGroup("TF")))
@@ -432,7 +439,7 @@ bool VirtualizerModule::configure(yarp::os::ResourceFinder& rf)
         }
     }
 
-    if (!configureVirtualizer())
+    if (!configureVirtualizer(rf))
     {
         yError() << "[configure] Unable to configure the virtualizer";
         return false;
@@ -443,13 +450,13 @@ bool VirtualizerModule::configure(yarp::os::ResourceFinder& rf)
     yarp::os::Time::delay(0.5);
 
     // reset player orientation
-    m_cvirtDeviceID->ResetPlayerOrientation();
+    m_virtualizerDevice->resetPlayerOrientation();
 
-    m_cvirtDeviceID->ResetPlayerHeight();
+    m_virtualizerDevice->resetPlayerHeight();
 
     // reset some quanties
     m_robotYaw = 0;
-    m_oldPlayerYaw = (double)(m_cvirtDeviceID->GetPlayerOrientation());
+    m_oldPlayerYaw = (double)(m_virtualizerDevice->getPlayerOrientation());
     m_oldPlayerYaw *= 360.0f;
     m_oldPlayerYaw = m_oldPlayerYaw * M_PI / 180;
     m_oldPlayerYaw = Angles::normalizeAngle(m_oldPlayerYaw);
@@ -471,7 +478,7 @@ bool VirtualizerModule::close()
     m_rpcServerPort.close();
 
     // deallocate memory
-    delete m_cvirtDeviceID;
+    m_virtualizerDevice.reset();
 
     m_headDevice.close();
     m_encodersInterface = nullptr;
@@ -499,14 +506,14 @@ bool VirtualizerModule::updateModule()
 
     //get player height
     float playerHeightInCm;
-    playerHeightInCm = m_cvirtDeviceID->GetPlayerHeight(); //It is relative to the initial height set ResetPlayerHeight, positive upward
+    playerHeightInCm = m_virtualizerDevice->getPlayerHeight(); //It is relative to the initial height set ResetPlayerHeight, positive upward
     double playerHeighInM = playerHeightInCm / 100.0;
 
     // get the player speed
-    double virtualizerSpeedData = (double)(m_cvirtDeviceID->GetMovementSpeed());
+    double virtualizerSpeedData = (double)(m_virtualizerDevice->getMovementSpeed());
     double speedData = threshold(virtualizerSpeedData, m_speedDeadzone);
 
-    double tmpSpeedDirection = (double)(m_cvirtDeviceID->GetMovementDirection());
+    double tmpSpeedDirection = (double)(m_virtualizerDevice->getMovementDirection());
     double speedDirection = 1.0; // set the speed direction to forward by default.
 
     if (std::abs(tmpSpeedDirection) < 0.01) // the "0" value means the user walking forward
@@ -674,20 +681,13 @@ bool VirtualizerModule::updateModule()
     yInfo() << "speed (x,y): " << x << " , " << y;
 
     // send data to the walking module
-    yarp::sig::Vector& goal = m_robotGoalPort.prepare();
-    goal.clear();
-    goal.push_back(x);
-    goal.push_back(y);
-    m_robotGoalPort.write();
+    m_robotGoalPort.publish(x, y);
 
 
     m_oldPlayerYaw = playerYaw;
 
     // send the orientation of the player
-    yarp::sig::Vector& playerOrientationVector = m_playerOrientationPort.prepare();
-    playerOrientationVector.clear();
-    playerOrientationVector.push_back(playerYaw);
-    m_playerOrientationPort.write();
+    YarpHelper::sendVariadicVector(m_playerOrientationPort, playerYaw);
 
     if (m_useTf)
     {
@@ -711,7 +711,7 @@ bool VirtualizerModule::updateModule()
 void VirtualizerModule::resetPlayerOrientation()
 {
     std::lock_guard<std::mutex> guard(m_mutex);
-    m_cvirtDeviceID->ResetPlayerOrientation();
+    m_virtualizerDevice->resetPlayerOrientation();
 
     m_oldPlayerYaw = getPlayerYaw();
 
@@ -723,7 +723,7 @@ void VirtualizerModule::resetPlayerOrientation()
 void VirtualizerModule::resetPlayerHeight()
 {
     std::lock_guard<std::mutex> guard(m_mutex);
-    m_cvirtDeviceID->ResetPlayerHeight();
+    m_virtualizerDevice->resetPlayerHeight();
 }
 
 void VirtualizerModule::forceStillAngle()
@@ -833,7 +833,7 @@ bool VirtualizerModule::updateRobotYaw()
 double VirtualizerModule::getPlayerYaw()
 {
     double playerYaw;
-    playerYaw = (double)(m_cvirtDeviceID->GetPlayerOrientation());
+    playerYaw = (double)(m_virtualizerDevice->getPlayerOrientation());
 
     playerYaw *= 360.0f; //The angle from the virtualizer is a number from 0 to 1
     playerYaw = playerYaw * M_PI / 180;
@@ -12,6 +12,7 @@
 #include <yarp/os/RFModule.h>
 
 #include "VirtualizerModule.hpp"
+#include <PeriodicExecutor.hpp>
 
 int main(int argc, char* argv[])
 {
@@ -33,5 +34,5 @@ int main(int argc, char* argv[])
     // create the producer module
     VirtualizerModule module;
 
-    return module.runModule(rf);
+    return YarpHelper::runModule(module, rf);
 }
@@ -0,0 +1,48 @@
+#ifndef XSENSJOINTMAPPING_H
+#define XSENSJOINTMAPPING_H
+
+// std
+#include <string>
+#include <vector>
+
+// YARP
+#include <yarp/sig/Vector.h>
+
+/**
+ * Mapping between the joints published by the human state provider and the robot joints used by
+ * the controller. The two lists have different orders, so the map is computed once and then used
+ * in every cycle to reorder the joint values.
+ */
+namespace XsensJointMapping
+{
+/**
+ * Map the joint values (order) coming from HDE to the controller order
+ * @param robotJointsListNames list of the joint names used in controller
+ * @param humanJointsListName list of the joint names received from the HDE
+ * (human-dynamics-estimation repository)
+ * @param humanToRobotMap the container for mapping of the human joints to the robot ones
+ * @return true in case of success and false otherwise
+ */
+bool mapJointsHDE2Controller(const std::vector<std::string>& robotJointsListNames,
+                             const std::vector<std::string>& humanJointsListName,
+                             std::vector<unsigned>& humanToRobotMap);
+
+/**
+ * Reorder the human joint values according to the controller joint list. A warning is printed
+ * for each joint whose value changes more than a threshold (spike in the data).
+ * @param humanJointsValues joint values received from the HDE
+ * @param humanToRobotMap mapping of the human joints to the robot ones
+ * @param robotJointsListNames list of the joint names used in controller
+ * @param jointDiffThreshold maximum joint variation between two consecutive values
+ * @param robotJointsValues joint values in the controller order. It is used as previous value
+ * for the spike check and it has to be already resized.
+ * @return the number of joints with a spike
+ */
+unsigned mapJointValues(const std::vector<double>& humanJointsValues,
+                        const std::vector<unsigned>& humanToRobotMap,
+                        const std::vector<std::string>& robotJointsListNames,
+                        double jointDiffThreshold,
+                        yarp::sig::Vector& robotJointsValues);
+} // namespace XsensJointMapping
+
+#endif // XSENSJOINTMAPPING_H
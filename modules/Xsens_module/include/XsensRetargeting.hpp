@@ -24,6 +24,9 @@
 #include <yarp/os/Clock.h>
 // iDynTree
 #include <iDynTree/Core/Transform.h>
+
+#include <InputSession.hpp>
+#include <LockFree.hpp>
 //#include <RetargetingController.hpp>
 
 class mapJoints
@@ -36,9 +39,6 @@ public:
 class XsensRetargeting : public yarp::os::RFModule
 {
 private:
-    /** An implementation class for spepcific functionalities required in this module. */
-    class impl;
-    std::unique_ptr<impl> pImpl;
     /** Minimum jerk trajectory smoother for the desired whole body joints */
     std::unique_ptr<iCub::ctrl::minJerkTrajGen> m_WBTrajectorySmoother{nullptr};
     /** target (robot) joint values (raw amd smoothed values) */
@@ -51,6 +51,14 @@ private:
 
     /** Port used to retrieve the human whole body joint pose. */
     yarp::os::BufferedPort<hde::msgs::HumanState> m_wholeBodyHumanJointsPort;
+    /** Latest human state received by the port thread. */
+    LockFree::PortMailbox<hde::msgs::HumanState> m_wholeBodyHumanJointsMailbox;
+
+    InputSession m_inputSession; /**< Record or replay of the human state. */
+    InputSession::Stream m_humanJointsNamesStream; /**< Joint names of the human state. */
+    InputSession::Stream m_humanJointsPositionsStream; /**< Joint positions of the human state. */
+    InputSession::Stream m_humanCoMStream; /**< CoM position of the human state. */
+    hde::msgs::HumanState m_replayedHumanState; /**< Human state read from the session. */
 
     /** Port used to provide the smoothed joint pose to the controller. */
     yarp::os::BufferedPort<yarp::sig::Vector> m_wholeBodyHumanSmoothedJointsPort;
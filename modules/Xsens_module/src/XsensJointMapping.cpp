@@ -0,0 +1,66 @@
+#include <XsensJointMapping.hpp>
+
+// std
+#include <cmath>
+
+// YARP
+#include <yarp/os/LogStream.h>
+
+bool XsensJointMapping::mapJointsHDE2Controller(
+    const std::vector<std::string>& robotJointsListNames,
+    const std::vector<std::string>& humanJointsListName,
+    std::vector<unsigned>& humanToRobotMap)
+{
+    if (!humanToRobotMap.empty())
+    {
+        humanToRobotMap.clear();
+    }
+
+    bool foundMatch = false;
+    for (unsigned i = 0; i < robotJointsListNames.size(); i++)
+    {
+        for (unsigned j = 0; j < humanJointsListName.size(); j++)
+        {
+
+            if (robotJointsListNames[i] == humanJointsListName[j])
+            {
+                foundMatch = true;
+                humanToRobotMap.push_back(j);
+                break;
+            }
+        }
+        if (!foundMatch)
+        {
+            yError() << "[XsensJointMapping::mapJointsHDE2CONTROLLER] not found match for: "
+                     << robotJointsListNames[i] << " , " << i;
+            return false;
+        }
+        foundMatch = false;
+    }
+
+    return true;
+}
+
+unsigned XsensJointMapping::mapJointValues(const std::vector<double>& humanJointsValues,
+                                           const std::vector<unsigned>& humanToRobotMap,
+                                           const std::vector<std::string>& robotJointsListNames,
+                                           double jointDiffThreshold,
+                                           yarp::sig::Vector& robotJointsValues)
+{
+    unsigned spikes = 0;
+    for (unsigned j = 0; j < humanToRobotMap.size(); j++)
+    {
+        const double newValue = humanJointsValues[humanToRobotMap[j]];
+
+        // check for the spikes in joint values
+        if (std::abs(newValue - robotJointsValues(j)) > jointDiffThreshold)
+        {
+            yWarning() << "spike in data: joint : " << j << " , " << robotJointsListNames[j]
+                       << " ; old data: " << robotJointsValues(j) << " ; new data:" << newValue;
+            spikes++;
+        }
+        robotJointsValues(j) = newValue;
+    }
+
+    return spikes;
+}
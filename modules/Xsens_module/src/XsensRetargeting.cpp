@@ -1,27 +1,45 @@
 //#include "yarp/ HumanState.h"
+#include <ConfigSchema.hpp>
 #include <Utils.hpp>
+#include <XsensJointMapping.hpp>
 #include <XsensRetargeting.hpp>
+#include <array>
 #include <iterator>
 #include <sstream>
 
-class XsensRetargeting::impl
+namespace
 {
-public:
-    /*
-     * map the joint values (order) coming from HDE to the controller order
-     * @param robotJointsListNames list of the joint names used in controller
-     * @param humanJointsListName list of the joint names received from the HDE
-     * (human-dynamics-estimation repository)
-     * @param humanToRobotMap the container for mapping of the human joints to the robot ones
-     * @return true in case of success and false otherwise
-     */
-    bool mapJointsHDE2Controller(std::vector<std::string> robotJointsListNames,
-                                 std::vector<std::string> humanJointsListName,
-                                 std::vector<unsigned>& humanToRobotMap);
+/**
+ * Parameters of the Xsens retargeting.
+ */
+struct XsensRetargetingParameters
+{
+    bool useSmoothing;
+    double samplingTime;
+    std::string name;
+    double smoothingTime;
+    std::vector<std::string> jointsList;
+    std::string wholeBodyJointsPort;
+    std::string controllerJointsPort;
+    std::string controllerCoMPort;
+    double jointDifferenceThreshold;
+
+    template <typename Visitor> void visit(Visitor& v)
+    {
+        v("useSmoothing", useSmoothing, true);
+        v("samplingTime", samplingTime, 0.1);
+        v("name", name);
+        v("smoothingTime", smoothingTime);
+        v("joints_list", jointsList);
+        v("wholeBodyJointsPort", wholeBodyJointsPort);
+        v("controllerJointsPort", controllerJointsPort);
+        v("controllerCoMPort", controllerCoMPort);
+        v("jointDifferenceThreshold", jointDifferenceThreshold);
+    }
 };
+} // namespace
 
-XsensRetargeting::XsensRetargeting()
-    : pImpl{new impl()} {};
+XsensRetargeting::XsensRetargeting(){};
 
 XsensRetargeting::~XsensRetargeting(){};
 
@@ -35,47 +53,38 @@ bool XsensRetargeting::configure(yarp::os::ResourceFinder& rf)
         return false;
     }
 
+    XsensRetargetingParameters parameters;
+    if (!YarpHelper::parseParameters(rf, parameters, "[XsensRetargeting::configure]"))
+    {
+        yError() << "[XsensRetargeting::configure] Unable to parse the retargeting parameters.";
+        return false;
+    }
+
     // check if use the smoothing, otherwise we do not smooth the joint values
-    m_useSmoothing = rf.check("useSmoothing", yarp::os::Value(true)).asBool();
+    m_useSmoothing = parameters.useSmoothing;
 
     yInfo() << "[XsensRetargeting::configure] m_useSmoothing: " << m_useSmoothing;
 
     // get the period
-    m_dT = rf.check("samplingTime", yarp::os::Value(0.1)).asFloat64();
+    m_dT = parameters.samplingTime;
 
     // set the module name
-    std::string name;
-    if (!YarpHelper::getStringFromSearchable(rf, "name", name))
-    {
-        yError() << "[XsensRetargeting::configure] Unable to get a string from a searchable";
-        return false;
-    }
-    setName(name.c_str());
-
-    // initialize minimum jerk trajectory for the whole body
+    setName(parameters.name.c_str());
 
-    double smoothingTime;
-    if (!YarpHelper::getDoubleFromSearchable(rf, "smoothingTime", smoothingTime))
+    if (!m_inputSession.configure(rf, getName()))
     {
-        yError() << "[XsensRetargeting::configure] Unable to find the whole body smoothing time";
+        yError() << "[XsensRetargeting::configure] Unable to configure the input session.";
         return false;
     }
+    m_humanJointsNamesStream = m_inputSession.addStream("human_state/joint_names");
+    m_humanJointsPositionsStream = m_inputSession.addStream("human_state/positions");
+    m_humanCoMStream = m_inputSession.addStream("human_state/CoM");
 
-    yarp::os::Value* axesListYarp;
+    // initialize minimum jerk trajectory for the whole body
 
-    if (!rf.check("joints_list", axesListYarp))
-    {
-        yError() << "[XsensRetargeting::configure] Unable to find joints_list"
-                    "into config file.";
-        return false;
-    }
+    const double smoothingTime = parameters.smoothingTime;
 
-    if (!YarpHelper::yarpListToStringVector(axesListYarp, m_robotJointsListNames))
-    {
-        yError() << "[XsensRetargeting::configure] Unable to convert yarp list into a "
-                    "vector of strings.";
-        return false;
-    }
+    m_robotJointsListNames = parameters.jointsList;
     m_actuatedDOFs = m_robotJointsListNames.size();
 
     m_WBTrajectorySmoother
@@ -88,34 +97,22 @@ bool XsensRetargeting::configure(yarp::os::ResourceFinder& rf)
     yInfo() << "XsensRetargeting::configure:  smoothingTime: " << smoothingTime;
     yInfo() << "XsensRetargeting::configure:  NoOfJoints: " << m_actuatedDOFs;
 
-    std::string portName;
-    if (!YarpHelper::getStringFromSearchable(rf, "wholeBodyJointsPort", portName))
-    {
-        yError() << "[XsensRetargeting::configure] Unable to get a string from a searchable";
-        return false;
-    }
+    std::string portName = parameters.wholeBodyJointsPort;
     if (!m_wholeBodyHumanJointsPort.open("/" + getName() + portName))
     {
         yError() << "[XsensRetargeting::configure] " << portName << " port already open.";
         return false;
     }
+    m_wholeBodyHumanJointsPort.useCallback(m_wholeBodyHumanJointsMailbox);
 
-    if (!YarpHelper::getStringFromSearchable(rf, "controllerJointsPort", portName))
-    {
-        yError() << "[XsensRetargeting::configure] Unable to get a string from a searchable";
-        return false;
-    }
+    portName = parameters.controllerJointsPort;
     if (!m_wholeBodyHumanSmoothedJointsPort.open("/" + getName() + portName))
     {
         yError() << "[XsensRetargeting::configure] Unable to open the port " << portName;
         return false;
     }
 
-    if (!YarpHelper::getStringFromSearchable(rf, "controllerCoMPort", portName))
-    {
-        yError() << "[XsensRetargeting::configure] Unable to get a string from a searchable";
-        return false;
-    }
+    portName = parameters.controllerCoMPort;
     if (!m_HumanCoMPort.open("/" + getName() + portName))
     {
         yError() << "[XsensRetargeting::configure] Unable to open the port " << portName;
@@ -124,14 +121,7 @@ bool XsensRetargeting::configure(yarp::os::ResourceFinder& rf)
 
     m_firstIteration = true;
 
-    double jointThreshold;
-    if (!YarpHelper::getDoubleFromSearchable(rf, "jointDifferenceThreshold", jointThreshold))
-    {
-        yError() << "[XsensRetargeting::configure] Unable to find the whole body joint difference "
-                    "threshold.";
-        return false;
-    }
-    m_jointDiffThreshold = jointThreshold;
+    m_jointDiffThreshold = parameters.jointDifferenceThreshold;
     m_CoMValues.resize(3, 0.0);
 
     yInfo() << "[XsensRetargeting::configure]"
@@ -146,15 +136,43 @@ bool XsensRetargeting::configure(yarp::os::ResourceFinder& rf)
 }
 bool XsensRetargeting::getJointValues()
 {
-    hde::msgs::HumanState* desiredHumanStates = m_wholeBodyHumanJointsPort.read(false);
+    const hde::msgs::HumanState* desiredHumanStates = nullptr;
+    if (m_inputSession.isReplaying())
+    {
+        if (!m_inputSession.replay(m_humanJointsPositionsStream, m_replayedHumanState.positions))
+        {
+            return true;
+        }
+        m_inputSession.replayLabels(m_humanJointsNamesStream, m_replayedHumanState.jointNames);
 
-    if (desiredHumanStates == nullptr)
+        double CoM[3];
+        if (m_inputSession.replay(m_humanCoMStream, CoM, 3))
+        {
+            m_replayedHumanState.CoMPositionWRTGlobal.x = CoM[0];
+            m_replayedHumanState.CoMPositionWRTGlobal.y = CoM[1];
+            m_replayedHumanState.CoMPositionWRTGlobal.z = CoM[2];
+        }
+        desiredHumanStates = &m_replayedHumanState;
+    } else
     {
-        return true;
+        desiredHumanStates = m_wholeBodyHumanJointsMailbox.read();
+        if (desiredHumanStates == nullptr)
+        {
+            return true;
+        }
+
+        // the joint names are used only to build the joint map
+        if (m_firstIteration)
+        {
+            m_inputSession.recordLabels(m_humanJointsNamesStream, desiredHumanStates->jointNames);
+        }
+        m_inputSession.record(m_humanJointsPositionsStream, desiredHumanStates->positions);
+        const hde::msgs::Vector3& CoM = desiredHumanStates->CoMPositionWRTGlobal;
+        m_inputSession.record(m_humanCoMStream, std::array<double, 3>{CoM.x, CoM.y, CoM.z});
     }
 
     // get the new joint values
-    std::vector<double> newHumanjointsValues = desiredHumanStates->positions;
+    const std::vector<double>& newHumanjointsValues = desiredHumanStates->positions;
 
     // get the new CoM positions
     hde::msgs::Vector3 CoMValues = desiredHumanStates->CoMPositionWRTGlobal;
@@ -165,20 +183,11 @@ bool XsensRetargeting::getJointValues()
 
     if (!m_firstIteration)
     {
-        for (unsigned j = 0; j < m_actuatedDOFs; j++)
-        {
-            // check for the spikes in joint values
-             
-            if (std::abs(newHumanjointsValues[m_humanToRobotMap[j]] - m_jointValues(j))
-                > m_jointDiffThreshold)
-            {
-                yWarning() << "spike in data: joint : " << j << " , " << m_robotJointsListNames[j]
-                           << " ; old data: " << m_jointValues(j)
-                           << " ; new data:" << newHumanjointsValues[m_humanToRobotMap[j]];
-            }
-            m_jointValues(j) = newHumanjointsValues[m_humanToRobotMap[j]];
-            
-        }
+        XsensJointMapping::mapJointValues(newHumanjointsValues,
+                                          m_humanToRobotMap,
+                                          m_robotJointsListNames,
+                                          m_jointDiffThreshold,
+                                          m_jointValues);
     } else
     {
         yInfo() << "[XsensRetargeting::getJointValues] Xsens Retargeting Module is Running ...";
@@ -205,12 +214,21 @@ bool XsensRetargeting::getJointValues()
             }
         }
         /* find the map between the human and robot joint list orders*/
-        if (!pImpl->mapJointsHDE2Controller(
+        if (!XsensJointMapping::mapJointsHDE2Controller(
                 m_robotJointsListNames, m_humanJointsListName, m_humanToRobotMap))
         {
             yError() << "[XsensRetargeting::getJointValues()] mapping is not possible";
             return false;
         }
+
+        yInfo() << "*** mapped joint names: ****";
+        for (size_t i = 0; i < m_robotJointsListNames.size(); i++)
+        {
+            yInfo() << "(" << i << ", " << m_humanToRobotMap[i]
+                    << "): " << m_robotJointsListNames[i] << " , "
+                    << m_humanJointsListName[(m_humanToRobotMap[i])];
+        }
+
         if (m_humanToRobotMap.size() == 0)
         {
             yError() << "[XsensRetargeting::getJointValues()] m_humanToRobotMap.size is zero";
@@ -243,11 +261,15 @@ bool XsensRetargeting::getSmoothedJointValues(yarp::sig::Vector& smoothedJointVa
 
 double XsensRetargeting::getPeriod()
 {
-    return m_dT;
+    return m_inputSession.period(m_dT);
 }
 
 bool XsensRetargeting::updateModule()
 {
+    if (!m_inputSession.beginCycle())
+    {
+        return false;
+    }
 
     getJointValues();
 
@@ -265,19 +287,17 @@ bool XsensRetargeting::updateModule()
 
     if (!m_firstIteration)
     {
-        yarp::sig::Vector& CoMrefValues = m_HumanCoMPort.prepare();
-        CoMrefValues = m_CoMValues;
-        m_HumanCoMPort.write();
+        YarpHelper::sendVariadicVector(m_HumanCoMPort, m_CoMValues);
 
-        yarp::sig::Vector& refValues = m_wholeBodyHumanSmoothedJointsPort.prepare();
         if (m_useSmoothing)
         {
+            yarp::sig::Vector& refValues = m_wholeBodyHumanSmoothedJointsPort.prepare();
             getSmoothedJointValues(refValues);
+            m_wholeBodyHumanSmoothedJointsPort.write();
         } else
         {
-            refValues = m_jointValues;
+            YarpHelper::sendVariadicVector(m_wholeBodyHumanSmoothedJointsPort, m_jointValues);
         }
-        m_wholeBodyHumanSmoothedJointsPort.write();
     }
 
     return true;
@@ -285,45 +305,7 @@ bool XsensRetargeting::updateModule()
 
 bool XsensRetargeting::close()
 {
-    return true;
-}
-bool XsensRetargeting::impl::mapJointsHDE2Controller(std::vector<std::string> robotJointsListNames,
-                                                     std::vector<std::string> humanJointsListName,
-                                                     std::vector<unsigned>& humanToRobotMap)
-{
-    if (!humanToRobotMap.empty())
-    {
-        humanToRobotMap.clear();
-    }
-
-    bool foundMatch = false;
-    for (unsigned i = 0; i < robotJointsListNames.size(); i++)
-    {
-        for (unsigned j = 0; j < humanJointsListName.size(); j++)
-        {
-
-            if (robotJointsListNames[i] == humanJointsListName[j])
-            {
-                foundMatch = true;
-                humanToRobotMap.push_back(j);
-                break;
-            }
-        }
-        if (!foundMatch)
-        {
-            yError() << "[XsensRetargeting::impl::mapJointsHDE2CONTROLLER] not found match for: "
-                     << robotJointsListNames[i] << " , " << i;
-            return false;
-        }
-        foundMatch = false;
-    }
-
-    yInfo() << "*** mapped joint names: ****";
-    for (size_t i = 0; i < robotJointsListNames.size(); i++)
-    {
-        yInfo() << "(" << i << ", " << humanToRobotMap[i] << "): " << robotJointsListNames[i]
-                << " , " << humanJointsListName[(humanToRobotMap[i])];
-    }
-
+    m_wholeBodyHumanJointsPort.close();
+    m_inputSession.close();
     return true;
 }